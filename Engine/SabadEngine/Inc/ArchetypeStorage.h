@@ -0,0 +1,168 @@
+#pragma once
+
+#include "EntityHandle.h"
+#include "GameObjectHandle.h"
+
+namespace SabadEngine
+{
+	using EntityDataId = uint32_t;
+
+	// Plain data entities grouped by which data types they have (their archetype)
+	// each archetype stores its entities in fixed size chunks, one contiguous array per data type,
+	// so ForEach walks tightly packed memory with no virtual calls
+	// data types must be trivially copyable, entities are moved with memcpy when others are destroyed
+	// an entity can not gain or lose data types after it is created
+	class ArchetypeStorage final
+	{
+	public:
+		static constexpr uint32_t MaxDataTypes = 64;
+		static constexpr std::size_t ChunkSize = 16 * 1024;
+
+		ArchetypeStorage() = default;
+		~ArchetypeStorage();
+
+		ArchetypeStorage(const ArchetypeStorage&) = delete;
+		ArchetypeStorage(const ArchetypeStorage&&) = delete;
+		ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+		ArchetypeStorage& operator=(const ArchetypeStorage&&) = delete;
+
+		void Terminate();
+		void DebugUI();
+
+		template<class DataType>
+		static EntityDataId GetDataId()
+		{
+			static_assert(std::is_trivially_copyable_v<DataType>, "ArchetypeStorage: DataType must be trivially copyable!");
+			static_assert(alignof(DataType) <= ColumnAlignment, "ArchetypeStorage: DataType alignment is too large!");
+			static const EntityDataId id = RegisterDataType(sizeof(DataType));
+			return id;
+		}
+
+		// owner is optional, it lets systems find their way back to the GameObject
+		template<class... DataTypes>
+		EntityHandle Create(const GameObjectHandle& owner, const DataTypes&... data)
+		{
+			static_assert(sizeof...(DataTypes) > 0, "ArchetypeStorage: entities need at least one data type!");
+			const Signature signature = GetSignature<DataTypes...>();
+			ASSERT(CountDataTypes(signature) == sizeof...(DataTypes), "ArchetypeStorage: data types must be unique!");
+
+			const EntityHandle handle = Allocate(signature, owner);
+			const EntityRecord& record = mEntities[handle.mIndex];
+			Archetype& archetype = mArchetypes[record.archetype];
+			uint8_t* chunkData = archetype.chunks[record.chunk]->bytes;
+			(memcpy(chunkData + archetype.columnOffsets[GetDataId<DataTypes>()] + (record.row * sizeof(DataTypes)), &data, sizeof(DataTypes)), ...);
+			return handle;
+		}
+		void Destroy(const EntityHandle& handle);
+		void DestroyAll();
+		bool IsValid(const EntityHandle& handle) const;
+
+		// nullptr when the entity does not have the data type
+		template<class DataType>
+		DataType* Get(const EntityHandle& handle)
+		{
+			return static_cast<DataType*>(GetData(handle, GetDataId<DataType>(), sizeof(DataType)));
+		}
+		template<class DataType>
+		const DataType* Get(const EntityHandle& handle) const
+		{
+			return const_cast<ArchetypeStorage*>(this)->Get<DataType>(handle);
+		}
+		GameObjectHandle GetOwner(const EntityHandle& handle) const;
+
+		// calls function(DataTypes&...) for every entity that has all of the data types, chunk by chunk
+		// entities can not be created or destroyed from inside function
+		template<class... DataTypes, class Function>
+		void ForEach(Function&& function)
+		{
+			const Signature signature = GetSignature<DataTypes...>();
+			for (Archetype& archetype : mArchetypes)
+			{
+				if ((archetype.signature & signature) != signature)
+				{
+					continue;
+				}
+				const uint32_t offsets[] = { archetype.columnOffsets[GetDataId<DataTypes>()]... };
+				for (std::unique_ptr<Chunk>& chunk : archetype.chunks)
+				{
+					ForEachInChunk<DataTypes...>(*chunk, offsets, function, std::index_sequence_for<DataTypes...>());
+				}
+			}
+		}
+
+		uint32_t GetEntityCount() const;
+		uint32_t GetArchetypeCount() const;
+
+	private:
+		using Signature = uint64_t;
+		static constexpr uint32_t ColumnAlignment = 16;
+		static constexpr uint32_t InvalidOffset = std::numeric_limits<uint32_t>::max();
+
+		struct alignas(64) Chunk
+		{
+			uint8_t bytes[ChunkSize];
+			uint32_t count = 0;
+		};
+
+		struct Archetype
+		{
+			Signature signature = 0;
+			uint32_t chunkCapacity = 0;                     // entities that fit in one chunk
+			std::vector<EntityDataId> dataIds;
+			std::vector<uint32_t> dataSizes;
+			std::array<uint32_t, MaxDataTypes> columnOffsets;
+			uint32_t entityColumnOffset = 0;                // entity record index for each row
+			std::vector<std::unique_ptr<Chunk>> chunks;     // every chunk but the last is full
+		};
+
+		struct EntityRecord
+		{
+			uint32_t archetype = 0;
+			uint32_t chunk = 0;
+			uint32_t row = 0;
+			int generation = 0;
+			bool alive = false;
+			GameObjectHandle owner;
+		};
+
+		static EntityDataId RegisterDataType(uint32_t size);
+		static uint32_t GetDataSize(EntityDataId id);
+
+		template<class... DataTypes>
+		static Signature GetSignature()
+		{
+			return ((Signature(1) << GetDataId<DataTypes>()) | ...);
+		}
+
+		static constexpr uint32_t CountDataTypes(Signature signature)
+		{
+			uint32_t count = 0;
+			for (; signature != 0; signature &= signature - 1)
+			{
+				++count;
+			}
+			return count;
+		}
+
+		template<class... DataTypes, class Function, std::size_t... Indices>
+		static void ForEachInChunk(Chunk& chunk, const uint32_t* offsets, Function& function, std::index_sequence<Indices...>)
+		{
+			const std::tuple<DataTypes*...> columns(reinterpret_cast<DataTypes*>(chunk.bytes + offsets[Indices])...);
+			const uint32_t count = chunk.count;
+			for (uint32_t row = 0; row < count; ++row)
+			{
+				function(std::get<Indices>(columns)[row]...);
+			}
+		}
+
+		EntityHandle Allocate(Signature signature, const GameObjectHandle& owner);
+		uint32_t GetOrCreateArchetype(Signature signature);
+		void* GetData(const EntityHandle& handle, EntityDataId dataId, uint32_t size);
+
+		std::vector<Archetype> mArchetypes;
+		std::unordered_map<Signature, uint32_t> mArchetypeLookup;
+		std::vector<EntityRecord> mEntities;
+		std::vector<uint32_t> mFreeEntities;
+		uint32_t mEntityCount = 0;
+	};
+}
\ No newline at end of file
@@ -8,11 +8,14 @@ namespace SabadEngine
 	{
 	public:
 		SET_TYPE_ID(ComponentId::Camera);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
 
 		void Initialize() override;
 		void Terminate() override;
 		void DebugUI() override;
 		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
 
 		Graphics::Camera& GetCamera();
 		const Graphics::Camera& GetCamera() const;
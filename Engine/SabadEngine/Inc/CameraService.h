@@ -10,7 +10,10 @@ namespace SabadEngine
     {
     public:
         SET_TYPE_ID(ServiceId::Camera);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::Serial);
 
+        // points the world's tick view at the main camera
+        void Update(float deltaTime) override;
         void DebugUI() override;
 
         const Graphics::Camera& GetMain() const;
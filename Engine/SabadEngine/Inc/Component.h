@@ -1,10 +1,14 @@
 #pragma once
 
 #include "TypeIds.h"
+#include "UpdateAccess.h"
+#include "TickLod.h"
 
 namespace SabadEngine
 {
     class GameObject;
+    class SnapshotWriter;
+    class SnapshotReader;
 
     class Component
     {
@@ -29,14 +33,55 @@ namespace SabadEngine
         virtual void Deserialize(const rapidjson::Value& value) {}
         // Will write out data to a json document, which will be saved to a json file
         virtual void Serialize(rapidjson::Document& doc, rapidjson::Value& value, const rapidjson::Value& originalValue) {}
+        // binary state for a WorldSnapshot, LoadState runs before Initialize the same as Deserialize
+        // types that don't override it come back with their default values
+        virtual void SaveState(SnapshotWriter& writer) const {}
+        virtual void LoadState(SnapshotReader& reader) {}
 
         virtual uint32_t GetTypeId() const = 0;
+        // what Update and LateUpdate touch, override with SET_UPDATE_ACCESS to let the GameWorld run them in parallel
+        virtual UpdateAccess GetUpdateAccess() const { return {}; }
 
         GameObject& GetOwner() { return *mOwner; }
         const GameObject& GetOwner() const { return *mOwner; }
 
+        // Update runs every interval frames and gets the time since it last ran, LateUpdate still runs every frame
+        // components on the same interval are spread over its frames so the work doesn't land on one frame
+        void SetTickInterval(uint32_t interval);
+        // the interval then follows the owner's distance to the world's tick view, picked again every time it ticks
+        // the lod must outlive the component, null goes back to the fixed interval
+        void SetTickLod(const TickLod* tickLod);
+        uint32_t GetTickInterval() const { return mTickInterval; }
+        const TickLod* GetTickLod() const { return mTickLod; }
+
+        // false when the type keeps the empty Component::Update or LateUpdate, the GameWorld then never calls it
+        bool HasUpdate() const { return mHasUpdate; }
+        bool HasLateUpdate() const { return mHasLateUpdate; }
+
+        // a type ticks in a phase if it or a base between it and Component overrides the function
+        template<class ComponentType>
+        static constexpr bool OverridesUpdate()
+        {
+            return !std::is_same_v<decltype(&ComponentType::Update), void (Component::*)(float)>;
+        }
+        template<class ComponentType>
+        static constexpr bool OverridesLateUpdate()
+        {
+            return !std::is_same_v<decltype(&ComponentType::LateUpdate), void (Component::*)(float)>;
+        }
+
     private:
         friend class GameObject;
+        friend class UpdateScheduler;
+        void AssignTickSlot();
+
         GameObject* mOwner = nullptr;
+        const TickLod* mTickLod = nullptr;
+        float mTickElapsed = 0.0f;
+        uint32_t mTickInterval = 1;
+        uint32_t mTickSlot = 0;
+        bool mHasTickSlot = false;
+        bool mHasUpdate = true;
+        bool mHasLateUpdate = true;
     };
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "EntityHandle.h"
+
+namespace SabadEngine
+{
+	class GameObject;
+	class GameWorld;
+	class TransformComponent;
+	class RigidBodyComponent;
+
+	// the rigid body state a ForEach can read and change, mass is only read
+	struct RigidBodyData
+	{
+		Math::Vector3 velocity = Math::Vector3::Zero;
+		Math::Vector3 angularVelocity = Math::Vector3::Zero;
+		float mass = 0.0f;  // 0 for static bodies
+	};
+
+	// the components a mirrored entity copies from and back to, they are destroyed along with the entity
+	struct MirroredComponents
+	{
+		TransformComponent* transform = nullptr;
+		RigidBodyComponent* rigidBody = nullptr;
+	};
+}
+
+// Lets ForEach<Graphics::Transform, RigidBodyData> reach game objects built from components
+// Mirror attaches an entity holding copies of the object's TransformComponent and RigidBodyComponent
+// the components stay the source of truth: Pull copies them into every mirrored entity before a ForEach,
+// and Push copies the entities back after it, moving the dynamic bodies whose transform or velocity changed
+// the Graphics::Transform is local to the parent, the same as the component's
+namespace SabadEngine::ComponentMirror
+{
+	// the object needs a TransformComponent and must not have an entity yet, a RigidBodyComponent is optional
+	EntityHandle Mirror(GameWorld& world, GameObject& gameObject);
+	void Pull(GameWorld& world);
+	void Push(GameWorld& world);
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#pragma once
+
+namespace SabadEngine::CookedLevel
+{
+	// A level and every template it references compiled into one file that GameWorld::LoadCookedLevel maps and reads in place
+	// layout: Header, then each table at the offset the header gives, all records are fixed size and 4 or 8 byte aligned
+	// component data is kept as a tree of ValueRecords so every component's Deserialize still works on it,
+	// the loader turns those straight into rapidjson values without any text parsing
+	constexpr uint32_t Magic = 0x564C4253; // "SBLV"
+	constexpr uint32_t Version = 2;
+	constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+	constexpr const char* Extension = ".sblevel";
+
+	struct Header
+	{
+		uint32_t magic = Magic;
+		uint32_t version = Version;
+		uint32_t fileSize = 0;
+		uint32_t capacity = 0;
+
+		uint32_t stringCount = 0;
+		uint32_t stringsOffset = 0;
+		uint32_t charCount = 0;
+		uint32_t charsOffset = 0;
+		uint32_t valueCount = 0;
+		uint32_t valuesOffset = 0;
+		uint32_t serviceCount = 0;
+		uint32_t servicesOffset = 0;
+		uint32_t templateCount = 0;
+		uint32_t templatesOffset = 0;
+		uint32_t componentCount = 0;
+		uint32_t componentsOffset = 0;
+		uint32_t objectCount = 0;
+		uint32_t objectsOffset = 0;
+	};
+
+	// chars are null terminated so they can be handed out as c strings
+	struct StringRecord
+	{
+		uint32_t offset = 0;
+		uint32_t length = 0;
+	};
+
+	enum class ValueType : uint8_t
+	{
+		Null,
+		False,
+		True,
+		Int,
+		Double,
+		String,
+		Array,
+		Object
+	};
+
+	// arrays and objects own the children [first, first + count), object members carry their name
+	struct ValueRecord
+	{
+		ValueType type = ValueType::Null;
+		uint32_t name = InvalidIndex;
+		union
+		{
+			int64_t intValue = 0;
+			double doubleValue;
+			uint32_t string;
+			struct
+			{
+				uint32_t first;
+				uint32_t count;
+			} children;
+		};
+	};
+	static_assert(sizeof(ValueRecord) == 16, "CookedLevel: ValueRecord must stay 16 bytes.");
+
+	struct ServiceRecord
+	{
+		uint32_t name = InvalidIndex;
+		uint32_t value = InvalidIndex;  // passed to Service::Deserialize
+	};
+
+	struct ComponentRecord
+	{
+		uint32_t type = InvalidIndex;   // component name, as in the json
+		uint32_t value = InvalidIndex;
+	};
+
+	// components every object made from the template gets, stored once
+	struct TemplateRecord
+	{
+		uint32_t path = InvalidIndex;
+		uint32_t firstComponent = 0;
+		uint32_t componentCount = 0;
+	};
+
+	// the overrides are applied after the template components, the same as GameObjectFactory::OverrideDeserialize
+	struct ObjectRecord
+	{
+		uint32_t name = InvalidIndex;
+		uint32_t templateIndex = InvalidIndex;
+		uint32_t firstOverride = 0;
+		uint32_t overrideCount = 0;
+	};
+
+	// reads the level json and its templates and writes the cooked file, returns false if a file can't be read or written
+	bool Cook(const std::filesystem::path& levelFile, const std::filesystem::path& cookedFile);
+
+	// checked view over a mapped cooked file
+	class Reader
+	{
+	public:
+		// returns false if the data is not a cooked level of this version, or any record points outside its table
+		// after that the getters only assert, every index they are handed by the records was checked here
+		bool Open(const uint8_t* data, std::size_t size);
+
+		const Header& GetHeader() const;
+		std::string_view GetString(uint32_t index) const;
+		const ServiceRecord& GetServiceRecord(uint32_t index) const;
+		const TemplateRecord& GetTemplateRecord(uint32_t index) const;
+		const ComponentRecord& GetComponentRecord(uint32_t index) const;
+		const ObjectRecord& GetObjectRecord(uint32_t index) const;
+
+		// strings are referenced, not copied, so the value must not outlive the mapped data
+		rapidjson::Value MakeValue(uint32_t index, rapidjson::MemoryPoolAllocator<>& allocator) const;
+
+	private:
+		template<class RecordType>
+		const RecordType* GetTable(uint32_t offset, uint32_t count) const;
+		bool ValidateRecords() const;
+
+		const Header* mHeader = nullptr;
+		const StringRecord* mStrings = nullptr;
+		const char* mChars = nullptr;
+		const ValueRecord* mValues = nullptr;
+		const ServiceRecord* mServices = nullptr;
+		const TemplateRecord* mTemplates = nullptr;
+		const ComponentRecord* mComponents = nullptr;
+		const ObjectRecord* mObjects = nullptr;
+		const uint8_t* mData = nullptr;
+		std::size_t mSize = 0;
+	};
+}
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace SabadEngine
 	{
 	public:
 		SET_TYPE_ID(ComponentId::Animator);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::Pose, UpdateThreading::PerObject);
 
 		void Initialize() override;
 
@@ -15,6 +16,11 @@ namespace SabadEngine
 
 		void DebugUI() override;
 
+		// "TickInterval" for a fixed rate or "TickLod" to slow down with distance, see SaveUtil::ReadTickLod
+		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
+
 		bool Play(int index, bool looping = false);
 
 		Graphics::Animator& GetAnimator();
@@ -22,5 +28,6 @@ namespace SabadEngine
 
 	private:
 		Graphics::Animator mAnimator;
+		TickLod mTickLod;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+namespace SabadEngine
+{
+	class EntityHandle
+	{
+	public:
+		EntityHandle() = default;
+
+	private:
+		friend class ArchetypeStorage;
+		int mIndex = -1;        // index of the entity record in the archetype storage
+		int mGeneration = -1;   // bumped when the entity is destroyed so stale handles fail
+	};
+}
\ No newline at end of file
@@ -10,12 +10,15 @@ namespace SabadEngine
 	{
 	public:
 		SET_TYPE_ID(ComponentId::FPSCamera);
+		SET_UPDATE_ACCESS(UpdateData::Input, UpdateData::Camera, UpdateThreading::PerObject);
 
 		void Initialize() override;
 		void Terminate() override;
 		void Update(float deltaTime) override;
 		void DebugUI() override;
 		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
 
 	private:
 		CameraComponent* mCameraComponent = nullptr;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GameObjectHandle.h"
+#include "EntityHandle.h"
 #include "Component.h"
 
 namespace SabadEngine
@@ -25,6 +26,8 @@ namespace SabadEngine
         uint32_t GetId() const;
 
         const GameObjectHandle& GetHandle() const;
+        // plain data entity attached with GameWorld::AttachEntity, invalid if there is none
+        const EntityHandle& GetEntity() const;
 
         GameWorld& GetWorld();
         const GameWorld& GetWorld() const;
@@ -39,6 +42,30 @@ namespace SabadEngine
         GameObject* GetParent();
         const GameObject* GetParent() const;
 
+        // one bit per component slot, test against MakeComponentMask<...>() to filter objects without lookups
+        using ComponentMask = uint64_t;
+        static constexpr uint32_t MaxComponentSlots = 64;
+
+        // built in component ids are their own slot, custom ids get the next free slot the first time they are seen
+        static uint32_t GetComponentSlot(uint32_t typeId);
+        template<class ComponentType>
+        static uint32_t GetComponentSlot()
+        {
+            const uint32_t typeId = ComponentType::StaticGetTypeId();
+            if (typeId < static_cast<uint32_t>(ComponentId::Count))
+            {
+                return typeId;
+            }
+            static const uint32_t slot = GetComponentSlot(typeId);
+            return slot;
+        }
+        template<class... ComponentTypes>
+        static ComponentMask MakeComponentMask()
+        {
+            return ((ComponentMask(1) << GetComponentSlot<ComponentTypes>()) | ...);
+        }
+        ComponentMask GetComponentMask() const;
+
         template<class ComponentType>
         ComponentType* AddComponent()
         {
@@ -49,25 +76,24 @@ namespace SabadEngine
             ASSERT(ComponentType::StaticGetTypeId() != static_cast<uint32_t>(ComponentId::Invalid),
                 "GameObject: Component has an invalid ID!");
 
+            const uint32_t slot = GetComponentSlot<ComponentType>();
+            mComponentIndices[slot] = static_cast<uint8_t>(mComponents.size());
+            mComponentMask |= ComponentMask(1) << slot;
+
             auto& newComponent = mComponents.emplace_back(std::make_unique<ComponentType>());
             newComponent->mOwner = this;
+            newComponent->mHasUpdate = Component::OverridesUpdate<ComponentType>();
+            newComponent->mHasLateUpdate = Component::OverridesLateUpdate<ComponentType>();
             return static_cast<ComponentType*>(newComponent.get());
         }
 
         template<class ComponentType>
-        bool HasA()
+        bool HasA() const
         {
             static_assert(std::is_base_of_v<Component, ComponentType>,
                 "GameObject: ComponentType must be of type Component!");
 
-            for (auto& component : mComponents)
-            {
-                if (component->GetTypeId() == ComponentType::StaticGetTypeId())
-                {
-                    return true;
-                }
-            }
-            return false;
+            return (mComponentMask & (ComponentMask(1) << GetComponentSlot<ComponentType>())) != 0;
         }
 
         template<class ComponentType>
@@ -76,14 +102,12 @@ namespace SabadEngine
             static_assert(std::is_base_of_v<Component, ComponentType>,
                 "GameObject: ComponentType must be of type Component!");
 
-            for (auto& component : mComponents)
+            const uint8_t index = mComponentIndices[GetComponentSlot<ComponentType>()];
+            if (index == InvalidComponentIndex)
             {
-                if (component->GetTypeId() == ComponentType::StaticGetTypeId())
-                {
-                    return static_cast<ComponentType*>(component.get());
-                }
+                return nullptr;
             }
-            return nullptr;
+            return static_cast<const ComponentType*>(mComponents[index].get());
         }
 
         template<class ComponentType>
@@ -101,12 +125,28 @@ namespace SabadEngine
         uint32_t mId = 0;
 
         GameObjectHandle mHandle;
+        EntityHandle mEntity;
 
         GameWorld* mWorld = nullptr;
 
         using Components = std::vector<std::unique_ptr<Component>>;
         Components mComponents;
 
+        // index into mComponents for every component slot, so lookups never scan
+        static constexpr uint8_t InvalidComponentIndex = 0xFF;
+        std::array<uint8_t, MaxComponentSlots> mComponentIndices = MakeEmptyComponentIndices();
+        ComponentMask mComponentMask = 0;
+
+        static constexpr std::array<uint8_t, MaxComponentSlots> MakeEmptyComponentIndices()
+        {
+            std::array<uint8_t, MaxComponentSlots> indices = {};
+            for (std::size_t i = 0; i < indices.size(); ++i)
+            {
+                indices[i] = InvalidComponentIndex;
+            }
+            return indices;
+        }
+
         using Children = std::vector<GameObject*>;
         Children mChildren;
         GameObject* mParent = nullptr;
@@ -6,13 +6,25 @@ namespace SabadEngine
 	class GameWorld;
 	class Component;
 
-	using CustomComponent = std::function<Component* (const std::string&, GameObject&)>;
-
 	namespace GameObjectFactory
 	{
-		void SetCustomMake(CustomComponent callback);
-		void SetCustomGet(CustomComponent callback);
+		struct Template;
+
+		// template files are parsed once and cached, a file edited on disk is picked up within a second
 		void Make(const std::filesystem::path& templatePath, GameObject& gameObject, GameWorld& gameWorld);
+		// the cached template itself, for making many objects without going through the cache for each
+		// it is read only, so any number of threads can make objects from it at once
+		std::shared_ptr<const Template> GetTemplate(const std::filesystem::path& templatePath);
+		void Make(const Template& objectTemplate, GameObject& gameObject);
+		// parses the template into the cache without making anything, safe to call from a worker thread
+		void PreloadTemplate(const std::filesystem::path& templatePath);
+		// drops every cached template so the next Make reads the files again
+		void InvalidateTemplates();
+		uint32_t GetCachedTemplateCount();
 		void OverrideDeserialize(const rapidjson::Value& value, GameObject& gameObject);
+
+		// makes or finds a component by its json type name through the TypeRegistry, for loaders that keep their own component data
+		Component* AddComponent(const std::string& componentName, GameObject& gameObject);
+		Component* GetComponent(const std::string& componentName, GameObject& gameObject);
 	}
 }
\ No newline at end of file
@@ -2,14 +2,29 @@
 
 namespace SabadEngine
 {
+    // 24 bits of slot index and 8 bits of generation packed in one word, so handles copy and compare as a uint32_t
     class GameObjectHandle
     {
     public:
+        static constexpr uint32_t IndexBits = 24;
+        static constexpr uint32_t GenerationBits = 8;
+        static constexpr uint32_t MaxIndex = (1u << IndexBits) - 2; // the all ones index is the invalid handle
+        static constexpr uint32_t MaxGeneration = (1u << GenerationBits) - 1;
+
         GameObjectHandle() = default;
 
+        bool operator==(const GameObjectHandle& other) const { return mValue == other.mValue; }
+        bool operator!=(const GameObjectHandle& other) const { return mValue != other.mValue; }
+
     private:
         friend class GameWorld;
-        int mIndex = -1; // Is going to be the index of the slot in the game world
-        int mGeneration = -1; // to verify if item is already tagged for deletion/ removal
+
+        GameObjectHandle(uint32_t index, uint32_t generation)
+            : mValue((generation << IndexBits) | index) {}
+
+        uint32_t GetIndex() const { return mValue & ((1u << IndexBits) - 1); } // Is going to be the index of the slot in the game world
+        uint32_t GetGeneration() const { return mValue >> IndexBits; } // to verify if item is already tagged for deletion/ removal
+
+        uint32_t mValue = UINT32_MAX;
     };
 }
\ No newline at end of file
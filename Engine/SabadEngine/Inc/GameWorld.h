@@ -2,17 +2,24 @@
 
 #include "GameObject.h"
 #include "Service.h"
+#include "ArchetypeStorage.h"
+#include "UpdateScheduler.h"
+#include "TransformHierarchy.h"
+#include "LevelLoader.h"
 
 namespace SabadEngine
 {
-
-	using CustomService = std::function<Service* (const std::string&, GameWorld&)>;
+	class CameraService;
+	class RenderService;
+	class PhysicsService;
+	class UIRenderService;
+	class SpatialService;
+	class WorldSnapshot;
 
 	class GameWorld final
 	{
 	public:
-		static void SetCustomService(CustomService customService);
-
+		// capacity is only the starting size, the world grows when it runs out of slots
 		void Initialize(uint32_t capacity = 10);
 		void Terminate();
 		void Update(float deltaTime);
@@ -20,9 +27,77 @@ namespace SabadEngine
 		void DebugUI();
 
 		GameObject* CreateGameObject(std::string name, const std::filesystem::path& templatePath = "");
+		// makes count objects from one template, named after the template file with their index, and initializes them
+		// components are made and deserialized on the JobSystem workers along with initializer(gameObject, index),
+		// which must only touch that object and must not parent it, parent the returned objects afterwards
+		// then every object initializes on the calling thread in index order
+		// the objects take the same slots count CreateGameObject calls would
+		using ObjectInitializer = std::function<void(GameObject&, uint32_t)>;
+		std::vector<GameObject*> CreateGameObjects(const std::filesystem::path& templatePath, uint32_t count, const ObjectInitializer& initializer = nullptr);
 		void DestroyGameObject(const GameObjectHandle& handle);
+		// null once the object is destroyed, the handle stays safe to test after its slot is reused
+		GameObject* GetGameObject(const GameObjectHandle& handle);
+		const GameObject* GetGameObject(const GameObjectHandle& handle) const;
+		uint32_t GetGameObjectCount() const;
 
+		// a file with the CookedLevel extension is loaded with LoadCookedLevel
 		void LoadLevel(const std::filesystem::path& levelFile);
+		// maps a level made by CookedLevel::Cook, same result as LoadLevel on the json it came from
+		void LoadCookedLevel(const std::filesystem::path& cookedFile);
+		// reads the file on a worker thread, then makes objects in Update for at most budgetMs each frame
+		// the world only updates and renders once every object is made, progress is sent as a LevelLoadProgressEvent
+		void LoadLevelAsync(const std::filesystem::path& levelFile, float budgetMs = 4.0f);
+		void SetLevelLoadBudget(float budgetMs);
+		bool IsLoading() const;
+
+		// every object with its handle, parent, children and component state, taken between updates
+		// objects destroyed this frame are left out, so are components and services of types that were never registered
+		void CaptureSnapshot(WorldSnapshot& snapshot, uint32_t frame) const;
+		// into a world that is not initialized, like a level, handles from the captured world find the same objects
+		void RestoreSnapshot(const WorldSnapshot& snapshot);
+
+		// where components with a TickLod measure their distance from, set by the CameraService each frame
+		void SetTickView(const TickView& tickView);
+		const TickView& GetTickView() const;
+		// components or services the last Update ran in the phase, idle components are never counted
+		uint32_t GetUpdateWorkCount(UpdatePhase phase) const;
+		// off until enabled here or in DebugUI, times Update, LateUpdate, Render and DebugUI per component type and service
+		UpdateProfiler& GetUpdateProfiler();
+		const UpdateProfiler& GetUpdateProfiler() const;
+
+		// opt in plain data entities for systems that touch many objects every frame, see ArchetypeStorage
+		template<class... DataTypes>
+		EntityHandle CreateEntity(const DataTypes&... data)
+		{
+			return mEntities.Create(GameObjectHandle(), data...);
+		}
+		// the entity is destroyed along with the game object
+		template<class... DataTypes>
+		EntityHandle AttachEntity(GameObject& owner, const DataTypes&... data)
+		{
+			ASSERT(!mEntities.IsValid(owner.mEntity), "GameWorld: game object already has an entity.");
+			owner.mEntity = mEntities.Create(owner.GetHandle(), data...);
+			return owner.mEntity;
+		}
+		// destroys right away, so not from inside ForEach
+		void DestroyEntity(const EntityHandle& handle);
+
+		template<class DataType>
+		DataType* GetEntityData(const EntityHandle& handle)
+		{
+			return mEntities.Get<DataType>(handle);
+		}
+		GameObjectHandle GetEntityOwner(const EntityHandle& handle) const;
+
+		// calls function(DataTypes&...) for every entity that has all of the data types
+		template<class... DataTypes, class Function>
+		void ForEach(Function&& function)
+		{
+			mEntities.ForEach<DataTypes...>(std::forward<Function>(function));
+		}
+		uint32_t GetEntityCount() const;
+
+		const TransformHierarchy& GetTransformHierarchy() const;
 
 		template<class ServiceType>
 		ServiceType* AddService()
@@ -33,19 +108,23 @@ namespace SabadEngine
 
 			auto& newService = mServices.emplace_back(std::make_unique<ServiceType>());
 			newService->mWorld = this;
+			SetServiceSlot(GetServiceSlot<ServiceType>(), newService.get());
 			return static_cast<ServiceType*>(newService.get());
 		}
+		// an indexed load for engine services, custom services look their slot up once per type
 		template<class ServiceType>
 		const ServiceType* GetService() const
 		{
-			for (auto& service : mServices)
+			const uint32_t slot = GetServiceSlot<ServiceType>();
+			if constexpr (ServiceType::StaticGetTypeId() < EngineServiceCount)
+			{
+				return static_cast<const ServiceType*>(mEngineServices[slot]);
+			}
+			else
 			{
-				if (service->GetTypeId() == ServiceType::StaticGetTypeId())
-				{
-					return static_cast<ServiceType*>(service.get());
-				}
+				const uint32_t customIndex = slot - EngineServiceCount;
+				return (customIndex < mCustomServices.size()) ? static_cast<const ServiceType*>(mCustomServices[customIndex]) : nullptr;
 			}
-			return nullptr;
 		}
 		template<class ServiceType>
 		ServiceType* GetService()
@@ -54,23 +133,106 @@ namespace SabadEngine
 			return const_cast<ServiceType*>(thisConst->GetService<ServiceType>());
 		}
 
+		// cached when the service is added, null if the world doesn't have one
+		CameraService* GetCameraService() { return mCameraService; }
+		const CameraService* GetCameraService() const { return mCameraService; }
+		RenderService* GetRenderService() { return mRenderService; }
+		const RenderService* GetRenderService() const { return mRenderService; }
+		PhysicsService* GetPhysicsService() { return mPhysicsService; }
+		const PhysicsService* GetPhysicsService() const { return mPhysicsService; }
+		UIRenderService* GetUIRenderService() { return mUIRenderService; }
+		const UIRenderService* GetUIRenderService() const { return mUIRenderService; }
+		SpatialService* GetSpatialService() { return mSpatialService; }
+		const SpatialService* GetSpatialService() const { return mSpatialService; }
+
 	private:
-		bool IsValid(const GameObjectHandle& handle);
+		friend class GameObject;
+		friend class LevelLoader;
+
+		bool IsValid(const GameObjectHandle& handle) const;
+		// liveIndex must already be in mLiveObjects, so objects can be made into reserved slots from several threads
+		GameObject* CreateInSlot(std::string name, uint32_t index, uint32_t liveIndex);
+		bool TakeFreeSlot(uint32_t& index);
+		Service* AddServiceByName(const std::string& serviceName);
 		void ProcessDestroyList();
+		void BuildSchedule();
+		void BuildTransformHierarchy();
+		void RefreshTransformHierarchy();
+		void UpdateLevelLoad();
+		void SetServiceSlot(uint32_t slot, Service* service);
+
+		static constexpr uint32_t EngineServiceCount = static_cast<uint32_t>(ServiceId::Count);
+
+		// engine service ids are their own slot, custom ids get the next free slot the first time they are seen
+		static uint32_t GetServiceSlot(uint32_t typeId);
+		template<class ServiceType>
+		static uint32_t GetServiceSlot()
+		{
+			constexpr uint32_t typeId = ServiceType::StaticGetTypeId();
+			if constexpr (typeId < EngineServiceCount)
+			{
+				return typeId;
+			}
+			else
+			{
+				static const uint32_t slot = GetServiceSlot(typeId);
+				return slot;
+			}
+		}
 
 		struct Slot
 		{
 			std::unique_ptr<GameObject> gameObject;
 			uint32_t generation = 0;
+			uint32_t liveIndex = 0; // where the object is in mLiveObjects
 		};
 
-		using GameObjectSlots = std::vector<Slot>;
-		GameObjectSlots mGameObjectSlots;
+		Slot& GetSlot(uint32_t index);
+		const Slot& GetSlot(uint32_t index) const;
+		void AddSlotChunk();
+
+		// slots are added a chunk at a time and never move, a slot whose generation runs out is retired
+		// instead of freed so a stale handle can never match a newer object
+		static constexpr uint32_t SlotChunkBits = 10;
+		static constexpr uint32_t SlotChunkSize = 1u << SlotChunkBits;
+		std::vector<std::unique_ptr<Slot[]>> mSlotChunks;
+		uint32_t mSlotCount = 0;
 		std::vector<uint32_t> mFreeSlots;
+		// every object not yet removed by ProcessDestroyList, packed so loops never visit empty slots
+		std::vector<GameObject*> mLiveObjects;
 		std::vector<uint32_t> mToBeDestroyed;
 		bool mInitialized = false;
+		// set while CreateGameObjects runs its initializer on the workers, parent links can't change then
+		bool mCreatingObjects = false;
 
+		// owned in the order they were added, which is the order they initialize and update in
 		using Services = std::vector<std::unique_ptr<Service>>;
 		Services mServices;
+		// the same services by slot, engine services by ServiceId and custom ones after them
+		std::array<Service*, EngineServiceCount> mEngineServices = {};
+		std::vector<Service*> mCustomServices;
+		CameraService* mCameraService = nullptr;
+		RenderService* mRenderService = nullptr;
+		PhysicsService* mPhysicsService = nullptr;
+		UIRenderService* mUIRenderService = nullptr;
+		SpatialService* mSpatialService = nullptr;
+
+		ArchetypeStorage mEntities;
+
+		// rebuilt at the start of the next Update whenever objects are initialized or destroyed
+		UpdateScheduler mScheduler;
+		bool mScheduleDirty = true;
+		UpdateProfiler mProfiler;
+
+		// world matrices are refreshed right before Render, or after LateUpdate when the world was not rendered since the last Update
+		// the order is rebuilt when objects or parent links change
+		TransformHierarchy mTransformHierarchy;
+		bool mTransformHierarchyDirty = true;
+		bool mRenderedSinceUpdate = false;
+
+		// set while LoadLevelAsync is running, the read future is done before the world is initialized
+		std::unique_ptr<LevelLoader> mLevelLoader;
+		std::future<void> mLevelRead;
+		float mLevelLoadBudgetMs = 4.0f;
 	};
 }
\ No newline at end of file
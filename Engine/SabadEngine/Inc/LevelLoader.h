@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CookedLevel.h"
+#include "TypeIds.h"
+
+namespace SabadEngine
+{
+	class GameWorld;
+	struct ComponentRegistration;
+
+	// sent by GameWorld::LoadLevelAsync after every frame of object creation, done is set once the level is complete
+	class LevelLoadProgressEvent : public Core::Event
+	{
+	public:
+		LevelLoadProgressEvent(uint32_t loadedCount, uint32_t totalCount, bool isDone)
+			: loaded(loadedCount), total(totalCount), done(isDone) {}
+		SET_EVENT_TYPE_ID(EngineEventId::LevelLoadProgress)
+
+		uint32_t loaded = 0;
+		uint32_t total = 0;
+		bool done = false;
+	};
+
+	// Loads a json or cooked level in two stages so the work can be spread out
+	// Read opens and parses the file and warms the template cache, it touches no world state and can run on a worker thread
+	// the rest runs on the thread that owns the world, one object per CreateNext
+	class LevelLoader final
+	{
+	public:
+		void Read(const std::filesystem::path& levelFile);
+		void Close();
+
+		// adds and deserializes the level services, then initializes the world with the level capacity
+		void InitializeWorld(GameWorld& gameWorld);
+		// makes, deserializes and initializes the next object, returns false once every object is made
+		bool CreateNext(GameWorld& gameWorld);
+
+		uint32_t GetObjectCount() const;
+		uint32_t GetCreatedCount() const;
+
+	private:
+		void ReadLevel(const std::filesystem::path& levelFile);
+		void ReadCookedLevel(const std::filesystem::path& cookedFile);
+		void CreateLevelObject(GameWorld& gameWorld, uint32_t index);
+		void CreateCookedObject(GameWorld& gameWorld, uint32_t index);
+		const ComponentRegistration& GetRegistration(uint32_t componentIndex);
+
+		bool mCooked = false;
+		uint32_t mCapacity = 0;
+		uint32_t mCreatedCount = 0;
+		std::vector<std::string> mServiceNames;
+		std::vector<rapidjson::Value> mServiceValues;
+
+		// json levels, the objects point into the document
+		rapidjson::Document mDocument;
+		std::vector<const rapidjson::Value*> mLevelObjects;
+		std::vector<std::string> mLevelObjectNames;
+
+		// cooked levels, component values are built once and point at the mapped strings
+		Core::MappedFile mFile;
+		CookedLevel::Reader mReader;
+		std::vector<rapidjson::Value> mComponentValues;
+		std::vector<const ComponentRegistration*> mRegistrations;
+	};
+}
\ No newline at end of file
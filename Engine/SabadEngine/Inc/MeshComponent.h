@@ -8,11 +8,27 @@ namespace SabadEngine
     {
     public:
         SET_TYPE_ID(ComponentId::Mesh);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
 
         void Deserialize(const rapidjson::Value& value) override;
+        void SaveState(SnapshotWriter& writer) const override;
+        void LoadState(SnapshotReader& reader) override;
         const Graphics::Model& GetModel() const override;
 
     private:
+        // what each mesh was built from, a snapshot keeps this instead of the vertices
+        struct MeshShape
+        {
+            std::string type;
+            uint32_t slices = 0;        // rows for a plane
+            uint32_t rings = 0;         // columns for a plane
+            float size = 0.0f;          // the sphere radius, plane spacing or cube size
+            bool horizontal = true;
+        };
+
+        static Graphics::Mesh BuildMesh(const MeshShape& shape);
+
         Graphics::Model mMeshModel;
+        std::vector<MeshShape> mShapes;
     };
 }
\ No newline at end of file
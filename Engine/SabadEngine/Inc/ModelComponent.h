@@ -8,12 +8,15 @@ namespace SabadEngine
     {
     public:
         SET_TYPE_ID(ComponentId::Model);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
 
         void Initialize() override;
 
         void Terminate() override;
 
         void Deserialize(const rapidjson::Value& value) override;
+        void SaveState(SnapshotWriter& writer) const override;
+        void LoadState(SnapshotReader& reader) override;
 
         Graphics::ModelId GetModelId() const override;
 
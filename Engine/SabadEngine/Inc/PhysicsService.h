@@ -1,10 +1,31 @@
 #pragma once
 
 #include "Service.h"
+#include "GameObjectHandle.h"
 
 namespace SabadEngine
 {
 	class RigidBodyComponent;
+	class TriggerComponent;
+
+	struct PhysicsContactPair
+	{
+		GameObjectHandle objectA;
+		GameObjectHandle objectB;   // always the trigger for TriggerEnter and TriggerExit
+		Physics::ContactEventType type;
+	};
+
+	// every contact change from one physics update in a single broadcast
+	// the event owns its pairs, so a listener may keep a copy of it after the callback
+	class PhysicsContactEvent : public Core::Event
+	{
+	public:
+		PhysicsContactEvent(std::vector<PhysicsContactPair>&& contactPairs) : pairs(std::move(contactPairs)) {}
+		SET_EVENT_TYPE_ID(EngineEventId::PhysicsContacts)
+
+		std::vector<PhysicsContactPair> pairs;
+	};
+
 	class PhysicsService : public Service
 	{
 	public:
@@ -16,11 +37,23 @@ namespace SabadEngine
 
 		void Register(RigidBodyComponent* rigidBodyComponent);
 		void Unregister(RigidBodyComponent* rigidBodyComponent);
+		void Register(TriggerComponent* triggerComponent);
+		void Unregister(TriggerComponent* triggerComponent);
 
 		void SetEnabled(bool enabled);
 
 	private:
+		void UnregisterObject(Physics::PhysicsObject* physicsObject);
+		void AddContactPair(const Physics::ContactEvent& contactEvent, std::vector<PhysicsContactPair>& contactPairs) const;
+		// skips the world's first events, those are the ones UnregisterObject already added to mEndedPairs
+		void BroadcastContacts(std::size_t endedCount);
+
 		bool mEnabled = true;
 
+		std::unordered_map<const Physics::PhysicsObject*, GameObjectHandle> mObjectHandles;
+		std::vector<PhysicsContactPair> mContactPairs;
+		// pairs that ended because an object was unregistered, sent first with the next update's contacts
+		std::vector<PhysicsContactPair> mEndedPairs;
+
 	};
 }
\ No newline at end of file
@@ -11,6 +11,8 @@ namespace SabadEngine
         void Terminate() override;
 
         void Deserialize(const rapidjson::Value& value) override;
+        void SaveState(SnapshotWriter& writer) const override;
+        void LoadState(SnapshotReader& reader) override;
 
         bool CanCastShadow() const;
 
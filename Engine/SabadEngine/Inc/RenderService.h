@@ -12,6 +12,7 @@ namespace SabadEngine
 	{
 	public:
 		SET_TYPE_ID(ServiceId::Render);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::Render, UpdateThreading::Serial);
 
 		void Initialize() override;
 		void Terminate() override;
@@ -34,6 +35,7 @@ namespace SabadEngine
 			const RenderObjectComponent* renderComponent = nullptr;
 			const TransformComponent* transformComponent = nullptr;
 			Graphics::RenderGroup renderGroup;
+			Math::Matrix4 worldMatrix;
 		};
 		using RenderEntries = std::vector<Entry>;
 		RenderEntries mRenderEntries;
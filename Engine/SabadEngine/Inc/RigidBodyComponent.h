@@ -8,21 +8,37 @@ namespace SabadEngine
 	{
 	public:
 		SET_TYPE_ID(ComponentId::RigidBody);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
 
 		void Initialize() override;
 
 		void Terminate() override;
 
 		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
 
 		void SetPosition(const Math::Vector3& position);
 
 		void SetVelocity(const Math::Vector3& velocity);
+		void SetAngularVelocity(const Math::Vector3& velocity);
+
+		// zero for static bodies and bodies that are not in a world
+		Math::Vector3 GetVelocity() const;
+		Math::Vector3 GetAngularVelocity() const;
+		// 0 for static bodies
+		float GetMass() const;
+		bool IsDynamic() const;
 
 	private:
 		friend class PhysicsService;
-		Physics::CollisionShape mCollisionShape;
+		void SetCollisionShape(Physics::CollisionShapeId shapeId);
+
+		Physics::CollisionShapeId mCollisionShapeId = 0;
 		Physics::RigidBody mRigidBody;
 		float mMass = -1.0f;
+		// from LoadState, given to the body when it is initialized
+		Math::Vector3 mLoadedVelocity = Math::Vector3::Zero;
+		Math::Vector3 mLoadedAngularVelocity = Math::Vector3::Zero;
 	};
 }
@@ -11,6 +11,19 @@
 #include "GameWorld.h"
 #include "GameObjectHandle.h"
 #include "GameObjectFactory.h"
+#include "TypeRegistry.h"
+#include "CookedLevel.h"
+#include "LevelLoader.h"
+#include "SnapshotArchive.h"
+#include "WorldSnapshot.h"
+#include "EntityHandle.h"
+#include "ArchetypeStorage.h"
+#include "ComponentMirror.h"
+#include "UpdateAccess.h"
+#include "UpdateScheduler.h"
+#include "UpdateProfiler.h"
+#include "TickLod.h"
+#include "TransformHierarchy.h"
 
 // components
 #include "TypeIds.h"
@@ -23,6 +36,8 @@
 #include "ModelComponent.h"
 #include "AnimatorComponent.h"
 #include "RigidBodyComponent.h"
+#include "TriggerComponent.h"
+#include "SpatialComponent.h"
 #include "SoundEventComponent.h"
 #include "SoundBankComponent.h"
 #include "UIComponent.h"
@@ -34,6 +49,7 @@
 #include "RenderService.h"
 #include "PhysicsService.h"
 #include "UIRenderService.h"
+#include "SpatialService.h"
 #include "UISpriteComponent.h"
 
 #define USE_PHYSICS_SERVICE
@@ -1,5 +1,13 @@
 #pragma once
 
+#include "TickLod.h"
+
+namespace SabadEngine
+{
+    class SnapshotWriter;
+    class SnapshotReader;
+}
+
 namespace SabadEngine::SaveUtil
 {
     bool ReadBool(const char* key, bool& b, const rapidjson::Value& value);
@@ -25,4 +33,18 @@ namespace SabadEngine::SaveUtil
 
     bool ReadStringArray(const char* key, std::vector<std::string>& strArray, const rapidjson::Value& value);
     void WriteStringArray(const char* key, const std::vector<std::string>& strArray, rapidjson::Document& doc, rapidjson::Value& member);
+
+    // acquires the collider described by the object at key from the CollisionShapeCache, the caller owns the release
+    bool ReadCollisionShape(const char* key, Physics::CollisionShapeId& shapeId, const rapidjson::Value& value);
+
+    // "Bands": [{ "Distance", "Interval" }], "FarInterval" and "HiddenInterval", missing fields keep their value
+    bool ReadTickLod(const char* key, TickLod& tickLod, const rapidjson::Value& value);
+
+    // binary state for a component's SaveState and LoadState
+    // a collider is stored as its CollisionShapeCache key, the load acquires it again and the caller owns the release
+    void SaveCollisionShape(SnapshotWriter& writer, Physics::CollisionShapeId shapeId);
+    bool LoadCollisionShape(SnapshotReader& reader, Physics::CollisionShapeId& shapeId);
+
+    void SaveTickLod(SnapshotWriter& writer, const TickLod& tickLod);
+    void LoadTickLod(SnapshotReader& reader, TickLod& tickLod);
 }
\ No newline at end of file
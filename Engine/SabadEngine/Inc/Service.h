@@ -1,10 +1,13 @@
 #pragma once
 
 #include "TypeIds.h"
+#include "UpdateAccess.h"
 
 namespace SabadEngine
 {
 	class GameWorld;
+	class SnapshotWriter;
+	class SnapshotReader;
 
 	class Service
 	{
@@ -18,6 +21,8 @@ namespace SabadEngine
 		Service& operator=(const Service&&) = delete;
 
 		virtual uint32_t GetTypeId() const = 0;
+		// what Update touches, override with SET_UPDATE_ACCESS to let the GameWorld run it beside other work
+		virtual UpdateAccess GetUpdateAccess() const { return {}; }
 
 		virtual void Initialize() {}
 		virtual void Terminate() {}
@@ -25,6 +30,9 @@ namespace SabadEngine
 		virtual void Render() {}
 		virtual void DebugUI() {}
 		virtual void Deserialize(const rapidjson::Value& value) {}
+		// binary state for a WorldSnapshot, LoadState runs before Initialize
+		virtual void SaveState(SnapshotWriter& writer) const {}
+		virtual void LoadState(SnapshotReader& reader) {}
 
 		GameWorld& GetWorld() { return *mWorld; }
 		const GameWorld& GetWorld() const { return *mWorld; }
@@ -0,0 +1,66 @@
+#pragma once
+
+namespace SabadEngine
+{
+	// Binary stream a WorldSnapshot is written with, every value takes whole 32 bit words
+	// so two snapshots of the same world line up word for word and delta encode well
+	// the version is the WorldSnapshot version the data was written with, LoadState branches on it when a layout changes
+	class SnapshotWriter final
+	{
+	public:
+		SnapshotWriter(std::vector<uint32_t>& words, uint32_t version);
+
+		uint32_t GetVersion() const;
+
+		void Write(uint32_t value);
+		void Write(int value);
+		void Write(float value);
+		void Write(bool value);
+		void Write(const Math::Vector2& value);
+		void Write(const Math::Vector3& value);
+		void Write(const Math::Quaternion& value);
+		void Write(const Graphics::Color& value);
+		void Write(std::string_view value);
+
+		// reserves the size word of a block, EndBlock fills in how many words were written since
+		uint32_t BeginBlock();
+		void EndBlock(uint32_t block);
+
+	private:
+		std::vector<uint32_t>& mWords;
+		uint32_t mVersion = 0;
+	};
+
+	// reads back what a SnapshotWriter wrote, reading past the end gives zeros and marks the reader as failed
+	class SnapshotReader final
+	{
+	public:
+		SnapshotReader(const uint32_t* words, std::size_t wordCount, uint32_t version);
+
+		uint32_t GetVersion() const;
+		bool IsValid() const;
+		bool IsAtEnd() const;
+
+		void Read(uint32_t& value);
+		void Read(int& value);
+		void Read(float& value);
+		void Read(bool& value);
+		void Read(Math::Vector2& value);
+		void Read(Math::Vector3& value);
+		void Read(Math::Quaternion& value);
+		void Read(Graphics::Color& value);
+		void Read(std::string& value);
+		uint32_t ReadUInt();
+
+		// a reader over one block, this reader skips the whole block however much of it the caller reads
+		// so a type that reads less or more than an older version wrote can't throw off what follows
+		SnapshotReader ReadBlock();
+
+	private:
+		const uint32_t* mWords = nullptr;
+		std::size_t mWordCount = 0;
+		std::size_t mPosition = 0;
+		uint32_t mVersion = 0;
+		bool mFailed = false;
+	};
+}
\ No newline at end of file
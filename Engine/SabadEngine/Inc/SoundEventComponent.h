@@ -9,11 +9,14 @@ namespace SabadEngine
 	{
 	public:
 		SET_TYPE_ID(ComponentId::SoundEffect);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
 
 		void Initialize() override;
 		void Terminate() override;
 		void DebugUI() override;
 		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
 
 		void Play();
 		void Stop();
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Component.h"
+
+namespace SabadEngine
+{
+	class TransformComponent;
+
+	// puts the owner in the SpatialService as a sphere around its world position
+	class SpatialComponent final : public Component
+	{
+	public:
+		SET_TYPE_ID(ComponentId::Spatial);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
+
+		void Initialize() override;
+		void Terminate() override;
+
+		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
+
+		float GetRadius() const;
+
+	private:
+		friend class SpatialService;
+		const TransformComponent* mTransformComponent = nullptr;
+		float mRadius = 0.5f;
+		uint32_t mEntryIndex = UINT32_MAX; // set by the SpatialService while registered
+	};
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Service.h"
+#include "GameObjectHandle.h"
+
+namespace SabadEngine
+{
+	class SpatialComponent;
+
+	// Finds objects with a SpatialComponent by position, each one is a sphere around its world position
+	// objects sit in hashed cells, the grid has one cell size and the loose octree has a level for every halving of it,
+	// an object goes in the smallest cell it fits in with half a cell of slack so moving a little never changes its level
+	// Update compares each transform with the last one seen and only moves the objects that changed cell
+	// world positions come from the last TransformHierarchy pass, so queries during a frame all see the same snapshot
+	// queries are const and share nothing, any number can run at once on any thread as long as Update isn't running,
+	// updates that query declare UpdateData::Spatial as a read so the scheduler keeps them apart from it
+	class SpatialService final : public Service
+	{
+	public:
+		SET_TYPE_ID(ServiceId::Spatial);
+		SET_UPDATE_ACCESS(UpdateData::Transform, UpdateData::Spatial, UpdateThreading::Serial);
+
+		enum class Partition
+		{
+			Grid,           // one cell size, best when the objects are about the same size
+			LooseOctree     // cells from cellSize down by halves, for worlds mixing big and small objects
+		};
+
+		void Initialize() override;
+		void Terminate() override;
+		void Update(float deltaTime) override;
+		void DebugUI() override;
+		// "Partition": "Grid" or "LooseOctree", "CellSize" and "Levels"
+		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
+
+		// only before anything is registered, cellSize is the grid cell or the octree's biggest cell
+		void SetPartition(Partition partition, float cellSize, uint32_t levelCount = 1);
+		Partition GetPartition() const;
+
+		void Register(SpatialComponent* spatialComponent);
+		void Unregister(SpatialComponent* spatialComponent);
+
+		// results are appended and unordered unless stated, objects count when any part of their sphere is inside
+		void QueryRadius(const Math::Vector3& center, float radius, std::vector<GameObjectHandle>& results) const;
+		void QueryAABB(const Math::AABB& box, std::vector<GameObjectHandle>& results) const;
+		void QueryFrustum(const Math::Frustum& frustum, std::vector<GameObjectHandle>& results) const;
+		// the count objects with their center closest to the point, closest first
+		void QueryNearest(const Math::Vector3& center, uint32_t count, std::vector<GameObjectHandle>& results) const;
+
+		uint32_t GetObjectCount() const;
+		uint32_t GetCellCount() const;
+		// objects that changed cell in the last Update
+		uint32_t GetMovedCount() const;
+
+	private:
+		static constexpr uint32_t MaxLevels = 16;
+
+		struct Entry
+		{
+			SpatialComponent* component = nullptr;
+			GameObjectHandle handle;
+			Math::Vector3 position;
+			float radius = 0.0f;
+			uint64_t cellKey = 0;
+			uint32_t cellSlot = 0; // where the entry is in its cell
+			uint32_t level = 0;
+		};
+
+		using Cell = std::vector<uint32_t>;
+		struct Level
+		{
+			float cellSize = 0.0f;
+			float inverseCellSize = 0.0f;
+			float maxRadius = 0.0f;     // only grows, widens every query on the level so no loose object is missed
+			std::unordered_map<uint64_t, Cell> cells;
+		};
+
+		uint32_t GetLevelIndex(float radius) const;
+		uint64_t GetCellKey(uint32_t level, const Math::Vector3& position) const;
+		void AddToCell(uint32_t entryIndex);
+		void RemoveFromCell(uint32_t entryIndex);
+
+		// calls visitCell(level, x, y, z, cell) for every occupied cell whose loose bounds may overlap the box on any level
+		template<class VisitCell>
+		void ForEachCellInBox(const Math::AABB& box, VisitCell&& visitCell) const;
+		// calls visit(entryIndex) for every entry in those cells
+		template<class Visit>
+		void ForEachInBox(const Math::AABB& box, Visit&& visit) const;
+
+		Partition mPartition = Partition::Grid;
+		std::vector<Level> mLevels;
+		std::vector<Entry> mEntries;
+		uint32_t mCellCount = 0;
+		uint32_t mMovedCount = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace SabadEngine
+{
+	// where tick lod distances are measured from, the CameraService sets it from the main camera every frame
+	struct TickView
+	{
+		Math::Vector3 position;
+		Math::Frustum frustum;
+		bool hasFrustum = false;
+	};
+
+	// picks how often a component's Update runs from how far its owner is from the tick view, intervals are in frames
+	struct TickLod
+	{
+		static constexpr uint32_t MaxBands = 4;
+
+		struct Band
+		{
+			float distance = 0.0f;      // the band covers owners up to this far from the view
+			uint32_t interval = 1;
+		};
+
+		std::array<Band, MaxBands> bands;
+		uint32_t bandCount = 0;         // in increasing distance, owners past the last band use farInterval
+		uint32_t farInterval = 8;
+		uint32_t hiddenInterval = 0;    // the least interval for owners outside the view frustum, 0 ignores visibility
+
+		uint32_t GetInterval(const Math::Vector3& position, const TickView& view) const
+		{
+			const float distanceSqr = Math::MagnitudeSqr(position - view.position);
+			uint32_t interval = farInterval;
+			for (uint32_t i = 0; i < bandCount; ++i)
+			{
+				if (distanceSqr <= bands[i].distance * bands[i].distance)
+				{
+					interval = bands[i].interval;
+					break;
+				}
+			}
+			if (hiddenInterval > interval && view.hasFrustum && !view.frustum.IntersectsSphere(position, 0.0f))
+			{
+				interval = hiddenInterval;
+			}
+			return std::max(interval, 1u);
+		}
+	};
+}
\ No newline at end of file
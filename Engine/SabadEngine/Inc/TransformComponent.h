@@ -4,14 +4,29 @@
 
 namespace SabadEngine
 {
+    // position, rotation and scale are local to the nearest parent with a transform
     class TransformComponent final : public Component, public Graphics::Transform
     {
     public:
         SET_TYPE_ID(ComponentId::Transform);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
 
+        void Terminate() override;
         void DebugUI() override;
 
         void Deserialize(const rapidjson::Value& value) override;
         //void Serialize();
+        void SaveState(SnapshotWriter& writer) const override;
+        void LoadState(SnapshotReader& reader) override;
+
+        // cached by the TransformHierarchy right before Render, or after LateUpdate in a world that is not rendered
+        // local changes show up after the next pass
+        // falls back to the local matrix until the object has been through one
+        Math::Matrix4 GetWorldMatrix() const;
+        Math::Vector3 GetWorldPosition() const;
+
+    private:
+        friend class TransformHierarchy;
+        const Math::Matrix4* mWorldMatrix = nullptr;
     };
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace SabadEngine
+{
+	class TransformComponent;
+
+	// World matrices for every TransformComponent in the world, stored parent before child
+	// nodes are grouped by depth so one forward pass resolves the whole tree and each depth can be split over the JobSystem
+	// the local transforms are compared against the copy from the last pass, only nodes that changed or
+	// sit under a node that changed are recomputed
+	class TransformHierarchy final
+	{
+	public:
+		// transforms must be added in a stable order, the parent is the nearest ancestor with a transform or null
+		void Clear();
+		void Add(TransformComponent* transform, const TransformComponent* parent);
+		void Build();
+
+		void Update();
+
+		uint32_t GetNodeCount() const;
+		uint32_t GetLevelCount() const;
+		// nodes recomputed by the last Update
+		uint32_t GetRecomputedCount() const;
+
+	private:
+		void DetectChanges(uint32_t begin, uint32_t end);
+		void Recompute(uint32_t begin, uint32_t end);
+
+		struct PendingNode
+		{
+			TransformComponent* transform = nullptr;
+			const TransformComponent* parent = nullptr;
+		};
+		std::vector<PendingNode> mPendingNodes;
+
+		// all in parent before child order
+		std::vector<TransformComponent*> mTransforms;
+		std::vector<int32_t> mParents;
+		std::vector<Graphics::Transform> mLocals;
+		std::vector<Math::Matrix4> mWorldMatrices;
+		std::vector<uint8_t> mDirty;
+
+		// first node of each depth, with one extra entry for the end
+		std::vector<uint32_t> mLevelStarts;
+		uint32_t mRecomputedCount = 0;
+	};
+}
\ No newline at end of file
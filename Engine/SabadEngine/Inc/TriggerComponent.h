@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Component.h"
+
+namespace SabadEngine
+{
+	class TriggerComponent : public Component
+	{
+	public:
+		SET_TYPE_ID(ComponentId::Trigger);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
+
+		void Initialize() override;
+
+		void Terminate() override;
+
+		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
+
+	private:
+		friend class PhysicsService;
+		void SetCollisionShape(Physics::CollisionShapeId shapeId);
+
+		Physics::CollisionShapeId mCollisionShapeId = 0;
+		Physics::TriggerVolume mTriggerVolume;
+	};
+}
\ No newline at end of file
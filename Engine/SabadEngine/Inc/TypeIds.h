@@ -17,6 +17,8 @@ namespace SabadEngine
 		UIText,             // adds a UI text element to an object
 		UISprite,           // adds a UI sprite element to an object
 		UIButton,           // adds a UI button element to an object
+		Trigger,            // adds a physics trigger volume to an object
+		Spatial,            // adds the object to the SpatialService for range queries
 		Count               // last value, can be used to chain custom components
 	};
 
@@ -27,10 +29,17 @@ namespace SabadEngine
 		Render,				// renders renderobjects in the world
 		Physics, 		    // registers and mnitors physics objects in the world
 		UIRender,           // renders UI components in the world
+		Spatial,            // finds objects by position with radius, box, frustum and nearest queries
 		Count               // last value, can be used to chain custom services
 	};
+
+	enum class EngineEventId
+	{
+		PhysicsContacts = 1000, // starts high so game event ids starting at 1 never collide
+		LevelLoadProgress,
+	};
 }
 
 #define SET_TYPE_ID(id)\
-	static uint32_t StaticGetTypeId() { return static_cast<uint32_t>(id); }\
+	static constexpr uint32_t StaticGetTypeId() { return static_cast<uint32_t>(id); }\
 	uint32_t GetTypeId() const override { return StaticGetTypeId(); }
\ No newline at end of file
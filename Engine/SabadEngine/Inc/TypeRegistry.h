@@ -0,0 +1,103 @@
+#pragma once
+
+#include "GameWorld.h"
+
+namespace SabadEngine
+{
+	// FNV-1a of the type name used in level and template files, the registry is keyed by it
+	constexpr uint32_t HashTypeName(std::string_view name)
+	{
+		uint32_t hash = 2166136261u;
+		for (const char c : name)
+		{
+			hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+		}
+		return hash;
+	}
+
+	struct ComponentRegistration
+	{
+		std::string name;
+		uint32_t typeId = 0;
+		Component* (*make)(GameObject&) = nullptr;
+		Component* (*get)(GameObject&) = nullptr;
+		void (*deserialize)(Component&, const rapidjson::Value&) = nullptr;
+	};
+
+	struct ServiceRegistration
+	{
+		std::string name;
+		uint32_t typeId = 0;
+		Service* (*make)(GameWorld&) = nullptr;
+		Service* (*get)(GameWorld&) = nullptr;
+	};
+
+	// Every component and service a level or template can name, any number of modules can add their own types
+	// engine types are registered the first time the registry is used, game types register with the macros below
+	// registering happens before main or before the first level load, lookups are read only and safe from any thread
+	namespace TypeRegistry
+	{
+		// asserts if a different type already took the name or its hash, the same type registering again is ignored
+		bool RegisterComponent(const ComponentRegistration& registration);
+		bool RegisterService(const ServiceRegistration& registration);
+
+		// null if nothing registered the name
+		const ComponentRegistration* FindComponent(uint32_t nameHash);
+		const ComponentRegistration* FindComponent(std::string_view name);
+		const ServiceRegistration* FindService(uint32_t nameHash);
+		const ServiceRegistration* FindService(std::string_view name);
+		// by the id the type was registered with, for data that stores types by name hash
+		const ComponentRegistration* FindComponentByTypeId(uint32_t typeId);
+		const ServiceRegistration* FindServiceByTypeId(uint32_t typeId);
+
+		uint32_t GetComponentCount();
+		uint32_t GetServiceCount();
+
+		template<class ComponentType>
+		ComponentRegistration MakeComponentRegistration(const char* name)
+		{
+			static_assert(std::is_base_of_v<Component, ComponentType>, "TypeRegistry: ComponentType must be of type Component.");
+			ComponentRegistration registration;
+			registration.name = name;
+			registration.typeId = ComponentType::StaticGetTypeId();
+			registration.make = [](GameObject& gameObject) -> Component* { return gameObject.AddComponent<ComponentType>(); };
+			registration.get = [](GameObject& gameObject) -> Component* { return gameObject.GetComponent<ComponentType>(); };
+			registration.deserialize = [](Component& component, const rapidjson::Value& value)
+			{
+				static_cast<ComponentType&>(component).Deserialize(value);
+			};
+			return registration;
+		}
+
+		template<class ServiceType>
+		ServiceRegistration MakeServiceRegistration(const char* name)
+		{
+			static_assert(std::is_base_of_v<Service, ServiceType>, "TypeRegistry: ServiceType must be of type Service.");
+			ServiceRegistration registration;
+			registration.name = name;
+			registration.typeId = ServiceType::StaticGetTypeId();
+			registration.make = [](GameWorld& gameWorld) -> Service* { return gameWorld.AddService<ServiceType>(); };
+			registration.get = [](GameWorld& gameWorld) -> Service* { return gameWorld.GetService<ServiceType>(); };
+			return registration;
+		}
+
+		template<class ComponentType>
+		bool RegisterComponent(const char* name)
+		{
+			return RegisterComponent(MakeComponentRegistration<ComponentType>(name));
+		}
+
+		template<class ServiceType>
+		bool RegisterService(const char* name)
+		{
+			return RegisterService(MakeServiceRegistration<ServiceType>(name));
+		}
+	}
+}
+
+// at file scope in the type's cpp, the name in level files is the class name
+// only for types linked into the executable, a library object file nothing refers to is dropped with its registration
+#define REGISTER_COMPONENT(ComponentType)\
+	static const bool s##ComponentType##Registered = SabadEngine::TypeRegistry::RegisterComponent<ComponentType>(#ComponentType)
+#define REGISTER_SERVICE(ServiceType)\
+	static const bool s##ServiceType##Registered = SabadEngine::TypeRegistry::RegisterService<ServiceType>(#ServiceType)
\ No newline at end of file
@@ -15,6 +15,8 @@ namespace SabadEngine
 
     using ButtonCallback = std::function<void()>;
 
+    class UIRenderService;
+
     class UIButtonComponent : public UIComponent
     {
     public:
@@ -25,6 +27,8 @@ namespace SabadEngine
         void Update(float deltaTime) override;
         void Render() override;
         void Deserialize(const rapidjson::Value& value) override;
+        void SaveState(SnapshotWriter& writer) const override;
+        void LoadState(SnapshotReader& reader) override;
 
         Math::Vector2 GetPosition(bool includeOrigin = true);
         void SetCallback(ButtonCallback cb);
@@ -40,6 +44,7 @@ namespace SabadEngine
         using ButtonStates = std::array<ButtonStateEntry, static_cast<uint32_t>(ButtonState::Count)>;
         ButtonStates mButtonStates;
 
+        UIRenderService* mUIRenderService = nullptr;
         ButtonCallback mCallback = nullptr;
         DirectX::XMFLOAT2 mPosition = { 0.0f, 0.0f };
         ButtonState mCurrentState = ButtonState::Default;
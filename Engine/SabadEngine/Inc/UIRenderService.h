@@ -4,12 +4,14 @@
 
 namespace SabadEngine
 {
+	class GameObject;
 	class UIComponent;
 
 	class UIRenderService final : public Service
 	{
 	public:
 		SET_TYPE_ID(ServiceId::UIRender);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::Serial);
 
 		void Terminate() override;
 		void Render() override;
@@ -17,8 +19,13 @@ namespace SabadEngine
 		void Register(UIComponent* uiComponent);
 		void Unregister(UIComponent* uiComponent);
 
+		// summed positions of the UI sprites and buttons above gameObject, cached until the next Render
+		Math::Vector2 GetParentOffset(GameObject& gameObject);
+
 	private:
 		using UIComponents = std::vector<UIComponent*>;
 		UIComponents mUIComponents;
+
+		std::unordered_map<const GameObject*, Math::Vector2> mParentOffsets;
 	};
 }
\ No newline at end of file
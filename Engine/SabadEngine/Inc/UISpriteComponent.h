@@ -4,15 +4,20 @@
 
 namespace SabadEngine
 {
+	class UIRenderService;
+
 	class UISpriteComponent : public UIComponent
 	{
 	public:
 		SET_TYPE_ID(ComponentId::UISprite);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
 
 		void Initialize() override;
 		void Terminate() override;
 		void Render() override;
 		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
 
 		void SetTexture(const std::filesystem::path& texturePath);
 		void SetPosition(const Math::Vector2& pos);
@@ -21,6 +26,7 @@ namespace SabadEngine
 		Math::Vector2 GetPosition(bool includeOrigin = true);
 
 	private:
+		UIRenderService* mUIRenderService = nullptr;
 		bool mActive = true;
 		std::filesystem::path mTexturePath;
 		Math::Vector2 mPosition;
@@ -8,12 +8,15 @@ namespace SabadEngine
 	{
 	public:
 		SET_TYPE_ID(ComponentId::UIText);
+		SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
 
 		void Initialize() override;
 		void Terminate() override;
 		void Render() override;
 
 		void Deserialize(const rapidjson::Value& value) override;
+		void SaveState(SnapshotWriter& writer) const override;
+		void LoadState(SnapshotReader& reader) override;
 
 		void SetText(const std::string& text);
 
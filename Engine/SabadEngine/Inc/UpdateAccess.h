@@ -0,0 +1,41 @@
+#pragma once
+
+namespace SabadEngine
+{
+	// data an Update or LateUpdate can touch, combined as bit flags
+	// Transform and Pose mean the owner's own data, the rest are shared systems
+	namespace UpdateData
+	{
+		constexpr uint32_t None = 0;
+		constexpr uint32_t Transform = 1 << 0;      // the owner's TransformComponent
+		constexpr uint32_t Pose = 1 << 1;           // the owner's animator pose
+		constexpr uint32_t Camera = 1 << 2;         // cameras and the CameraService
+		constexpr uint32_t Physics = 1 << 3;        // the PhysicsWorld and its bodies
+		constexpr uint32_t Render = 1 << 4;         // render objects and the RenderService
+		constexpr uint32_t UI = 1 << 5;             // ui components and the UIRenderService
+		constexpr uint32_t Audio = 1 << 6;
+		constexpr uint32_t Input = 1 << 7;          // only ever read during an update
+		constexpr uint32_t Events = 1 << 8;         // EventManager broadcasts, listeners run inline
+		constexpr uint32_t Spatial = 1 << 9;        // the SpatialService index, queries are reads
+		constexpr uint32_t All = 0xFFFFFFFF;
+	}
+
+	enum class UpdateThreading
+	{
+		MainThread,     // runs on the main thread with nothing beside it, for updates that can touch anything
+		Serial,         // every object in order on one thread, beside other work that doesn't conflict
+		PerObject       // objects are split across threads, each update only touches its own object
+	};
+
+	// what a component type or service declares so the GameWorld can schedule it
+	// the default is the safe one, the update runs alone on the main thread
+	struct UpdateAccess
+	{
+		uint32_t reads = UpdateData::All;
+		uint32_t writes = UpdateData::All;
+		UpdateThreading threading = UpdateThreading::MainThread;
+	};
+}
+
+#define SET_UPDATE_ACCESS(reads, writes, threading)\
+	SabadEngine::UpdateAccess GetUpdateAccess() const override { return { reads, writes, threading }; }
\ No newline at end of file
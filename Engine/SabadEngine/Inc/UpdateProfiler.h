@@ -0,0 +1,88 @@
+#pragma once
+
+namespace SabadEngine
+{
+	class Service;
+
+	enum class ProfilePhase
+	{
+		Update,         // Component::Update and Service::Update
+		LateUpdate,     // Component::LateUpdate
+		Render,         // Service::Render
+		DebugUI,        // Component::DebugUI and Service::DebugUI
+		Count
+	};
+
+	// Optional timing a GameWorld keeps per ComponentId and per service, to find which type makes a level slow
+	// component updates are timed a scheduler batch at a time, so it costs one clock read per batch instead of per component
+	// while it is off every hook is one branch on IsEnabled
+	class UpdateProfiler final
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+		static constexpr uint32_t InvalidEntry = std::numeric_limits<uint32_t>::max();
+		// frames the p95 is taken over
+		static constexpr uint32_t FrameHistory = 120;
+
+		struct Row
+		{
+			std::string name;
+			bool isService = false;
+			ProfilePhase phase = ProfilePhase::Update;
+			double averageMs = 0.0;     // per frame it ran in
+			double p95Ms = 0.0;         // per frame, over the last FrameHistory frames it ran in
+			double totalMs = 0.0;
+			double callsPerFrame = 0.0;
+			uint64_t callCount = 0;
+			uint32_t frameCount = 0;
+		};
+
+		// turning it on starts from an empty frame, the totals are kept until Reset
+		void SetEnabled(bool enabled);
+		bool IsEnabled() const { return mEnabled; }
+
+		// the same type always gets the same entry, only from the main thread while nothing records
+		uint32_t GetComponentEntry(uint32_t typeId);
+		uint32_t GetServiceEntry(const Service& service);
+
+		// adds the time since start to this frame, safe from the JobSystem workers
+		// returns the time it measured to, so back to back work only reads the clock once each
+		Clock::time_point Record(uint32_t entry, ProfilePhase phase, const Clock::time_point& start, uint32_t callCount);
+		// moves this frame's times into the totals and the p95 history
+		void EndFrame();
+		void Reset();
+
+		uint32_t GetFrameCount() const;
+		// every type and phase that ran since the last Reset, most expensive per frame first
+		std::vector<Row> GetRows() const;
+		bool SaveToCsv(const std::filesystem::path& filePath) const;
+		void DebugUI();
+
+	private:
+		struct PhaseTimes
+		{
+			std::atomic<uint64_t> frameNs = 0;
+			std::atomic<uint32_t> frameCalls = 0;
+			std::array<float, FrameHistory> history = {};
+			uint64_t totalNs = 0;
+			uint64_t totalCalls = 0;
+			uint32_t frameCount = 0;
+		};
+
+		struct Entry
+		{
+			std::string name;
+			bool isService = false;
+			std::array<PhaseTimes, static_cast<size_t>(ProfilePhase::Count)> phases;
+		};
+
+		uint32_t AddEntry(std::string name, bool isService);
+
+		// entries never move once added, the workers hold on to them while they record
+		std::vector<std::unique_ptr<Entry>> mEntries;
+		std::unordered_map<uint32_t, uint32_t> mComponentEntries;
+		std::unordered_map<uint32_t, uint32_t> mServiceEntries;
+		uint32_t mFrameCount = 0;
+		bool mEnabled = false;
+	};
+}
\ No newline at end of file
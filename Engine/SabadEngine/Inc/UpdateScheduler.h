@@ -0,0 +1,98 @@
+#pragma once
+
+#include "UpdateAccess.h"
+#include "TickLod.h"
+#include "UpdateProfiler.h"
+
+namespace SabadEngine
+{
+	class Component;
+	class Service;
+
+	enum class UpdatePhase
+	{
+		Update,         // Component::Update
+		Services,       // Service::Update, physics steps here
+		LateUpdate      // Component::LateUpdate, after physics
+	};
+
+	// Runs a frame's updates in dependency order, with independent work spread over the JobSystem
+	// components are grouped by type, each group is a node with the UpdateAccess of its type
+	// except MainThread components, which share one node per phase at the first MainThread type's slot
+	// and keep the order they were added in, so objects still see their main thread updates one object at a time
+	// each component phase has its own nodes, holding only the components that override that phase's function
+	// a node only starts once every earlier node it conflicts with has finished, so the result is
+	// the same for any thread count as long as the declared access is honest
+	class UpdateScheduler final
+	{
+	public:
+		// components and services must be added in a stable order, it decides the order of conflicting nodes
+		void Clear();
+		void AddComponent(Component* component, uint32_t componentSlot);
+		void AddService(Service* service);
+		// with a profiler each batch looks up its entry once here, and Run times it whenever the profiler is enabled
+		void Build(UpdateProfiler* profiler = nullptr);
+
+		void Run(UpdatePhase phase, float deltaTime);
+
+		// read by components with a TickLod when they tick, only set between update phases
+		void SetTickView(const TickView& tickView);
+		const TickView& GetTickView() const;
+
+		uint32_t GetNodeCount(UpdatePhase phase) const;
+		uint32_t GetLevelCount(UpdatePhase phase) const;
+		// components or services that run in the phase
+		uint32_t GetWorkCount(UpdatePhase phase) const;
+
+	private:
+		struct Node
+		{
+			UpdateAccess access;
+			std::vector<Component*> components;
+			Service* service = nullptr;
+		};
+
+		// a range of one node's components that runs as a single job, all of one type
+		struct Batch
+		{
+			uint32_t node = 0;
+			uint32_t begin = 0;
+			uint32_t end = 0;
+			uint32_t profileEntry = UpdateProfiler::InvalidEntry;
+		};
+
+		// nodes that don't conflict with each other and can run at the same time
+		struct Level
+		{
+			std::vector<Batch> batches;
+			bool mainThread = false;
+		};
+
+		struct ComponentPhase
+		{
+			std::vector<Node> nodes;
+			std::vector<uint32_t> nodeBySlot;
+			std::vector<Level> levels;
+			uint32_t mainThreadNode = std::numeric_limits<uint32_t>::max();
+			uint32_t componentCount = 0;
+		};
+
+		static bool Conflicts(const UpdateAccess& a, const UpdateAccess& b);
+		static void AddToPhase(ComponentPhase& componentPhase, Component* component, uint32_t componentSlot);
+		static void BuildPhase(ComponentPhase& componentPhase);
+		static void BuildLevels(const std::vector<Node>& nodes, std::vector<Level>& levels);
+		void RunBatch(const std::vector<Node>& nodes, const Level& level, const Batch& batch, UpdatePhase phase, float deltaTime, bool profiling);
+		void UpdateBatch(const Node& node, const Batch& batch, UpdatePhase phase, float deltaTime);
+		void TickComponent(Component* component, float deltaTime) const;
+
+		ComponentPhase mUpdatePhase;
+		ComponentPhase mLateUpdatePhase;
+
+		std::vector<Node> mServiceNodes;
+		std::vector<Level> mServiceLevels;
+
+		TickView mTickView;
+		UpdateProfiler* mProfiler = nullptr;
+		uint32_t mFrameIndex = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+namespace SabadEngine
+{
+	// Binary copy of a GameWorld taken with GameWorld::CaptureSnapshot, for saves, autosaves and replay checkpoints
+	// holds every object's handle, parent, children and component state, the services, and the slot generations
+	// so handles taken in the captured world stay valid in the restored one
+	// components and services write their state with SaveState, plain data entities are not part of snapshots
+	// the state is HeaderWordCount words, then records of [key, size, size words], the world's slots, each service and each object
+	class WorldSnapshot final
+	{
+	public:
+		static constexpr uint32_t Magic = 0x534E5753; // "SWNS"
+		static constexpr uint32_t Version = 2;
+		// version 1 had no records, its objects can't be lined up with a baseline
+		static constexpr uint32_t MinVersion = 2;
+		// the object count and the version
+		static constexpr uint32_t HeaderWordCount = 2;
+		static constexpr uint32_t NoBaseline = std::numeric_limits<uint32_t>::max();
+
+		uint32_t GetFrame() const;
+		uint32_t GetObjectCount() const;
+		// the version the state was written with
+		uint32_t GetVersion() const;
+
+		// full state in bytes, this is what restore reads
+		std::size_t GetSizeInBytes() const;
+
+		// state xor'd against a baseline snapshot and zero run length encoded, the same scheme as PhysicsSnapshot
+		// each record is xor'd against the baseline record with the same key rather than the words at the same position
+		// so objects that did not change encode to almost nothing even after spawns and destroys, this is what gets stored
+		void Encode(const WorldSnapshot* baseline);
+		const std::vector<uint32_t>& GetDelta() const;
+		std::size_t GetDeltaSizeInBytes() const;
+
+		// rebuilds the full state from a delta, baseline must be the snapshot the delta was encoded against
+		// returns false if the delta is truncated
+		bool Decode(const WorldSnapshot* baseline, const uint32_t* delta, std::size_t deltaCount, uint32_t frame);
+
+		// writes the delta against the baseline, null for a standalone file
+		bool SaveToFile(const std::filesystem::path& filePath, const WorldSnapshot* baseline);
+		// the baseline must be the snapshot the file was saved against, returns false if it isn't or the file is not a snapshot
+		// older versions back to MinVersion load, the components read them through the SnapshotReader version
+		bool LoadFromFile(const std::filesystem::path& filePath, const WorldSnapshot* baseline);
+
+	private:
+		friend class GameWorld;
+
+		struct FileHeader
+		{
+			uint32_t magic = Magic;
+			uint32_t version = Version;
+			uint32_t frame = 0;
+			uint32_t baselineFrame = NoBaseline;
+			uint32_t deltaCount = 0;
+		};
+
+		std::vector<uint32_t> mState;
+		std::vector<uint32_t> mDelta;
+		uint32_t mFrame = 0;
+	};
+}
\ No newline at end of file
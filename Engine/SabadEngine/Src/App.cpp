@@ -22,6 +22,7 @@ void App::Run(const AppConfig& config)
 		config.winHeight
 	);
 	auto handle = myWindow.GetWindowHandle();
+	JobSystem::StaticInitialize();
 	GraphicsSystem::StaticInitialize(handle, false);
 	InputSystem::StaticInitialize(handle);
 	DebugUI::StaticInitialize(handle, false, true);
@@ -33,6 +34,7 @@ void App::Run(const AppConfig& config)
 
 	PhysicsWorld::Settings physicsSettings;
 	PhysicsWorld::StaticInitialize(physicsSettings);
+	CollisionShapeCache::StaticInitialize();
 
 	EventManager::StaticInitialize();
 
@@ -98,6 +100,7 @@ void App::Run(const AppConfig& config)
 	UIFont::StaticTerminate();
 	SoundEffectManager::StaticTerminate();
 	AudioSystem::StaticTerminate();
+	CollisionShapeCache::StaticTerminate();
 	PhysicsWorld::StaticTerminate();
 	EventManager::StaticTerminate();
 	ModelManager::StaticTerminate();
@@ -106,6 +109,7 @@ void App::Run(const AppConfig& config)
 	SimpleDraw::StaticTerminate();
 	GraphicsSystem::StaticTerminate();
 	InputSystem::StaticTerminate();
+	JobSystem::StaticTerminate();
 
 	myWindow.Terminate();
 }
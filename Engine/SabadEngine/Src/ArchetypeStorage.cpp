@@ -0,0 +1,243 @@
+#include "Precompiled.h"
+#include "ArchetypeStorage.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+	std::mutex sDataTypeMutex;
+	std::vector<uint32_t> sDataSizes;
+
+	uint32_t AlignUp(uint32_t value, uint32_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+EntityDataId ArchetypeStorage::RegisterDataType(uint32_t size)
+{
+	std::lock_guard<std::mutex> lock(sDataTypeMutex);
+	ASSERT(sDataSizes.size() < MaxDataTypes, "ArchetypeStorage: too many data types, increase MaxDataTypes");
+	sDataSizes.push_back(size);
+	return static_cast<EntityDataId>(sDataSizes.size() - 1);
+}
+
+uint32_t ArchetypeStorage::GetDataSize(EntityDataId id)
+{
+	std::lock_guard<std::mutex> lock(sDataTypeMutex);
+	return sDataSizes[id];
+}
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+	ASSERT(mEntities.empty(), "ArchetypeStorage: terminate must be called!");
+}
+
+void ArchetypeStorage::Terminate()
+{
+	mArchetypes.clear();
+	mArchetypeLookup.clear();
+	mEntities.clear();
+	mFreeEntities.clear();
+	mEntityCount = 0;
+}
+
+void ArchetypeStorage::DebugUI()
+{
+	if (ImGui::CollapsingHeader("Entities"))
+	{
+		ImGui::Text("Entities: %u", mEntityCount);
+		for (const Archetype& archetype : mArchetypes)
+		{
+			const uint32_t lastCount = archetype.chunks.empty() ? 0 : archetype.chunks.back()->count;
+			const uint32_t count = archetype.chunks.empty() ? 0 : ((static_cast<uint32_t>(archetype.chunks.size()) - 1) * archetype.chunkCapacity) + lastCount;
+			ImGui::Text("Archetype %016llx: %u entities, %zu chunks of %u", static_cast<unsigned long long>(archetype.signature),
+				count, archetype.chunks.size(), archetype.chunkCapacity);
+		}
+	}
+}
+
+void ArchetypeStorage::Destroy(const EntityHandle& handle)
+{
+	if (!IsValid(handle))
+	{
+		return;
+	}
+
+	EntityRecord& record = mEntities[handle.mIndex];
+	Archetype& archetype = mArchetypes[record.archetype];
+	Chunk& lastChunk = *archetype.chunks.back();
+	const uint32_t lastRow = lastChunk.count - 1;
+	Chunk& chunk = *archetype.chunks[record.chunk];
+
+	// the last entity of the archetype fills the hole so every chunk but the last stays full
+	if (&chunk != &lastChunk || record.row != lastRow)
+	{
+		for (std::size_t i = 0; i < archetype.dataIds.size(); ++i)
+		{
+			const uint32_t size = archetype.dataSizes[i];
+			const uint32_t offset = archetype.columnOffsets[archetype.dataIds[i]];
+			memcpy(chunk.bytes + offset + (record.row * size), lastChunk.bytes + offset + (lastRow * size), size);
+		}
+		uint32_t* chunkEntities = reinterpret_cast<uint32_t*>(chunk.bytes + archetype.entityColumnOffset);
+		const uint32_t* lastChunkEntities = reinterpret_cast<const uint32_t*>(lastChunk.bytes + archetype.entityColumnOffset);
+		const uint32_t movedIndex = lastChunkEntities[lastRow];
+		chunkEntities[record.row] = movedIndex;
+		mEntities[movedIndex].chunk = record.chunk;
+		mEntities[movedIndex].row = record.row;
+	}
+
+	--lastChunk.count;
+	if (lastChunk.count == 0)
+	{
+		archetype.chunks.pop_back();
+	}
+
+	record.alive = false;
+	record.owner = GameObjectHandle();
+	++record.generation;
+	mFreeEntities.push_back(static_cast<uint32_t>(handle.mIndex));
+	--mEntityCount;
+}
+
+void ArchetypeStorage::DestroyAll()
+{
+	for (Archetype& archetype : mArchetypes)
+	{
+		archetype.chunks.clear();
+	}
+	mFreeEntities.clear();
+	for (uint32_t i = static_cast<uint32_t>(mEntities.size()); i > 0; --i)
+	{
+		EntityRecord& record = mEntities[i - 1];
+		if (record.alive)
+		{
+			record.alive = false;
+			record.owner = GameObjectHandle();
+			++record.generation;
+		}
+		mFreeEntities.push_back(i - 1);
+	}
+	mEntityCount = 0;
+}
+
+bool ArchetypeStorage::IsValid(const EntityHandle& handle) const
+{
+	if (handle.mIndex < 0 || handle.mIndex >= static_cast<int>(mEntities.size()))
+	{
+		return false;
+	}
+	const EntityRecord& record = mEntities[handle.mIndex];
+	return record.alive && record.generation == handle.mGeneration;
+}
+
+GameObjectHandle ArchetypeStorage::GetOwner(const EntityHandle& handle) const
+{
+	return IsValid(handle) ? mEntities[handle.mIndex].owner : GameObjectHandle();
+}
+
+uint32_t ArchetypeStorage::GetEntityCount() const
+{
+	return mEntityCount;
+}
+
+uint32_t ArchetypeStorage::GetArchetypeCount() const
+{
+	return static_cast<uint32_t>(mArchetypes.size());
+}
+
+EntityHandle ArchetypeStorage::Allocate(Signature signature, const GameObjectHandle& owner)
+{
+	const uint32_t archetypeIndex = GetOrCreateArchetype(signature);
+	Archetype& archetype = mArchetypes[archetypeIndex];
+	if (archetype.chunks.empty() || archetype.chunks.back()->count == archetype.chunkCapacity)
+	{
+		archetype.chunks.push_back(std::make_unique<Chunk>());
+	}
+	Chunk& chunk = *archetype.chunks.back();
+
+	uint32_t index = 0;
+	if (mFreeEntities.empty())
+	{
+		index = static_cast<uint32_t>(mEntities.size());
+		mEntities.emplace_back();
+	}
+	else
+	{
+		index = mFreeEntities.back();
+		mFreeEntities.pop_back();
+	}
+
+	EntityRecord& record = mEntities[index];
+	record.archetype = archetypeIndex;
+	record.chunk = static_cast<uint32_t>(archetype.chunks.size() - 1);
+	record.row = chunk.count++;
+	record.alive = true;
+	record.owner = owner;
+	reinterpret_cast<uint32_t*>(chunk.bytes + archetype.entityColumnOffset)[record.row] = index;
+	++mEntityCount;
+
+	EntityHandle handle;
+	handle.mIndex = static_cast<int>(index);
+	handle.mGeneration = record.generation;
+	return handle;
+}
+
+uint32_t ArchetypeStorage::GetOrCreateArchetype(Signature signature)
+{
+	auto iter = mArchetypeLookup.find(signature);
+	if (iter != mArchetypeLookup.end())
+	{
+		return iter->second;
+	}
+
+	Archetype& archetype = mArchetypes.emplace_back();
+	archetype.signature = signature;
+	archetype.columnOffsets.fill(InvalidOffset);
+
+	uint32_t rowSize = sizeof(uint32_t);
+	for (EntityDataId dataId = 0; dataId < MaxDataTypes; ++dataId)
+	{
+		if (signature & (Signature(1) << dataId))
+		{
+			archetype.dataIds.push_back(dataId);
+			archetype.dataSizes.push_back(GetDataSize(dataId));
+			rowSize += archetype.dataSizes.back();
+		}
+	}
+
+	// every column starts aligned, so leave room for the padding between them
+	const uint32_t padding = ColumnAlignment * static_cast<uint32_t>(archetype.dataIds.size() + 1);
+	archetype.chunkCapacity = static_cast<uint32_t>(ChunkSize - padding) / rowSize;
+	ASSERT(archetype.chunkCapacity > 0, "ArchetypeStorage: entity is too large for a chunk");
+
+	uint32_t offset = 0;
+	archetype.entityColumnOffset = offset;
+	offset = AlignUp(offset + (archetype.chunkCapacity * sizeof(uint32_t)), ColumnAlignment);
+	for (std::size_t i = 0; i < archetype.dataIds.size(); ++i)
+	{
+		archetype.columnOffsets[archetype.dataIds[i]] = offset;
+		offset = AlignUp(offset + (archetype.chunkCapacity * archetype.dataSizes[i]), ColumnAlignment);
+	}
+	ASSERT(offset <= ChunkSize, "ArchetypeStorage: chunk layout overflow");
+
+	const uint32_t archetypeIndex = static_cast<uint32_t>(mArchetypes.size() - 1);
+	mArchetypeLookup.emplace(signature, archetypeIndex);
+	return archetypeIndex;
+}
+
+void* ArchetypeStorage::GetData(const EntityHandle& handle, EntityDataId dataId, uint32_t size)
+{
+	if (!IsValid(handle))
+	{
+		return nullptr;
+	}
+	const EntityRecord& record = mEntities[handle.mIndex];
+	Archetype& archetype = mArchetypes[record.archetype];
+	const uint32_t offset = archetype.columnOffsets[dataId];
+	if (offset == InvalidOffset)
+	{
+		return nullptr;
+	}
+	return archetype.chunks[record.chunk]->bytes + offset + (record.row * size);
+}
\ No newline at end of file
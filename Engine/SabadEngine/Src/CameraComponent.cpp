@@ -1,6 +1,7 @@
 #include "Precompiled.h"
 #include "CameraComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 #include "CameraService.h"
 #include "GameWorld.h"
 #include "GameObject.h"
@@ -9,7 +10,7 @@ using namespace SabadEngine;
 
 void CameraComponent::Initialize()
 {
-	CameraService* cameraService = GetOwner().GetWorld().GetService<CameraService>();
+	CameraService* cameraService = GetOwner().GetWorld().GetCameraService();
 	if (cameraService != nullptr)
 	{
 		cameraService->Register(this);
@@ -18,7 +19,7 @@ void CameraComponent::Initialize()
 
 void CameraComponent::Terminate()
 {
-	CameraService* cameraService = GetOwner().GetWorld().GetService<CameraService>();
+	CameraService* cameraService = GetOwner().GetWorld().GetCameraService();
 	if (cameraService != nullptr)
 	{
 		cameraService->Unregister(this);
@@ -56,6 +57,21 @@ void CameraComponent::Deserialize(const rapidjson::Value& value)
 	}
 }
 
+void CameraComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mCamera.GetPosition());
+	writer.Write(mCamera.GetDirection());
+}
+
+void CameraComponent::LoadState(SnapshotReader& reader)
+{
+	Math::Vector3 readValue = Math::Vector3::Zero;
+	reader.Read(readValue);
+	mCamera.SetPosition(readValue);
+	reader.Read(readValue);
+	mCamera.SetDirection(readValue);
+}
+
 Graphics::Camera& CameraComponent::GetCamera()
 {
 	return mCamera;
@@ -1,9 +1,23 @@
 #include "Precompiled.h"
 #include "CameraService.h"
 #include "CameraComponent.h"
+#include "GameWorld.h"
 
 using namespace SabadEngine;
 
+void CameraService::Update(float deltaTime)
+{
+    if (mMainCamera != nullptr)
+    {
+        const Graphics::Camera& camera = GetMain();
+        TickView tickView;
+        tickView.position = camera.GetPosition();
+        tickView.frustum = Math::Frustum::FromMatrix(camera.GetViewMatrix() * camera.GetProjectionMatrix());
+        tickView.hasFrustum = true;
+        GetWorld().SetTickView(tickView);
+    }
+}
+
 void CameraService::DebugUI()
 {
     Graphics::SimpleDraw::Render(GetMain());
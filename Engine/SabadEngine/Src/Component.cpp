@@ -0,0 +1,32 @@
+#include "Precompiled.h"
+#include "Component.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // handed out in order so objects that start ticking together are spread over the frames of their interval
+    std::atomic<uint32_t> sNextTickSlot = 0;
+}
+
+void Component::SetTickInterval(uint32_t interval)
+{
+    ASSERT(interval > 0, "Component: tick interval must be at least 1.");
+    mTickInterval = interval;
+    AssignTickSlot();
+}
+
+void Component::SetTickLod(const TickLod* tickLod)
+{
+    mTickLod = tickLod;
+    AssignTickSlot();
+}
+
+void Component::AssignTickSlot()
+{
+    if (!mHasTickSlot)
+    {
+        mTickSlot = sNextTickSlot.fetch_add(1, std::memory_order_relaxed);
+        mHasTickSlot = true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "Precompiled.h"
+#include "ComponentMirror.h"
+#include "GameWorld.h"
+#include "TransformComponent.h"
+#include "RigidBodyComponent.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+	bool Differs(const Math::Vector3& a, const Math::Vector3& b)
+	{
+		return a.x != b.x || a.y != b.y || a.z != b.z;
+	}
+
+	void ReadRigidBody(const RigidBodyComponent& rigidBodyComponent, RigidBodyData& rigidBody)
+	{
+		rigidBody.velocity = rigidBodyComponent.GetVelocity();
+		rigidBody.angularVelocity = rigidBodyComponent.GetAngularVelocity();
+		rigidBody.mass = rigidBodyComponent.GetMass();
+	}
+}
+
+EntityHandle ComponentMirror::Mirror(GameWorld& world, GameObject& gameObject)
+{
+	TransformComponent* transformComponent = gameObject.GetComponent<TransformComponent>();
+	ASSERT(transformComponent != nullptr, "ComponentMirror: game object needs a transform component.");
+	RigidBodyComponent* rigidBodyComponent = gameObject.GetComponent<RigidBodyComponent>();
+	const MirroredComponents components{ transformComponent, rigidBodyComponent };
+	const Graphics::Transform transform = *transformComponent;
+	if (rigidBodyComponent == nullptr)
+	{
+		return world.AttachEntity(gameObject, components, transform);
+	}
+	RigidBodyData rigidBody;
+	ReadRigidBody(*rigidBodyComponent, rigidBody);
+	return world.AttachEntity(gameObject, components, transform, rigidBody);
+}
+
+void ComponentMirror::Pull(GameWorld& world)
+{
+	world.ForEach<MirroredComponents, Graphics::Transform>([](const MirroredComponents& components, Graphics::Transform& transform)
+	{
+		transform = *components.transform;
+	});
+	world.ForEach<MirroredComponents, RigidBodyData>([](const MirroredComponents& components, RigidBodyData& rigidBody)
+	{
+		ReadRigidBody(*components.rigidBody, rigidBody);
+	});
+}
+
+void ComponentMirror::Push(GameWorld& world)
+{
+	world.ForEach<MirroredComponents, Graphics::Transform>([](const MirroredComponents& components, const Graphics::Transform& transform)
+	{
+		// setting a body's position wakes it up, so only the ones the ForEach moved are set
+		TransformComponent& transformComponent = *components.transform;
+		const bool moved = Differs(transform.position, transformComponent.position) || transform.rotation != transformComponent.rotation;
+		static_cast<Graphics::Transform&>(transformComponent) = transform;
+		if (moved && components.rigidBody != nullptr && components.rigidBody->IsDynamic())
+		{
+			components.rigidBody->SetPosition(transform.position);
+		}
+	});
+	world.ForEach<MirroredComponents, RigidBodyData>([](const MirroredComponents& components, const RigidBodyData& rigidBody)
+	{
+		RigidBodyComponent& rigidBodyComponent = *components.rigidBody;
+		if (!rigidBodyComponent.IsDynamic())
+		{
+			return;
+		}
+		if (Differs(rigidBody.velocity, rigidBodyComponent.GetVelocity()))
+		{
+			rigidBodyComponent.SetVelocity(rigidBody.velocity);
+		}
+		if (Differs(rigidBody.angularVelocity, rigidBodyComponent.GetAngularVelocity()))
+		{
+			rigidBodyComponent.SetAngularVelocity(rigidBody.angularVelocity);
+		}
+	});
+}
\ No newline at end of file
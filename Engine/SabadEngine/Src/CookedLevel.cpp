@@ -0,0 +1,451 @@
+#include "Precompiled.h"
+#include "CookedLevel.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::CookedLevel;
+
+namespace
+{
+	bool ReadJsonFile(const std::filesystem::path& filePath, rapidjson::Document& document)
+	{
+		FILE* file = nullptr;
+		auto err = fopen_s(&file, filePath.u8string().c_str(), "r");
+		if (err != 0 || file == nullptr)
+		{
+			LOG("CookedLevel: failed to open %s", filePath.u8string().c_str());
+			return false;
+		}
+
+		char readBuffer[65536];
+		rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
+		document.ParseStream(readStream);
+		fclose(file);
+		if (document.HasParseError())
+		{
+			LOG("CookedLevel: failed to parse %s", filePath.u8string().c_str());
+			return false;
+		}
+		return true;
+	}
+
+	class Writer
+	{
+	public:
+		uint32_t AddString(std::string_view str)
+		{
+			auto iter = mStringIndices.find(std::string(str));
+			if (iter != mStringIndices.end())
+			{
+				return iter->second;
+			}
+			const uint32_t index = static_cast<uint32_t>(mStrings.size());
+			StringRecord& record = mStrings.emplace_back();
+			record.offset = static_cast<uint32_t>(mChars.size());
+			record.length = static_cast<uint32_t>(str.size());
+			mChars.insert(mChars.end(), str.begin(), str.end());
+			mChars.push_back('\0');
+			mStringIndices.emplace(str, index);
+			return index;
+		}
+
+		uint32_t AddValue(const rapidjson::Value& value)
+		{
+			const uint32_t index = static_cast<uint32_t>(mValues.size());
+			mValues.emplace_back();
+			FillValue(index, value, InvalidIndex);
+			return index;
+		}
+
+		uint32_t AddComponent(const std::string& type, const rapidjson::Value& value)
+		{
+			const uint32_t index = static_cast<uint32_t>(mComponents.size());
+			ComponentRecord record;
+			record.type = AddString(type);
+			record.value = AddValue(value);
+			mComponents.push_back(record);
+			return index;
+		}
+
+		uint32_t GetComponentCount() const
+		{
+			return static_cast<uint32_t>(mComponents.size());
+		}
+
+		bool Save(Header header, const std::filesystem::path& filePath)
+		{
+			std::vector<uint8_t> blob(sizeof(Header));
+			header.stringCount = static_cast<uint32_t>(mStrings.size());
+			header.stringsOffset = Append(blob, mStrings);
+			header.charCount = static_cast<uint32_t>(mChars.size());
+			header.charsOffset = Append(blob, mChars);
+			header.valueCount = static_cast<uint32_t>(mValues.size());
+			header.valuesOffset = Append(blob, mValues);
+			header.servicesOffset = Append(blob, services);
+			header.serviceCount = static_cast<uint32_t>(services.size());
+			header.templateCount = static_cast<uint32_t>(templates.size());
+			header.templatesOffset = Append(blob, templates);
+			header.componentCount = static_cast<uint32_t>(mComponents.size());
+			header.componentsOffset = Append(blob, mComponents);
+			header.objectCount = static_cast<uint32_t>(objects.size());
+			header.objectsOffset = Append(blob, objects);
+			header.fileSize = static_cast<uint32_t>(blob.size());
+			std::memcpy(blob.data(), &header, sizeof(Header));
+
+			FILE* file = nullptr;
+			auto err = fopen_s(&file, filePath.u8string().c_str(), "wb");
+			if (err != 0 || file == nullptr)
+			{
+				LOG("CookedLevel: failed to write %s", filePath.u8string().c_str());
+				return false;
+			}
+			const std::size_t written = fwrite(blob.data(), 1, blob.size(), file);
+			fclose(file);
+			return written == blob.size();
+		}
+
+		std::vector<ServiceRecord> services;
+		std::vector<TemplateRecord> templates;
+		std::vector<ObjectRecord> objects;
+
+	private:
+		// children go in one block after everything written so far, so each container's children stay contiguous
+		void FillValue(uint32_t index, const rapidjson::Value& value, uint32_t name)
+		{
+			ValueRecord record;
+			record.name = name;
+			switch (value.GetType())
+			{
+			case rapidjson::kFalseType: record.type = ValueType::False; break;
+			case rapidjson::kTrueType: record.type = ValueType::True; break;
+			case rapidjson::kNumberType:
+				if (value.IsInt64())
+				{
+					record.type = ValueType::Int;
+					record.intValue = value.GetInt64();
+				}
+				else
+				{
+					record.type = ValueType::Double;
+					record.doubleValue = value.GetDouble();
+				}
+				break;
+			case rapidjson::kStringType:
+				record.type = ValueType::String;
+				record.string = AddString({ value.GetString(), value.GetStringLength() });
+				break;
+			case rapidjson::kArrayType:
+				record.type = ValueType::Array;
+				record.children.first = static_cast<uint32_t>(mValues.size());
+				record.children.count = value.Size();
+				break;
+			case rapidjson::kObjectType:
+				record.type = ValueType::Object;
+				record.children.first = static_cast<uint32_t>(mValues.size());
+				record.children.count = value.MemberCount();
+				break;
+			default: record.type = ValueType::Null; break;
+			}
+			mValues[index] = record;
+
+			if (record.type == ValueType::Array)
+			{
+				mValues.resize(mValues.size() + record.children.count);
+				for (uint32_t i = 0; i < record.children.count; ++i)
+				{
+					FillValue(record.children.first + i, value[i], InvalidIndex);
+				}
+			}
+			else if (record.type == ValueType::Object)
+			{
+				mValues.resize(mValues.size() + record.children.count);
+				uint32_t i = 0;
+				for (auto& member : value.GetObj())
+				{
+					const uint32_t memberName = AddString({ member.name.GetString(), member.name.GetStringLength() });
+					FillValue(record.children.first + i, member.value, memberName);
+					++i;
+				}
+			}
+		}
+
+		template<class RecordType>
+		static uint32_t Append(std::vector<uint8_t>& blob, const std::vector<RecordType>& records)
+		{
+			// 8 byte aligned so the tables can be read in place
+			blob.resize((blob.size() + 7) & ~std::size_t(7));
+			const uint32_t offset = static_cast<uint32_t>(blob.size());
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(records.data());
+			blob.insert(blob.end(), bytes, bytes + (records.size() * sizeof(RecordType)));
+			return offset;
+		}
+
+		std::vector<StringRecord> mStrings;
+		std::vector<char> mChars;
+		std::unordered_map<std::string, uint32_t> mStringIndices;
+		std::vector<ValueRecord> mValues;
+		std::vector<ComponentRecord> mComponents;
+	};
+
+	// [first, first + count) fits in a table of size records, without overflowing
+	bool IsRangeValid(uint32_t first, uint32_t count, uint32_t size)
+	{
+		return first <= size && count <= size - first;
+	}
+}
+
+bool CookedLevel::Cook(const std::filesystem::path& levelFile, const std::filesystem::path& cookedFile)
+{
+	rapidjson::Document levelDocument;
+	if (!ReadJsonFile(levelFile, levelDocument))
+	{
+		return false;
+	}
+
+	Writer writer;
+	Header header;
+	header.capacity = static_cast<uint32_t>(levelDocument["Capacity"].GetInt());
+
+	for (auto& service : levelDocument["Services"].GetObj())
+	{
+		ServiceRecord& record = writer.services.emplace_back();
+		record.name = writer.AddString(service.name.GetString());
+		record.value = writer.AddValue(service.value);
+	}
+
+	// template paths are kept as written, relative to the working directory the game runs from
+	std::unordered_map<std::string, uint32_t> templateIndices;
+	for (auto& gameObject : levelDocument["GameObjects"].GetObj())
+	{
+		const std::string templateFile = gameObject.value["Template"].GetString();
+		auto iter = templateIndices.find(templateFile);
+		if (iter == templateIndices.end())
+		{
+			rapidjson::Document templateDocument;
+			if (!ReadJsonFile(templateFile, templateDocument))
+			{
+				return false;
+			}
+			TemplateRecord& record = writer.templates.emplace_back();
+			record.path = writer.AddString(templateFile);
+			record.firstComponent = writer.GetComponentCount();
+			for (auto& component : templateDocument["Components"].GetObj())
+			{
+				writer.AddComponent(component.name.GetString(), component.value);
+			}
+			record.componentCount = writer.GetComponentCount() - record.firstComponent;
+			iter = templateIndices.emplace(templateFile, static_cast<uint32_t>(writer.templates.size() - 1)).first;
+		}
+
+		ObjectRecord& record = writer.objects.emplace_back();
+		record.name = writer.AddString(gameObject.name.GetString());
+		record.templateIndex = iter->second;
+		record.firstOverride = writer.GetComponentCount();
+		if (gameObject.value.HasMember("Components"))
+		{
+			for (auto& component : gameObject.value["Components"].GetObj())
+			{
+				writer.AddComponent(component.name.GetString(), component.value);
+			}
+		}
+		record.overrideCount = writer.GetComponentCount() - record.firstOverride;
+	}
+
+	if (!writer.Save(header, cookedFile))
+	{
+		return false;
+	}
+	LOG("CookedLevel: cooked %s, %zu objects from %zu templates", levelFile.u8string().c_str(), writer.objects.size(), writer.templates.size());
+	return true;
+}
+
+template<class RecordType>
+const RecordType* Reader::GetTable(uint32_t offset, uint32_t count) const
+{
+	if (offset > mSize || count > (mSize - offset) / sizeof(RecordType) || (offset % alignof(RecordType)) != 0)
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<const RecordType*>(mData + offset);
+}
+
+bool Reader::Open(const uint8_t* data, std::size_t size)
+{
+	mData = data;
+	mSize = size;
+	mHeader = GetTable<Header>(0, 1);
+	if (mHeader == nullptr || mHeader->magic != Magic || mHeader->version != Version || mHeader->fileSize != size)
+	{
+		mHeader = nullptr;
+		return false;
+	}
+
+	mStrings = GetTable<StringRecord>(mHeader->stringsOffset, mHeader->stringCount);
+	mChars = GetTable<char>(mHeader->charsOffset, mHeader->charCount);
+	mValues = GetTable<ValueRecord>(mHeader->valuesOffset, mHeader->valueCount);
+	mServices = GetTable<ServiceRecord>(mHeader->servicesOffset, mHeader->serviceCount);
+	mTemplates = GetTable<TemplateRecord>(mHeader->templatesOffset, mHeader->templateCount);
+	mComponents = GetTable<ComponentRecord>(mHeader->componentsOffset, mHeader->componentCount);
+	mObjects = GetTable<ObjectRecord>(mHeader->objectsOffset, mHeader->objectCount);
+	const bool valid = mStrings != nullptr && mChars != nullptr && mValues != nullptr && mServices != nullptr
+		&& mTemplates != nullptr && mComponents != nullptr && mObjects != nullptr && ValidateRecords();
+	if (!valid)
+	{
+		mHeader = nullptr;
+	}
+	return valid;
+}
+
+bool Reader::ValidateRecords() const
+{
+	const Header& header = *mHeader;
+	for (uint32_t i = 0; i < header.stringCount; ++i)
+	{
+		// the terminator has to be inside the chars too
+		const StringRecord& record = mStrings[i];
+		if (!IsRangeValid(record.offset, record.length, header.charCount) || record.offset + record.length == header.charCount
+			|| mChars[record.offset + record.length] != '\0')
+		{
+			LOG("CookedLevel: string %u is out of range", i);
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < header.valueCount; ++i)
+	{
+		const ValueRecord& record = mValues[i];
+		bool valid = record.type <= ValueType::Object && (record.name == InvalidIndex || record.name < header.stringCount);
+		if (valid && record.type == ValueType::String)
+		{
+			valid = record.string < header.stringCount;
+		}
+		else if (valid && (record.type == ValueType::Array || record.type == ValueType::Object))
+		{
+			// children always come after their parent, so MakeValue can't loop back on itself
+			valid = record.children.first > i && IsRangeValid(record.children.first, record.children.count, header.valueCount);
+			for (uint32_t c = 0; valid && record.type == ValueType::Object && c < record.children.count; ++c)
+			{
+				valid = mValues[record.children.first + c].name < header.stringCount;
+			}
+		}
+		if (!valid)
+		{
+			LOG("CookedLevel: value %u is invalid", i);
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < header.serviceCount; ++i)
+	{
+		const ServiceRecord& record = mServices[i];
+		if (record.name >= header.stringCount || record.value >= header.valueCount)
+		{
+			LOG("CookedLevel: service %u is invalid", i);
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < header.templateCount; ++i)
+	{
+		const TemplateRecord& record = mTemplates[i];
+		if (record.path >= header.stringCount || !IsRangeValid(record.firstComponent, record.componentCount, header.componentCount))
+		{
+			LOG("CookedLevel: template %u is invalid", i);
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < header.componentCount; ++i)
+	{
+		const ComponentRecord& record = mComponents[i];
+		if (record.type >= header.stringCount || record.value >= header.valueCount)
+		{
+			LOG("CookedLevel: component %u is invalid", i);
+			return false;
+		}
+	}
+	for (uint32_t i = 0; i < header.objectCount; ++i)
+	{
+		const ObjectRecord& record = mObjects[i];
+		if (record.name >= header.stringCount || record.templateIndex >= header.templateCount
+			|| !IsRangeValid(record.firstOverride, record.overrideCount, header.componentCount))
+		{
+			LOG("CookedLevel: object %u is invalid", i);
+			return false;
+		}
+	}
+	return true;
+}
+
+const Header& Reader::GetHeader() const
+{
+	return *mHeader;
+}
+
+std::string_view Reader::GetString(uint32_t index) const
+{
+	ASSERT(index < mHeader->stringCount, "CookedLevel: invalid string index %u", index);
+	const StringRecord& record = mStrings[index];
+	ASSERT(record.offset + record.length < mHeader->charCount, "CookedLevel: string %u is out of range", index);
+	return { mChars + record.offset, record.length };
+}
+
+const ServiceRecord& Reader::GetServiceRecord(uint32_t index) const
+{
+	ASSERT(index < mHeader->serviceCount, "CookedLevel: invalid service index %u", index);
+	return mServices[index];
+}
+
+const TemplateRecord& Reader::GetTemplateRecord(uint32_t index) const
+{
+	ASSERT(index < mHeader->templateCount, "CookedLevel: invalid template index %u", index);
+	return mTemplates[index];
+}
+
+const ComponentRecord& Reader::GetComponentRecord(uint32_t index) const
+{
+	ASSERT(index < mHeader->componentCount, "CookedLevel: invalid component index %u", index);
+	return mComponents[index];
+}
+
+const ObjectRecord& Reader::GetObjectRecord(uint32_t index) const
+{
+	ASSERT(index < mHeader->objectCount, "CookedLevel: invalid object index %u", index);
+	return mObjects[index];
+}
+
+rapidjson::Value Reader::MakeValue(uint32_t index, rapidjson::MemoryPoolAllocator<>& allocator) const
+{
+	ASSERT(index < mHeader->valueCount, "CookedLevel: invalid value index %u", index);
+	const ValueRecord& record = mValues[index];
+	switch (record.type)
+	{
+	case ValueType::False: return rapidjson::Value(false);
+	case ValueType::True: return rapidjson::Value(true);
+	case ValueType::Int: return rapidjson::Value(static_cast<int64_t>(record.intValue));
+	case ValueType::Double: return rapidjson::Value(record.doubleValue);
+	case ValueType::String:
+	{
+		const std::string_view str = GetString(record.string);
+		return rapidjson::Value(rapidjson::StringRef(str.data(), str.size()));
+	}
+	case ValueType::Array:
+	{
+		rapidjson::Value array(rapidjson::kArrayType);
+		array.Reserve(record.children.count, allocator);
+		for (uint32_t i = 0; i < record.children.count; ++i)
+		{
+			array.PushBack(MakeValue(record.children.first + i, allocator), allocator);
+		}
+		return array;
+	}
+	case ValueType::Object:
+	{
+		rapidjson::Value object(rapidjson::kObjectType);
+		object.MemberReserve(record.children.count, allocator);
+		for (uint32_t i = 0; i < record.children.count; ++i)
+		{
+			const uint32_t child = record.children.first + i;
+			const std::string_view name = GetString(mValues[child].name);
+			object.AddMember(rapidjson::Value(rapidjson::StringRef(name.data(), name.size())), MakeValue(child, allocator), allocator);
+		}
+		return object;
+	}
+	default: return rapidjson::Value();
+	}
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Precompiled.h"
 #include "DynamicAnimatorComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 #include "GameObject.h"
 #include "ModelComponent.h"
 
@@ -10,7 +11,16 @@ void DynamicAnimatorComponent::Initialize()
 {
 	const ModelComponent* modelComponent = GetOwner().GetComponent<ModelComponent>();
 	ASSERT(modelComponent != nullptr, "AnimatorComponent: GameObject needs a ModelComponent!");
+	// a clip set before Initialize came from LoadState
+	const int clipIndex = mAnimator.GetClipIndex();
+	const bool looping = mAnimator.IsLooping();
+	const float animationTick = mAnimator.GetAnimationTick();
 	mAnimator.Initialize(modelComponent->GetModelId());
+	if (clipIndex >= 0 && clipIndex < static_cast<int>(mAnimator.GetAnimationCount()))
+	{
+		mAnimator.PlayAnimation(clipIndex, looping);
+		mAnimator.SetAnimationTick(animationTick);
+	}
 }
 void DynamicAnimatorComponent::Update(float deltaTime)
 {
@@ -19,6 +29,53 @@ void DynamicAnimatorComponent::Update(float deltaTime)
 
 //salmon was here 
 
+void DynamicAnimatorComponent::Deserialize(const rapidjson::Value& value)
+{
+	int tickInterval = 1;
+	if (SaveUtil::ReadInt("TickInterval", tickInterval, value))
+	{
+		SetTickInterval(static_cast<uint32_t>(std::max(tickInterval, 1)));
+	}
+	if (SaveUtil::ReadTickLod("TickLod", mTickLod, value))
+	{
+		SetTickLod(&mTickLod);
+	}
+}
+void DynamicAnimatorComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(GetTickInterval());
+	writer.Write(GetTickLod() == &mTickLod);
+	SaveUtil::SaveTickLod(writer, mTickLod);
+	writer.Write(mAnimator.GetClipIndex());
+	writer.Write(mAnimator.IsLooping());
+	writer.Write(mAnimator.GetAnimationTick());
+}
+void DynamicAnimatorComponent::LoadState(SnapshotReader& reader)
+{
+	const uint32_t tickInterval = reader.ReadUInt();
+	if (tickInterval > 1)
+	{
+		SetTickInterval(tickInterval);
+	}
+	bool hasTickLod = false;
+	reader.Read(hasTickLod);
+	SaveUtil::LoadTickLod(reader, mTickLod);
+	if (hasTickLod)
+	{
+		SetTickLod(&mTickLod);
+	}
+
+	// Initialize carries the clip on, so the animation picks up where it was saved
+	int clipIndex = -1;
+	bool looping = false;
+	float animationTick = 0.0f;
+	reader.Read(clipIndex);
+	reader.Read(looping);
+	reader.Read(animationTick);
+	mAnimator.PlayAnimation(clipIndex, looping);
+	mAnimator.SetAnimationTick(animationTick);
+}
+
 void DynamicAnimatorComponent::DebugUI()
 {
 	uint32_t animCount = mAnimator.GetAnimationCount();
@@ -3,6 +3,7 @@
 #include "CameraComponent.h"
 #include "GameObject.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 using namespace SabadEngine::Input;
@@ -67,4 +68,18 @@ void FPSCameraComponent::Deserialize(const rapidjson::Value& value)
 	SaveUtil::ReadFloat("MoveSpeed", mMoveSpeed, value);
 	SaveUtil::ReadFloat("ShiftSpeed", mShiftSpeed, value);
 	SaveUtil::ReadFloat("TurnSpeed", mTurnSpeed, value);
+}
+
+void FPSCameraComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mMoveSpeed);
+	writer.Write(mShiftSpeed);
+	writer.Write(mTurnSpeed);
+}
+
+void FPSCameraComponent::LoadState(SnapshotReader& reader)
+{
+	reader.Read(mMoveSpeed);
+	reader.Read(mShiftSpeed);
+	reader.Read(mTurnSpeed);
 }
\ No newline at end of file
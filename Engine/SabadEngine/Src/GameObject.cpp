@@ -1,10 +1,36 @@
 #include "Precompiled.h"
 #include "GameObject.h"
+#include "GameWorld.h"
 
 using namespace SabadEngine;
 
 static uint32_t gUniqueId = 0;
 
+namespace
+{
+    std::mutex sComponentSlotMutex;
+    std::unordered_map<uint32_t, uint32_t> sCustomComponentSlots;
+}
+
+uint32_t GameObject::GetComponentSlot(uint32_t typeId)
+{
+    if (typeId < static_cast<uint32_t>(ComponentId::Count))
+    {
+        return typeId;
+    }
+
+    std::lock_guard<std::mutex> lock(sComponentSlotMutex);
+    auto iter = sCustomComponentSlots.find(typeId);
+    if (iter != sCustomComponentSlots.end())
+    {
+        return iter->second;
+    }
+    const uint32_t slot = static_cast<uint32_t>(ComponentId::Count) + static_cast<uint32_t>(sCustomComponentSlots.size());
+    ASSERT(slot < MaxComponentSlots, "GameObject: too many custom component types, increase MaxComponentSlots!");
+    sCustomComponentSlots.emplace(typeId, slot);
+    return slot;
+}
+
 void GameObject::Initialize()
 {
     ASSERT(!mInitialized, "GameObject: Already initialized!");
@@ -15,6 +41,11 @@ void GameObject::Initialize()
 
     mId = ++gUniqueId;
     mInitialized = true;
+    if (mWorld != nullptr)
+    {
+        mWorld->mScheduleDirty = true;
+        mWorld->mTransformHierarchyDirty = true;
+    }
 
     for (GameObject* child : mChildren)
     {
@@ -35,13 +66,18 @@ void GameObject::Terminate()
         component.reset();
     }
     mComponents.clear();
+    mComponentIndices = MakeEmptyComponentIndices();
+    mComponentMask = 0;
 }
 
 void GameObject::Update(float deltaTime)
 {
     for (auto& component : mComponents)
     {
-        component->Update(deltaTime);
+        if (component->HasUpdate())
+        {
+            component->Update(deltaTime);
+        }
     }
 }
 
@@ -49,7 +85,10 @@ void GameObject::LateUpdate(float deltaTime)
 {
     for (auto& component : mComponents)
     {
-        component->LateUpdate(deltaTime);
+        if (component->HasLateUpdate())
+        {
+            component->LateUpdate(deltaTime);
+        }
     }
 }
 
@@ -58,9 +97,15 @@ void GameObject::DebugUI()
     ImGui::PushID(mId);
     if (ImGui::CollapsingHeader(mName.c_str()))
     {
+        UpdateProfiler* profiler = (mWorld != nullptr && mWorld->mProfiler.IsEnabled()) ? &mWorld->mProfiler : nullptr;
         for (auto& component : mComponents)
         {
+            const UpdateProfiler::Clock::time_point start = (profiler != nullptr) ? UpdateProfiler::Clock::now() : UpdateProfiler::Clock::time_point();
             component->DebugUI();
+            if (profiler != nullptr)
+            {
+                profiler->Record(profiler->GetComponentEntry(component->GetTypeId()), ProfilePhase::DebugUI, start, 1);
+            }
         }
     }
     ImGui::PopID();
@@ -89,6 +134,16 @@ const GameObjectHandle& GameObject::GetHandle() const
     return mHandle;
 }
 
+GameObject::ComponentMask GameObject::GetComponentMask() const
+{
+    return mComponentMask;
+}
+
+const EntityHandle& GameObject::GetEntity() const
+{
+    return mEntity;
+}
+
 GameWorld& GameObject::GetWorld()
 {
     return *mWorld;
@@ -101,7 +156,13 @@ const GameWorld& GameObject::GetWorld() const
 
 void GameObject::AddChild(GameObject* child)
 {
+    // the parent's children and the world's dirty flag are shared between the workers
+    ASSERT(mWorld == nullptr || !mWorld->mCreatingObjects, "GameObject: parent objects after CreateGameObjects returns, not in its initializer");
     mChildren.push_back(child);
+    if (mWorld != nullptr)
+    {
+        mWorld->mTransformHierarchyDirty = true;
+    }
 }
 
 uint32_t GameObject::GetChildCount() const
@@ -129,7 +190,12 @@ const GameObject* GameObject::GetChild(uint32_t index) const
 
 void GameObject::SetParent(GameObject* parent)
 {
+    ASSERT(mWorld == nullptr || !mWorld->mCreatingObjects, "GameObject: parent objects after CreateGameObjects returns, not in its initializer");
     mParent = parent;
+    if (mWorld != nullptr)
+    {
+        mWorld->mTransformHierarchyDirty = true;
+    }
 }
 
 GameObject* GameObject::GetParent()
@@ -2,169 +2,166 @@
 #include "GameObjectFactory.h"
 #include "GameObject.h"
 #include "Component.h"
-#include "TransformComponent.h"
-#include "CameraComponent.h"
-#include "FPSCameraComponent.h"
-#include "MeshComponent.h"
-#include "ModelComponent.h"
-#include "AnimatorComponent.h"
-#include "RigidBodyComponent.h"
-#include "SoundEventComponent.h"
-#include "SoundBankComponent.h"
-#include "UITextComponent.h"
-#include "UISpriteComponent.h"
+#include "TypeRegistry.h"
 
 using namespace SabadEngine;
+using GameObjectFactory::Template;
 
 namespace
 {
-	CustomComponent TryMakeComponent;
-	CustomComponent TryGetComponent;
+	struct TemplateComponent
+	{
+		const ComponentRegistration* registration = nullptr;
+		const rapidjson::Value* data = nullptr;
+	};
+}
+
+// a template file parsed once, the component types are looked up once and the data stays in the document
+struct GameObjectFactory::Template
+{
+	rapidjson::Document document;
+	std::vector<TemplateComponent> components;
+	std::filesystem::file_time_type writeTime;
+};
 
-	Component* AddComponent(const std::string& componentName, GameObject& gameObject)
+namespace
+{
+	struct CachedTemplate
 	{
-		Component* newComponent = nullptr;
-		if (componentName == "TransformComponent")
-		{
-			newComponent = gameObject.AddComponent<TransformComponent>();
-		}
-		else if (componentName == "CameraComponent")
-		{
-			newComponent = gameObject.AddComponent<CameraComponent>();
-		}
-		else if (componentName == "FPSCameraComponent")
-		{
-			newComponent = gameObject.AddComponent<FPSCameraComponent>();
-		}
-		else if (componentName == "MeshComponent")
-		{
-			newComponent = gameObject.AddComponent<MeshComponent>();
-		}
-		else if (componentName == "ModelComponent")
-		{
-			newComponent = gameObject.AddComponent<ModelComponent>();
-		}
-		else if (componentName == "AnimatorComponent")
-		{
-			newComponent = gameObject.AddComponent<AnimatorComponent>();
-		}
-		else if (componentName == "RigidBodyComponent")
-		{
-			newComponent = gameObject.AddComponent<RigidBodyComponent>();
-		}
-		else if (componentName == "SoundEventComponent")
-		{
-			newComponent = gameObject.AddComponent<SoundEventComponent>();
-		}
-		else if (componentName == "SoundBankComponent")
+		std::shared_ptr<const Template> objectTemplate;
+		std::chrono::steady_clock::time_point lastWriteCheck;
+	};
+
+	// how often a cached template checks its file for edits, checking on every Make would cost more than the clone
+	constexpr std::chrono::milliseconds WriteCheckInterval(1000);
+
+	std::unordered_map<std::string, CachedTemplate> sTemplates;
+	std::mutex sTemplateMutex;
+
+	std::shared_ptr<const Template> LoadTemplate(const std::filesystem::path& templatePath)
+	{
+		FILE* file = nullptr;
+		auto err = fopen_s(&file, templatePath.u8string().c_str(), "r");
+		ASSERT(err == 0 && file != nullptr, "GameObjectFactory: failed to open file %s", templatePath.u8string().c_str());
+
+		auto newTemplate = std::make_shared<Template>();
+		std::error_code errorCode;
+		newTemplate->writeTime = std::filesystem::last_write_time(templatePath, errorCode);
+
+		// the stream reads as it parses, so the file stays open until the parse is done
+		char readBuffer[65536];
+		rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
+		newTemplate->document.ParseStream(readStream);
+		fclose(file);
+
+		auto components = newTemplate->document["Components"].GetObj();
+		for (auto& component : components)
 		{
-			newComponent = gameObject.AddComponent<SoundBankComponent>();
+			TemplateComponent& templateComponent = newTemplate->components.emplace_back();
+			templateComponent.registration = TypeRegistry::FindComponent(std::string_view(component.name.GetString(), component.name.GetStringLength()));
+			ASSERT(templateComponent.registration != nullptr, "GameObjectFactory: component type [%s] not found.", component.name.GetString());
+			templateComponent.data = &component.value;
 		}
-		else if (componentName == "UITextComponent")
+		return newTemplate;
+	}
+}
+
+void GameObjectFactory::Make(const std::filesystem::path& templatePath, GameObject& gameObject, GameWorld& gameWorld)
+{
+	// held for the whole make, so a reload from another thread can't free the data being read
+	const std::shared_ptr<const Template> objectTemplate = GetTemplate(templatePath);
+	Make(*objectTemplate, gameObject);
+}
+
+std::shared_ptr<const Template> GameObjectFactory::GetTemplate(const std::filesystem::path& templatePath)
+{
+	const std::string key = templatePath.lexically_normal().generic_string();
+	const auto now = std::chrono::steady_clock::now();
+
+	// the lock only covers the map, the file is checked and parsed outside it so other templates never wait on the disk
+	std::shared_ptr<const Template> cachedTemplate;
+	bool checkWriteTime = false;
+	{
+		std::lock_guard<std::mutex> lock(sTemplateMutex);
+		auto iter = sTemplates.find(key);
+		if (iter != sTemplates.end())
 		{
-			newComponent = gameObject.AddComponent<UITextComponent>();
+			cachedTemplate = iter->second.objectTemplate;
+			checkWriteTime = now - iter->second.lastWriteCheck >= WriteCheckInterval;
+			if (checkWriteTime)
+			{
+				iter->second.lastWriteCheck = now;
+			}
 		}
-		else if (componentName == "UISpriteComponent")
+	}
+	if (cachedTemplate != nullptr)
+	{
+		if (!checkWriteTime)
 		{
-			newComponent = gameObject.AddComponent<UISpriteComponent>();
+			return cachedTemplate;
 		}
-		else
+		std::error_code errorCode;
+		const auto writeTime = std::filesystem::last_write_time(templatePath, errorCode);
+		if (errorCode || writeTime == cachedTemplate->writeTime)
 		{
-			newComponent = TryMakeComponent(componentName, gameObject);
+			return cachedTemplate;
 		}
+	}
 
-		ASSERT(newComponent != nullptr, "GameObjectFactory: component type [%s] not found.", componentName.c_str());
-		return newComponent;
+	std::shared_ptr<const Template> loadedTemplate = LoadTemplate(templatePath);
+	std::lock_guard<std::mutex> lock(sTemplateMutex);
+	auto [iter, inserted] = sTemplates.emplace(key, CachedTemplate{ loadedTemplate, now });
+	// another thread may have loaded the same file meanwhile, its entry stays unless it is the stale one this replaces
+	if (!inserted && iter->second.objectTemplate == cachedTemplate)
+	{
+		iter->second.objectTemplate = std::move(loadedTemplate);
+		iter->second.lastWriteCheck = now;
 	}
+	return iter->second.objectTemplate;
+}
 
-	Component* GetComponent(const std::string& componentName, GameObject& gameObject)
+void GameObjectFactory::Make(const Template& objectTemplate, GameObject& gameObject)
+{
+	for (const TemplateComponent& templateComponent : objectTemplate.components)
 	{
-		Component* component = nullptr;
-		if (componentName == "TransformComponent")
+		const ComponentRegistration* registration = templateComponent.registration;
+		if (registration != nullptr)
 		{
-			component = gameObject.GetComponent<TransformComponent>();
+			registration->deserialize(*registration->make(gameObject), *templateComponent.data);
 		}
-		else if (componentName == "CameraComponent")
-		{
-			component = gameObject.GetComponent<CameraComponent>();
-		}
-		else if (componentName == "FPSCameraComponent")
-		{
-			component = gameObject.GetComponent<FPSCameraComponent>();
-		}
-		else if (componentName == "MeshComponent")
-		{
-			component = gameObject.GetComponent<MeshComponent>();
-		}
-		else if (componentName == "ModelComponent")
-		{
-			component = gameObject.GetComponent<ModelComponent>();
-		}
-		else if (componentName == "AnimatorComponent")
-		{
-			component = gameObject.GetComponent<AnimatorComponent>();
-		}
-		else if (componentName == "RigidBodyComponent")
-		{
-			component = gameObject.GetComponent<RigidBodyComponent>();
-		}
-		else if (componentName == "SoundEventComponent")
-		{
-			component = gameObject.GetComponent<SoundEventComponent>();
-		}
-		else if (componentName == "SoundBankComponent")
-		{
-			component = gameObject.GetComponent<SoundBankComponent>();
-		}
-		else if (componentName == "UITextComponent")
-		{
-			component = gameObject.GetComponent<UITextComponent>();
-		}
-		else if (componentName == "UISpriteComponent")
-		{
-			component = gameObject.GetComponent<UISpriteComponent>();
-		}
-		else
-		{
-			component = TryGetComponent(componentName, gameObject);
-		}
-
-		ASSERT(component != nullptr, "GameObjectFactory: component type [%s] not found.", componentName.c_str());
-		return component;
 	}
 }
 
-void GameObjectFactory::SetCustomMake(CustomComponent callback)
+void GameObjectFactory::PreloadTemplate(const std::filesystem::path& templatePath)
 {
-	TryMakeComponent = callback;
+	GetTemplate(templatePath);
 }
-void GameObjectFactory::SetCustomGet(CustomComponent callback)
+
+Component* GameObjectFactory::AddComponent(const std::string& componentName, GameObject& gameObject)
 {
-	TryGetComponent = callback;
+	const ComponentRegistration* registration = TypeRegistry::FindComponent(componentName);
+	ASSERT(registration != nullptr, "GameObjectFactory: component type [%s] not found.", componentName.c_str());
+	return (registration != nullptr) ? registration->make(gameObject) : nullptr;
 }
 
-void GameObjectFactory::Make(const std::filesystem::path& templatePath, GameObject& gameObject, GameWorld& gameWorld)
+Component* GameObjectFactory::GetComponent(const std::string& componentName, GameObject& gameObject)
 {
-	FILE* file = nullptr;
-	auto err = fopen_s(&file, templatePath.u8string().c_str(), "r");
-	ASSERT(err == 0, "GameObjectFactory: failed to open file %s", templatePath.u8string().c_str());
-
-	char readBuffer[65536];
-	rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
-	fclose(file);
-
-	rapidjson::Document doc;
-	doc.ParseStream(readStream);
-	auto components = doc["Components"].GetObj();
-	for (auto& component : components)
-	{
-		// todo read data
-		Component* newComponent = AddComponent(component.name.GetString(), gameObject);
-		if (newComponent != nullptr)
-		{
-			newComponent->Deserialize(component.value);
-		}
-	}
+	const ComponentRegistration* registration = TypeRegistry::FindComponent(componentName);
+	Component* component = (registration != nullptr) ? registration->get(gameObject) : nullptr;
+	ASSERT(component != nullptr, "GameObjectFactory: component type [%s] not found.", componentName.c_str());
+	return component;
+}
+
+void GameObjectFactory::InvalidateTemplates()
+{
+	std::lock_guard<std::mutex> lock(sTemplateMutex);
+	sTemplates.clear();
+}
+
+uint32_t GameObjectFactory::GetCachedTemplateCount()
+{
+	std::lock_guard<std::mutex> lock(sTemplateMutex);
+	return static_cast<uint32_t>(sTemplates.size());
 }
 
 void GameObjectFactory::OverrideDeserialize(const rapidjson::Value& value, GameObject& gameObject)
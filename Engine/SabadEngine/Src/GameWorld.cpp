@@ -1,22 +1,26 @@
 #include "Precompiled.h"
 #include "GameWorld.h"
 #include "GameObjectFactory.h"
-
+#include "LevelLoader.h"
+#include "TransformComponent.h"
+#include "TypeRegistry.h"
 #include "CameraService.h"
 #include "RenderService.h"
 #include "PhysicsService.h"
 #include "UIRenderService.h"
+#include "SpatialService.h"
+#include "SnapshotArchive.h"
+#include "WorldSnapshot.h"
 
 using namespace SabadEngine;
 
 namespace
 {
-	CustomService TryAddService;
-}
+	std::mutex sServiceSlotMutex;
+	std::unordered_map<uint32_t, uint32_t> sCustomServiceSlots;
 
-void GameWorld::SetCustomService(CustomService customService)
-{
-	TryAddService = customService;
+	// key of the snapshot record with the slots and free list, hashed like a type name so it won't match an object handle by accident
+	constexpr uint32_t WorldRecordKey = HashTypeName("GameWorld");
 }
 
 void GameWorld::Initialize(uint32_t capacity)
@@ -27,27 +31,38 @@ void GameWorld::Initialize(uint32_t capacity)
 		service->Initialize();
 	}
 
-	mGameObjectSlots.resize(capacity);
-	mFreeSlots.resize(capacity);
-	std::iota(mFreeSlots.begin(), mFreeSlots.end(), 0);
+	while (mSlotCount < capacity)
+	{
+		AddSlotChunk();
+	}
+	mLiveObjects.reserve(capacity);
 
 	mInitialized = true;
 }
 
 void GameWorld::Terminate()
 {
-	for (Slot& slot : mGameObjectSlots)
+	if (mLevelRead.valid())
 	{
-		if (slot.gameObject != nullptr)
-		{
-			slot.gameObject->Terminate();
-			slot.gameObject.reset();
-		}
+		mLevelRead.wait();
 	}
+	mLevelLoader.reset();
 
-	mGameObjectSlots.clear();
+	for (GameObject* gameObject : mLiveObjects)
+	{
+		gameObject->Terminate();
+	}
+
+	mLiveObjects.clear();
+	mSlotChunks.clear();
+	mSlotCount = 0;
 	mFreeSlots.clear();
 	mToBeDestroyed.clear();
+	mEntities.Terminate();
+	mScheduler.Clear();
+	mScheduleDirty = true;
+	mTransformHierarchy.Clear();
+	mTransformHierarchyDirty = true;
 
 	for (auto& service : mServices)
 	{
@@ -55,73 +70,171 @@ void GameWorld::Terminate()
 		service.reset();
 	}
 	mServices.clear();
+	mEngineServices.fill(nullptr);
+	mCustomServices.clear();
+	mCameraService = nullptr;
+	mRenderService = nullptr;
+	mPhysicsService = nullptr;
+	mUIRenderService = nullptr;
+	mSpatialService = nullptr;
 
 	mInitialized = false;
 }
 
 void GameWorld::Update(float deltaTime)
 {
-	for (Slot& slot : mGameObjectSlots)
+	if (mLevelLoader != nullptr)
 	{
-		if (slot.gameObject != nullptr)
-		{
-			slot.gameObject->Update(deltaTime);
-		}
+		// nothing ticks until the level is complete, so no object sees a half made level
+		UpdateLevelLoad();
+		return;
 	}
-	for (auto& service : mServices)
+	if (mProfiler.IsEnabled())
+	{
+		// the frame before this one ends here, after its Render and DebugUI
+		mProfiler.EndFrame();
+	}
+	if (mScheduleDirty)
 	{
-		service->Update(deltaTime);
+		BuildSchedule();
 	}
+	mScheduler.Run(UpdatePhase::Update, deltaTime);
+	mScheduler.Run(UpdatePhase::Services, deltaTime);
+	mScheduler.Run(UpdatePhase::LateUpdate, deltaTime);
+	// a world that is rendered refreshes them right before Render instead, so they are only compared once a frame
+	// a world that is not, like a server or a tool, still has them after every Update
+	if (!mRenderedSinceUpdate)
+	{
+		RefreshTransformHierarchy();
+	}
+	mRenderedSinceUpdate = false;
 	ProcessDestroyList();
 }
 
 void GameWorld::Render()
 {
+	if (mLevelLoader != nullptr)
+	{
+		return;
+	}
+	// changes from LateUpdate and from anything that ran after Update, new objects included, are drawn this frame
+	RefreshTransformHierarchy();
+	mRenderedSinceUpdate = true;
+	const bool profiling = mProfiler.IsEnabled();
 	for (auto& service : mServices)
 	{
+		const UpdateProfiler::Clock::time_point start = profiling ? UpdateProfiler::Clock::now() : UpdateProfiler::Clock::time_point();
 		service->Render();
+		if (profiling)
+		{
+			mProfiler.Record(mProfiler.GetServiceEntry(*service), ProfilePhase::Render, start, 1);
+		}
 	}
 }
 
 void GameWorld::DebugUI()
 {
-	for (Slot& slot : mGameObjectSlots)
+	for (GameObject* gameObject : mLiveObjects)
 	{
-		if (slot.gameObject != nullptr)
-		{
-			slot.gameObject->DebugUI();
-		}
+		gameObject->DebugUI();
 	}
+	const bool profiling = mProfiler.IsEnabled();
 	for (auto& service : mServices)
 	{
+		const UpdateProfiler::Clock::time_point start = profiling ? UpdateProfiler::Clock::now() : UpdateProfiler::Clock::time_point();
 		service->DebugUI();
+		if (profiling)
+		{
+			mProfiler.Record(mProfiler.GetServiceEntry(*service), ProfilePhase::DebugUI, start, 1);
+		}
+	}
+	if (mEntities.GetEntityCount() > 0)
+	{
+		mEntities.DebugUI();
 	}
+	mProfiler.DebugUI();
 }
 
 GameObject* GameWorld::CreateGameObject(std::string name, const std::filesystem::path& templatePath)
 {
 	ASSERT(mInitialized, "GameWorld: is not initialized.");
-	if (mFreeSlots.empty())
+	uint32_t freeSlot = 0;
+	if (!TakeFreeSlot(freeSlot))
 	{
-		ASSERT(false, "GameWorld: no free slots available.");
 		return nullptr;
 	}
 
-	const uint32_t freeSlot = mFreeSlots.back();
-	mFreeSlots.pop_back();
-
-	Slot& slot = mGameObjectSlots[freeSlot];
-	slot.gameObject = std::make_unique<GameObject>();
-	slot.gameObject->SetName(name);
-	slot.gameObject->mHandle.mIndex = freeSlot;
-	slot.gameObject->mHandle.mGeneration = slot.generation;
-	slot.gameObject->mWorld = this;
+	mLiveObjects.push_back(nullptr);
+	GameObject* gameObject = CreateInSlot(std::move(name), freeSlot, static_cast<uint32_t>(mLiveObjects.size() - 1));
 	if (!templatePath.empty())
 	{
-		GameObjectFactory::Make(templatePath, *slot.gameObject, *this);
+		GameObjectFactory::Make(templatePath, *gameObject, *this);
 	}
-	return slot.gameObject.get();
+	return gameObject;
+}
+
+std::vector<GameObject*> GameWorld::CreateGameObjects(const std::filesystem::path& templatePath, uint32_t count, const ObjectInitializer& initializer)
+{
+	ASSERT(mInitialized, "GameWorld: is not initialized.");
+	std::vector<GameObject*> gameObjects;
+	if (count == 0)
+	{
+		return gameObjects;
+	}
+
+	// the slots and live entries are taken up front, so the workers only ever write to their own object
+	std::vector<uint32_t> slots;
+	slots.reserve(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint32_t freeSlot = 0;
+		if (!TakeFreeSlot(freeSlot))
+		{
+			break;
+		}
+		slots.push_back(freeSlot);
+	}
+	const uint32_t firstLiveIndex = static_cast<uint32_t>(mLiveObjects.size());
+	mLiveObjects.resize(mLiveObjects.size() + slots.size(), nullptr);
+	gameObjects.resize(slots.size(), nullptr);
+
+	const std::shared_ptr<const GameObjectFactory::Template> objectTemplate = templatePath.empty() ? nullptr : GameObjectFactory::GetTemplate(templatePath);
+	const std::string baseName = templatePath.stem().string();
+	auto makeRange = [&](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const uint32_t index = static_cast<uint32_t>(i);
+			GameObject* gameObject = CreateInSlot(baseName + std::to_string(index), slots[i], firstLiveIndex + index);
+			if (objectTemplate != nullptr)
+			{
+				GameObjectFactory::Make(*objectTemplate, *gameObject);
+			}
+			if (initializer)
+			{
+				initializer(*gameObject, index);
+			}
+			gameObjects[i] = gameObject;
+		}
+	};
+	mCreatingObjects = true;
+	Core::JobSystem* jobSystem = Core::JobSystem::TryGet();
+	if (jobSystem == nullptr)
+	{
+		makeRange(0, gameObjects.size());
+	}
+	else
+	{
+		jobSystem->ParallelFor(gameObjects.size(), 16, makeRange);
+	}
+	mCreatingObjects = false;
 
+	// services register components as they initialize, which is not safe to do from the workers
+	for (GameObject* gameObject : gameObjects)
+	{
+		gameObject->Initialize();
+	}
+	return gameObjects;
 }
 
 void GameWorld::DestroyGameObject(const GameObjectHandle& handle)
@@ -131,91 +244,582 @@ void GameWorld::DestroyGameObject(const GameObjectHandle& handle)
 		return;
 	}
 
-	Slot& slot = mGameObjectSlots[handle.mIndex];
-	++slot.generation;
-	mToBeDestroyed.push_back(handle.mIndex);
+	const uint32_t index = handle.GetIndex();
+	++GetSlot(index).generation;
+	mToBeDestroyed.push_back(index);
+}
+
+GameObject* GameWorld::GetGameObject(const GameObjectHandle& handle)
+{
+	return IsValid(handle) ? GetSlot(handle.GetIndex()).gameObject.get() : nullptr;
+}
+
+const GameObject* GameWorld::GetGameObject(const GameObjectHandle& handle) const
+{
+	return IsValid(handle) ? GetSlot(handle.GetIndex()).gameObject.get() : nullptr;
+}
+
+uint32_t GameWorld::GetGameObjectCount() const
+{
+	return static_cast<uint32_t>(mLiveObjects.size() - mToBeDestroyed.size());
+}
+
+void GameWorld::DestroyEntity(const EntityHandle& handle)
+{
+	mEntities.Destroy(handle);
+}
+
+GameObjectHandle GameWorld::GetEntityOwner(const EntityHandle& handle) const
+{
+	return mEntities.GetOwner(handle);
+}
+
+uint32_t GameWorld::GetEntityCount() const
+{
+	return mEntities.GetEntityCount();
+}
+
+const TransformHierarchy& GameWorld::GetTransformHierarchy() const
+{
+	return mTransformHierarchy;
 }
 
 void GameWorld::LoadLevel(const std::filesystem::path& levelFile)
 {
-	FILE* file = nullptr;
-	auto err = fopen_s(&file, levelFile.u8string().c_str(), "r");
-	ASSERT(err == 0 && file != nullptr, "GameWorld: failed to open %s.", levelFile.u8string().c_str());
+	LevelLoader levelLoader;
+	levelLoader.Read(levelFile);
+	levelLoader.InitializeWorld(*this);
+	while (levelLoader.CreateNext(*this))
+	{
+	}
+	levelLoader.Close();
+}
 
-	char readBuffer[65536];
-	rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
-	fclose(file);
+void GameWorld::LoadCookedLevel(const std::filesystem::path& cookedFile)
+{
+	ASSERT(cookedFile.extension() == CookedLevel::Extension, "GameWorld: %s is not a cooked level.", cookedFile.u8string().c_str());
+	LoadLevel(cookedFile);
+}
+
+void GameWorld::LoadLevelAsync(const std::filesystem::path& levelFile, float budgetMs)
+{
+	ASSERT(!mInitialized && mLevelLoader == nullptr, "GameWorld: levels load into a world that is not initialized.");
+	mLevelLoader = std::make_unique<LevelLoader>();
+	mLevelLoadBudgetMs = budgetMs;
+	LevelLoader* levelLoader = mLevelLoader.get();
+	mLevelRead = std::async(std::launch::async, [levelLoader, levelFile]()
+	{
+		levelLoader->Read(levelFile);
+	});
+}
+
+void GameWorld::SetLevelLoadBudget(float budgetMs)
+{
+	mLevelLoadBudgetMs = budgetMs;
+}
+
+bool GameWorld::IsLoading() const
+{
+	return mLevelLoader != nullptr;
+}
 
-	rapidjson::Document doc;
-	doc.ParseStream(readStream);
+void GameWorld::CaptureSnapshot(WorldSnapshot& snapshot, uint32_t frame) const
+{
+	std::vector<uint32_t>& state = snapshot.mState;
+	state.clear();
+	SnapshotWriter writer(state, WorldSnapshot::Version);
+	// the object count is patched in once the objects destroyed this frame have been skipped
+	writer.Write(0u);
+	writer.Write(WorldSnapshot::Version);
 
-	auto services = doc["Services"].GetObj();
-	for (auto& service : services)
+	// types are stored by name hash so they are found again whatever order modules registered in
+	// a type that was never registered can't be found again, it is left out and the rest of the world is still captured
+	std::vector<uint32_t> skippedServiceIds;
+	std::vector<uint32_t> skippedComponentIds;
+	auto skipType = [](std::vector<uint32_t>& skippedTypeIds, uint32_t typeId, const char* kind)
 	{
-		std::string serviceName = service.name.GetString();
-		Service* newService = nullptr;
-		if (serviceName == "CameraService")
+		if (std::find(skippedTypeIds.begin(), skippedTypeIds.end(), typeId) == skippedTypeIds.end())
 		{
-			newService = AddService<CameraService>();
+			skippedTypeIds.push_back(typeId);
+			LOG("GameWorld: %s type %u is not registered and is left out of the snapshot.", kind, typeId);
 		}
-		else if (serviceName == "RenderService")
+	};
+	std::vector<std::pair<const Service*, uint32_t>> services;
+	for (const auto& service : mServices)
+	{
+		const ServiceRegistration* registration = TypeRegistry::FindServiceByTypeId(service->GetTypeId());
+		if (registration == nullptr)
 		{
-			newService = AddService<RenderService>();
+			skipType(skippedServiceIds, service->GetTypeId(), "service");
+			continue;
 		}
-		else if (serviceName == "PhysicsService")
+		services.emplace_back(service.get(), HashTypeName(registration->name));
+	}
+
+	// the rest is records of [key, size, words] so the delta lines each one up with the baseline record of the same key
+	writer.Write(WorldRecordKey);
+	const uint32_t worldBlock = writer.BeginBlock();
+	// every generation so a handle to an object destroyed before the capture stays stale after the restore
+	writer.Write(mSlotCount);
+	for (uint32_t i = 0; i < mSlotCount; ++i)
+	{
+		writer.Write(GetSlot(i).generation);
+	}
+	// the free list in order so the restored world hands out the same slots next, pending destroys are freed as ProcessDestroyList would
+	uint32_t freeCount = static_cast<uint32_t>(mFreeSlots.size());
+	for (uint32_t index : mToBeDestroyed)
+	{
+		freeCount += (GetSlot(index).generation <= GameObjectHandle::MaxGeneration) ? 1 : 0;
+	}
+	writer.Write(freeCount);
+	for (uint32_t index : mFreeSlots)
+	{
+		writer.Write(index);
+	}
+	for (uint32_t index : mToBeDestroyed)
+	{
+		if (GetSlot(index).generation <= GameObjectHandle::MaxGeneration)
+		{
+			writer.Write(index);
+		}
+	}
+	writer.Write(static_cast<uint32_t>(services.size()));
+	writer.EndBlock(worldBlock);
+
+	for (const auto& [service, nameHash] : services)
+	{
+		writer.Write(nameHash);
+		const uint32_t block = writer.BeginBlock();
+		service->SaveState(writer);
+		writer.EndBlock(block);
+	}
+
+	// an object's record is keyed by its handle, so objects spawned or destroyed since the baseline only change their own records
+	uint32_t objectCount = 0;
+	for (const GameObject* gameObject : mLiveObjects)
+	{
+		if (!IsValid(gameObject->mHandle))
 		{
-			newService = AddService<PhysicsService>();
+			continue;
 		}
-		else if (serviceName == "UIRenderService")
+		++objectCount;
+		writer.Write(gameObject->mHandle.mValue);
+		const uint32_t objectBlock = writer.BeginBlock();
+		writer.Write((gameObject->mParent != nullptr) ? gameObject->mParent->mHandle.mValue : GameObjectHandle().mValue);
+		writer.Write(gameObject->mInitialized);
+		writer.Write(gameObject->mName);
+		writer.Write(static_cast<uint32_t>(gameObject->mChildren.size()));
+		for (const GameObject* child : gameObject->mChildren)
 		{
-			newService = AddService<UIRenderService>();
+			writer.Write(child->mHandle.mValue);
 		}
-		else
+		const std::size_t componentCountIndex = state.size();
+		writer.Write(0u);
+		uint32_t componentCount = 0;
+		for (const auto& component : gameObject->mComponents)
 		{
-			newService = TryAddService(serviceName, *this);
+			const ComponentRegistration* registration = TypeRegistry::FindComponentByTypeId(component->GetTypeId());
+			if (registration == nullptr)
+			{
+				skipType(skippedComponentIds, component->GetTypeId(), "component");
+				continue;
+			}
+			++componentCount;
+			writer.Write(HashTypeName(registration->name));
+			const uint32_t block = writer.BeginBlock();
+			component->SaveState(writer);
+			writer.EndBlock(block);
 		}
+		state[componentCountIndex] = componentCount;
+		writer.EndBlock(objectBlock);
+	}
+	state[0] = objectCount;
+	snapshot.mFrame = frame;
+}
+
+void GameWorld::RestoreSnapshot(const WorldSnapshot& snapshot)
+{
+	ASSERT(!mInitialized && mLevelLoader == nullptr, "GameWorld: snapshots restore into a world that is not initialized.");
+	const std::vector<uint32_t>& state = snapshot.mState;
+	const uint32_t version = snapshot.GetVersion();
+	ASSERT(version >= WorldSnapshot::MinVersion && version <= WorldSnapshot::Version, "GameWorld: snapshot version %u can't be restored.", version);
+	SnapshotReader reader(state.data(), state.size(), version);
+	const uint32_t objectCount = reader.ReadUInt();
+	reader.ReadUInt();
 
-		ASSERT(newService != nullptr, "GameWorld: failed to add service %s.", serviceName.c_str());
+	const uint32_t worldKey = reader.ReadUInt();
+	ASSERT(worldKey == WorldRecordKey, "GameWorld: snapshot does not start with the world record.");
+	SnapshotReader worldReader = reader.ReadBlock();
+	const uint32_t slotCount = worldReader.ReadUInt();
+	std::vector<uint32_t> generations(slotCount);
+	for (uint32_t& generation : generations)
+	{
+		worldReader.Read(generation);
+	}
+	std::vector<uint32_t> freeSlots(worldReader.ReadUInt());
+	for (uint32_t& index : freeSlots)
+	{
+		worldReader.Read(index);
 	}
+	const uint32_t serviceCount = worldReader.ReadUInt();
 
-	uint32_t capacity = static_cast<uint32_t>(doc["Capacity"].GetInt());
-	Initialize(capacity);
+	for (uint32_t i = 0; i < serviceCount; ++i)
+	{
+		const uint32_t nameHash = reader.ReadUInt();
+		const ServiceRegistration* registration = TypeRegistry::FindService(nameHash);
+		ASSERT(registration != nullptr, "GameWorld: snapshot service %08x is not registered.", nameHash);
+		SnapshotReader block = reader.ReadBlock();
+		if (registration != nullptr)
+		{
+			registration->make(*this)->LoadState(block);
+		}
+	}
 
-	auto gameObjects = doc["GameObjects"].GetObj();
-	for (auto& gameObject : gameObjects)
+	// the slots first, so every handle in the snapshot lines up before any object is made
+	Initialize(slotCount);
+	for (uint32_t i = 0; i < slotCount; ++i)
 	{
-		std::string name = gameObject.name.GetString();
-		std::string templateFile = gameObject.value["Template"].GetString();
-		GameObject* go = CreateGameObject(name, templateFile);
-		GameObjectFactory::OverrideDeserialize(gameObject.value, *go);
-		go->Initialize();
+		GetSlot(i).generation = generations[i];
 	}
+	mFreeSlots = std::move(freeSlots);
+
+	struct Links
+	{
+		GameObject* gameObject = nullptr;
+		GameObjectHandle parent;
+		uint32_t firstChild = 0;
+		uint32_t childCount = 0;
+		bool initialized = false;
+	};
+	std::vector<Links> links(objectCount);
+	std::vector<GameObjectHandle> children;
+	std::string name;
+	for (Links& objectLinks : links)
+	{
+		GameObjectHandle handle;
+		reader.Read(handle.mValue);
+		SnapshotReader objectReader = reader.ReadBlock();
+		objectReader.Read(objectLinks.parent.mValue);
+		objectReader.Read(objectLinks.initialized);
+		objectReader.Read(name);
+		objectLinks.firstChild = static_cast<uint32_t>(children.size());
+		objectLinks.childCount = objectReader.ReadUInt();
+		for (uint32_t c = 0; c < objectLinks.childCount; ++c)
+		{
+			objectReader.Read(children.emplace_back().mValue);
+		}
+		if (!reader.IsValid() || !objectReader.IsValid())
+		{
+			break;
+		}
+		ASSERT(handle.GetIndex() < slotCount && GetSlot(handle.GetIndex()).gameObject == nullptr, "GameWorld: snapshot has an invalid handle.");
+		mLiveObjects.push_back(nullptr);
+		GameObject* gameObject = CreateInSlot(name, handle.GetIndex(), static_cast<uint32_t>(mLiveObjects.size() - 1));
+		objectLinks.gameObject = gameObject;
+
+		const uint32_t componentCount = objectReader.ReadUInt();
+		for (uint32_t c = 0; c < componentCount; ++c)
+		{
+			const uint32_t nameHash = objectReader.ReadUInt();
+			const ComponentRegistration* registration = TypeRegistry::FindComponent(nameHash);
+			ASSERT(registration != nullptr, "GameWorld: snapshot component %08x is not registered.", nameHash);
+			SnapshotReader block = objectReader.ReadBlock();
+			if (registration != nullptr)
+			{
+				registration->make(*gameObject)->LoadState(block);
+			}
+		}
+	}
+	ASSERT(reader.IsValid() && reader.IsAtEnd(), "GameWorld: snapshot is truncated.");
+
+	// links once every object exists, then initialize in live order, an object a parent already initialized is skipped
+	for (const Links& objectLinks : links)
+	{
+		if (objectLinks.gameObject == nullptr)
+		{
+			continue;
+		}
+		objectLinks.gameObject->mParent = GetGameObject(objectLinks.parent);
+		for (uint32_t c = objectLinks.firstChild; c < objectLinks.firstChild + objectLinks.childCount; ++c)
+		{
+			GameObject* child = GetGameObject(children[c]);
+			if (child != nullptr)
+			{
+				objectLinks.gameObject->mChildren.push_back(child);
+			}
+		}
+	}
+	for (const Links& objectLinks : links)
+	{
+		if (objectLinks.gameObject != nullptr && objectLinks.initialized && !objectLinks.gameObject->mInitialized)
+		{
+			objectLinks.gameObject->Initialize();
+		}
+	}
+	mScheduleDirty = true;
+	mTransformHierarchyDirty = true;
+}
+
+void GameWorld::SetTickView(const TickView& tickView)
+{
+	mScheduler.SetTickView(tickView);
+}
+
+const TickView& GameWorld::GetTickView() const
+{
+	return mScheduler.GetTickView();
+}
+
+uint32_t GameWorld::GetUpdateWorkCount(UpdatePhase phase) const
+{
+	return mScheduler.GetWorkCount(phase);
+}
+
+UpdateProfiler& GameWorld::GetUpdateProfiler()
+{
+	return mProfiler;
+}
+
+const UpdateProfiler& GameWorld::GetUpdateProfiler() const
+{
+	return mProfiler;
 }
 
-bool GameWorld::IsValid(const GameObjectHandle& handle)
+bool GameWorld::IsValid(const GameObjectHandle& handle) const
 {
-	if (handle.mIndex < 0 || handle.mIndex >= mGameObjectSlots.size())
+	const uint32_t index = handle.GetIndex();
+	if (index >= mSlotCount)
 	{
 		return false;
 	}
-	if (mGameObjectSlots[handle.mIndex].generation != handle.mGeneration)
+	// the slot generation keeps counting past MaxGeneration, so a retired slot never matches any handle
+	return GetSlot(index).generation == handle.GetGeneration();
+}
+
+GameObject* GameWorld::CreateInSlot(std::string name, uint32_t index, uint32_t liveIndex)
+{
+	Slot& slot = GetSlot(index);
+	slot.gameObject = std::make_unique<GameObject>();
+	slot.gameObject->SetName(name);
+	slot.gameObject->mHandle = GameObjectHandle(index, slot.generation);
+	slot.gameObject->mWorld = this;
+	slot.liveIndex = liveIndex;
+	mLiveObjects[liveIndex] = slot.gameObject.get();
+	return slot.gameObject.get();
+}
+
+bool GameWorld::TakeFreeSlot(uint32_t& index)
+{
+	if (mFreeSlots.empty())
 	{
-		return false;
+		if (mSlotCount > GameObjectHandle::MaxIndex)
+		{
+			ASSERT(false, "GameWorld: no free slots available.");
+			return false;
+		}
+		AddSlotChunk();
 	}
+	index = mFreeSlots.back();
+	mFreeSlots.pop_back();
 	return true;
 }
 
+GameWorld::Slot& GameWorld::GetSlot(uint32_t index)
+{
+	return mSlotChunks[index >> SlotChunkBits][index & (SlotChunkSize - 1)];
+}
+
+const GameWorld::Slot& GameWorld::GetSlot(uint32_t index) const
+{
+	return mSlotChunks[index >> SlotChunkBits][index & (SlotChunkSize - 1)];
+}
+
+void GameWorld::AddSlotChunk()
+{
+	const uint32_t firstIndex = mSlotCount;
+	const uint32_t count = std::min(SlotChunkSize, GameObjectHandle::MaxIndex + 1 - firstIndex);
+	mSlotChunks.push_back(std::make_unique<Slot[]>(SlotChunkSize));
+	mSlotCount += count;
+	// handed out from the back, so the lowest slots are used first
+	for (uint32_t i = mSlotCount; i > firstIndex; --i)
+	{
+		mFreeSlots.push_back(i - 1);
+	}
+}
+
+Service* GameWorld::AddServiceByName(const std::string& serviceName)
+{
+	const ServiceRegistration* registration = TypeRegistry::FindService(serviceName);
+	Service* newService = (registration != nullptr) ? registration->make(*this) : nullptr;
+	ASSERT(newService != nullptr, "GameWorld: failed to add service %s.", serviceName.c_str());
+	return newService;
+}
+
+uint32_t GameWorld::GetServiceSlot(uint32_t typeId)
+{
+	if (typeId < EngineServiceCount)
+	{
+		return typeId;
+	}
+
+	std::lock_guard<std::mutex> lock(sServiceSlotMutex);
+	auto iter = sCustomServiceSlots.find(typeId);
+	if (iter != sCustomServiceSlots.end())
+	{
+		return iter->second;
+	}
+	const uint32_t slot = EngineServiceCount + static_cast<uint32_t>(sCustomServiceSlots.size());
+	sCustomServiceSlots.emplace(typeId, slot);
+	return slot;
+}
+
+void GameWorld::SetServiceSlot(uint32_t slot, Service* service)
+{
+	Service** serviceSlot = nullptr;
+	if (slot < EngineServiceCount)
+	{
+		serviceSlot = &mEngineServices[slot];
+	}
+	else
+	{
+		const uint32_t customIndex = slot - EngineServiceCount;
+		if (customIndex >= mCustomServices.size())
+		{
+			mCustomServices.resize(customIndex + 1, nullptr);
+		}
+		serviceSlot = &mCustomServices[customIndex];
+	}
+	ASSERT(*serviceSlot == nullptr, "GameWorld: a service of type %u was already added.", service->GetTypeId());
+	*serviceSlot = service;
+
+	switch (static_cast<ServiceId>(slot))
+	{
+	case ServiceId::Camera: mCameraService = static_cast<CameraService*>(service); break;
+	case ServiceId::Render: mRenderService = static_cast<RenderService*>(service); break;
+	case ServiceId::Physics: mPhysicsService = static_cast<PhysicsService*>(service); break;
+	case ServiceId::UIRender: mUIRenderService = static_cast<UIRenderService*>(service); break;
+	case ServiceId::Spatial: mSpatialService = static_cast<SpatialService*>(service); break;
+	default: break;
+	}
+}
+
 void GameWorld::ProcessDestroyList()
 {
 	for (uint32_t index : mToBeDestroyed)
 	{
-		Slot& slot = mGameObjectSlots[index];
+		Slot& slot = GetSlot(index);
 		GameObject* gameObject = slot.gameObject.get();
 		ASSERT(!IsValid(gameObject->GetHandle()), "GameWorld: gameObjects is still alive.");
 
 		gameObject->Terminate();
+		mEntities.Destroy(gameObject->mEntity);
+
+		GameObject* movedObject = mLiveObjects.back();
+		mLiveObjects[slot.liveIndex] = movedObject;
+		GetSlot(movedObject->mHandle.GetIndex()).liveIndex = slot.liveIndex;
+		mLiveObjects.pop_back();
+
 		slot.gameObject.reset();
-		mFreeSlots.push_back(index);
+		if (slot.generation <= GameObjectHandle::MaxGeneration)
+		{
+			mFreeSlots.push_back(index);
+		}
+	}
+	if (!mToBeDestroyed.empty())
+	{
+		mScheduleDirty = true;
+		mTransformHierarchyDirty = true;
 	}
 	mToBeDestroyed.clear();
+}
+
+void GameWorld::BuildSchedule()
+{
+	// objects in live list order and components in the order they were added, so the schedule only changes when objects come or go
+	mScheduler.Clear();
+	for (GameObject* gameObject : mLiveObjects)
+	{
+		if (gameObject->mInitialized)
+		{
+			for (auto& component : gameObject->mComponents)
+			{
+				mScheduler.AddComponent(component.get(), GameObject::GetComponentSlot(component->GetTypeId()));
+			}
+		}
+	}
+	for (auto& service : mServices)
+	{
+		mScheduler.AddService(service.get());
+	}
+	mScheduler.Build(&mProfiler);
+	mScheduleDirty = false;
+}
+
+void GameWorld::BuildTransformHierarchy()
+{
+	mTransformHierarchy.Clear();
+	for (GameObject* gameObject : mLiveObjects)
+	{
+		if (!gameObject->mInitialized)
+		{
+			continue;
+		}
+		TransformComponent* transform = gameObject->GetComponent<TransformComponent>();
+		if (transform == nullptr)
+		{
+			continue;
+		}
+		const TransformComponent* parentTransform = nullptr;
+		for (const GameObject* parent = gameObject->GetParent(); parent != nullptr && parentTransform == nullptr; parent = parent->GetParent())
+		{
+			parentTransform = parent->GetComponent<TransformComponent>();
+		}
+		mTransformHierarchy.Add(transform, parentTransform);
+	}
+	mTransformHierarchy.Build();
+	mTransformHierarchyDirty = false;
+}
+
+void GameWorld::RefreshTransformHierarchy()
+{
+	if (mTransformHierarchyDirty)
+	{
+		BuildTransformHierarchy();
+	}
+	else
+	{
+		mTransformHierarchy.Update();
+	}
+}
+
+void GameWorld::UpdateLevelLoad()
+{
+	if (!mInitialized)
+	{
+		if (mLevelRead.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			return;
+		}
+		mLevelRead.get();
+		mLevelLoader->InitializeWorld(*this);
+	}
+
+	// always at least one object, so an object slower than the budget can't stall the load
+	const auto start = std::chrono::steady_clock::now();
+	const std::chrono::duration<float, std::milli> budget(mLevelLoadBudgetMs);
+	bool created = mLevelLoader->CreateNext(*this);
+	while (created && std::chrono::steady_clock::now() - start < budget)
+	{
+		created = mLevelLoader->CreateNext(*this);
+	}
+
+	const uint32_t loadedCount = mLevelLoader->GetCreatedCount();
+	const uint32_t totalCount = mLevelLoader->GetObjectCount();
+	const bool isDone = (loadedCount == totalCount);
+	if (isDone)
+	{
+		mLevelLoader->Close();
+		mLevelLoader.reset();
+	}
+	Core::EventManager::Broadcast(LevelLoadProgressEvent(loadedCount, totalCount, isDone));
 }
\ No newline at end of file
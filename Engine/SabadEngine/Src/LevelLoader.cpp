@@ -0,0 +1,169 @@
+#include "Precompiled.h"
+#include "LevelLoader.h"
+#include "GameWorld.h"
+#include "GameObjectFactory.h"
+#include "TypeRegistry.h"
+
+using namespace SabadEngine;
+
+void LevelLoader::Read(const std::filesystem::path& levelFile)
+{
+	mCreatedCount = 0;
+	mCooked = (levelFile.extension() == CookedLevel::Extension);
+	if (mCooked)
+	{
+		ReadCookedLevel(levelFile);
+	}
+	else
+	{
+		ReadLevel(levelFile);
+	}
+}
+
+void LevelLoader::Close()
+{
+	mServiceNames.clear();
+	mServiceValues.clear();
+	mLevelObjects.clear();
+	mLevelObjectNames.clear();
+	mComponentValues.clear();
+	mRegistrations.clear();
+	rapidjson::Document().Swap(mDocument);
+	mFile.Close();
+	mCooked = false;
+	mCapacity = 0;
+	mCreatedCount = 0;
+}
+
+void LevelLoader::InitializeWorld(GameWorld& gameWorld)
+{
+	for (std::size_t i = 0; i < mServiceNames.size(); ++i)
+	{
+		Service* service = gameWorld.AddServiceByName(mServiceNames[i]);
+		service->Deserialize(mServiceValues[i]);
+	}
+	gameWorld.Initialize(mCapacity);
+}
+
+bool LevelLoader::CreateNext(GameWorld& gameWorld)
+{
+	if (mCreatedCount >= GetObjectCount())
+	{
+		return false;
+	}
+	if (mCooked)
+	{
+		CreateCookedObject(gameWorld, mCreatedCount);
+	}
+	else
+	{
+		CreateLevelObject(gameWorld, mCreatedCount);
+	}
+	++mCreatedCount;
+	return true;
+}
+
+uint32_t LevelLoader::GetObjectCount() const
+{
+	return mCooked ? mReader.GetHeader().objectCount : static_cast<uint32_t>(mLevelObjects.size());
+}
+
+uint32_t LevelLoader::GetCreatedCount() const
+{
+	return mCreatedCount;
+}
+
+void LevelLoader::ReadLevel(const std::filesystem::path& levelFile)
+{
+	FILE* file = nullptr;
+	auto err = fopen_s(&file, levelFile.u8string().c_str(), "r");
+	ASSERT(err == 0 && file != nullptr, "LevelLoader: failed to open %s.", levelFile.u8string().c_str());
+
+	char readBuffer[65536];
+	rapidjson::FileReadStream readStream(file, readBuffer, sizeof(readBuffer));
+	mDocument.ParseStream(readStream);
+	fclose(file);
+
+	auto services = mDocument["Services"].GetObj();
+	for (auto& service : services)
+	{
+		mServiceNames.push_back(service.name.GetString());
+		mServiceValues.emplace_back(service.value, mDocument.GetAllocator());
+	}
+	mCapacity = static_cast<uint32_t>(mDocument["Capacity"].GetInt());
+
+	// every template is parsed here so creating the objects never waits on a file
+	auto gameObjects = mDocument["GameObjects"].GetObj();
+	for (auto& gameObject : gameObjects)
+	{
+		mLevelObjectNames.push_back(gameObject.name.GetString());
+		mLevelObjects.push_back(&gameObject.value);
+		GameObjectFactory::PreloadTemplate(gameObject.value["Template"].GetString());
+	}
+}
+
+void LevelLoader::ReadCookedLevel(const std::filesystem::path& cookedFile)
+{
+	const bool opened = mFile.Open(cookedFile);
+	ASSERT(opened, "LevelLoader: failed to open %s.", cookedFile.u8string().c_str());
+	const bool valid = mReader.Open(mFile.GetData(), mFile.GetSize());
+	ASSERT(valid, "LevelLoader: %s is not a cooked level of this version, cook it again.", cookedFile.u8string().c_str());
+	const CookedLevel::Header& header = mReader.GetHeader();
+
+	for (uint32_t i = 0; i < header.serviceCount; ++i)
+	{
+		const CookedLevel::ServiceRecord& service = mReader.GetServiceRecord(i);
+		mServiceNames.emplace_back(mReader.GetString(service.name));
+		mServiceValues.push_back(mReader.MakeValue(service.value, mDocument.GetAllocator()));
+	}
+	mCapacity = header.capacity;
+
+	// every component record is built into a value once, the template ones are shared by all objects made from them
+	mComponentValues.reserve(header.componentCount);
+	for (uint32_t i = 0; i < header.componentCount; ++i)
+	{
+		mComponentValues.push_back(mReader.MakeValue(mReader.GetComponentRecord(i).value, mDocument.GetAllocator()));
+	}
+	mRegistrations.resize(header.stringCount, nullptr);
+}
+
+void LevelLoader::CreateLevelObject(GameWorld& gameWorld, uint32_t index)
+{
+	const rapidjson::Value& value = *mLevelObjects[index];
+	GameObject* go = gameWorld.CreateGameObject(mLevelObjectNames[index], value["Template"].GetString());
+	GameObjectFactory::OverrideDeserialize(value, *go);
+	go->Initialize();
+}
+
+void LevelLoader::CreateCookedObject(GameWorld& gameWorld, uint32_t index)
+{
+	const CookedLevel::ObjectRecord& object = mReader.GetObjectRecord(index);
+	const CookedLevel::TemplateRecord& objectTemplate = mReader.GetTemplateRecord(object.templateIndex);
+	GameObject* go = gameWorld.CreateGameObject(std::string(mReader.GetString(object.name)));
+	for (uint32_t c = objectTemplate.firstComponent; c < objectTemplate.firstComponent + objectTemplate.componentCount; ++c)
+	{
+		const ComponentRegistration& registration = GetRegistration(c);
+		registration.deserialize(*registration.make(*go), mComponentValues[c]);
+	}
+	for (uint32_t c = object.firstOverride; c < object.firstOverride + object.overrideCount; ++c)
+	{
+		const ComponentRegistration& registration = GetRegistration(c);
+		Component* component = registration.get(*go);
+		ASSERT(component != nullptr, "LevelLoader: override for missing component %s.", registration.name.c_str());
+		registration.deserialize(*component, mComponentValues[c]);
+	}
+	go->Initialize();
+}
+
+const ComponentRegistration& LevelLoader::GetRegistration(uint32_t componentIndex)
+{
+	// each type name is looked up once per load, the string index stands in for the type after that
+	const uint32_t type = mReader.GetComponentRecord(componentIndex).type;
+	ASSERT(type < mRegistrations.size(), "LevelLoader: component %u has an invalid type %u.", componentIndex, type);
+	if (mRegistrations[type] == nullptr)
+	{
+		mRegistrations[type] = TypeRegistry::FindComponent(mReader.GetString(type));
+		ASSERT(mRegistrations[type] != nullptr, "LevelLoader: component type [%s] not found.", std::string(mReader.GetString(type)).c_str());
+	}
+	return *mRegistrations[type];
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Precompiled.h"
 #include "MeshComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 
@@ -18,32 +19,27 @@ void MeshComponent::Deserialize(const rapidjson::Value& value)
         const auto& shapeData = value["Shape"].GetObj();
         if (shapeData.HasMember("Type"))
         {
-            std::string shapeType = shapeData["Type"].GetString();
-            if (shapeType == "Sphere")
+            MeshShape& shape = mShapes.emplace_back();
+            shape.type = shapeData["Type"].GetString();
+            if (shape.type == "Sphere")
             {
-                uint32_t slices = static_cast<uint32_t>(shapeData["Slices"].GetInt());
-                uint32_t rings = static_cast<uint32_t>(shapeData["Rings"].GetInt());
+                shape.slices = static_cast<uint32_t>(shapeData["Slices"].GetInt());
+                shape.rings = static_cast<uint32_t>(shapeData["Rings"].GetInt());
                 uint32_t radius = shapeData["Radius"].GetFloat();
-                meshData.mesh = Graphics::MeshBuilder::CreateSphere(slices, rings, radius);
+                shape.size = static_cast<float>(radius);
             }
-            else if (shapeType == "Plane")
+            else if (shape.type == "Plane")
             {
-                uint32_t rows = static_cast<uint32_t>(shapeData["Rows"].GetInt());
-                uint32_t columns = static_cast<uint32_t>(shapeData["Columns"].GetInt());
-                float spacing = shapeData["Spacing"].GetFloat();
-                bool horizontal = true;
-                SaveUtil::ReadBool("Vertical", horizontal, shapeData);
-                meshData.mesh = Graphics::MeshBuilder::CreatePlane(rows, columns, spacing, horizontal);
+                shape.slices = static_cast<uint32_t>(shapeData["Rows"].GetInt());
+                shape.rings = static_cast<uint32_t>(shapeData["Columns"].GetInt());
+                shape.size = shapeData["Spacing"].GetFloat();
+                SaveUtil::ReadBool("Vertical", shape.horizontal, shapeData);
             }
-            else if (shapeType == "Cube")
+            else if (shape.type == "Cube")
             {
-                float size = shapeData["Size"].GetFloat();
-                meshData.mesh = Graphics::MeshBuilder::CreateCube(size);
-            }
-            else
-            {
-                ASSERT(false, "MeshComponent: Unrecognised Shape Type %s!", shapeType.c_str());
+                shape.size = shapeData["Size"].GetFloat();
             }
+            meshData.mesh = BuildMesh(shape);
         }
         else
         {
@@ -69,7 +65,84 @@ void MeshComponent::Deserialize(const rapidjson::Value& value)
     }
 }
 
+void MeshComponent::SaveState(SnapshotWriter& writer) const
+{
+    RenderObjectComponent::SaveState(writer);
+    writer.Write(static_cast<uint32_t>(mShapes.size()));
+    for (std::size_t i = 0; i < mShapes.size(); ++i)
+    {
+        const MeshShape& shape = mShapes[i];
+        writer.Write(shape.type);
+        writer.Write(shape.slices);
+        writer.Write(shape.rings);
+        writer.Write(shape.size);
+        writer.Write(shape.horizontal);
+
+        const Graphics::Model::MaterialData& matData = mMeshModel.materialData[i];
+        writer.Write(mMeshModel.meshData[i].materialIndex);
+        writer.Write(matData.material.emissive);
+        writer.Write(matData.material.ambient);
+        writer.Write(matData.material.diffuse);
+        writer.Write(matData.material.specular);
+        writer.Write(matData.material.shininess);
+        writer.Write(matData.diffuseMapName);
+        writer.Write(matData.normalMapName);
+        writer.Write(matData.specMapName);
+        writer.Write(matData.bumpMapName);
+    }
+}
+
+void MeshComponent::LoadState(SnapshotReader& reader)
+{
+    RenderObjectComponent::LoadState(reader);
+    mShapes.clear();
+    mMeshModel.meshData.clear();
+    mMeshModel.materialData.clear();
+    const uint32_t meshCount = reader.ReadUInt();
+    for (uint32_t i = 0; i < meshCount && reader.IsValid(); ++i)
+    {
+        MeshShape& shape = mShapes.emplace_back();
+        reader.Read(shape.type);
+        reader.Read(shape.slices);
+        reader.Read(shape.rings);
+        reader.Read(shape.size);
+        reader.Read(shape.horizontal);
+
+        Graphics::Model::MeshData& meshData = mMeshModel.meshData.emplace_back();
+        Graphics::Model::MaterialData& matData = mMeshModel.materialData.emplace_back();
+        reader.Read(meshData.materialIndex);
+        reader.Read(matData.material.emissive);
+        reader.Read(matData.material.ambient);
+        reader.Read(matData.material.diffuse);
+        reader.Read(matData.material.specular);
+        reader.Read(matData.material.shininess);
+        reader.Read(matData.diffuseMapName);
+        reader.Read(matData.normalMapName);
+        reader.Read(matData.specMapName);
+        reader.Read(matData.bumpMapName);
+        meshData.mesh = BuildMesh(shape);
+    }
+}
+
 const Graphics::Model& MeshComponent::GetModel() const
 {
     return mMeshModel;
+}
+
+Graphics::Mesh MeshComponent::BuildMesh(const MeshShape& shape)
+{
+    if (shape.type == "Sphere")
+    {
+        return Graphics::MeshBuilder::CreateSphere(shape.slices, shape.rings, shape.size);
+    }
+    if (shape.type == "Plane")
+    {
+        return Graphics::MeshBuilder::CreatePlane(shape.slices, shape.rings, shape.size, shape.horizontal);
+    }
+    if (shape.type == "Cube")
+    {
+        return Graphics::MeshBuilder::CreateCube(shape.size);
+    }
+    ASSERT(false, "MeshComponent: Unrecognised Shape Type %s!", shape.type.c_str());
+    return {};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Precompiled.h"
 #include "ModelComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 
@@ -35,6 +36,29 @@ void ModelComponent::Deserialize(const rapidjson::Value& value)
 	SaveUtil::ReadStringArray("Animations", mAnimations, value);
 }
 
+void ModelComponent::SaveState(SnapshotWriter& writer) const
+{
+	RenderObjectComponent::SaveState(writer);
+	writer.Write(mFileName);
+	writer.Write(static_cast<uint32_t>(mAnimations.size()));
+	for (const std::string& animation : mAnimations)
+	{
+		writer.Write(animation);
+	}
+}
+
+void ModelComponent::LoadState(SnapshotReader& reader)
+{
+	RenderObjectComponent::LoadState(reader);
+	reader.Read(mFileName);
+	mAnimations.clear();
+	const uint32_t animationCount = reader.ReadUInt();
+	for (uint32_t i = 0; i < animationCount && reader.IsValid(); ++i)
+	{
+		reader.Read(mAnimations.emplace_back());
+	}
+}
+
 Graphics::ModelId ModelComponent::GetModelId() const
 {
 	return mModelId;
@@ -1,6 +1,8 @@
 #include "Precompiled.h"
 #include "PhysicsService.h"
 #include "RigidBodyComponent.h"
+#include "TriggerComponent.h"
+#include "GameObject.h"
 #include "SaveUtil.h"
 
 using namespace SabadEngine;
@@ -9,7 +11,10 @@ void PhysicsService::Update(float deltaTime)
 {
 	if (mEnabled)
 	{
-		Physics::PhysicsWorld::Get()->Update(deltaTime);
+		Physics::PhysicsWorld* physicsWorld = Physics::PhysicsWorld::Get();
+		const std::size_t endedCount = physicsWorld->GetPendingContactEvents().size();
+		physicsWorld->Update(deltaTime);
+		BroadcastContacts(endedCount);
 	}
 }
 
@@ -18,6 +23,7 @@ void PhysicsService::DebugUI()
 	if (mEnabled)
 	{
 		Physics::PhysicsWorld::Get()->DebugUI();
+		Physics::CollisionShapeCache::Get()->DebugUI();
 	}
 }
 
@@ -35,14 +41,73 @@ void PhysicsService::Deserialize(const rapidjson::Value& value)
 void PhysicsService::Register(RigidBodyComponent* rigidBodyComponent)
 {
 	Physics::PhysicsWorld::Get()->Register(&rigidBodyComponent->mRigidBody);
+	mObjectHandles[&rigidBodyComponent->mRigidBody] = rigidBodyComponent->GetOwner().GetHandle();
 }
 
 void PhysicsService::Unregister(RigidBodyComponent* rigidBodyComponent)
 {
-	Physics::PhysicsWorld::Get()->Unregister(&rigidBodyComponent->mRigidBody);
+	UnregisterObject(&rigidBodyComponent->mRigidBody);
+}
+
+void PhysicsService::Register(TriggerComponent* triggerComponent)
+{
+	Physics::PhysicsWorld::Get()->Register(&triggerComponent->mTriggerVolume);
+	mObjectHandles[&triggerComponent->mTriggerVolume] = triggerComponent->GetOwner().GetHandle();
+}
+
+void PhysicsService::Unregister(TriggerComponent* triggerComponent)
+{
+	UnregisterObject(&triggerComponent->mTriggerVolume);
 }
 
 void PhysicsService::SetEnabled(bool enabled)
 {
 	mEnabled = enabled;
+}
+
+void PhysicsService::UnregisterObject(Physics::PhysicsObject* physicsObject)
+{
+	// the pairs it leaves are looked up now, while both handles are known and its address can't be reused yet
+	Physics::PhysicsWorld* physicsWorld = Physics::PhysicsWorld::Get();
+	const std::size_t firstEnded = physicsWorld->GetPendingContactEvents().size();
+	physicsWorld->Unregister(physicsObject);
+	const std::vector<Physics::ContactEvent>& pendingEvents = physicsWorld->GetPendingContactEvents();
+	for (std::size_t i = firstEnded; i < pendingEvents.size(); ++i)
+	{
+		AddContactPair(pendingEvents[i], mEndedPairs);
+	}
+	mObjectHandles.erase(physicsObject);
+}
+
+void PhysicsService::AddContactPair(const Physics::ContactEvent& contactEvent, std::vector<PhysicsContactPair>& contactPairs) const
+{
+	// objects that are not owned by a component (pooled bodies, debug objects) are left out
+	auto handleA = mObjectHandles.find(contactEvent.objectA);
+	auto handleB = mObjectHandles.find(contactEvent.objectB);
+	if (handleA != mObjectHandles.end() && handleB != mObjectHandles.end())
+	{
+		PhysicsContactPair& pair = contactPairs.emplace_back();
+		pair.objectA = handleA->second;
+		pair.objectB = handleB->second;
+		pair.type = contactEvent.type;
+	}
+}
+
+void PhysicsService::BroadcastContacts(std::size_t endedCount)
+{
+	mContactPairs.clear();
+	std::swap(mContactPairs, mEndedPairs);
+	const std::vector<Physics::ContactEvent>& contactEvents = Physics::PhysicsWorld::Get()->GetContactEvents();
+	for (std::size_t i = endedCount; i < contactEvents.size(); ++i)
+	{
+		AddContactPair(contactEvents[i], mContactPairs);
+	}
+
+	if (!mContactPairs.empty())
+	{
+		// the pairs are lent to the event and taken back afterwards, so their buffer is reused every update
+		PhysicsContactEvent contactEvent(std::move(mContactPairs));
+		Core::EventManager::Broadcast(contactEvent);
+		mContactPairs = std::move(contactEvent.pairs);
+	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Precompiled.h"
 #include "RenderObjectComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 #include "GameWorld.h"
 #include "GameObject.h"
 #include "RenderService.h"
@@ -9,7 +10,7 @@ using namespace SabadEngine;
 
 void RenderObjectComponent::Initialize()
 {
-    RenderService* renderService = GetOwner().GetWorld().GetService<RenderService>();
+    RenderService* renderService = GetOwner().GetWorld().GetRenderService();
     if (renderService != nullptr)
     {
         renderService->Register(this);
@@ -18,7 +19,7 @@ void RenderObjectComponent::Initialize()
 
 void RenderObjectComponent::Terminate()
 {
-    RenderService* renderService = GetOwner().GetWorld().GetService<RenderService>();
+    RenderService* renderService = GetOwner().GetWorld().GetRenderService();
     if (renderService != nullptr)
     {
         renderService->Unregister(this);
@@ -30,6 +31,16 @@ void RenderObjectComponent::Deserialize(const rapidjson::Value& value)
     SaveUtil::ReadBool("CastShadow", mCastShadow, value);
 }
 
+void RenderObjectComponent::SaveState(SnapshotWriter& writer) const
+{
+    writer.Write(mCastShadow);
+}
+
+void RenderObjectComponent::LoadState(SnapshotReader& reader)
+{
+    reader.Read(mCastShadow);
+}
+
 bool RenderObjectComponent::CanCastShadow() const
 {
     return mCastShadow;
@@ -12,7 +12,7 @@ using namespace SabadEngine;
 
 void RenderService::Initialize()
 {
-	mCameraService = GetWorld().GetService<CameraService>();
+	mCameraService = GetWorld().GetCameraService();
 
 	std::filesystem::path shaderFile = L"../../Assets/Shaders/Standard.fx";
 	mStandardEffect.Initialize(shaderFile);
@@ -39,9 +39,10 @@ void RenderService::Render()
 {
 	const Graphics::Camera& camera = mCameraService->GetMain();
 	mStandardEffect.SetCamera(camera);
+	// world matrices come from the transform hierarchy, both passes share them
 	for (Entry& entry : mRenderEntries)
 	{
-		entry.renderGroup.transform = *entry.transformComponent;
+		entry.worldMatrix = entry.transformComponent->GetWorldMatrix();
 	}
 
 	mShadowEffect.Begin();
@@ -49,7 +50,7 @@ void RenderService::Render()
 	{
 		if (entry.renderComponent->CanCastShadow())
 		{
-			mShadowEffect.Render(entry.renderGroup);
+			mShadowEffect.Render(entry.renderGroup, entry.worldMatrix);
 		}
 	}
 	mShadowEffect.End();
@@ -57,7 +58,7 @@ void RenderService::Render()
 	mStandardEffect.Begin();
 	for (Entry& entry : mRenderEntries)
 	{
-		mStandardEffect.Render(entry.renderGroup);
+		mStandardEffect.Render(entry.renderGroup, entry.worldMatrix);
 	}
 	mStandardEffect.End();
 }
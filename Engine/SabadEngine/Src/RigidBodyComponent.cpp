@@ -1,34 +1,46 @@
 #include "Precompiled.h"
 #include "RigidBodyComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 #include "GameObject.h"
 #include "TransformComponent.h"
 #include "PhysicsService.h"
 #include "GameWorld.h"
 
 using namespace SabadEngine;
+using namespace SabadEngine::Physics;
 
 void RigidBodyComponent::Initialize()
 {
-	PhysicsService* physicsService = GetOwner().GetWorld().GetService<PhysicsService>();
+	PhysicsService* physicsService = GetOwner().GetWorld().GetPhysicsService();
 	if (physicsService != nullptr)
 	{
+		const CollisionShape* collisionShape = CollisionShapeCache::Get()->GetShape(mCollisionShapeId);
+		ASSERT(collisionShape != nullptr, "RigidBodyComponent: Requires shape data!");
 		TransformComponent* transformComponent = GetOwner().GetComponent<TransformComponent>();
-		mRigidBody.Initialize(*transformComponent, mCollisionShape, mMass, false);
+		mRigidBody.Initialize(*transformComponent, *collisionShape, mMass, false);
+		// only a body that was moving is woken up, a resting one stays asleep
+		if (mRigidBody.IsDynamic() && (Math::MagnitudeSqr(mLoadedVelocity) > 0.0f || Math::MagnitudeSqr(mLoadedAngularVelocity) > 0.0f))
+		{
+			mRigidBody.SetVelocity(mLoadedVelocity);
+			mRigidBody.SetAngularVelocity(mLoadedAngularVelocity);
+		}
+		mLoadedVelocity = Math::Vector3::Zero;
+		mLoadedAngularVelocity = Math::Vector3::Zero;
 		physicsService->Register(this);
 	}
 }
 
 void RigidBodyComponent::Terminate()
 {
-	PhysicsService* physicsService = GetOwner().GetWorld().GetService<PhysicsService>();
+	PhysicsService* physicsService = GetOwner().GetWorld().GetPhysicsService();
 	if (physicsService != nullptr)
 	{
 		physicsService->Unregister(this);
 	}
 
 	mRigidBody.Terminate();
-	mCollisionShape.Terminate();
+	SetCollisionShape(0);
 }
 
 void RigidBodyComponent::Deserialize(const rapidjson::Value& value)
@@ -36,50 +48,37 @@ void RigidBodyComponent::Deserialize(const rapidjson::Value& value)
 	SaveUtil::ReadFloat("Mass", mMass, value);
 	if (value.HasMember("ColliderData"))
 	{
-		mCollisionShape.Terminate();
-		auto colliderData = value["ColliderData"].GetObj();
-		if (colliderData.HasMember("Shape"))
-		{
-			std::string shape = colliderData["Shape"].GetString();
-			if (shape == "Empty")
-			{
-				mCollisionShape.InitializeEmpty();
-			}
-			else if (shape == "Box")
-			{
-				const auto halfExtents = colliderData["HalfExtents"].GetArray();
-				const float x = halfExtents[0].GetFloat();
-				const float y = halfExtents[1].GetFloat();
-				const float z = halfExtents[2].GetFloat();
-				mCollisionShape.InitializeBox({ x, y, z });
-			}
-			else if (shape == "Sphere")
-			{
-				const float radius = colliderData["Radius"].GetFloat();
-				mCollisionShape.InitializeSphere(radius);
-			}
-			else if (shape == "Hull")
-			{
-				const auto halfExtents = colliderData["HalfExtents"].GetArray();
-				const float hx = halfExtents[0].GetFloat();
-				const float hy = halfExtents[1].GetFloat();
-				const float hz = halfExtents[2].GetFloat();
-				const auto origin = colliderData["Origin"].GetArray();
-				const float ox = origin[0].GetFloat();
-				const float oy = origin[1].GetFloat();
-				const float oz = origin[2].GetFloat();
-				mCollisionShape.InitializeHull({ hx, hy, hz }, { ox, oy, oz });
-			}
-			else
-			{
-				ASSERT(false, "RigidBodyComponent: Invalid shape type %s !", shape.c_str());
-			}
-		}
-		else
-		{
-			ASSERT(false, "RigidBodyComponent: Requires shape data!");
-		}
+		const auto colliderData = value["ColliderData"].GetObj();
+		const bool isHeightfield = colliderData.HasMember("Shape") && std::string(colliderData["Shape"].GetString()) == "Heightfield";
+		ASSERT(!isHeightfield || mMass <= 0.0f, "RigidBodyComponent: Heightfield colliders must be static (Mass 0)!");
+	}
+	CollisionShapeId shapeId = 0;
+	if (SaveUtil::ReadCollisionShape("ColliderData", shapeId, value))
+	{
+		SetCollisionShape(shapeId);
+	}
+}
+
+void RigidBodyComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mMass);
+	SaveUtil::SaveCollisionShape(writer, mCollisionShapeId);
+	// a body that was never added to a world has nothing moving yet
+	const bool isDynamic = mRigidBody.IsDynamic();
+	writer.Write(isDynamic ? mRigidBody.GetVelocity() : Math::Vector3::Zero);
+	writer.Write(isDynamic ? mRigidBody.GetAngularVelocity() : Math::Vector3::Zero);
+}
+
+void RigidBodyComponent::LoadState(SnapshotReader& reader)
+{
+	reader.Read(mMass);
+	CollisionShapeId shapeId = 0;
+	if (SaveUtil::LoadCollisionShape(reader, shapeId))
+	{
+		SetCollisionShape(shapeId);
 	}
+	reader.Read(mLoadedVelocity);
+	reader.Read(mLoadedAngularVelocity);
 }
 
 void RigidBodyComponent::SetPosition(const Math::Vector3& position)
@@ -90,4 +89,39 @@ void RigidBodyComponent::SetPosition(const Math::Vector3& position)
 void RigidBodyComponent::SetVelocity(const Math::Vector3& velocity)
 {
 	mRigidBody.SetVelocity(velocity);
+}
+
+void RigidBodyComponent::SetAngularVelocity(const Math::Vector3& velocity)
+{
+	mRigidBody.SetAngularVelocity(velocity);
+}
+
+Math::Vector3 RigidBodyComponent::GetVelocity() const
+{
+	return mRigidBody.IsDynamic() ? mRigidBody.GetVelocity() : Math::Vector3::Zero;
+}
+
+Math::Vector3 RigidBodyComponent::GetAngularVelocity() const
+{
+	return mRigidBody.IsDynamic() ? mRigidBody.GetAngularVelocity() : Math::Vector3::Zero;
+}
+
+float RigidBodyComponent::GetMass() const
+{
+	return std::max(mMass, 0.0f);
+}
+
+bool RigidBodyComponent::IsDynamic() const
+{
+	return mRigidBody.IsDynamic();
+}
+
+void RigidBodyComponent::SetCollisionShape(CollisionShapeId shapeId)
+{
+	// acquire happens before the release so re-deserializing the same shape never frees it
+	if (mCollisionShapeId != 0)
+	{
+		CollisionShapeCache::Get()->Release(mCollisionShapeId);
+	}
+	mCollisionShapeId = shapeId;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Precompiled.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 
@@ -176,4 +177,158 @@ void SaveUtil::WriteStringArray(const char* key, const std::vector<std::string>&
         valueArray.PushBack(valueStr, doc.GetAllocator());
     }
     member.AddMember(keyStr, valueArray, doc.GetAllocator());
+}
+
+// Collision Shape --------------
+bool SaveUtil::ReadCollisionShape(const char* key, Physics::CollisionShapeId& shapeId, const rapidjson::Value& value)
+{
+    if (!value.HasMember(key))
+    {
+        return false;
+    }
+
+    auto colliderData = value[key].GetObj();
+    ASSERT(colliderData.HasMember("Shape"), "SaveUtil: %s requires shape data!", key);
+    std::string shape = colliderData["Shape"].GetString();
+    Physics::CollisionShapeCache* shapeCache = Physics::CollisionShapeCache::Get();
+    if (shape == "Empty")
+    {
+        shapeId = shapeCache->AcquireEmpty();
+    }
+    else if (shape == "Box")
+    {
+        const auto halfExtents = colliderData["HalfExtents"].GetArray();
+        const float x = halfExtents[0].GetFloat();
+        const float y = halfExtents[1].GetFloat();
+        const float z = halfExtents[2].GetFloat();
+        shapeId = shapeCache->AcquireBox({ x, y, z });
+    }
+    else if (shape == "Sphere")
+    {
+        const float radius = colliderData["Radius"].GetFloat();
+        shapeId = shapeCache->AcquireSphere(radius);
+    }
+    else if (shape == "Hull")
+    {
+        const auto halfExtents = colliderData["HalfExtents"].GetArray();
+        const float hx = halfExtents[0].GetFloat();
+        const float hy = halfExtents[1].GetFloat();
+        const float hz = halfExtents[2].GetFloat();
+        const auto origin = colliderData["Origin"].GetArray();
+        const float ox = origin[0].GetFloat();
+        const float oy = origin[1].GetFloat();
+        const float oz = origin[2].GetFloat();
+        shapeId = shapeCache->AcquireHull({ hx, hy, hz }, { ox, oy, oz });
+    }
+    else if (shape == "Heightfield")
+    {
+        const std::string fileName = colliderData["FileName"].GetString();
+        const float heightScale = colliderData["HeightScale"].GetFloat();
+        shapeId = shapeCache->AcquireHeightfield(fileName, heightScale);
+    }
+    else
+    {
+        ASSERT(false, "SaveUtil: Invalid shape type %s !", shape.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SaveUtil::ReadTickLod(const char* key, TickLod& tickLod, const rapidjson::Value& value)
+{
+    if (!value.HasMember(key))
+    {
+        return false;
+    }
+
+    const rapidjson::Value& lodValue = value[key];
+    if (lodValue.HasMember("Bands"))
+    {
+        const auto bands = lodValue["Bands"].GetArray();
+        ASSERT(bands.Size() <= TickLod::MaxBands, "SaveUtil: %s has more than %u bands.", key, TickLod::MaxBands);
+        tickLod.bandCount = std::min(bands.Size(), TickLod::MaxBands);
+        for (uint32_t i = 0; i < tickLod.bandCount; ++i)
+        {
+            TickLod::Band& band = tickLod.bands[i];
+            band.distance = bands[i]["Distance"].GetFloat();
+            band.interval = bands[i]["Interval"].GetUint();
+        }
+    }
+    if (lodValue.HasMember("FarInterval"))
+    {
+        tickLod.farInterval = lodValue["FarInterval"].GetUint();
+    }
+    if (lodValue.HasMember("HiddenInterval"))
+    {
+        tickLod.hiddenInterval = lodValue["HiddenInterval"].GetUint();
+    }
+    return true;
+}
+
+// Snapshot state --------------
+void SaveUtil::SaveCollisionShape(SnapshotWriter& writer, Physics::CollisionShapeId shapeId)
+{
+    Physics::CollisionShapeCache::Key key;
+    const bool hasShape = shapeId != 0 && Physics::CollisionShapeCache::Get()->GetKey(shapeId, key);
+    writer.Write(hasShape);
+    if (hasShape)
+    {
+        writer.Write(static_cast<uint32_t>(key.type));
+        for (float param : key.params)
+        {
+            writer.Write(param);
+        }
+        writer.Write(key.fileName);
+    }
+}
+
+bool SaveUtil::LoadCollisionShape(SnapshotReader& reader, Physics::CollisionShapeId& shapeId)
+{
+    bool hasShape = false;
+    reader.Read(hasShape);
+    if (!hasShape)
+    {
+        return false;
+    }
+
+    Physics::CollisionShapeCache::Key key;
+    const uint32_t type = reader.ReadUInt();
+    for (float& param : key.params)
+    {
+        reader.Read(param);
+    }
+    reader.Read(key.fileName);
+    if (!reader.IsValid() || type >= static_cast<uint32_t>(Physics::CollisionShapeCache::ShapeType::Count))
+    {
+        LOG("SaveUtil: snapshot has an invalid collision shape.");
+        return false;
+    }
+    key.type = static_cast<Physics::CollisionShapeCache::ShapeType>(type);
+    shapeId = Physics::CollisionShapeCache::Get()->Acquire(key);
+    return true;
+}
+
+void SaveUtil::SaveTickLod(SnapshotWriter& writer, const TickLod& tickLod)
+{
+    writer.Write(tickLod.bandCount);
+    for (const TickLod::Band& band : tickLod.bands)
+    {
+        writer.Write(band.distance);
+        writer.Write(band.interval);
+    }
+    writer.Write(tickLod.farInterval);
+    writer.Write(tickLod.hiddenInterval);
+}
+
+void SaveUtil::LoadTickLod(SnapshotReader& reader, TickLod& tickLod)
+{
+    reader.Read(tickLod.bandCount);
+    tickLod.bandCount = std::min(tickLod.bandCount, TickLod::MaxBands);
+    for (TickLod::Band& band : tickLod.bands)
+    {
+        reader.Read(band.distance);
+        reader.Read(band.interval);
+    }
+    reader.Read(tickLod.farInterval);
+    reader.Read(tickLod.hiddenInterval);
 }
\ No newline at end of file
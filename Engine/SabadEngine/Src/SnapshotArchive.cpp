@@ -0,0 +1,200 @@
+#include "Precompiled.h"
+#include "SnapshotArchive.h"
+
+using namespace SabadEngine;
+
+SnapshotWriter::SnapshotWriter(std::vector<uint32_t>& words, uint32_t version)
+	: mWords(words)
+	, mVersion(version)
+{
+}
+
+uint32_t SnapshotWriter::GetVersion() const
+{
+	return mVersion;
+}
+
+void SnapshotWriter::Write(uint32_t value)
+{
+	mWords.push_back(value);
+}
+
+void SnapshotWriter::Write(int value)
+{
+	mWords.push_back(static_cast<uint32_t>(value));
+}
+
+void SnapshotWriter::Write(float value)
+{
+	uint32_t word = 0;
+	std::memcpy(&word, &value, sizeof(word));
+	mWords.push_back(word);
+}
+
+void SnapshotWriter::Write(bool value)
+{
+	mWords.push_back(value ? 1 : 0);
+}
+
+void SnapshotWriter::Write(const Math::Vector2& value)
+{
+	Write(value.x);
+	Write(value.y);
+}
+
+void SnapshotWriter::Write(const Math::Vector3& value)
+{
+	Write(value.x);
+	Write(value.y);
+	Write(value.z);
+}
+
+void SnapshotWriter::Write(const Math::Quaternion& value)
+{
+	Write(value.x);
+	Write(value.y);
+	Write(value.z);
+	Write(value.w);
+}
+
+void SnapshotWriter::Write(const Graphics::Color& value)
+{
+	Write(value.r);
+	Write(value.g);
+	Write(value.b);
+	Write(value.a);
+}
+
+void SnapshotWriter::Write(std::string_view value)
+{
+	// the length, then the chars with the last word zero padded
+	const std::size_t first = mWords.size() + 1;
+	const std::size_t wordCount = (value.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+	mWords.push_back(static_cast<uint32_t>(value.size()));
+	mWords.resize(first + wordCount, 0);
+	std::memcpy(mWords.data() + first, value.data(), value.size());
+}
+
+uint32_t SnapshotWriter::BeginBlock()
+{
+	const uint32_t block = static_cast<uint32_t>(mWords.size());
+	mWords.push_back(0);
+	return block;
+}
+
+void SnapshotWriter::EndBlock(uint32_t block)
+{
+	ASSERT(block < mWords.size(), "SnapshotWriter: invalid block.");
+	mWords[block] = static_cast<uint32_t>(mWords.size() - block - 1);
+}
+
+SnapshotReader::SnapshotReader(const uint32_t* words, std::size_t wordCount, uint32_t version)
+	: mWords(words)
+	, mWordCount(wordCount)
+	, mVersion(version)
+{
+}
+
+uint32_t SnapshotReader::GetVersion() const
+{
+	return mVersion;
+}
+
+bool SnapshotReader::IsValid() const
+{
+	return !mFailed;
+}
+
+bool SnapshotReader::IsAtEnd() const
+{
+	return mPosition >= mWordCount;
+}
+
+void SnapshotReader::Read(uint32_t& value)
+{
+	value = ReadUInt();
+}
+
+void SnapshotReader::Read(int& value)
+{
+	value = static_cast<int>(ReadUInt());
+}
+
+void SnapshotReader::Read(float& value)
+{
+	const uint32_t word = ReadUInt();
+	std::memcpy(&value, &word, sizeof(value));
+}
+
+void SnapshotReader::Read(bool& value)
+{
+	value = ReadUInt() != 0;
+}
+
+void SnapshotReader::Read(Math::Vector2& value)
+{
+	Read(value.x);
+	Read(value.y);
+}
+
+void SnapshotReader::Read(Math::Vector3& value)
+{
+	Read(value.x);
+	Read(value.y);
+	Read(value.z);
+}
+
+void SnapshotReader::Read(Math::Quaternion& value)
+{
+	Read(value.x);
+	Read(value.y);
+	Read(value.z);
+	Read(value.w);
+}
+
+void SnapshotReader::Read(Graphics::Color& value)
+{
+	Read(value.r);
+	Read(value.g);
+	Read(value.b);
+	Read(value.a);
+}
+
+void SnapshotReader::Read(std::string& value)
+{
+	const uint32_t length = ReadUInt();
+	const std::size_t wordCount = (static_cast<std::size_t>(length) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+	if (wordCount > mWordCount - mPosition)
+	{
+		mFailed = true;
+		mPosition = mWordCount;
+		value.clear();
+		return;
+	}
+	value.assign(reinterpret_cast<const char*>(mWords + mPosition), length);
+	mPosition += wordCount;
+}
+
+uint32_t SnapshotReader::ReadUInt()
+{
+	if (mPosition >= mWordCount)
+	{
+		mFailed = true;
+		return 0;
+	}
+	return mWords[mPosition++];
+}
+
+SnapshotReader SnapshotReader::ReadBlock()
+{
+	const uint32_t wordCount = ReadUInt();
+	if (wordCount > mWordCount - mPosition)
+	{
+		mFailed = true;
+		mPosition = mWordCount;
+		return SnapshotReader(nullptr, 0, mVersion);
+	}
+	SnapshotReader block(mWords + mPosition, wordCount, mVersion);
+	mPosition += wordCount;
+	return block;
+}
\ No newline at end of file
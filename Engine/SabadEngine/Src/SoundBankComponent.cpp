@@ -1,6 +1,7 @@
 #include "Precompiled.h"
 #include "SoundBankComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 using namespace SabadEngine::Audio;
@@ -63,6 +64,42 @@ void SoundBankComponent::Deserialize(const rapidjson::Value& value)
 	}
 }
 
+void SoundBankComponent::SaveState(SnapshotWriter& writer) const
+{
+	// in name order, so two snapshots of the same bank line up
+	std::vector<const SoundEffects::value_type*> soundEffects;
+	soundEffects.reserve(mSoundEffects.size());
+	for (const auto& effect : mSoundEffects)
+	{
+		soundEffects.push_back(&effect);
+	}
+	std::sort(soundEffects.begin(), soundEffects.end(), [](const auto* a, const auto* b)
+	{
+		return a->first < b->first;
+	});
+	writer.Write(static_cast<uint32_t>(soundEffects.size()));
+	for (const auto* effect : soundEffects)
+	{
+		writer.Write(effect->first);
+		writer.Write(effect->second.fileName);
+		writer.Write(effect->second.looping);
+	}
+}
+
+void SoundBankComponent::LoadState(SnapshotReader& reader)
+{
+	mSoundEffects.clear();
+	const uint32_t effectCount = reader.ReadUInt();
+	for (uint32_t i = 0; i < effectCount && reader.IsValid(); ++i)
+	{
+		std::string name;
+		reader.Read(name);
+		SoundEffectData& data = mSoundEffects[name];
+		reader.Read(data.fileName);
+		reader.Read(data.looping);
+	}
+}
+
 void SoundBankComponent::Play(const std::string& key)
 {
 	auto iter = mSoundEffects.find(key);
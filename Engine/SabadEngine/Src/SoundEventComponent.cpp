@@ -1,6 +1,7 @@
 #include "Precompiled.h"
 #include "SoundEventComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 using namespace SabadEngine::Audio;
@@ -35,6 +36,16 @@ void SoundEventComponent::Deserialize(const rapidjson::Value& value)
 	SaveUtil::ReadString("FileName", mFileName, value);
 	SaveUtil::ReadBool("Looping", mLooping, value);
 }
+void SoundEventComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mFileName);
+	writer.Write(mLooping);
+}
+void SoundEventComponent::LoadState(SnapshotReader& reader)
+{
+	reader.Read(mFileName);
+	reader.Read(mLooping);
+}
 void SoundEventComponent::Play()
 {
 	SoundEffectManager::Get()->Play(mSoundId, mLooping);
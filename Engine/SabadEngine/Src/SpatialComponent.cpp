@@ -0,0 +1,50 @@
+#include "Precompiled.h"
+#include "SpatialComponent.h"
+#include "SaveUtil.h"
+#include "SnapshotArchive.h"
+#include "SpatialService.h"
+#include "TransformComponent.h"
+#include "GameWorld.h"
+#include "GameObject.h"
+
+using namespace SabadEngine;
+
+void SpatialComponent::Initialize()
+{
+	mTransformComponent = GetOwner().GetComponent<TransformComponent>();
+	ASSERT(mTransformComponent != nullptr, "SpatialComponent: requires a TransformComponent.");
+	SpatialService* spatialService = GetOwner().GetWorld().GetSpatialService();
+	if (spatialService != nullptr)
+	{
+		spatialService->Register(this);
+	}
+}
+
+void SpatialComponent::Terminate()
+{
+	SpatialService* spatialService = GetOwner().GetWorld().GetSpatialService();
+	if (spatialService != nullptr)
+	{
+		spatialService->Unregister(this);
+	}
+}
+
+void SpatialComponent::Deserialize(const rapidjson::Value& value)
+{
+	SaveUtil::ReadFloat("Radius", mRadius, value);
+}
+
+void SpatialComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mRadius);
+}
+
+void SpatialComponent::LoadState(SnapshotReader& reader)
+{
+	reader.Read(mRadius);
+}
+
+float SpatialComponent::GetRadius() const
+{
+	return mRadius;
+}
\ No newline at end of file
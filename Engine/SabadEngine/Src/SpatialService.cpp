@@ -0,0 +1,426 @@
+#include "Precompiled.h"
+#include "SpatialService.h"
+#include "SpatialComponent.h"
+#include "TransformComponent.h"
+#include "GameObject.h"
+#include "SaveUtil.h"
+#include "SnapshotArchive.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+	// cell coordinates take 20 bits each and the level the top 4, coordinates past the range share the edge cells
+	constexpr uint32_t CoordinateBits = 20;
+	constexpr int32_t MaxCoordinate = (1 << (CoordinateBits - 1)) - 1;
+	constexpr uint64_t CoordinateMask = (uint64_t(1) << CoordinateBits) - 1;
+
+	constexpr float DefaultCellSize = 10.0f;
+
+	int32_t GetCoordinate(float value, float inverseCellSize)
+	{
+		const float coordinate = floorf(value * inverseCellSize);
+		return static_cast<int32_t>(Math::Clamp(coordinate, static_cast<float>(-MaxCoordinate), static_cast<float>(MaxCoordinate)));
+	}
+
+	uint64_t MakeKey(uint32_t level, int32_t x, int32_t y, int32_t z)
+	{
+		return (static_cast<uint64_t>(level) << (CoordinateBits * 3))
+			| ((static_cast<uint64_t>(x) & CoordinateMask) << (CoordinateBits * 2))
+			| ((static_cast<uint64_t>(y) & CoordinateMask) << CoordinateBits)
+			| (static_cast<uint64_t>(z) & CoordinateMask);
+	}
+
+	int32_t GetKeyCoordinate(uint64_t key, uint32_t shift)
+	{
+		// sign extends the 20 bit field
+		const int32_t field = static_cast<int32_t>((key >> shift) & CoordinateMask);
+		return (field << (32 - CoordinateBits)) >> (32 - CoordinateBits);
+	}
+
+	// the point where three planes meet
+	Math::Vector3 Intersect(const Math::Vector4& a, const Math::Vector4& b, const Math::Vector4& c)
+	{
+		const Math::Vector3 na(a.x, a.y, a.z);
+		const Math::Vector3 nb(b.x, b.y, b.z);
+		const Math::Vector3 nc(c.x, c.y, c.z);
+		const Math::Vector3 bc = Math::Cross(nb, nc);
+		return ((bc * -a.w) - (Math::Cross(nc, na) * b.w) - (Math::Cross(na, nb) * c.w)) / Math::Dot(na, bc);
+	}
+
+	Math::AABB GetBounds(const Math::Frustum& frustum)
+	{
+		// left, right, bottom, top, near, far
+		const Math::Vector4* planes = frustum.planes;
+		Math::AABB bounds(Math::Vector3(FLT_MAX), Math::Vector3(-FLT_MAX));
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			const Math::Vector3 point = Intersect(planes[corner & 1], planes[2 + ((corner >> 1) & 1)], planes[4 + (corner >> 2)]);
+			bounds.min = { std::min(bounds.min.x, point.x), std::min(bounds.min.y, point.y), std::min(bounds.min.z, point.z) };
+			bounds.max = { std::max(bounds.max.x, point.x), std::max(bounds.max.y, point.y), std::max(bounds.max.z, point.z) };
+		}
+		return bounds;
+	}
+}
+
+template<class VisitCell>
+void SpatialService::ForEachCellInBox(const Math::AABB& box, VisitCell&& visitCell) const
+{
+	for (uint32_t levelIndex = 0; levelIndex < mLevels.size(); ++levelIndex)
+	{
+		const Level& level = mLevels[levelIndex];
+		if (level.cells.empty())
+		{
+			continue;
+		}
+
+		// widened by the biggest radius on the level, an object can reach that far out of its cell
+		const float slack = level.maxRadius;
+		const int32_t minX = GetCoordinate(box.min.x - slack, level.inverseCellSize);
+		const int32_t minY = GetCoordinate(box.min.y - slack, level.inverseCellSize);
+		const int32_t minZ = GetCoordinate(box.min.z - slack, level.inverseCellSize);
+		const int32_t maxX = GetCoordinate(box.max.x + slack, level.inverseCellSize);
+		const int32_t maxY = GetCoordinate(box.max.y + slack, level.inverseCellSize);
+		const int32_t maxZ = GetCoordinate(box.max.z + slack, level.inverseCellSize);
+		const uint64_t spanCount = static_cast<uint64_t>(maxX - minX + 1) * (maxY - minY + 1) * (maxZ - minZ + 1);
+
+		// a box covering more cells than are occupied walks the occupied ones instead
+		if (spanCount > level.cells.size())
+		{
+			for (const auto& [cellKey, cell] : level.cells)
+			{
+				const int32_t x = GetKeyCoordinate(cellKey, CoordinateBits * 2);
+				const int32_t y = GetKeyCoordinate(cellKey, CoordinateBits);
+				const int32_t z = GetKeyCoordinate(cellKey, 0);
+				if (x >= minX && x <= maxX && y >= minY && y <= maxY && z >= minZ && z <= maxZ)
+				{
+					visitCell(level, x, y, z, cell);
+				}
+			}
+			continue;
+		}
+
+		for (int32_t x = minX; x <= maxX; ++x)
+		{
+			for (int32_t y = minY; y <= maxY; ++y)
+			{
+				for (int32_t z = minZ; z <= maxZ; ++z)
+				{
+					auto iter = level.cells.find(MakeKey(levelIndex, x, y, z));
+					if (iter != level.cells.end())
+					{
+						visitCell(level, x, y, z, iter->second);
+					}
+				}
+			}
+		}
+	}
+}
+
+template<class Visit>
+void SpatialService::ForEachInBox(const Math::AABB& box, Visit&& visit) const
+{
+	ForEachCellInBox(box, [&](const Level&, int32_t, int32_t, int32_t, const Cell& cell)
+	{
+		for (const uint32_t entryIndex : cell)
+		{
+			visit(entryIndex);
+		}
+	});
+}
+
+void SpatialService::Initialize()
+{
+	if (mLevels.empty())
+	{
+		SetPartition(mPartition, DefaultCellSize);
+	}
+}
+
+void SpatialService::Terminate()
+{
+	mEntries.clear();
+	mLevels.clear();
+	mCellCount = 0;
+	mMovedCount = 0;
+}
+
+void SpatialService::Update(float deltaTime)
+{
+	mMovedCount = 0;
+	const uint32_t entryCount = static_cast<uint32_t>(mEntries.size());
+	for (uint32_t i = 0; i < entryCount; ++i)
+	{
+		Entry& entry = mEntries[i];
+		const Math::Vector3 position = entry.component->mTransformComponent->GetWorldPosition();
+		if (position.x == entry.position.x && position.y == entry.position.y && position.z == entry.position.z)
+		{
+			continue;
+		}
+		entry.position = position;
+		const uint64_t cellKey = GetCellKey(entry.level, position);
+		if (cellKey != entry.cellKey)
+		{
+			RemoveFromCell(i);
+			entry.cellKey = cellKey;
+			AddToCell(i);
+			++mMovedCount;
+		}
+	}
+}
+
+void SpatialService::DebugUI()
+{
+	if (ImGui::CollapsingHeader("Spatial"))
+	{
+		ImGui::Text("%s, %zu levels, biggest cell %.1f", (mPartition == Partition::Grid) ? "Grid" : "Loose octree",
+			mLevels.size(), mLevels.empty() ? 0.0f : mLevels[0].cellSize);
+		ImGui::Text("Objects: %u, cells: %u, moved cell last update: %u", GetObjectCount(), mCellCount, mMovedCount);
+	}
+}
+
+void SpatialService::Deserialize(const rapidjson::Value& value)
+{
+	std::string partitionName = "Grid";
+	float cellSize = DefaultCellSize;
+	int levelCount = 1;
+	SaveUtil::ReadString("Partition", partitionName, value);
+	SaveUtil::ReadFloat("CellSize", cellSize, value);
+	SaveUtil::ReadInt("Levels", levelCount, value);
+	ASSERT(partitionName == "Grid" || partitionName == "LooseOctree", "SpatialService: unknown partition %s.", partitionName.c_str());
+	const Partition partition = (partitionName == "LooseOctree") ? Partition::LooseOctree : Partition::Grid;
+	SetPartition(partition, cellSize, static_cast<uint32_t>(std::max(levelCount, 1)));
+}
+
+void SpatialService::SaveState(SnapshotWriter& writer) const
+{
+	// only the partition, the entries come back as the restored objects register
+	writer.Write(static_cast<uint32_t>(mPartition));
+	writer.Write(mLevels.empty() ? DefaultCellSize : mLevels.front().cellSize);
+	writer.Write(static_cast<uint32_t>(mLevels.size()));
+}
+
+void SpatialService::LoadState(SnapshotReader& reader)
+{
+	const Partition partition = static_cast<Partition>(reader.ReadUInt());
+	float cellSize = DefaultCellSize;
+	reader.Read(cellSize);
+	const uint32_t levelCount = reader.ReadUInt();
+	SetPartition(partition, cellSize, std::max(levelCount, 1u));
+}
+
+void SpatialService::SetPartition(Partition partition, float cellSize, uint32_t levelCount)
+{
+	ASSERT(mEntries.empty(), "SpatialService: the partition can't change once objects are registered.");
+	ASSERT(cellSize > 0.0f, "SpatialService: cell size must be greater than 0.");
+	mPartition = partition;
+	levelCount = (partition == Partition::Grid) ? 1 : Math::Clamp(levelCount, 1u, MaxLevels);
+	mLevels.clear();
+	mLevels.resize(levelCount);
+	for (Level& level : mLevels)
+	{
+		level.cellSize = cellSize;
+		level.inverseCellSize = 1.0f / cellSize;
+		cellSize *= 0.5f;
+	}
+	mCellCount = 0;
+}
+
+SpatialService::Partition SpatialService::GetPartition() const
+{
+	return mPartition;
+}
+
+void SpatialService::Register(SpatialComponent* spatialComponent)
+{
+	ASSERT(spatialComponent->mEntryIndex == UINT32_MAX, "SpatialService: component is already registered.");
+	if (mLevels.empty())
+	{
+		SetPartition(mPartition, DefaultCellSize);
+	}
+
+	Entry entry;
+	entry.component = spatialComponent;
+	entry.handle = spatialComponent->GetOwner().GetHandle();
+	entry.position = spatialComponent->mTransformComponent->GetWorldPosition();
+	entry.radius = spatialComponent->mRadius;
+	entry.level = GetLevelIndex(entry.radius);
+	entry.cellKey = GetCellKey(entry.level, entry.position);
+	Level& level = mLevels[entry.level];
+	level.maxRadius = std::max(level.maxRadius, entry.radius);
+
+	const uint32_t entryIndex = static_cast<uint32_t>(mEntries.size());
+	mEntries.push_back(entry);
+	spatialComponent->mEntryIndex = entryIndex;
+	AddToCell(entryIndex);
+}
+
+void SpatialService::Unregister(SpatialComponent* spatialComponent)
+{
+	const uint32_t entryIndex = spatialComponent->mEntryIndex;
+	if (entryIndex == UINT32_MAX)
+	{
+		return;
+	}
+
+	RemoveFromCell(entryIndex);
+	const uint32_t lastIndex = static_cast<uint32_t>(mEntries.size() - 1);
+	if (entryIndex != lastIndex)
+	{
+		Entry& movedEntry = mEntries[entryIndex];
+		movedEntry = mEntries[lastIndex];
+		movedEntry.component->mEntryIndex = entryIndex;
+		mLevels[movedEntry.level].cells[movedEntry.cellKey][movedEntry.cellSlot] = entryIndex;
+	}
+	mEntries.pop_back();
+	spatialComponent->mEntryIndex = UINT32_MAX;
+}
+
+void SpatialService::QueryRadius(const Math::Vector3& center, float radius, std::vector<GameObjectHandle>& results) const
+{
+	ForEachInBox(Math::AABB::FromCenter(center, Math::Vector3(radius)), [&](uint32_t entryIndex)
+	{
+		const Entry& entry = mEntries[entryIndex];
+		if (Math::MagnitudeSqr(center - entry.position) <= Math::Sqr(radius + entry.radius))
+		{
+			results.push_back(entry.handle);
+		}
+	});
+}
+
+void SpatialService::QueryAABB(const Math::AABB& box, std::vector<GameObjectHandle>& results) const
+{
+	ForEachInBox(box, [&](uint32_t entryIndex)
+	{
+		const Entry& entry = mEntries[entryIndex];
+		if (box.IntersectsSphere(entry.position, entry.radius))
+		{
+			results.push_back(entry.handle);
+		}
+	});
+}
+
+void SpatialService::QueryFrustum(const Math::Frustum& frustum, std::vector<GameObjectHandle>& results) const
+{
+	// only the cells in the box around the frustum corners are looked at, each is tested with its loose bounds first
+	ForEachCellInBox(GetBounds(frustum), [&](const Level& level, int32_t x, int32_t y, int32_t z, const Cell& cell)
+	{
+		const Math::Vector3 slack(level.maxRadius);
+		const Math::Vector3 cellMin(x * level.cellSize, y * level.cellSize, z * level.cellSize);
+		const Math::AABB looseBounds(cellMin - slack, cellMin + Math::Vector3(level.cellSize) + slack);
+		if (!frustum.IntersectsAABB(looseBounds))
+		{
+			return;
+		}
+		for (const uint32_t entryIndex : cell)
+		{
+			const Entry& entry = mEntries[entryIndex];
+			if (frustum.IntersectsSphere(entry.position, entry.radius))
+			{
+				results.push_back(entry.handle);
+			}
+		}
+	});
+}
+
+void SpatialService::QueryNearest(const Math::Vector3& center, uint32_t count, std::vector<GameObjectHandle>& results) const
+{
+	count = std::min(count, GetObjectCount());
+	if (count == 0)
+	{
+		return;
+	}
+
+	// grows the search until it holds enough objects, everything inside the radius is found so the closest count are exact
+	std::vector<std::pair<float, uint32_t>> candidates;
+	float radius = mLevels.back().cellSize;
+	while (true)
+	{
+		candidates.clear();
+		const float radiusSqr = radius * radius;
+		ForEachInBox(Math::AABB::FromCenter(center, Math::Vector3(radius)), [&](uint32_t entryIndex)
+		{
+			const float distanceSqr = Math::MagnitudeSqr(center - mEntries[entryIndex].position);
+			if (distanceSqr <= radiusSqr)
+			{
+				candidates.emplace_back(distanceSqr, entryIndex);
+			}
+		});
+		if (candidates.size() >= count)
+		{
+			break;
+		}
+		radius *= 2.0f;
+	}
+
+	std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		results.push_back(mEntries[candidates[i].second].handle);
+	}
+}
+
+uint32_t SpatialService::GetObjectCount() const
+{
+	return static_cast<uint32_t>(mEntries.size());
+}
+
+uint32_t SpatialService::GetCellCount() const
+{
+	return mCellCount;
+}
+
+uint32_t SpatialService::GetMovedCount() const
+{
+	return mMovedCount;
+}
+
+uint32_t SpatialService::GetLevelIndex(float radius) const
+{
+	// the smallest cell the whole sphere fits in, with the loose half cell of slack on each side
+	uint32_t levelIndex = 0;
+	while (levelIndex + 1 < mLevels.size() && radius * 2.0f <= mLevels[levelIndex + 1].cellSize)
+	{
+		++levelIndex;
+	}
+	return levelIndex;
+}
+
+uint64_t SpatialService::GetCellKey(uint32_t levelIndex, const Math::Vector3& position) const
+{
+	const float inverseCellSize = mLevels[levelIndex].inverseCellSize;
+	return MakeKey(levelIndex,
+		GetCoordinate(position.x, inverseCellSize),
+		GetCoordinate(position.y, inverseCellSize),
+		GetCoordinate(position.z, inverseCellSize));
+}
+
+void SpatialService::AddToCell(uint32_t entryIndex)
+{
+	Entry& entry = mEntries[entryIndex];
+	Cell& cell = mLevels[entry.level].cells[entry.cellKey];
+	if (cell.empty())
+	{
+		++mCellCount;
+	}
+	entry.cellSlot = static_cast<uint32_t>(cell.size());
+	cell.push_back(entryIndex);
+}
+
+void SpatialService::RemoveFromCell(uint32_t entryIndex)
+{
+	const Entry& entry = mEntries[entryIndex];
+	auto& cells = mLevels[entry.level].cells;
+	auto iter = cells.find(entry.cellKey);
+	ASSERT(iter != cells.end(), "SpatialService: entry is missing from its cell.");
+	Cell& cell = iter->second;
+	const uint32_t movedIndex = cell.back();
+	cell[entry.cellSlot] = movedIndex;
+	mEntries[movedIndex].cellSlot = entry.cellSlot;
+	cell.pop_back();
+	if (cell.empty())
+	{
+		cells.erase(iter);
+		--mCellCount;
+	}
+}
\ No newline at end of file
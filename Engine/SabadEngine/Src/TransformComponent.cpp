@@ -1,17 +1,23 @@
 #include "Precompiled.h"
 #include "TransformComponent.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 using namespace SabadEngine::Graphics;
 
+void TransformComponent::Terminate()
+{
+	mWorldMatrix = nullptr;
+}
+
 void TransformComponent::DebugUI()
 {
 	ImGui::DragFloat3("Position", &position.x, 0.1f);
 	ImGui::DragFloat4("Rotation", &rotation.x, 0.0001f);
 	ImGui::DragFloat3("Scale", &scale.x, 0.1f);
 
-	SimpleDraw::AddTransform(GetMatrix4());
+	SimpleDraw::AddTransform(GetWorldMatrix());
 }
 
 void TransformComponent::Deserialize(const rapidjson::Value& value)
@@ -19,4 +25,28 @@ void TransformComponent::Deserialize(const rapidjson::Value& value)
 	SaveUtil::ReadVector3("Position", position, value);
 	SaveUtil::ReadQuaternion("Rotation", rotation, value);
 	SaveUtil::ReadVector3("Scale", scale, value);
+}
+
+void TransformComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(position);
+	writer.Write(rotation);
+	writer.Write(scale);
+}
+
+void TransformComponent::LoadState(SnapshotReader& reader)
+{
+	reader.Read(position);
+	reader.Read(rotation);
+	reader.Read(scale);
+}
+
+Math::Matrix4 TransformComponent::GetWorldMatrix() const
+{
+	return (mWorldMatrix != nullptr) ? *mWorldMatrix : GetMatrix4();
+}
+
+Math::Vector3 TransformComponent::GetWorldPosition() const
+{
+	return (mWorldMatrix != nullptr) ? Math::GetTranslation(*mWorldMatrix) : position;
 }
\ No newline at end of file
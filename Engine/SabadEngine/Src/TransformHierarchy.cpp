@@ -0,0 +1,248 @@
+#include "Precompiled.h"
+#include "TransformHierarchy.h"
+#include "TransformComponent.h"
+
+#include <xmmintrin.h>
+
+using namespace SabadEngine;
+
+namespace
+{
+	// nodes per job, below this a pass runs on the calling thread
+	constexpr uint32_t NodeBatchSize = 256;
+
+	// S * R * T written straight into rows, then multiplied by the parent world matrix four floats at a time
+	void ComputeWorldMatrix(const Graphics::Transform& local, const Math::Matrix4* parentWorld, Math::Matrix4& world)
+	{
+		const Math::Quaternion& q = local.rotation;
+		const Math::Vector3& s = local.scale;
+		const Math::Vector3& p = local.position;
+		__m128 rows[4] = {
+			_mm_mul_ps(_mm_setr_ps(
+				1.0f - (2.0f * q.y * q.y) - (2.0f * q.z * q.z),
+				(2.0f * q.x * q.y) + (2.0f * q.z * q.w),
+				(2.0f * q.x * q.z) - (2.0f * q.y * q.w),
+				0.0f), _mm_set1_ps(s.x)),
+			_mm_mul_ps(_mm_setr_ps(
+				(2.0f * q.x * q.y) - (2.0f * q.z * q.w),
+				1.0f - (2.0f * q.x * q.x) - (2.0f * q.z * q.z),
+				(2.0f * q.y * q.z) + (2.0f * q.x * q.w),
+				0.0f), _mm_set1_ps(s.y)),
+			_mm_mul_ps(_mm_setr_ps(
+				(2.0f * q.x * q.z) + (2.0f * q.y * q.w),
+				(2.0f * q.y * q.z) - (2.0f * q.x * q.w),
+				1.0f - (2.0f * q.x * q.x) - (2.0f * q.y * q.y),
+				0.0f), _mm_set1_ps(s.z)),
+			_mm_setr_ps(p.x, p.y, p.z, 1.0f)
+		};
+
+		if (parentWorld != nullptr)
+		{
+			const float* parent = parentWorld->v.data();
+			const __m128 parentRow0 = _mm_loadu_ps(parent);
+			const __m128 parentRow1 = _mm_loadu_ps(parent + 4);
+			const __m128 parentRow2 = _mm_loadu_ps(parent + 8);
+			const __m128 parentRow3 = _mm_loadu_ps(parent + 12);
+			for (__m128& row : rows)
+			{
+				const __m128 x = _mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0));
+				const __m128 y = _mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1));
+				const __m128 z = _mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2));
+				const __m128 w = _mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3));
+				row = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(x, parentRow0), _mm_mul_ps(y, parentRow1)),
+					_mm_add_ps(_mm_mul_ps(z, parentRow2), _mm_mul_ps(w, parentRow3)));
+			}
+		}
+
+		float* out = world.v.data();
+		_mm_storeu_ps(out, rows[0]);
+		_mm_storeu_ps(out + 4, rows[1]);
+		_mm_storeu_ps(out + 8, rows[2]);
+		_mm_storeu_ps(out + 12, rows[3]);
+	}
+
+	template<class Function>
+	void RunRange(uint32_t begin, uint32_t end, Function&& function)
+	{
+		Core::JobSystem* jobSystem = Core::JobSystem::TryGet();
+		if (end - begin <= NodeBatchSize || jobSystem == nullptr)
+		{
+			function(begin, end);
+			return;
+		}
+		jobSystem->ParallelFor(end - begin, NodeBatchSize, [&](std::size_t first, std::size_t last)
+		{
+			function(begin + static_cast<uint32_t>(first), begin + static_cast<uint32_t>(last));
+		});
+	}
+}
+
+void TransformHierarchy::Clear()
+{
+	mPendingNodes.clear();
+	mTransforms.clear();
+	mParents.clear();
+	mLocals.clear();
+	mWorldMatrices.clear();
+	mDirty.clear();
+	mLevelStarts.clear();
+	mRecomputedCount = 0;
+}
+
+void TransformHierarchy::Add(TransformComponent* transform, const TransformComponent* parent)
+{
+	PendingNode& node = mPendingNodes.emplace_back();
+	node.transform = transform;
+	node.parent = parent;
+}
+
+void TransformHierarchy::Build()
+{
+	const uint32_t nodeCount = static_cast<uint32_t>(mPendingNodes.size());
+	std::unordered_map<const TransformComponent*, uint32_t> pendingIndices;
+	pendingIndices.reserve(nodeCount);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		pendingIndices[mPendingNodes[i].transform] = i;
+	}
+
+	// a parent that was not added, not initialized yet, makes the node a root
+	std::vector<int32_t> pendingParents(nodeCount, -1);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		auto iter = pendingIndices.find(mPendingNodes[i].parent);
+		if (iter != pendingIndices.end())
+		{
+			pendingParents[i] = static_cast<int32_t>(iter->second);
+		}
+	}
+
+	// depth by walking up to the first node with a known depth
+	std::vector<int32_t> depths(nodeCount, -1);
+	std::vector<uint32_t> chain;
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		int32_t node = static_cast<int32_t>(i);
+		while (node >= 0 && depths[node] < 0 && chain.size() <= nodeCount)
+		{
+			chain.push_back(static_cast<uint32_t>(node));
+			node = pendingParents[node];
+		}
+		ASSERT(chain.size() <= nodeCount, "TransformHierarchy: parent links form a loop.");
+		int32_t depth = (node >= 0) ? depths[node] : -1;
+		for (auto iter = chain.rbegin(); iter != chain.rend(); ++iter)
+		{
+			depths[*iter] = ++depth;
+		}
+		chain.clear();
+	}
+
+	// stable, so nodes of the same depth keep the order they were added in
+	std::vector<uint32_t> order(nodeCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&depths](uint32_t a, uint32_t b)
+	{
+		return depths[a] < depths[b];
+	});
+
+	std::vector<int32_t> sortedIndices(nodeCount, -1);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		sortedIndices[order[i]] = static_cast<int32_t>(i);
+	}
+
+	mTransforms.resize(nodeCount);
+	mParents.resize(nodeCount);
+	mLocals.resize(nodeCount);
+	mWorldMatrices.resize(nodeCount);
+	mDirty.assign(nodeCount, 1);
+	mLevelStarts.clear();
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		const uint32_t pendingIndex = order[i];
+		const int32_t pendingParent = pendingParents[pendingIndex];
+		mTransforms[i] = mPendingNodes[pendingIndex].transform;
+		mParents[i] = (pendingParent >= 0) ? sortedIndices[pendingParent] : -1;
+		mLocals[i] = *mTransforms[i];
+		mTransforms[i]->mWorldMatrix = &mWorldMatrices[i];
+		while (mLevelStarts.size() <= static_cast<std::size_t>(depths[pendingIndex]))
+		{
+			mLevelStarts.push_back(i);
+		}
+	}
+	mLevelStarts.push_back(nodeCount);
+	mPendingNodes.clear();
+
+	// world matrices are valid as soon as the build is done
+	Update();
+}
+
+void TransformHierarchy::Update()
+{
+	const uint32_t nodeCount = static_cast<uint32_t>(mTransforms.size());
+	RunRange(0, nodeCount, [this](uint32_t begin, uint32_t end)
+	{
+		DetectChanges(begin, end);
+	});
+
+	// every depth reads the depth before it, so they run one after the other
+	for (std::size_t level = 0; level + 1 < mLevelStarts.size(); ++level)
+	{
+		RunRange(mLevelStarts[level], mLevelStarts[level + 1], [this](uint32_t begin, uint32_t end)
+		{
+			Recompute(begin, end);
+		});
+	}
+
+	mRecomputedCount = 0;
+	for (uint8_t& dirty : mDirty)
+	{
+		mRecomputedCount += dirty;
+		dirty = 0;
+	}
+}
+
+uint32_t TransformHierarchy::GetNodeCount() const
+{
+	return static_cast<uint32_t>(mTransforms.size());
+}
+
+uint32_t TransformHierarchy::GetLevelCount() const
+{
+	return mLevelStarts.empty() ? 0 : static_cast<uint32_t>(mLevelStarts.size() - 1);
+}
+
+uint32_t TransformHierarchy::GetRecomputedCount() const
+{
+	return mRecomputedCount;
+}
+
+void TransformHierarchy::DetectChanges(uint32_t begin, uint32_t end)
+{
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const Graphics::Transform& local = *mTransforms[i];
+		if (std::memcmp(&local, &mLocals[i], sizeof(Graphics::Transform)) != 0)
+		{
+			mLocals[i] = local;
+			mDirty[i] = 1;
+		}
+	}
+}
+
+void TransformHierarchy::Recompute(uint32_t begin, uint32_t end)
+{
+	for (uint32_t i = begin; i < end; ++i)
+	{
+		const int32_t parent = mParents[i];
+		if (parent >= 0 && mDirty[parent] != 0)
+		{
+			mDirty[i] = 1;
+		}
+		if (mDirty[i] != 0)
+		{
+			ComputeWorldMatrix(mLocals[i], (parent >= 0) ? &mWorldMatrices[parent] : nullptr, mWorldMatrices[i]);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "Precompiled.h"
+#include "TriggerComponent.h"
+#include "SaveUtil.h"
+#include "SnapshotArchive.h"
+#include "GameObject.h"
+#include "TransformComponent.h"
+#include "PhysicsService.h"
+#include "GameWorld.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Physics;
+
+void TriggerComponent::Initialize()
+{
+	PhysicsService* physicsService = GetOwner().GetWorld().GetPhysicsService();
+	if (physicsService != nullptr)
+	{
+		const CollisionShape* collisionShape = CollisionShapeCache::Get()->GetShape(mCollisionShapeId);
+		ASSERT(collisionShape != nullptr, "TriggerComponent: Requires shape data!");
+		TransformComponent* transformComponent = GetOwner().GetComponent<TransformComponent>();
+		mTriggerVolume.Initialize(*transformComponent, *collisionShape, false);
+		physicsService->Register(this);
+	}
+}
+
+void TriggerComponent::Terminate()
+{
+	PhysicsService* physicsService = GetOwner().GetWorld().GetPhysicsService();
+	if (physicsService != nullptr)
+	{
+		physicsService->Unregister(this);
+	}
+
+	mTriggerVolume.Terminate();
+	SetCollisionShape(0);
+}
+
+void TriggerComponent::Deserialize(const rapidjson::Value& value)
+{
+	CollisionShapeId shapeId = 0;
+	if (SaveUtil::ReadCollisionShape("ColliderData", shapeId, value))
+	{
+		SetCollisionShape(shapeId);
+	}
+}
+
+void TriggerComponent::SaveState(SnapshotWriter& writer) const
+{
+	SaveUtil::SaveCollisionShape(writer, mCollisionShapeId);
+}
+
+void TriggerComponent::LoadState(SnapshotReader& reader)
+{
+	CollisionShapeId shapeId = 0;
+	if (SaveUtil::LoadCollisionShape(reader, shapeId))
+	{
+		SetCollisionShape(shapeId);
+	}
+}
+
+void TriggerComponent::SetCollisionShape(CollisionShapeId shapeId)
+{
+	if (mCollisionShapeId != 0)
+	{
+		CollisionShapeCache::Get()->Release(mCollisionShapeId);
+	}
+	mCollisionShapeId = shapeId;
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "Precompiled.h"
+#include "TypeRegistry.h"
+
+#include "TransformComponent.h"
+#include "CameraComponent.h"
+#include "FPSCameraComponent.h"
+#include "MeshComponent.h"
+#include "ModelComponent.h"
+#include "AnimatorComponent.h"
+#include "RigidBodyComponent.h"
+#include "SpatialComponent.h"
+#include "TriggerComponent.h"
+#include "SoundEventComponent.h"
+#include "SoundBankComponent.h"
+#include "UITextComponent.h"
+#include "UISpriteComponent.h"
+#include "UIButtonComponent.h"
+
+#include "CameraService.h"
+#include "RenderService.h"
+#include "PhysicsService.h"
+#include "UIRenderService.h"
+#include "SpatialService.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+	// keyed by name hash, map nodes never move so the returned pointers stay valid as modules register
+	template<class RegistrationType>
+	struct Registrations
+	{
+		std::unordered_map<uint32_t, RegistrationType> byNameHash;
+		std::unordered_map<uint32_t, uint32_t> nameHashByTypeId;
+	};
+
+	struct Registry
+	{
+		Registry();
+
+		Registrations<ComponentRegistration> components;
+		Registrations<ServiceRegistration> services;
+	};
+
+	template<class RegistrationType>
+	bool Register(Registrations<RegistrationType>& registrations, const RegistrationType& registration, const char* kind)
+	{
+		const uint32_t nameHash = HashTypeName(registration.name);
+		auto iter = registrations.byNameHash.find(nameHash);
+		if (iter != registrations.byNameHash.end())
+		{
+			ASSERT(iter->second.name == registration.name && iter->second.typeId == registration.typeId,
+				"TypeRegistry: %s %s clashes with %s.", kind, registration.name.c_str(), iter->second.name.c_str());
+			return false;
+		}
+		auto typeIter = registrations.nameHashByTypeId.find(registration.typeId);
+		if (typeIter != registrations.nameHashByTypeId.end())
+		{
+			ASSERT(false, "TypeRegistry: %s %s uses the type id of %s.", kind, registration.name.c_str(),
+				registrations.byNameHash[typeIter->second].name.c_str());
+			return false;
+		}
+
+		registrations.byNameHash.emplace(nameHash, registration);
+		registrations.nameHashByTypeId.emplace(registration.typeId, nameHash);
+		return true;
+	}
+
+	template<class RegistrationType>
+	const RegistrationType* Find(const Registrations<RegistrationType>& registrations, uint32_t nameHash)
+	{
+		auto iter = registrations.byNameHash.find(nameHash);
+		return (iter != registrations.byNameHash.end()) ? &iter->second : nullptr;
+	}
+
+	template<class RegistrationType>
+	const RegistrationType* FindByTypeId(const Registrations<RegistrationType>& registrations, uint32_t typeId)
+	{
+		auto iter = registrations.nameHashByTypeId.find(typeId);
+		return (iter != registrations.nameHashByTypeId.end()) ? Find(registrations, iter->second) : nullptr;
+	}
+
+	Registry& GetRegistry()
+	{
+		static Registry sRegistry;
+		return sRegistry;
+	}
+
+	// engine types are registered here rather than in their own files, so no object file has to be referenced to be linked
+	Registry::Registry()
+	{
+		using namespace TypeRegistry;
+		Register(components, MakeComponentRegistration<TransformComponent>("TransformComponent"), "component");
+		Register(components, MakeComponentRegistration<CameraComponent>("CameraComponent"), "component");
+		Register(components, MakeComponentRegistration<FPSCameraComponent>("FPSCameraComponent"), "component");
+		Register(components, MakeComponentRegistration<MeshComponent>("MeshComponent"), "component");
+		Register(components, MakeComponentRegistration<ModelComponent>("ModelComponent"), "component");
+		Register(components, MakeComponentRegistration<AnimatorComponent>("AnimatorComponent"), "component");
+		Register(components, MakeComponentRegistration<RigidBodyComponent>("RigidBodyComponent"), "component");
+		Register(components, MakeComponentRegistration<TriggerComponent>("TriggerComponent"), "component");
+		Register(components, MakeComponentRegistration<SpatialComponent>("SpatialComponent"), "component");
+		Register(components, MakeComponentRegistration<SoundEventComponent>("SoundEventComponent"), "component");
+		Register(components, MakeComponentRegistration<SoundBankComponent>("SoundBankComponent"), "component");
+		Register(components, MakeComponentRegistration<UITextComponent>("UITextComponent"), "component");
+		Register(components, MakeComponentRegistration<UISpriteComponent>("UISpriteComponent"), "component");
+		Register(components, MakeComponentRegistration<UIButtonComponent>("UIButtonComponent"), "component");
+
+		Register(services, MakeServiceRegistration<CameraService>("CameraService"), "service");
+		Register(services, MakeServiceRegistration<RenderService>("RenderService"), "service");
+		Register(services, MakeServiceRegistration<PhysicsService>("PhysicsService"), "service");
+		Register(services, MakeServiceRegistration<UIRenderService>("UIRenderService"), "service");
+		Register(services, MakeServiceRegistration<SpatialService>("SpatialService"), "service");
+	}
+}
+
+bool TypeRegistry::RegisterComponent(const ComponentRegistration& registration)
+{
+	return Register(GetRegistry().components, registration, "component");
+}
+
+bool TypeRegistry::RegisterService(const ServiceRegistration& registration)
+{
+	return Register(GetRegistry().services, registration, "service");
+}
+
+const ComponentRegistration* TypeRegistry::FindComponent(uint32_t nameHash)
+{
+	return Find(GetRegistry().components, nameHash);
+}
+
+const ComponentRegistration* TypeRegistry::FindComponent(std::string_view name)
+{
+	const ComponentRegistration* registration = FindComponent(HashTypeName(name));
+	return (registration != nullptr && registration->name == name) ? registration : nullptr;
+}
+
+const ServiceRegistration* TypeRegistry::FindService(uint32_t nameHash)
+{
+	return Find(GetRegistry().services, nameHash);
+}
+
+const ServiceRegistration* TypeRegistry::FindService(std::string_view name)
+{
+	const ServiceRegistration* registration = FindService(HashTypeName(name));
+	return (registration != nullptr && registration->name == name) ? registration : nullptr;
+}
+
+const ComponentRegistration* TypeRegistry::FindComponentByTypeId(uint32_t typeId)
+{
+	return FindByTypeId(GetRegistry().components, typeId);
+}
+
+const ServiceRegistration* TypeRegistry::FindServiceByTypeId(uint32_t typeId)
+{
+	return FindByTypeId(GetRegistry().services, typeId);
+}
+
+uint32_t TypeRegistry::GetComponentCount()
+{
+	return static_cast<uint32_t>(GetRegistry().components.byNameHash.size());
+}
+
+uint32_t TypeRegistry::GetServiceCount()
+{
+	return static_cast<uint32_t>(GetRegistry().services.byNameHash.size());
+}
\ No newline at end of file
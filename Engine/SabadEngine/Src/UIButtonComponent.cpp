@@ -2,7 +2,7 @@
 #include "UIButtonComponent.h"
 #include "GameWorld.h"
 #include "UIRenderService.h"
-#include "UISpriteComponent.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 using namespace SabadEngine::Graphics;
@@ -19,14 +19,14 @@ void UIButtonComponent::Initialize()
 	}
 
 	//mCurrentState = ButtonState::Disabled;
-	UIRenderService* uiRenderService = GetOwner().GetWorld().GetService<UIRenderService>();
-	uiRenderService->Register(this);
+	mUIRenderService = GetOwner().GetWorld().GetUIRenderService();
+	mUIRenderService->Register(this);
 }
 
 void UIButtonComponent::Terminate()
 {
-	UIRenderService* uiRenderService = GetOwner().GetWorld().GetService<UIRenderService>();
-	uiRenderService->Unregister(this);
+	mUIRenderService->Unregister(this);
+	mUIRenderService = nullptr;
 
 	for (ButtonStateEntry& buttonState : mButtonStates)
 	{
@@ -66,25 +66,7 @@ void UIButtonComponent::Render()
 	{
 		buttonStateIndex = 0;
 	}
-	Math::Vector2 worldPosition = GetPosition(false);
-	GameObject* parent = GetOwner().GetParent();
-	while (parent != nullptr)
-	{
-		UISpriteComponent* spriteComponent = parent->GetComponent<UISpriteComponent>();
-		if (spriteComponent != nullptr)
-		{
-			worldPosition += spriteComponent->GetPosition();
-		}
-		else
-		{
-			UIButtonComponent* buttonComponent = parent->GetComponent<UIButtonComponent>();
-			if (buttonComponent != nullptr)
-			{
-				worldPosition += buttonComponent->GetPosition();
-			}
-		}
-		parent = parent->GetParent();
-	}
+	const Math::Vector2 worldPosition = GetPosition(false) + mUIRenderService->GetParentOffset(GetOwner());
 	mButtonStates[buttonStateIndex].sprite.SetPosition({ worldPosition.x, worldPosition.y });
 	UISpriteRenderer::Get()->Render(mButtonStates[buttonStateIndex].sprite);
 }
@@ -176,6 +158,53 @@ void UIButtonComponent::Deserialize(const rapidjson::Value& value)
 	}
 }
 
+void UIButtonComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(Math::Vector2(mPosition.x, mPosition.y));
+	writer.Write(static_cast<uint32_t>(mCurrentState));
+	for (const ButtonStateEntry& buttonState : mButtonStates)
+	{
+		writer.Write(buttonState.texture);
+		writer.Write(buttonState.sprite.GetScale());
+		writer.Write(static_cast<uint32_t>(buttonState.sprite.GetPivot()));
+		writer.Write(static_cast<uint32_t>(buttonState.sprite.GetFlip()));
+		writer.Write(buttonState.sprite.GetColor());
+		writer.Write(buttonState.sprite.GetRotation());
+	}
+}
+
+void UIButtonComponent::LoadState(SnapshotReader& reader)
+{
+	Math::Vector2 position = Math::Vector2::Zero;
+	reader.Read(position);
+	mPosition = { position.x, position.y };
+	const uint32_t currentState = reader.ReadUInt();
+	mCurrentState = (currentState < static_cast<uint32_t>(ButtonState::Count)) ? static_cast<ButtonState>(currentState) : ButtonState::Default;
+	for (ButtonStateEntry& buttonState : mButtonStates)
+	{
+		reader.Read(buttonState.texture);
+		Math::Vector2 scale = { 1.0f, 1.0f };
+		reader.Read(scale);
+		buttonState.sprite.SetScale(scale);
+		const uint32_t pivot = reader.ReadUInt();
+		if (pivot <= static_cast<uint32_t>(Pivot::BottomRight))
+		{
+			buttonState.sprite.SetPivot(static_cast<Pivot>(pivot));
+		}
+		const uint32_t flip = reader.ReadUInt();
+		if (flip <= static_cast<uint32_t>(Flip::Both))
+		{
+			buttonState.sprite.SetFlip(static_cast<Flip>(flip));
+		}
+		Color color = Colors::White;
+		reader.Read(color);
+		buttonState.sprite.SetColor(color);
+		float rotation = 0.0f;
+		reader.Read(rotation);
+		buttonState.sprite.SetRotation(rotation);
+	}
+}
+
 Math::Vector2 UIButtonComponent::GetPosition(bool includeOrigin)
 {
 	float x = 0.0f;
@@ -1,6 +1,9 @@
 #include "Precompiled.h"
 #include "UIRenderService.h"
 #include "UIComponent.h"
+#include "UIButtonComponent.h"
+#include "UISpriteComponent.h"
+#include "GameObject.h"
 
 using namespace SabadEngine;
 using namespace SabadEngine::Graphics;
@@ -8,10 +11,12 @@ using namespace SabadEngine::Graphics;
 void UIRenderService::Terminate()
 {
 	mUIComponents.clear();
+	mParentOffsets.clear();
 }
 
 void UIRenderService::Render()
 {
+	mParentOffsets.clear();
 	UISpriteRenderer::Get()->BeginRender();
 
 	for (UIComponent* uiComponent : mUIComponents)
@@ -38,4 +43,36 @@ void UIRenderService::Unregister(UIComponent* uiComponent)
 	{
 		mUIComponents.erase(iter);
 	}
+}
+
+Math::Vector2 UIRenderService::GetParentOffset(GameObject& gameObject)
+{
+	GameObject* parent = gameObject.GetParent();
+	if (parent == nullptr)
+	{
+		return Math::Vector2::Zero;
+	}
+	auto iter = mParentOffsets.find(&gameObject);
+	if (iter != mParentOffsets.end())
+	{
+		return iter->second;
+	}
+
+	// siblings share the parent's offset, so each parent chain is only walked once a frame
+	Math::Vector2 offset = GetParentOffset(*parent);
+	UISpriteComponent* spriteComponent = parent->GetComponent<UISpriteComponent>();
+	if (spriteComponent != nullptr)
+	{
+		offset += spriteComponent->GetPosition();
+	}
+	else
+	{
+		UIButtonComponent* buttonComponent = parent->GetComponent<UIButtonComponent>();
+		if (buttonComponent != nullptr)
+		{
+			offset += buttonComponent->GetPosition();
+		}
+	}
+	mParentOffsets.emplace(&gameObject, offset);
+	return offset;
 }
\ No newline at end of file
@@ -4,9 +4,9 @@
 #include "GameObject.h"
 #include "GameWorld.h"
 #include "UIRenderService.h"
-#include "UIButtonComponent.h"
 
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 using namespace SabadEngine::Graphics;
@@ -19,15 +19,15 @@ void UISpriteComponent::Initialize()
 	{
 		mUISprite.SetRect(mRect.top, mRect.left, mRect.right, mRect.bottom);
 	}
-	UIRenderService* uiRenderService = GetOwner().GetWorld().GetService<UIRenderService>();
-	ASSERT(uiRenderService != nullptr, "UISpriteComponent: Needs a UI render service!");
-	uiRenderService->Register(this);
+	mUIRenderService = GetOwner().GetWorld().GetUIRenderService();
+	ASSERT(mUIRenderService != nullptr, "UISpriteComponent: Needs a UI render service!");
+	mUIRenderService->Register(this);
 }
 
 void UISpriteComponent::Terminate()
 {
-	UIRenderService* uiRenderService = GetOwner().GetWorld().GetService<UIRenderService>();
-	uiRenderService->Unregister(this);
+	mUIRenderService->Unregister(this);
+	mUIRenderService = nullptr;
 	mUISprite.Terminate();
 }
 
@@ -36,28 +36,8 @@ void UISpriteComponent::Render()
 	if (!mActive) return;
 
 	//UISpriteRenderer::Get()->Render(mUISprite);
-	Math::Vector2 worldPos = GetPosition(false);
-	GameObject* parent = GetOwner().GetParent();
-	while (parent != nullptr)
-	{
-		UISpriteComponent* spriteComponent = parent->GetComponent<UISpriteComponent>();
-		if (spriteComponent != nullptr)
-		{
-			worldPos += spriteComponent->GetPosition();
-		}
-		else
-		{
-			UIButtonComponent* buttonComponent = parent->GetComponent<UIButtonComponent>();
-			if (buttonComponent != nullptr)
-			{
-				// We need to add the buttons position too as the button component is what is actually rendering the sprite,
-				// so the sprite component's position is relative to the button component, not the other way around
-				worldPos += buttonComponent->GetPosition();
-			}
-		}
-
-		parent = parent->GetParent();
-	}
+	// a button parent counts too, the sprite's position is relative to the button that owns it
+	Math::Vector2 worldPos = GetPosition(false) + mUIRenderService->GetParentOffset(GetOwner());
 
 	mUISprite.SetPosition({ worldPos.x, worldPos.y });
 	UISpriteRenderer::Get()->Render(mUISprite);
@@ -124,6 +104,57 @@ void UISpriteComponent::Deserialize(const rapidjson::Value& value)
 	SaveUtil::ReadFloat("Rotation", rotation, value);
 }
 
+void UISpriteComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mTexturePath.u8string());
+	writer.Write(mPosition);
+	writer.Write(static_cast<int>(mRect.top));
+	writer.Write(static_cast<int>(mRect.left));
+	writer.Write(static_cast<int>(mRect.right));
+	writer.Write(static_cast<int>(mRect.bottom));
+	writer.Write(mUISprite.GetScale());
+	writer.Write(static_cast<uint32_t>(mUISprite.GetPivot()));
+	writer.Write(static_cast<uint32_t>(mUISprite.GetFlip()));
+	writer.Write(mUISprite.GetColor());
+	writer.Write(mUISprite.GetRotation());
+	writer.Write(mActive);
+}
+
+void UISpriteComponent::LoadState(SnapshotReader& reader)
+{
+	std::string texturePath;
+	reader.Read(texturePath);
+	mTexturePath = std::filesystem::u8path(texturePath);
+	reader.Read(mPosition);
+	int rect[4] = {};
+	for (int& side : rect)
+	{
+		reader.Read(side);
+	}
+	mRect = { rect[1], rect[0], rect[2], rect[3] };
+
+	Math::Vector2 scale = { 1.0f, 1.0f };
+	reader.Read(scale);
+	mUISprite.SetScale(scale);
+	const uint32_t pivot = reader.ReadUInt();
+	if (pivot <= static_cast<uint32_t>(Pivot::BottomRight))
+	{
+		mUISprite.SetPivot(static_cast<Pivot>(pivot));
+	}
+	const uint32_t flip = reader.ReadUInt();
+	if (flip <= static_cast<uint32_t>(Flip::Both))
+	{
+		mUISprite.SetFlip(static_cast<Flip>(flip));
+	}
+	Color color = Colors::White;
+	reader.Read(color);
+	mUISprite.SetColor(color);
+	float rotation = 0.0f;
+	reader.Read(rotation);
+	mUISprite.SetRotation(rotation);
+	reader.Read(mActive);
+}
+
 Math::Vector2 UISpriteComponent::GetPosition(bool includeOrigin)
 {
 	if (includeOrigin)
@@ -5,20 +5,21 @@
 #include "GameWorld.h"
 #include "UIRenderService.h"
 #include "SaveUtil.h"
+#include "SnapshotArchive.h"
 
 using namespace SabadEngine;
 using namespace SabadEngine::Graphics;
 
 void UITextComponent::Initialize()
 {
-	UIRenderService* uiRenderService = GetOwner().GetWorld().GetService<UIRenderService>();
+	UIRenderService* uiRenderService = GetOwner().GetWorld().GetUIRenderService();
 	ASSERT(uiRenderService != nullptr, "UITextComponent: Needs a UI render service!");
 	uiRenderService->Register(this);
 }
 
 void UITextComponent::Terminate()
 {
-	UIRenderService* uiRenderService = GetOwner().GetWorld().GetService<UIRenderService>();
+	UIRenderService* uiRenderService = GetOwner().GetWorld().GetUIRenderService();
 	uiRenderService->Unregister(this);
 }
 
@@ -43,6 +44,24 @@ void UITextComponent::Deserialize(const rapidjson::Value& value)
 	SaveUtil::ReadFloat("Size", mSize, value);
 }
 
+void UITextComponent::SaveState(SnapshotWriter& writer) const
+{
+	writer.Write(mText.u8string());
+	writer.Write(mPosition);
+	writer.Write(mColor);
+	writer.Write(mSize);
+}
+
+void UITextComponent::LoadState(SnapshotReader& reader)
+{
+	std::string text;
+	reader.Read(text);
+	mText = std::filesystem::u8path(text);
+	reader.Read(mPosition);
+	reader.Read(mColor);
+	reader.Read(mSize);
+}
+
 void UITextComponent::SetText(const std::string& text)
 {
 	mText = text;
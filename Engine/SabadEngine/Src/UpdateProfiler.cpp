@@ -0,0 +1,236 @@
+#include "Precompiled.h"
+#include "UpdateProfiler.h"
+#include "Service.h"
+#include "TypeRegistry.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+	const char* GetPhaseName(ProfilePhase phase)
+	{
+		switch (phase)
+		{
+		case ProfilePhase::Update: return "Update";
+		case ProfilePhase::LateUpdate: return "LateUpdate";
+		case ProfilePhase::Render: return "Render";
+		case ProfilePhase::DebugUI: return "DebugUI";
+		default: return "Unknown";
+		}
+	}
+}
+
+void UpdateProfiler::SetEnabled(bool enabled)
+{
+	if (enabled && !mEnabled)
+	{
+		for (auto& entry : mEntries)
+		{
+			for (PhaseTimes& times : entry->phases)
+			{
+				times.frameNs = 0;
+				times.frameCalls = 0;
+			}
+		}
+	}
+	mEnabled = enabled;
+}
+
+uint32_t UpdateProfiler::GetComponentEntry(uint32_t typeId)
+{
+	auto iter = mComponentEntries.find(typeId);
+	if (iter != mComponentEntries.end())
+	{
+		return iter->second;
+	}
+	const ComponentRegistration* registration = TypeRegistry::FindComponentByTypeId(typeId);
+	const uint32_t entry = AddEntry((registration != nullptr) ? registration->name : "Component " + std::to_string(typeId), false);
+	mComponentEntries.emplace(typeId, entry);
+	return entry;
+}
+
+uint32_t UpdateProfiler::GetServiceEntry(const Service& service)
+{
+	const uint32_t typeId = service.GetTypeId();
+	auto iter = mServiceEntries.find(typeId);
+	if (iter != mServiceEntries.end())
+	{
+		return iter->second;
+	}
+	const ServiceRegistration* registration = TypeRegistry::FindServiceByTypeId(typeId);
+	const uint32_t entry = AddEntry((registration != nullptr) ? registration->name : "Service " + std::to_string(typeId), true);
+	mServiceEntries.emplace(typeId, entry);
+	return entry;
+}
+
+UpdateProfiler::Clock::time_point UpdateProfiler::Record(uint32_t entry, ProfilePhase phase, const Clock::time_point& start, uint32_t callCount)
+{
+	const Clock::time_point end = Clock::now();
+	if (entry < mEntries.size())
+	{
+		PhaseTimes& times = mEntries[entry]->phases[static_cast<size_t>(phase)];
+		times.frameNs.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()), std::memory_order_relaxed);
+		times.frameCalls.fetch_add(callCount, std::memory_order_relaxed);
+	}
+	return end;
+}
+
+void UpdateProfiler::EndFrame()
+{
+	for (auto& entry : mEntries)
+	{
+		for (PhaseTimes& times : entry->phases)
+		{
+			const uint32_t calls = times.frameCalls.exchange(0, std::memory_order_relaxed);
+			const uint64_t frameNs = times.frameNs.exchange(0, std::memory_order_relaxed);
+			if (calls == 0)
+			{
+				continue;
+			}
+			times.history[times.frameCount % FrameHistory] = static_cast<float>(frameNs * 1e-6);
+			times.totalNs += frameNs;
+			times.totalCalls += calls;
+			++times.frameCount;
+		}
+	}
+	++mFrameCount;
+}
+
+void UpdateProfiler::Reset()
+{
+	for (auto& entry : mEntries)
+	{
+		for (PhaseTimes& times : entry->phases)
+		{
+			times.frameNs = 0;
+			times.frameCalls = 0;
+			times.totalNs = 0;
+			times.totalCalls = 0;
+			times.frameCount = 0;
+		}
+	}
+	mFrameCount = 0;
+}
+
+uint32_t UpdateProfiler::GetFrameCount() const
+{
+	return mFrameCount;
+}
+
+std::vector<UpdateProfiler::Row> UpdateProfiler::GetRows() const
+{
+	std::vector<Row> rows;
+	std::vector<float> samples;
+	for (const auto& entry : mEntries)
+	{
+		for (size_t p = 0; p < entry->phases.size(); ++p)
+		{
+			const PhaseTimes& times = entry->phases[p];
+			if (times.frameCount == 0)
+			{
+				continue;
+			}
+			Row& row = rows.emplace_back();
+			row.name = entry->name;
+			row.isService = entry->isService;
+			row.phase = static_cast<ProfilePhase>(p);
+			row.totalMs = times.totalNs * 1e-6;
+			row.averageMs = row.totalMs / times.frameCount;
+			row.callCount = times.totalCalls;
+			row.callsPerFrame = static_cast<double>(times.totalCalls) / times.frameCount;
+			row.frameCount = times.frameCount;
+
+			samples.assign(times.history.begin(), times.history.begin() + std::min(times.frameCount, FrameHistory));
+			const size_t p95Index = (samples.size() * 95) / 100;
+			std::nth_element(samples.begin(), samples.begin() + std::min(p95Index, samples.size() - 1), samples.end());
+			row.p95Ms = samples[std::min(p95Index, samples.size() - 1)];
+		}
+	}
+	std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b)
+	{
+		return a.averageMs > b.averageMs;
+	});
+	return rows;
+}
+
+bool UpdateProfiler::SaveToCsv(const std::filesystem::path& filePath) const
+{
+	FILE* file = nullptr;
+	auto err = fopen_s(&file, filePath.u8string().c_str(), "w");
+	if (err != 0 || file == nullptr)
+	{
+		LOG("UpdateProfiler: failed to write %s", filePath.u8string().c_str());
+		return false;
+	}
+	fprintf(file, "type,kind,phase,ms_per_frame,p95_ms,calls_per_frame,total_ms,calls,frames\n");
+	for (const Row& row : GetRows())
+	{
+		fprintf(file, "%s,%s,%s,%.6f,%.6f,%.2f,%.6f,%llu,%u\n", row.name.c_str(), row.isService ? "service" : "component",
+			GetPhaseName(row.phase), row.averageMs, row.p95Ms, row.callsPerFrame, row.totalMs,
+			static_cast<unsigned long long>(row.callCount), row.frameCount);
+	}
+	fclose(file);
+	return true;
+}
+
+void UpdateProfiler::DebugUI()
+{
+	if (!ImGui::CollapsingHeader("Update Profiler"))
+	{
+		return;
+	}
+	bool enabled = mEnabled;
+	if (ImGui::Checkbox("Enabled##UpdateProfiler", &enabled))
+	{
+		SetEnabled(enabled);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Reset##UpdateProfiler"))
+	{
+		Reset();
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Save CSV##UpdateProfiler"))
+	{
+		const std::filesystem::path filePath = "update_profile.csv";
+		if (SaveToCsv(filePath))
+		{
+			LOG("UpdateProfiler: saved %s", std::filesystem::absolute(filePath).u8string().c_str());
+		}
+	}
+	ImGui::Text("Frames: %u", mFrameCount);
+
+	const std::vector<Row> rows = GetRows();
+	if (ImGui::BeginTable("UpdateProfilerTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+	{
+		ImGui::TableSetupColumn("Type");
+		ImGui::TableSetupColumn("Phase");
+		ImGui::TableSetupColumn("ms/frame");
+		ImGui::TableSetupColumn("p95 ms");
+		ImGui::TableSetupColumn("calls/frame");
+		ImGui::TableHeadersRow();
+		for (const Row& row : rows)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", row.name.c_str());
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", GetPhaseName(row.phase));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", row.averageMs);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", row.p95Ms);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", row.callsPerFrame);
+		}
+		ImGui::EndTable();
+	}
+}
+
+uint32_t UpdateProfiler::AddEntry(std::string name, bool isService)
+{
+	auto& entry = mEntries.emplace_back(std::make_unique<Entry>());
+	entry->name = std::move(name);
+	entry->isService = isService;
+	return static_cast<uint32_t>(mEntries.size() - 1);
+}
\ No newline at end of file
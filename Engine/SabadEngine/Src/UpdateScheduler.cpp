@@ -0,0 +1,344 @@
+#include "Precompiled.h"
+#include "UpdateScheduler.h"
+#include "Component.h"
+#include "Service.h"
+#include "GameObject.h"
+#include "TransformComponent.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+	// per object components per job, small enough to balance, large enough to hide the job overhead
+	constexpr uint32_t ComponentBatchSize = 64;
+	constexpr uint32_t InvalidNode = std::numeric_limits<uint32_t>::max();
+
+	// where the last profiled batch on this thread ended, the next batch of the same level starts timing there
+	// so a thread working through a level reads the clock once per batch
+	struct ProfileCursor
+	{
+		const void* level = nullptr;
+		uint32_t frameIndex = 0;
+		UpdateProfiler::Clock::time_point time;
+	};
+	thread_local ProfileCursor tProfileCursor;
+}
+
+void UpdateScheduler::Clear()
+{
+	mUpdatePhase = {};
+	mLateUpdatePhase = {};
+	mServiceNodes.clear();
+	mServiceLevels.clear();
+}
+
+void UpdateScheduler::AddComponent(Component* component, uint32_t componentSlot)
+{
+	// components with the empty default never enter a phase, so they cost nothing per frame
+	if (component->HasUpdate())
+	{
+		AddToPhase(mUpdatePhase, component, componentSlot);
+	}
+	if (component->HasLateUpdate())
+	{
+		AddToPhase(mLateUpdatePhase, component, componentSlot);
+	}
+}
+
+void UpdateScheduler::AddService(Service* service)
+{
+	Node& node = mServiceNodes.emplace_back();
+	node.access = service->GetUpdateAccess();
+	node.service = service;
+}
+
+void UpdateScheduler::Build(UpdateProfiler* profiler)
+{
+	BuildPhase(mUpdatePhase);
+	BuildPhase(mLateUpdatePhase);
+	BuildLevels(mServiceNodes, mServiceLevels);
+
+	mProfiler = profiler;
+	if (mProfiler != nullptr)
+	{
+		for (ComponentPhase* componentPhase : { &mUpdatePhase, &mLateUpdatePhase })
+		{
+			for (Level& level : componentPhase->levels)
+			{
+				for (Batch& batch : level.batches)
+				{
+					batch.profileEntry = mProfiler->GetComponentEntry(componentPhase->nodes[batch.node].components[batch.begin]->GetTypeId());
+				}
+			}
+		}
+		for (Level& level : mServiceLevels)
+		{
+			for (Batch& batch : level.batches)
+			{
+				batch.profileEntry = mProfiler->GetServiceEntry(*mServiceNodes[batch.node].service);
+			}
+		}
+	}
+}
+
+void UpdateScheduler::Run(UpdatePhase phase, float deltaTime)
+{
+	if (phase == UpdatePhase::Update)
+	{
+		++mFrameIndex;
+	}
+	const bool isServicePhase = (phase == UpdatePhase::Services);
+	const ComponentPhase& componentPhase = (phase == UpdatePhase::Update) ? mUpdatePhase : mLateUpdatePhase;
+	const std::vector<Node>& nodes = isServicePhase ? mServiceNodes : componentPhase.nodes;
+	const std::vector<Level>& levels = isServicePhase ? mServiceLevels : componentPhase.levels;
+	const bool profiling = (mProfiler != nullptr && mProfiler->IsEnabled());
+	Core::JobSystem* jobSystem = Core::JobSystem::TryGet();
+	for (const Level& level : levels)
+	{
+		if (level.mainThread || level.batches.size() == 1 || jobSystem == nullptr)
+		{
+			for (const Batch& batch : level.batches)
+			{
+				RunBatch(nodes, level, batch, phase, deltaTime, profiling);
+			}
+			continue;
+		}
+		jobSystem->ParallelFor(level.batches.size(), 1, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				RunBatch(nodes, level, level.batches[i], phase, deltaTime, profiling);
+			}
+		});
+	}
+}
+
+void UpdateScheduler::SetTickView(const TickView& tickView)
+{
+	mTickView = tickView;
+}
+
+const TickView& UpdateScheduler::GetTickView() const
+{
+	return mTickView;
+}
+
+uint32_t UpdateScheduler::GetNodeCount(UpdatePhase phase) const
+{
+	switch (phase)
+	{
+	case UpdatePhase::Update: return static_cast<uint32_t>(mUpdatePhase.nodes.size());
+	case UpdatePhase::LateUpdate: return static_cast<uint32_t>(mLateUpdatePhase.nodes.size());
+	default: return static_cast<uint32_t>(mServiceNodes.size());
+	}
+}
+
+uint32_t UpdateScheduler::GetLevelCount(UpdatePhase phase) const
+{
+	switch (phase)
+	{
+	case UpdatePhase::Update: return static_cast<uint32_t>(mUpdatePhase.levels.size());
+	case UpdatePhase::LateUpdate: return static_cast<uint32_t>(mLateUpdatePhase.levels.size());
+	default: return static_cast<uint32_t>(mServiceLevels.size());
+	}
+}
+
+uint32_t UpdateScheduler::GetWorkCount(UpdatePhase phase) const
+{
+	switch (phase)
+	{
+	case UpdatePhase::Update: return mUpdatePhase.componentCount;
+	case UpdatePhase::LateUpdate: return mLateUpdatePhase.componentCount;
+	default: return static_cast<uint32_t>(mServiceNodes.size());
+	}
+}
+
+void UpdateScheduler::AddToPhase(ComponentPhase& componentPhase, Component* component, uint32_t componentSlot)
+{
+	if (componentSlot >= componentPhase.nodeBySlot.size())
+	{
+		componentPhase.nodeBySlot.resize(componentSlot + 1, InvalidNode);
+	}
+	uint32_t& nodeIndex = componentPhase.nodeBySlot[componentSlot];
+	if (nodeIndex == InvalidNode)
+	{
+		const UpdateAccess access = component->GetUpdateAccess();
+		if (access.threading == UpdateThreading::MainThread && componentPhase.mainThreadNode != InvalidNode)
+		{
+			nodeIndex = componentPhase.mainThreadNode;
+		}
+		else
+		{
+			nodeIndex = static_cast<uint32_t>(componentPhase.nodes.size());
+			Node& node = componentPhase.nodes.emplace_back();
+			node.access = access;
+			if (access.threading == UpdateThreading::MainThread)
+			{
+				componentPhase.mainThreadNode = nodeIndex;
+			}
+		}
+	}
+	componentPhase.nodes[nodeIndex].components.push_back(component);
+	++componentPhase.componentCount;
+}
+
+void UpdateScheduler::BuildPhase(ComponentPhase& componentPhase)
+{
+	// component types run in slot order, not in the order they were first seen
+	// the shared main thread node moves once, to the first slot that uses it
+	std::vector<Node> sortedNodes;
+	sortedNodes.reserve(componentPhase.nodes.size());
+	std::vector<uint32_t> sortedIndex(componentPhase.nodes.size(), InvalidNode);
+	for (uint32_t& nodeIndex : componentPhase.nodeBySlot)
+	{
+		if (nodeIndex == InvalidNode)
+		{
+			continue;
+		}
+		if (sortedIndex[nodeIndex] == InvalidNode)
+		{
+			sortedNodes.push_back(std::move(componentPhase.nodes[nodeIndex]));
+			sortedIndex[nodeIndex] = static_cast<uint32_t>(sortedNodes.size() - 1);
+		}
+		nodeIndex = sortedIndex[nodeIndex];
+	}
+	if (componentPhase.mainThreadNode != InvalidNode)
+	{
+		componentPhase.mainThreadNode = sortedIndex[componentPhase.mainThreadNode];
+	}
+	componentPhase.nodes = std::move(sortedNodes);
+	BuildLevels(componentPhase.nodes, componentPhase.levels);
+}
+
+bool UpdateScheduler::Conflicts(const UpdateAccess& a, const UpdateAccess& b)
+{
+	if (a.threading == UpdateThreading::MainThread || b.threading == UpdateThreading::MainThread)
+	{
+		return true;
+	}
+	return (a.writes & (b.reads | b.writes)) != 0 || (b.writes & a.reads) != 0;
+}
+
+void UpdateScheduler::BuildLevels(const std::vector<Node>& nodes, std::vector<Level>& levels)
+{
+	// a node goes one level past the latest earlier node it conflicts with
+	levels.clear();
+	std::vector<uint32_t> nodeLevels(nodes.size(), 0);
+	for (std::size_t j = 0; j < nodes.size(); ++j)
+	{
+		uint32_t levelIndex = 0;
+		for (std::size_t i = 0; i < j; ++i)
+		{
+			if (Conflicts(nodes[i].access, nodes[j].access))
+			{
+				levelIndex = std::max(levelIndex, nodeLevels[i] + 1);
+			}
+		}
+		// main thread nodes conflict with everything, so they always end up alone past every earlier node
+		// and every later node is pushed past them
+		nodeLevels[j] = levelIndex;
+		if (levelIndex >= levels.size())
+		{
+			levels.resize(levelIndex + 1);
+		}
+
+		Level& level = levels[levelIndex];
+		const Node& node = nodes[j];
+		const uint32_t nodeIndex = static_cast<uint32_t>(j);
+		level.mainThread = level.mainThread || (node.access.threading == UpdateThreading::MainThread);
+		const uint32_t count = (node.service != nullptr) ? 1 : static_cast<uint32_t>(node.components.size());
+		if (node.service == nullptr && node.access.threading == UpdateThreading::MainThread)
+		{
+			// the shared main thread node mixes types, each run of one type is its own batch so it profiles as that type
+			uint32_t begin = 0;
+			for (uint32_t i = 1; i <= count; ++i)
+			{
+				if (i == count || node.components[i]->GetTypeId() != node.components[begin]->GetTypeId())
+				{
+					level.batches.push_back({ nodeIndex, begin, i });
+					begin = i;
+				}
+			}
+			continue;
+		}
+		const uint32_t batchSize = (node.access.threading == UpdateThreading::PerObject) ? ComponentBatchSize : count;
+		for (uint32_t begin = 0; begin < count; begin += batchSize)
+		{
+			level.batches.push_back({ nodeIndex, begin, std::min(begin + batchSize, count) });
+		}
+	}
+}
+
+void UpdateScheduler::RunBatch(const std::vector<Node>& nodes, const Level& level, const Batch& batch, UpdatePhase phase, float deltaTime, bool profiling)
+{
+	const Node& node = nodes[batch.node];
+	if (!profiling)
+	{
+		UpdateBatch(node, batch, phase, deltaTime);
+		return;
+	}
+	ProfileCursor& cursor = tProfileCursor;
+	if (cursor.level != &level || cursor.frameIndex != mFrameIndex)
+	{
+		cursor.level = &level;
+		cursor.frameIndex = mFrameIndex;
+		cursor.time = UpdateProfiler::Clock::now();
+	}
+	UpdateBatch(node, batch, phase, deltaTime);
+	const ProfilePhase profilePhase = (phase == UpdatePhase::LateUpdate) ? ProfilePhase::LateUpdate : ProfilePhase::Update;
+	cursor.time = mProfiler->Record(batch.profileEntry, profilePhase, cursor.time, (node.service != nullptr) ? 1 : batch.end - batch.begin);
+}
+
+void UpdateScheduler::UpdateBatch(const Node& node, const Batch& batch, UpdatePhase phase, float deltaTime)
+{
+	if (node.service != nullptr)
+	{
+		node.service->Update(deltaTime);
+		return;
+	}
+	if (phase == UpdatePhase::Update)
+	{
+		for (uint32_t i = batch.begin; i < batch.end; ++i)
+		{
+			Component* component = node.components[i];
+			if (component->mTickInterval == 1 && component->mTickLod == nullptr)
+			{
+				component->Update(deltaTime);
+			}
+			else
+			{
+				TickComponent(component, deltaTime);
+			}
+		}
+	}
+	else
+	{
+		for (uint32_t i = batch.begin; i < batch.end; ++i)
+		{
+			node.components[i]->LateUpdate(deltaTime);
+		}
+	}
+}
+
+void UpdateScheduler::TickComponent(Component* component, float deltaTime) const
+{
+	// the slot offsets the frame so a quarter of the components on interval 4 run each frame
+	component->mTickElapsed += deltaTime;
+	if ((mFrameIndex + component->mTickSlot) % component->mTickInterval != 0)
+	{
+		return;
+	}
+
+	const float elapsed = component->mTickElapsed;
+	component->mTickElapsed = 0.0f;
+	if (component->mTickLod != nullptr)
+	{
+		// the world position from the last hierarchy pass, nothing writes it during the update phase
+		const TransformComponent* transformComponent = component->GetOwner().GetComponent<TransformComponent>();
+		if (transformComponent != nullptr)
+		{
+			component->mTickInterval = component->mTickLod->GetInterval(transformComponent->GetWorldPosition(), mTickView);
+		}
+	}
+	component->Update(elapsed);
+}
\ No newline at end of file
@@ -0,0 +1,273 @@
+#include "Precompiled.h"
+#include "WorldSnapshot.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+	uint32_t BaselineWord(const std::vector<uint32_t>* baseline, std::size_t index)
+	{
+		return (baseline != nullptr && index < baseline->size()) ? (*baseline)[index] : 0;
+	}
+
+	// walks the state a word at a time and gives the baseline word each one is xor'd with
+	// Encode and Decode both walk it, Decode only knows the words it already rebuilt so the cursor only looks back
+	// a record's key is guessed as the one after the last baseline record it matched, its size and words come from
+	// the baseline record with that key, or zero for a record the baseline doesn't have
+	class BaselineCursor
+	{
+	public:
+		explicit BaselineCursor(const std::vector<uint32_t>* baseline)
+			: mBaseline(baseline)
+		{
+			if (baseline == nullptr)
+			{
+				return;
+			}
+			// a record per object, plus the world and the services
+			const std::size_t recordCount = std::min<std::size_t>(BaselineWord(baseline, 0) + 16, baseline->size() / 2);
+			mRecords.reserve(recordCount);
+			mRecordByKey.reserve(recordCount);
+			std::size_t position = WorldSnapshot::HeaderWordCount;
+			while (position + 1 < baseline->size())
+			{
+				const std::size_t first = position + 2;
+				Record record;
+				record.key = (*baseline)[position];
+				record.first = first;
+				record.size = static_cast<uint32_t>(std::min<std::size_t>((*baseline)[position + 1], baseline->size() - first));
+				// the first record with a key wins, a repeated key only costs size
+				mRecordByKey.emplace(record.key, static_cast<uint32_t>(mRecords.size()));
+				mRecords.push_back(record);
+				position = first + record.size;
+			}
+		}
+
+		uint32_t GetBaselineWord() const
+		{
+			switch (mPart)
+			{
+			case Part::Header: return BaselineWord(mBaseline, mIndex);
+			case Part::Key: return (mNextRecord < mRecords.size()) ? mRecords[mNextRecord].key : 0;
+			case Part::Size: return (mRecord != nullptr) ? mRecord->size : 0;
+			default: return (mRecord != nullptr && mIndex < mRecord->size) ? (*mBaseline)[mRecord->first + mIndex] : 0;
+			}
+		}
+
+		// moves on once the state word at the cursor is known
+		void Advance(uint32_t word)
+		{
+			switch (mPart)
+			{
+			case Part::Header:
+				if (++mIndex == WorldSnapshot::HeaderWordCount)
+				{
+					mPart = Part::Key;
+				}
+				break;
+			case Part::Key:
+			{
+				auto iter = mRecordByKey.find(word);
+				mRecord = nullptr;
+				if (iter != mRecordByKey.end())
+				{
+					mRecord = &mRecords[iter->second];
+					mNextRecord = iter->second + 1;
+				}
+				mPart = Part::Size;
+				break;
+			}
+			case Part::Size:
+				mSize = word;
+				mIndex = 0;
+				mPart = (mSize > 0) ? Part::Body : Part::Key;
+				break;
+			default:
+				if (++mIndex == mSize)
+				{
+					mPart = Part::Key;
+				}
+				break;
+			}
+		}
+
+	private:
+		enum class Part
+		{
+			Header,
+			Key,
+			Size,
+			Body
+		};
+
+		struct Record
+		{
+			uint32_t key = 0;
+			std::size_t first = 0;
+			uint32_t size = 0;
+		};
+
+		const std::vector<uint32_t>* mBaseline = nullptr;
+		std::vector<Record> mRecords;
+		std::unordered_map<uint32_t, uint32_t> mRecordByKey;
+		const Record* mRecord = nullptr;
+		std::size_t mNextRecord = 0;
+		uint32_t mIndex = 0;
+		uint32_t mSize = 0;
+		Part mPart = Part::Header;
+	};
+}
+
+uint32_t WorldSnapshot::GetFrame() const
+{
+	return mFrame;
+}
+
+uint32_t WorldSnapshot::GetObjectCount() const
+{
+	return mState.empty() ? 0 : mState[0];
+}
+
+uint32_t WorldSnapshot::GetVersion() const
+{
+	return (mState.size() < 2) ? 0 : mState[1];
+}
+
+std::size_t WorldSnapshot::GetSizeInBytes() const
+{
+	return mState.size() * sizeof(uint32_t);
+}
+
+void WorldSnapshot::Encode(const WorldSnapshot* baseline)
+{
+	const std::vector<uint32_t>* baseState = (baseline != nullptr && baseline != this) ? &baseline->mState : nullptr;
+	const std::size_t wordCount = mState.size();
+	BaselineCursor cursor(baseState);
+
+	// stored as [zero run, literal run, literals...] until every word is written
+	mDelta.clear();
+	mDelta.reserve(wordCount + 2);
+	std::size_t index = 0;
+	while (index < wordCount)
+	{
+		uint32_t zeroCount = 0;
+		while (index < wordCount && mState[index] == cursor.GetBaselineWord())
+		{
+			cursor.Advance(mState[index]);
+			++zeroCount;
+			++index;
+		}
+		mDelta.push_back(zeroCount);
+		const std::size_t literalCountIndex = mDelta.size();
+		mDelta.push_back(0);
+		uint32_t baselineWord = 0;
+		while (index < wordCount && mState[index] != (baselineWord = cursor.GetBaselineWord()))
+		{
+			mDelta.push_back(mState[index] ^ baselineWord);
+			cursor.Advance(mState[index]);
+			++index;
+		}
+		mDelta[literalCountIndex] = static_cast<uint32_t>(mDelta.size() - literalCountIndex - 1);
+	}
+}
+
+const std::vector<uint32_t>& WorldSnapshot::GetDelta() const
+{
+	return mDelta;
+}
+
+std::size_t WorldSnapshot::GetDeltaSizeInBytes() const
+{
+	return mDelta.size() * sizeof(uint32_t);
+}
+
+bool WorldSnapshot::Decode(const WorldSnapshot* baseline, const uint32_t* delta, std::size_t deltaCount, uint32_t frame)
+{
+	ASSERT(baseline != this, "WorldSnapshot: can't decode against itself.");
+	const std::vector<uint32_t>* baseState = (baseline != nullptr) ? &baseline->mState : nullptr;
+	BaselineCursor cursor(baseState);
+
+	mState.clear();
+	std::size_t read = 0;
+	while (read + 1 < deltaCount)
+	{
+		const uint32_t zeroCount = delta[read++];
+		const uint32_t literalCount = delta[read++];
+		if (literalCount > deltaCount - read)
+		{
+			mState.clear();
+			return false;
+		}
+		for (uint32_t i = 0; i < zeroCount; ++i)
+		{
+			const uint32_t word = cursor.GetBaselineWord();
+			mState.push_back(word);
+			cursor.Advance(word);
+		}
+		for (uint32_t i = 0; i < literalCount; ++i)
+		{
+			const uint32_t word = delta[read++] ^ cursor.GetBaselineWord();
+			mState.push_back(word);
+			cursor.Advance(word);
+		}
+	}
+	mDelta.assign(delta, delta + deltaCount);
+	mFrame = frame;
+	return read == deltaCount;
+}
+
+bool WorldSnapshot::SaveToFile(const std::filesystem::path& filePath, const WorldSnapshot* baseline)
+{
+	Encode(baseline);
+	FileHeader header;
+	header.frame = mFrame;
+	header.baselineFrame = (baseline != nullptr) ? baseline->mFrame : NoBaseline;
+	header.deltaCount = static_cast<uint32_t>(mDelta.size());
+
+	FILE* file = nullptr;
+	auto err = fopen_s(&file, filePath.u8string().c_str(), "wb");
+	if (err != 0 || file == nullptr)
+	{
+		LOG("WorldSnapshot: failed to write %s", filePath.u8string().c_str());
+		return false;
+	}
+	const bool written = fwrite(&header, sizeof(FileHeader), 1, file) == 1
+		&& fwrite(mDelta.data(), sizeof(uint32_t), mDelta.size(), file) == mDelta.size();
+	fclose(file);
+	return written;
+}
+
+bool WorldSnapshot::LoadFromFile(const std::filesystem::path& filePath, const WorldSnapshot* baseline)
+{
+	FILE* file = nullptr;
+	auto err = fopen_s(&file, filePath.u8string().c_str(), "rb");
+	if (err != 0 || file == nullptr)
+	{
+		LOG("WorldSnapshot: failed to open %s", filePath.u8string().c_str());
+		return false;
+	}
+
+	FileHeader header;
+	std::vector<uint32_t> delta;
+	bool valid = fread(&header, sizeof(FileHeader), 1, file) == 1 && header.magic == Magic
+		&& header.version >= MinVersion && header.version <= Version;
+	if (valid)
+	{
+		delta.resize(header.deltaCount);
+		valid = fread(delta.data(), sizeof(uint32_t), delta.size(), file) == delta.size();
+	}
+	fclose(file);
+	if (!valid)
+	{
+		LOG("WorldSnapshot: %s is not a world snapshot this version can read", filePath.u8string().c_str());
+		return false;
+	}
+
+	const uint32_t baselineFrame = (baseline != nullptr) ? baseline->mFrame : NoBaseline;
+	if (header.baselineFrame != baselineFrame)
+	{
+		LOG("WorldSnapshot: %s was saved against frame %u, not %u", filePath.u8string().c_str(), header.baselineFrame, baselineFrame);
+		return false;
+	}
+	return Decode(baseline, delta.data(), delta.size(), header.frame);
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "DebugUtil.h"
 #include "Event.h"
 #include "EventManager.h"
+#include "JobSystem.h"
+#include "MappedFile.h"
 #include "TimeUtil.h"
 #include "Window.h"
 #include "WindowMessageHandler.h"
@@ -0,0 +1,56 @@
+#pragma once
+
+namespace SabadEngine::Core
+{
+	// Worker threads that split batches of independent work across the cpu
+	// the calling thread always helps out, so a job system with 0 workers runs everything serially
+	class JobSystem final
+	{
+	public:
+		using Job = std::function<void()>;
+		using RangeJob = std::function<void(std::size_t begin, std::size_t end)>;
+
+		static void StaticInitialize(uint32_t workerCount = 0);
+		static void StaticTerminate();
+		static JobSystem* Get();
+		// nullptr when it isn't initialized, for code that can fall back to running serially
+		static JobSystem* TryGet();
+
+		// 0 for the thread that owns the job system, 1 to workerCount for the worker threads
+		static uint32_t GetThreadIndex();
+
+		JobSystem() = default;
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem(const JobSystem&&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&&) = delete;
+
+		// workerCount of 0 uses every hardware thread except the calling one
+		void Initialize(uint32_t workerCount = 0);
+		void Terminate();
+
+		// splits [0, count) into batches of batchSize and blocks until every batch has run
+		// nested calls from inside a job run serially on the calling worker
+		void ParallelFor(std::size_t count, std::size_t batchSize, const RangeJob& job);
+
+		// limits how many workers ParallelFor will use, used for scaling benchmarks
+		void SetActiveWorkerCount(uint32_t count);
+		uint32_t GetActiveWorkerCount() const;
+		uint32_t GetWorkerCount() const;
+
+		// number of threads that can run a job at the same time, including the caller
+		uint32_t GetThreadCount() const;
+
+	private:
+		void WorkerLoop(uint32_t threadIndex);
+
+		std::vector<std::thread> mWorkers;
+		std::queue<Job> mJobs;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		uint32_t mActiveWorkerCount = 0;
+		bool mStop = false;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+namespace SabadEngine::Core
+{
+	// Read only view of a whole file mapped into memory, pages are loaded by the OS as they are touched
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(const MappedFile&&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&&) = delete;
+
+		bool Open(const std::filesystem::path& filePath);
+		void Close();
+
+		bool IsOpen() const;
+		const uint8_t* GetData() const;
+		std::size_t GetSize() const;
+
+	private:
+		HANDLE mFile = INVALID_HANDLE_VALUE;
+		HANDLE mMapping = nullptr;
+		const uint8_t* mData = nullptr;
+		std::size_t mSize = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "Precompiled.h"
+#include "JobSystem.h"
+#include "DebugUtil.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+
+namespace
+{
+	std::unique_ptr<JobSystem> sJobSystem;
+	thread_local uint32_t tThreadIndex = 0;
+}
+
+void JobSystem::StaticInitialize(uint32_t workerCount)
+{
+	ASSERT(sJobSystem == nullptr, "JobSystem: is already initialized");
+	sJobSystem = std::make_unique<JobSystem>();
+	sJobSystem->Initialize(workerCount);
+}
+
+void JobSystem::StaticTerminate()
+{
+	if (sJobSystem != nullptr)
+	{
+		sJobSystem->Terminate();
+		sJobSystem.reset();
+	}
+}
+
+JobSystem* JobSystem::Get()
+{
+	ASSERT(sJobSystem != nullptr, "JobSystem: is not initialized");
+	return sJobSystem.get();
+}
+
+JobSystem* JobSystem::TryGet()
+{
+	return sJobSystem.get();
+}
+
+uint32_t JobSystem::GetThreadIndex()
+{
+	return tThreadIndex;
+}
+
+JobSystem::~JobSystem()
+{
+	ASSERT(mWorkers.empty(), "JobSystem: terminate must be called");
+}
+
+void JobSystem::Initialize(uint32_t workerCount)
+{
+	ASSERT(mWorkers.empty(), "JobSystem: is already initialized");
+	if (workerCount == 0)
+	{
+		const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+	}
+
+	mStop = false;
+	mActiveWorkerCount = workerCount;
+	mWorkers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+	}
+	LOG("JobSystem: started %u worker threads", workerCount);
+}
+
+void JobSystem::Terminate()
+{
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mStop = true;
+	}
+	mCondition.notify_all();
+	for (std::thread& worker : mWorkers)
+	{
+		if (worker.joinable())
+		{
+			worker.join();
+		}
+	}
+	mWorkers.clear();
+	mJobs = {};
+}
+
+void JobSystem::ParallelFor(std::size_t count, std::size_t batchSize, const RangeJob& job)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	batchSize = std::max<std::size_t>(batchSize, 1);
+	const std::size_t batchCount = (count + batchSize - 1) / batchSize;
+	const std::size_t helperCount = std::min<std::size_t>(mActiveWorkerCount, batchCount - 1);
+	if (helperCount == 0 || tThreadIndex != 0)
+	{
+		job(0, count);
+		return;
+	}
+
+	// every thread pulls batches until they run out, the caller waits on the helpers
+	// before returning because they reference this stack frame
+	std::atomic<std::size_t> nextBatch = 0;
+	std::atomic<std::size_t> pendingHelpers = helperCount;
+	auto runBatches = [&]()
+	{
+		for (std::size_t batch = nextBatch++; batch < batchCount; batch = nextBatch++)
+		{
+			const std::size_t begin = batch * batchSize;
+			const std::size_t end = std::min(begin + batchSize, count);
+			job(begin, end);
+		}
+	};
+
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		for (std::size_t i = 0; i < helperCount; ++i)
+		{
+			mJobs.emplace([&]()
+			{
+				runBatches();
+				--pendingHelpers;
+			});
+		}
+	}
+	mCondition.notify_all();
+
+	runBatches();
+	while (pendingHelpers > 0)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::SetActiveWorkerCount(uint32_t count)
+{
+	mActiveWorkerCount = std::min(count, GetWorkerCount());
+}
+
+uint32_t JobSystem::GetActiveWorkerCount() const
+{
+	return mActiveWorkerCount;
+}
+
+uint32_t JobSystem::GetWorkerCount() const
+{
+	return static_cast<uint32_t>(mWorkers.size());
+}
+
+uint32_t JobSystem::GetThreadCount() const
+{
+	return GetWorkerCount() + 1;
+}
+
+void JobSystem::WorkerLoop(uint32_t threadIndex)
+{
+	tThreadIndex = threadIndex;
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [this]() { return mStop || !mJobs.empty(); });
+			if (mStop && mJobs.empty())
+			{
+				return;
+			}
+			job = std::move(mJobs.front());
+			mJobs.pop();
+		}
+		job();
+	}
+}
\ No newline at end of file
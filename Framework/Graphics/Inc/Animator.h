@@ -14,6 +14,11 @@ namespace SabadEngine::Graphics
 		void Update(float deltaTime);
 
 		bool IsFinished() const;
+		int GetClipIndex() const;
+		bool IsLooping() const;
+		float GetAnimationTick() const;
+		// moves the playing clip to a tick, used to pick an animation up where a saved one was
+		void SetAnimationTick(float animationTick);
 		size_t GetAnimationCount() const;
 		bool GetToParentTransform(const Bone* bone, Math::Matrix4& transform) const;
 
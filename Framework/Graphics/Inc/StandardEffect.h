@@ -25,6 +25,8 @@ namespace SabadEngine::Graphics
 
         void Render(const RenderObject& renderObject);
         void Render(const RenderGroup& renderGroup);
+        // uses a world matrix computed elsewhere instead of the group's transform
+        void Render(const RenderGroup& renderGroup, const Math::Matrix4& matWorld);
 
         void SetCamera(const Camera& camera);
 
@@ -45,6 +45,12 @@ namespace SabadEngine::Graphics
 		void SetColor(const Color& color);
 		void SetRotation(float rotation);
 
+		Math::Vector2 GetScale() const;
+		Pivot GetPivot() const;
+		Flip GetFlip() const;
+		Color GetColor() const;
+		float GetRotation() const;
+
 		bool IsInSprite(float x, float y) const;
 		void GetOrigin(float& x, float& y);
 
@@ -57,6 +57,26 @@ bool Animator::IsFinished() const
 	return mAnimationTick >= animClip.tickDuration;
 }
 
+int Animator::GetClipIndex() const
+{
+	return mClipIndex;
+}
+
+bool Animator::IsLooping() const
+{
+	return mIsLooping;
+}
+
+float Animator::GetAnimationTick() const
+{
+	return mAnimationTick;
+}
+
+void Animator::SetAnimationTick(float animationTick)
+{
+	mAnimationTick = animationTick;
+}
+
 size_t Animator::GetAnimationCount() const
 {
 	const Model* model = ModelManager::Get()->GetModel(mModelId);
@@ -62,7 +62,11 @@ void ShadowEffect::Render(const RenderObject& renderObject)
 
 void ShadowEffect::Render(const RenderGroup& renderGroup)
 {
-    const Math::Matrix4 matWorld = renderGroup.transform.GetMatrix4();
+    Render(renderGroup, renderGroup.transform.GetMatrix4());
+}
+
+void ShadowEffect::Render(const RenderGroup& renderGroup, const Math::Matrix4& matWorld)
+{
     const Math::Matrix4 matView = mLightCamera.GetViewMatrix();
     const Math::Matrix4 matProj = mLightCamera.GetProjectionMatrix();
 
@@ -113,7 +113,11 @@ void StandardEffect::Render(const RenderObject& renderObject)
 
 void StandardEffect::Render(const RenderGroup& renderGroup)
 {
-    const Math::Matrix4 matWorld = renderGroup.transform.GetMatrix4();
+    Render(renderGroup, renderGroup.transform.GetMatrix4());
+}
+
+void StandardEffect::Render(const RenderGroup& renderGroup, const Math::Matrix4& matWorld)
+{
     const Math::Matrix4 matView = mCamera->GetViewMatrix();
     const Math::Matrix4 matProj = mCamera->GetProjectionMatrix();
     const Math::Matrix4 matFinal = matWorld * matView * matProj;
@@ -69,6 +69,33 @@ void UISprite::SetRotation(float rotation)
 {
 	mRotation = rotation;
 }
+Math::Vector2 UISprite::GetScale() const
+{
+	return { mScale.x, mScale.y };
+}
+Pivot UISprite::GetPivot() const
+{
+	return mPivot;
+}
+Flip UISprite::GetFlip() const
+{
+	switch (mFlip)
+	{
+	case DirectX::SpriteEffects_FlipHorizontally:	return Flip::Horizontal;
+	case DirectX::SpriteEffects_FlipVertically:		return Flip::Vertical;
+	case DirectX::SpriteEffects_FlipBoth:			return Flip::Both;
+	default:
+		return Flip::None;
+	}
+}
+Color UISprite::GetColor() const
+{
+	return { mColor.m128_f32[0], mColor.m128_f32[1], mColor.m128_f32[2], mColor.m128_f32[3] };
+}
+float UISprite::GetRotation() const
+{
+	return mRotation;
+}
 bool UISprite::IsInSprite(float x, float y) const
 {
 	const float width = mRect.right - mRect.left;
@@ -9,6 +9,7 @@
 #include "Quaternion.h"
 #include "Matrix4.h"
 #include "Range.h"
+#include "Shapes.h"
 
 namespace SabadEngine::Math
 {
@@ -0,0 +1,86 @@
+#pragma once
+
+namespace SabadEngine::Math
+{
+    struct AABB
+    {
+        Vector3 min;
+        Vector3 max;
+
+        constexpr AABB() = default;
+        constexpr AABB(const Vector3& min, const Vector3& max) : min(min), max(max) {}
+
+        static constexpr AABB FromCenter(const Vector3& center, const Vector3& extend)
+        {
+            return { center - extend, center + extend };
+        }
+
+        constexpr bool Intersects(const AABB& other) const
+        {
+            return min.x <= other.max.x && max.x >= other.min.x
+                && min.y <= other.max.y && max.y >= other.min.y
+                && min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        constexpr bool IntersectsSphere(const Vector3& center, float radius) const
+        {
+            const float dx = (center.x < min.x) ? min.x - center.x : ((center.x > max.x) ? center.x - max.x : 0.0f);
+            const float dy = (center.y < min.y) ? min.y - center.y : ((center.y > max.y) ? center.y - max.y : 0.0f);
+            const float dz = (center.z < min.z) ? min.z - center.z : ((center.z > max.z) ? center.z - max.z : 0.0f);
+            return (dx * dx) + (dy * dy) + (dz * dz) <= radius * radius;
+        }
+    };
+
+    // six planes facing inwards, ax + by + cz + d >= 0 is inside, in left, right, bottom, top, near, far order
+    struct Frustum
+    {
+        Vector4 planes[6];
+
+        // from a view * projection matrix in the row vector convention the engine uses, with depth from 0 to 1
+        static Frustum FromMatrix(const Matrix4& m)
+        {
+            Frustum frustum;
+            frustum.planes[0] = { m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41 };
+            frustum.planes[1] = { m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41 };
+            frustum.planes[2] = { m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42 };
+            frustum.planes[3] = { m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42 };
+            frustum.planes[4] = { m._13, m._23, m._33, m._43 };
+            frustum.planes[5] = { m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43 };
+            for (Vector4& plane : frustum.planes)
+            {
+                const float length = sqrt((plane.x * plane.x) + (plane.y * plane.y) + (plane.z * plane.z));
+                plane /= length;
+            }
+            return frustum;
+        }
+
+        bool IntersectsSphere(const Vector3& center, float radius) const
+        {
+            for (const Vector4& plane : planes)
+            {
+                if ((plane.x * center.x) + (plane.y * center.y) + (plane.z * center.z) + plane.w < -radius)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // may report a box that is just outside a corner as inside, never the other way around
+        bool IntersectsAABB(const AABB& box) const
+        {
+            for (const Vector4& plane : planes)
+            {
+                // the corner furthest along the plane normal
+                const float x = (plane.x >= 0.0f) ? box.max.x : box.min.x;
+                const float y = (plane.y >= 0.0f) ? box.max.y : box.min.y;
+                const float z = (plane.z >= 0.0f) ? box.max.z : box.min.z;
+                if ((plane.x * x) + (plane.y * y) + (plane.z * z) + plane.w < 0.0f)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+namespace SabadEngine::Physics
+{
+    struct ClothSettings
+    {
+        float mass = 1.0f;                  // total mass spread over every node
+        uint32_t subSteps = 10;             // small steps with one solve each converge better than many iterations
+        uint32_t iterations = 1;
+        float stretchCompliance = 0.0f;     // inverse stiffness, 0 is rigid
+        float shearCompliance = 0.0001f;
+        float bendCompliance = 0.01f;
+        float damping = 0.1f;               // fraction of velocity lost per second
+        float maxTimeStep = 1.0f / 30.0f;   // larger frames are clamped so the cloth never explodes
+    };
+
+    // Extended position based dynamics cloth, an alternative to SoftBody that does not go through bullet
+    // constraints are graph colored so each color can be solved 4 at a time with SSE and split across the JobSystem
+    // positions, normals and tangents are written straight into the mesh vertices ready for MeshBuffer::Update
+    class Cloth final
+    {
+    public:
+        Cloth() = default;
+        ~Cloth();
+
+        // mesh must be a grid from MeshBuilder::CreatePlane(rows, columns, ...) and must outlive the cloth
+        void Initialize(Graphics::Mesh& mesh, uint32_t rows, uint32_t columns, const std::vector<uint32_t>& fixedNodeIndices, const ClothSettings& settings = {});
+        void Terminate();
+
+        void Update(float deltaTime);
+        void DebugUI();
+
+        // collision shapes the nodes are pushed out of every sub step
+        void SetGroundHeight(std::optional<float> height);
+        void AddSphereCollider(const Math::Vector3& center, float radius);
+        void ClearSphereColliders();
+
+        uint32_t GetNodeCount() const;
+        uint32_t GetConstraintCount() const;
+        uint32_t GetColorCount() const;
+
+    private:
+        enum class ConstraintType
+        {
+            Stretch,
+            Shear,
+            Bend
+        };
+
+        struct SphereCollider
+        {
+            Math::Vector3 center;
+            float radius;
+        };
+
+        void AddConstraint(uint32_t nodeA, uint32_t nodeB, ConstraintType type);
+        void BuildColors();
+
+        void Integrate(float timeStep);
+        void SolveColor(uint32_t color, float timeStep);
+        void ProjectConstraint(uint32_t index, float complianceScale);
+        void ProjectConstraints4(uint32_t index, float complianceScale);
+        // pushes nodes out of the colliders then derives the velocity from how far they moved
+        void EndSubStep(float timeStep);
+        void WriteVertices();
+
+        Graphics::Mesh* mMesh = nullptr;
+        ClothSettings mSettings;
+        uint32_t mRows = 0;
+        uint32_t mColumns = 0;
+
+        // nodes as structure of arrays so 4 constraints load into one register per axis
+        std::vector<float> mPositionX, mPositionY, mPositionZ;
+        std::vector<float> mPreviousX, mPreviousY, mPreviousZ;
+        std::vector<float> mVelocityX, mVelocityY, mVelocityZ;
+        std::vector<float> mInverseMass;
+
+        // constraints sorted by color, no two constraints in a color share a node
+        std::vector<uint32_t> mNodeA, mNodeB;
+        std::vector<float> mRestLength;
+        std::vector<float> mCompliance;
+        std::vector<float> mLambda;
+        std::vector<ConstraintType> mType;
+        std::vector<uint32_t> mColorOffsets;
+
+        std::optional<float> mGroundHeight;
+        std::vector<SphereCollider> mSphereColliders;
+    };
+}
\ No newline at end of file
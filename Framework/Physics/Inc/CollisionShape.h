@@ -18,10 +18,31 @@ namespace SabadEngine::Physics
 
         void InitializeHull(const Math::Vector3& halfExtents, const Math::Vector3& origin);
 
+        // static terrain collision straight from a raw height map, without building the terrain mesh
+        // lines up with a Graphics::Terrain of the same file and scale when the rigid body sits at the same transform
+        void InitializeHeightfield(const std::filesystem::path& fileName, float heightScale);
+        // the same from a terrain that is already loaded, its heights are copied
+        // bullet needs a packed grid and the terrain only has them interleaved in its mesh vertices
+        void InitializeHeightfield(const Graphics::Terrain& terrain);
+        // rows * columns heights, row by row, read in place without a copy
+        // they must stay alive and unchanged until Terminate, bullet reads them on every query against the shape
+        void InitializeHeightfield(const float* heights, uint32_t rows, uint32_t columns);
+
+        // static collision against every triangle of the mesh, the positions and indices are copied
+        void InitializeTriangleMesh(const Graphics::Mesh& mesh);
+
         void Terminate();
 
     private:
         friend class RigidBody;
+        friend class RigidBodyPool;
+        friend class TriggerVolume;
+        void CreateHeightfieldShape(const float* heights, uint32_t rows, uint32_t columns);
+
         btCollisionShape* mCollisionShape = nullptr;
+        btCollisionShape* mChildShape = nullptr;
+        btTriangleMesh* mTriangleMesh = nullptr;
+        // the heightfield reads its samples from here, unless they were lent to it
+        std::vector<float> mHeights;
     };
 }
\ No newline at end of file
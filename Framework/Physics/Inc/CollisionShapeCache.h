@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CollisionShape.h"
+
+namespace SabadEngine::Physics
+{
+	using CollisionShapeId = std::size_t;
+
+	// Shares bullet collision shapes between every object that uses the same shape and parameters
+	// a level full of identical crates will only ever allocate one shape
+	// safe to use from several threads, so components can acquire shapes while objects are built in parallel
+	class CollisionShapeCache final
+	{
+	public:
+		enum class ShapeType : uint32_t
+		{
+			Empty,
+			Sphere,
+			Capsule,
+			Box,
+			Hull,
+			Heightfield,
+			Count
+		};
+
+		// canonical description of a shape, two shapes with the same key are interchangeable
+		struct Key
+		{
+			ShapeType type = ShapeType::Empty;
+			std::array<float, 6> params = {};
+			std::string fileName;
+
+			bool operator==(const Key& other) const;
+		};
+
+		static void StaticInitialize();
+		static void StaticTerminate();
+		static CollisionShapeCache* Get();
+
+		CollisionShapeCache() = default;
+		~CollisionShapeCache();
+
+		CollisionShapeCache(const CollisionShapeCache&) = delete;
+		CollisionShapeCache(const CollisionShapeCache&&) = delete;
+		CollisionShapeCache& operator=(const CollisionShapeCache&) = delete;
+		CollisionShapeCache& operator=(const CollisionShapeCache&&) = delete;
+
+		// each acquire adds a reference, must be matched with a Release
+		CollisionShapeId AcquireEmpty();
+		CollisionShapeId AcquireSphere(float radius);
+		CollisionShapeId AcquireCapsule(float radius, float height);
+		CollisionShapeId AcquireBox(const Math::Vector3& halfExtents);
+		CollisionShapeId AcquireHull(const Math::Vector3& halfExtents, const Math::Vector3& origin);
+		// reads the raw height map straight into the shape, no terrain mesh is built
+		CollisionShapeId AcquireHeightfield(const std::filesystem::path& fileName, float heightScale);
+		// the key must have a type below Count, used to acquire a shape again from a stored key
+		CollisionShapeId Acquire(const Key& key);
+
+		const CollisionShape* GetShape(CollisionShapeId id) const;
+		// what the shape was acquired with, so it can be stored and acquired again, false if the id holds no shape
+		bool GetKey(CollisionShapeId id, Key& key) const;
+		void Release(CollisionShapeId id);
+
+		std::size_t GetShapeCount() const;
+		std::size_t GetReferenceCount() const;
+
+		void DebugUI();
+
+	private:
+		struct Entry
+		{
+			Key key;
+			std::unique_ptr<CollisionShape> shape;
+			uint32_t refCount = 0;
+		};
+
+		static CollisionShapeId HashKey(const Key& key);
+		// probe order over the ids, 0 is skipped
+		static CollisionShapeId NextId(CollisionShapeId id);
+		static CollisionShapeId PreviousId(CollisionShapeId id);
+
+		// ids are probed linearly from the key's hash, released entries are left as tombstones (no shape)
+		using Inventory = std::unordered_map<CollisionShapeId, Entry>;
+		Inventory mInventory;
+		std::size_t mShapeCount = 0;
+		std::size_t mReferenceCount = 0;
+		mutable std::mutex mMutex;
+	};
+}
\ No newline at end of file
@@ -8,8 +8,16 @@
 #include <Graphics/Inc/Graphics.h>
 
 // Bullet Headers
+// bullet is built thread safe so PhysicsWorld can spread a step over the JobSystem, every user of its headers has to agree
+#define BT_THREADSAFE 1
 #include <Bullet/btBulletCollisionCommon.h>
 #include <Bullet/btBulletDynamicsCommon.h>
+#include <Bullet/BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <Bullet/BulletCollision/CollisionDispatch/btGhostObject.h>
+#include <Bullet/BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
+#include <Bullet/BulletCollision/NarrowPhaseCollision/btGjkEpa2.h>
+#include <Bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <Bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 
 // Softbody Headers
 #include <Bullet/BulletSoftBody/btSoftRigidDynamicsWorld.h>
@@ -0,0 +1,104 @@
+#pragma once
+
+namespace SabadEngine::Physics
+{
+    struct FluidSettings
+    {
+        float particleSpacing = 0.1f;       // rest distance between particles, the smoothing radius is twice this
+        float restDensity = 1000.0f;
+        float stiffness = 200.0f;           // pressure per unit of density above rest, higher is less compressible but needs smaller steps
+        float viscosity = 0.05f;            // kinematic viscosity
+        uint32_t subSteps = 4;
+        float maxTimeStep = 1.0f / 30.0f;   // larger frames are clamped so the fluid never explodes
+        Math::Vector3 boundsMin = { -5.0f, 0.0f, -5.0f };   // particles are kept inside this box
+        Math::Vector3 boundsMax = { 5.0f, 10.0f, 5.0f };
+        bool collideWithWorld = false;      // pushes particles out of the static convex colliders in the PhysicsWorld
+    };
+
+    // Smoothed particle hydrodynamics fluid that runs beside bullet rather than through it
+    // every sub step the particles are sorted by a spatial hash of their cell with a parallel radix sort,
+    // so each cell is a contiguous range and neighbours are read 4 at a time with SSE
+    // particles are reordered by the sort, an index is only valid until the next Update
+    class Fluid final
+    {
+    public:
+        Fluid() = default;
+        ~Fluid();
+
+        void Initialize(uint32_t maxParticles, const FluidSettings& settings = {});
+        void Terminate();
+
+        void Update(float deltaTime);
+        void DebugUI();
+        void Render(Graphics::ParticleSystemEffect& effect, const Graphics::Color& color);
+
+        // returns false when the fluid is full
+        bool AddParticle(const Math::Vector3& position, const Math::Vector3& velocity = Math::Vector3::Zero);
+        // fills the box with particles at the rest spacing, returns how many were added
+        uint32_t AddBlock(const Math::Vector3& minCorner, const Math::Vector3& maxCorner);
+        void Clear();
+
+        uint32_t GetParticleCount() const;
+        uint32_t GetMaxParticles() const;
+        Math::Vector3 GetPosition(uint32_t index) const;
+        Math::Vector3 GetVelocity(uint32_t index) const;
+        float GetDensity(uint32_t index) const;
+
+    private:
+        struct StaticCollider
+        {
+            const btConvexShape* shape = nullptr;
+            btTransform transform;
+            btVector3 aabbMin;
+            btVector3 aabbMax;
+        };
+
+        void Step(float timeStep);
+        void GatherStaticColliders();
+        // hashes every particle, radix sorts them by cell and reorders the particle data to match
+        void SortParticles();
+        void ComputeDensities();
+        void ComputeAccelerations();
+        void Integrate(float timeStep);
+
+        // the sorted particle ranges of the 27 cells around one cell, particles in the same cell share them
+        struct NeighbourRanges
+        {
+            int32_t cellX = 0;
+            int32_t cellY = 0;
+            int32_t cellZ = 0;
+            bool valid = false;
+            uint32_t count = 0;
+            uint32_t first[27];
+            uint32_t last[27];
+        };
+
+        uint32_t GetCellKey(float x, float y, float z) const;
+        void GatherNeighbourRanges(uint32_t index, NeighbourRanges& ranges) const;
+
+        FluidSettings mSettings;
+        float mSmoothingRadius = 0.0f;
+        float mParticleMass = 0.0f;
+        uint32_t mMaxParticles = 0;
+        uint32_t mParticleCount = 0;
+
+        // particles as structure of arrays so 4 neighbours load into one register per axis
+        std::vector<float> mPositionX, mPositionY, mPositionZ;
+        std::vector<float> mVelocityX, mVelocityY, mVelocityZ;
+        std::vector<float> mAccelerationX, mAccelerationY, mAccelerationZ;
+        std::vector<float> mDensity;
+        std::vector<float> mInverseDensity;
+        std::vector<float> mPressure;
+
+        // spatial hash, mCellStart and mCellEnd give the sorted range of particles in each hash bucket
+        uint32_t mHashMask = 0;
+        std::vector<uint32_t> mCellStart;
+        std::vector<uint32_t> mCellEnd;
+        std::vector<uint32_t> mKeys, mSortedKeys;
+        std::vector<uint32_t> mOrder, mSortedOrder;
+        std::vector<uint32_t> mDigitOffsets;
+        std::vector<float> mScratch;
+
+        std::vector<StaticCollider> mStaticColliders;
+    };
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "RigidBody.h"
-#include "CollisionShape.h"
+#include "CollisionShapeCache.h"
 
 namespace SabadEngine::Physics
 {
@@ -33,7 +33,7 @@ namespace SabadEngine::Physics
     private:
         Graphics::Transform mTransform;
         RigidBody mRigidBody;
-        CollisionShape mCollisionShape;
+        CollisionShapeId mCollisionShapeId = 0;
 
         ParticleInfo mInfo;
         float mLifetime = 0.0f;
@@ -3,10 +3,18 @@
 #include "Common.h"
 
 #include "PhysicsObject.h"
+#include "PhysicsContact.h"
+#include "PhysicsQuery.h"
+#include "PhysicsSnapshot.h"
 #include "PhysicsWorld.h"
 #include "CollisionShape.h"
+#include "CollisionShapeCache.h"
 #include "RigidBody.h"
+#include "RigidBodyPool.h"
+#include "TriggerVolume.h"
 #include "PhysicsDebugDraw.h"
 #include "SoftBody.h"
+#include "Cloth.h"
+#include "Fluid.h"
 #include "Particle.h"
 #include "ParticleSystem.h"
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace SabadEngine::Physics
+{
+	class PhysicsObject;
+
+	enum class ContactEventType : uint8_t
+	{
+		ContactBegin,	// two bodies started touching
+		ContactEnd,		// two bodies stopped touching
+		TriggerEnter,	// a body started overlapping a trigger volume
+		TriggerExit		// a body stopped overlapping a trigger volume
+	};
+
+	// one change in touching pairs, gathered once per PhysicsWorld::Update from bullet's contact manifolds
+	// for trigger events objectB is always the trigger volume, for contacts objectA is the one registered first
+	struct ContactEvent
+	{
+		PhysicsObject* objectA = nullptr;
+		PhysicsObject* objectB = nullptr;
+		ContactEventType type = ContactEventType::ContactBegin;
+	};
+}
\ No newline at end of file
@@ -18,5 +18,6 @@ namespace SabadEngine::Physics
         virtual void SyncWithGraphics() = 0;
         virtual btRigidBody* GetRigidBody() { return nullptr; } // Not all objects will have rigid bodies
         virtual btSoftBody* GetSoftBody() { return nullptr; }
+        virtual btGhostObject* GetGhostObject() { return nullptr; }
     };
 }
\ No newline at end of file
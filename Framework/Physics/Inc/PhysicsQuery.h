@@ -0,0 +1,52 @@
+#pragma once
+
+namespace SabadEngine::Physics
+{
+	class PhysicsObject;
+
+	// Batched scene queries, filled in by PhysicsWorld::RayCast/SphereSweep/Overlap
+	// a body is only considered if (collisionGroup & bodyMask) && (bodyGroup & collisionMask), same as bullet
+
+	struct RayQuery
+	{
+		Math::Vector3 from = Math::Vector3::Zero;
+		Math::Vector3 to = Math::Vector3::Zero;
+		int collisionGroup = btBroadphaseProxy::DefaultFilter;
+		int collisionMask = btBroadphaseProxy::AllFilter;
+	};
+
+	struct SphereSweepQuery
+	{
+		Math::Vector3 from = Math::Vector3::Zero;
+		Math::Vector3 to = Math::Vector3::Zero;
+		float radius = 0.5f;
+		int collisionGroup = btBroadphaseProxy::DefaultFilter;
+		int collisionMask = btBroadphaseProxy::AllFilter;
+	};
+
+	struct OverlapQuery
+	{
+		Math::Vector3 min = Math::Vector3::Zero;
+		Math::Vector3 max = Math::Vector3::Zero;
+		int collisionGroup = btBroadphaseProxy::DefaultFilter;
+		int collisionMask = btBroadphaseProxy::AllFilter;
+	};
+
+	// closest hit for a ray or sweep, object is nullptr when nothing was hit
+	struct QueryHit
+	{
+		PhysicsObject* object = nullptr;
+		Math::Vector3 position = Math::Vector3::Zero;
+		Math::Vector3 normal = Math::Vector3::Zero;
+		float fraction = 1.0f;
+
+		bool HasHit() const { return object != nullptr; }
+	};
+
+	// range of the hit buffer that belongs to one overlap query
+	struct OverlapResult
+	{
+		std::size_t firstHit = 0;
+		uint32_t hitCount = 0;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+namespace SabadEngine::Physics
+{
+	// Binary copy of every dynamic rigid body in the physics world and the contacts between them
+	// used to rewind the simulation for rollback, replays and prediction
+	class PhysicsSnapshot final
+	{
+	public:
+		uint32_t GetFrame() const;
+		uint32_t GetBodyCount() const;
+
+		// full state in bytes, this is what restore reads
+		std::size_t GetSizeInBytes() const;
+		// true when both hold the same state bit for bit, used to check that a re-simulation is deterministic
+		bool Matches(const PhysicsSnapshot& other) const;
+
+		// state xor'd against the baseline it was encoded with and zero run length encoded
+		// bodies that did not move encode to almost nothing, this is what gets stored or sent
+		const std::vector<uint32_t>& GetDelta() const;
+		std::size_t GetDeltaSizeInBytes() const;
+
+		// rebuilds the full state from a delta, baseline must be the snapshot the delta was encoded against
+		void Decode(const PhysicsSnapshot* baseline, const uint32_t* delta, std::size_t deltaCount, uint32_t frame);
+
+	private:
+		friend class PhysicsWorld;
+		friend class PhysicsSnapshotPool;
+
+		void Encode(const PhysicsSnapshot* baseline);
+
+		std::vector<uint32_t> mState;
+		std::vector<uint32_t> mDelta;
+		uint32_t mFrame = 0;
+	};
+
+	// Ring buffer of snapshots, buffers are reused so capturing every frame does not allocate
+	class PhysicsSnapshotPool final
+	{
+	public:
+		void Initialize(uint32_t capacity);
+		void Terminate();
+
+		// captures the physics world into the oldest slot, delta encoded against the previous capture
+		const PhysicsSnapshot& Capture(uint32_t frame);
+
+		// nullptr if the frame was never captured or has been overwritten
+		const PhysicsSnapshot* Find(uint32_t frame) const;
+		const PhysicsSnapshot* GetLatest() const;
+
+		// forget everything captured, keeps the memory
+		void Clear();
+
+	private:
+		std::vector<PhysicsSnapshot> mSnapshots;
+		uint32_t mNextIndex = 0;
+		uint32_t mCount = 0;
+	};
+}
\ No newline at end of file
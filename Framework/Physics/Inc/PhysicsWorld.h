@@ -1,6 +1,9 @@
 #pragma once
 
+#include "PhysicsContact.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsQuery.h"
+#include "PhysicsSnapshot.h"
 
 namespace SabadEngine::Physics
 {
@@ -8,6 +11,12 @@ namespace SabadEngine::Physics
 	class PhysicsWorld final
 	{
 	public:
+		enum class BroadphaseType
+		{
+			Dbvt,           // dynamic aabb trees, good default for scenes that grow and move
+			AxisSweep       // sweep and prune inside fixed world bounds, can be faster for mostly static scenes
+		};
+
 		struct Settings
 		{
 			// is the gravity used for physics simulations
@@ -16,6 +25,17 @@ namespace SabadEngine::Physics
 			uint32_t simulationSteps = 1;
 			// the fixed rate that the simulation swill run to ensure consistent/predictable outcomes
 			float fixedTimeStep = 1.0f / 60.0f;
+			// constraint solver passes per step, more is stiffer stacking at a higher cost
+			uint32_t solverIterations = 10;
+			// only read by Initialize, the broadphase can't be swapped on a live world
+			BroadphaseType broadphase = BroadphaseType::Dbvt;
+			// threads a step may use including the calling one, more than 1 runs the collision dispatch and the solver
+			// on the JobSystem, capped at its thread count, only read by Initialize
+			// results are only reproducible bit for bit with 1, the threads add new contacts in whichever order they finish
+			uint32_t threadCount = 1;
+			// bounds for the axis sweep broadphase, anything outside them is not found by it
+			Math::Vector3 worldMin = { -1000.0f, -1000.0f, -1000.0f };
+			Math::Vector3 worldMax = { 1000.0f, 1000.0f, 1000.0f };
 		};
 
 		static void StaticInitialize(const Settings& settings);
@@ -36,10 +56,41 @@ namespace SabadEngine::Physics
 		const Settings& GetSettings() const;
 
 		void Register(PhysicsObject* physicsObject);
+		// registers a rigid body with its own collision filter instead of bullet's default for static or dynamic bodies
+		void Register(PhysicsObject* physicsObject, int collisionGroup, int collisionMask);
+		// every pair the object was touching ends with it, as a ContactEnd or TriggerExit at the start of the next Update's events
+		// only compare the objects of those events, the unregistered one may be gone by then
 		void Unregister(PhysicsObject* physicsObject);
 
+		// changes what a registered rigid body or trigger collides with without rebuilding its broadphase proxy
+		// pairs the new filter allows are found straight away and the ones it rejects stop colliding from the next step
+		// the call costs a broadphase query at most, a mask of 0 leaves the object colliding with nothing and costs no query
+		void SetCollisionFilter(PhysicsObject* physicsObject, int collisionGroup, int collisionMask);
+
+		// every contact and trigger pair that started or stopped touching during the last Update
+		// sorted by the order the objects were registered in, so the same run always reports them in the same order
+		const std::vector<ContactEvent>& GetContactEvents() const;
+		// the events Unregister added since the last Update, in the order the next Update reports them
+		const std::vector<ContactEvent>& GetPendingContactEvents() const;
+
+		// batched scene queries, results[i] is written for queries[i]
+		// the queries only read the world and run in parallel on the JobSystem, don't call them during Update
+		// any thread may call them, several batches can run at the same time
+		void RayCast(const RayQuery* queries, QueryHit* results, std::size_t count) const;
+		void SphereSweep(const SphereSweepQuery* queries, QueryHit* results, std::size_t count) const;
+		// hits must hold count * maxHitsPerQuery entries, query i writes its hits starting at i * maxHitsPerQuery
+		void Overlap(const OverlapQuery* queries, OverlapResult* results, std::size_t count, PhysicsObject** hits, uint32_t maxHitsPerQuery) const;
+
+		// copies every dynamic rigid body and the contact points the solver warm starts from into the snapshot, call between updates
+		void CaptureSnapshot(PhysicsSnapshot& snapshot, uint32_t frame) const;
+		// puts the bodies, their collision filters and the contact points back without taking anything out of the broadphase
+		// stepping on from a restore gives the same result as stepping on from the capture did
+		// the collision objects must be the same as when the snapshot was captured,
+		// objects added to the world without Register are kept as they are
+		void RestoreSnapshot(const PhysicsSnapshot& snapshot);
 
 	private:
+		friend class Fluid;
 		Settings mSettings;
 
 		//bullet objects
@@ -59,6 +110,32 @@ namespace SabadEngine::Physics
 
 		using PhysicsObjects = std::vector<PhysicsObject*>;
 		PhysicsObjects mPhysicsObjects;
+		int mNextObjectId = 0;
+
+		// touching pairs sorted by object id so the previous and current step can be diffed in one pass
+		// the ids come from Register and are kept in the collision object's user index, addresses change from run to run
+		struct ContactPair
+		{
+			PhysicsObject* objectA = nullptr;
+			PhysicsObject* objectB = nullptr;
+			int idA = 0;
+			int idB = 0;
+			bool isTrigger = false;
+		};
+		void CollectTouchingPairs(std::vector<ContactPair>& pairs) const;
+		void UpdateContacts();
+		std::vector<ContactPair> mActivePairs;
+		std::vector<ContactPair> mCurrentPairs;
+		std::vector<ContactEvent> mContactEvents;
+		std::vector<ContactEvent> mPendingContactEvents;
+
+		void ApplyCollisionFilter(btCollisionObject* collisionObject, int collisionGroup, int collisionMask);
+
+		// the dispatcher's manifolds sorted by body for snapshots, kept to not allocate
+		void GatherManifolds() const;
+		// true if it had to add pairs for contacts that had no manifold, restoring again fills those in
+		bool RestoreManifolds(const uint32_t* read, uint32_t manifoldCount, bool addMissingPairs);
+		mutable std::vector<btPersistentManifold*> mSnapshotManifolds;
 
 		PhysicsDebugDraw mPhysicsDebugDraw;
 		bool mDebugDraw = false;
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "PhysicsObject.h"
+
+namespace SabadEngine::Physics
+{
+	class CollisionShape;
+
+	class RigidBodyHandle
+	{
+	public:
+		RigidBodyHandle() = default;
+
+	private:
+		friend class RigidBodyPool;
+		int mIndex = -1;
+		int mGeneration = -1;
+	};
+
+	// Fixed set of rigid bodies that all share one shape, for projectiles and debris that spawn every frame
+	// bodies and motion states are built once in block allocated storage and registered with the world parked,
+	// so they keep their broadphase proxies: spawning only turns collision and simulation on and despawning off again
+	// despawning leaves the body's pairs for the narrowphase to skip, it never searches the world's pair cache for them
+	// nothing is allocated or freed after Initialize
+	// PhysicsWorld snapshots hold the bodies but not which slots are spawned, restore a snapshot taken with the same ones spawned
+	class RigidBodyPool final
+	{
+	public:
+		RigidBodyPool() = default;
+		~RigidBodyPool();
+
+		RigidBodyPool(const RigidBodyPool&) = delete;
+		RigidBodyPool(const RigidBodyPool&&) = delete;
+		RigidBodyPool& operator=(const RigidBodyPool&) = delete;
+		RigidBodyPool& operator=(const RigidBodyPool&&) = delete;
+
+		// the shape must outlive the pool
+		void Initialize(const CollisionShape& shape, float mass, uint32_t capacity);
+		void Terminate();
+
+		// returns an invalid handle when every body is in use
+		RigidBodyHandle Spawn(const Math::Vector3& position, const Math::Vector3& velocity = Math::Vector3::Zero);
+		void Despawn(const RigidBodyHandle& handle);
+		void DespawnAll();
+		bool IsValid(const RigidBodyHandle& handle) const;
+
+		void SetVelocity(const RigidBodyHandle& handle, const Math::Vector3& velocity);
+		Math::Vector3 GetVelocity(const RigidBodyHandle& handle) const;
+		Graphics::Transform GetTransform(const RigidBodyHandle& handle) const;
+
+		// maps a PhysicsObject from a scene query back to its handle, invalid if it is not from this pool
+		RigidBodyHandle GetHandle(const PhysicsObject* physicsObject) const;
+
+		uint32_t GetActiveCount() const;
+		uint32_t GetCapacity() const;
+
+	private:
+		// parked bodies are in no collision group and collide with none
+		static constexpr int ParkedFilter = 0;
+
+		class Slot final : public PhysicsObject
+		{
+		public:
+			void SyncWithGraphics() override {}
+			btRigidBody* GetRigidBody() override { return body; }
+
+			btRigidBody* body = nullptr;
+			btDefaultMotionState* motionState = nullptr;
+			int generation = 0;
+			bool active = false;
+		};
+
+		Slot* GetSlot(const RigidBodyHandle& handle);
+		const Slot* GetSlot(const RigidBodyHandle& handle) const;
+
+		std::unique_ptr<Core::TypedAllocator<btRigidBody>> mBodyAllocator;
+		std::unique_ptr<Core::TypedAllocator<btDefaultMotionState>> mMotionStateAllocator;
+		std::vector<Slot> mSlots;
+		std::vector<int> mFreeSlots;
+		uint32_t mActiveCount = 0;
+	};
+}
\ No newline at end of file
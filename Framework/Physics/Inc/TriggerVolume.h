@@ -0,0 +1,27 @@
+#pragma once
+
+#include "PhysicsObject.h"
+
+namespace SabadEngine::Physics
+{
+	class CollisionShape;
+
+	// Ghost object that reports TriggerEnter/TriggerExit contact events without pushing anything
+	// it follows the graphics transform, so moving the transform moves the trigger on the next update
+	class TriggerVolume final : public PhysicsObject
+	{
+	public:
+		TriggerVolume() = default;
+		~TriggerVolume() override;
+
+		void Initialize(Graphics::Transform& graphicsTransform, const CollisionShape& shape, bool addToWorld = true);
+		void Terminate();
+
+	private:
+		void SyncWithGraphics() override;
+		btGhostObject* GetGhostObject() override;
+
+		btGhostObject* mGhostObject = nullptr;
+		Graphics::Transform* mGraphicsTransform = nullptr;
+	};
+}
\ No newline at end of file
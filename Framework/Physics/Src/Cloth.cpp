@@ -0,0 +1,461 @@
+#include "Precompiled.h"
+#include "Cloth.h"
+#include "PhysicsWorld.h"
+
+#include <xmmintrin.h>
+
+using namespace SabadEngine;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+    // multiples of 4 so every batch but the last fills whole sse lanes
+    constexpr std::size_t NodeBatchSize = 1024;
+    constexpr std::size_t ConstraintBatchSize = 256;
+    constexpr uint32_t MaxColors = 64;
+    constexpr float Epsilon = 1.0e-6f;
+
+    __m128 Gather(const float* data, const uint32_t* indices)
+    {
+        return _mm_setr_ps(data[indices[0]], data[indices[1]], data[indices[2]], data[indices[3]]);
+    }
+
+    // only safe because the 4 lanes never share a node
+    void Scatter(float* data, const uint32_t* indices, __m128 values)
+    {
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, values);
+        data[indices[0]] = lanes[0];
+        data[indices[1]] = lanes[1];
+        data[indices[2]] = lanes[2];
+        data[indices[3]] = lanes[3];
+    }
+
+    Math::Vector3 SafeNormalize(const Math::Vector3& v, const Math::Vector3& fallback)
+    {
+        const float magnitudeSqr = Math::MagnitudeSqr(v);
+        return (magnitudeSqr > Epsilon * Epsilon) ? v / sqrt(magnitudeSqr) : fallback;
+    }
+}
+
+Cloth::~Cloth()
+{
+    ASSERT(mMesh == nullptr, "Cloth: Must call Terminate!");
+}
+
+void Cloth::Initialize(Graphics::Mesh& mesh, uint32_t rows, uint32_t columns, const std::vector<uint32_t>& fixedNodeIndices, const ClothSettings& settings)
+{
+    const uint32_t nodeCount = (rows + 1) * (columns + 1);
+    ASSERT(rows > 0 && columns > 0 && mesh.vertices.size() == nodeCount, "Cloth: mesh is not a %u by %u plane!", rows, columns);
+    ASSERT(settings.mass > 0.0f && settings.subSteps > 0, "Cloth: mass and sub steps must be greater than 0");
+
+    mMesh = &mesh;
+    mSettings = settings;
+    mRows = rows;
+    mColumns = columns;
+
+    for (std::vector<float>* nodeData : { &mPositionX, &mPositionY, &mPositionZ, &mPreviousX, &mPreviousY, &mPreviousZ, &mVelocityX, &mVelocityY, &mVelocityZ })
+    {
+        nodeData->assign(nodeCount, 0.0f);
+    }
+    mInverseMass.assign(nodeCount, static_cast<float>(nodeCount) / settings.mass);
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        const Math::Vector3& position = mesh.vertices[i].position;
+        mPositionX[i] = position.x;
+        mPositionY[i] = position.y;
+        mPositionZ[i] = position.z;
+    }
+    for (uint32_t fixedNode : fixedNodeIndices)
+    {
+        ASSERT(fixedNode < nodeCount, "Cloth: fixed node %u is out of range", fixedNode);
+        mInverseMass[fixedNode] = 0.0f;
+    }
+
+    auto nodeIndex = [columns](uint32_t r, uint32_t c) { return (r * (columns + 1)) + c; };
+    for (uint32_t r = 0; r <= rows; ++r)
+    {
+        for (uint32_t c = 0; c <= columns; ++c)
+        {
+            if (c < columns)
+            {
+                AddConstraint(nodeIndex(r, c), nodeIndex(r, c + 1), ConstraintType::Stretch);
+            }
+            if (r < rows)
+            {
+                AddConstraint(nodeIndex(r, c), nodeIndex(r + 1, c), ConstraintType::Stretch);
+            }
+            if (r < rows && c < columns)
+            {
+                AddConstraint(nodeIndex(r, c), nodeIndex(r + 1, c + 1), ConstraintType::Shear);
+                AddConstraint(nodeIndex(r, c + 1), nodeIndex(r + 1, c), ConstraintType::Shear);
+            }
+            if (c + 2 <= columns)
+            {
+                AddConstraint(nodeIndex(r, c), nodeIndex(r, c + 2), ConstraintType::Bend);
+            }
+            if (r + 2 <= rows)
+            {
+                AddConstraint(nodeIndex(r, c), nodeIndex(r + 2, c), ConstraintType::Bend);
+            }
+        }
+    }
+    BuildColors();
+    WriteVertices();
+}
+
+void Cloth::Terminate()
+{
+    mMesh = nullptr;
+    for (std::vector<float>* data : { &mPositionX, &mPositionY, &mPositionZ, &mPreviousX, &mPreviousY, &mPreviousZ,
+        &mVelocityX, &mVelocityY, &mVelocityZ, &mInverseMass, &mRestLength, &mCompliance, &mLambda })
+    {
+        data->clear();
+    }
+    mNodeA.clear();
+    mNodeB.clear();
+    mType.clear();
+    mColorOffsets.clear();
+    mSphereColliders.clear();
+}
+
+void Cloth::Update(float deltaTime)
+{
+    const float timeStep = std::min(deltaTime, mSettings.maxTimeStep);
+    if (timeStep <= 0.0f || mMesh == nullptr)
+    {
+        return;
+    }
+
+    const float subTimeStep = timeStep / static_cast<float>(mSettings.subSteps);
+    for (uint32_t step = 0; step < mSettings.subSteps; ++step)
+    {
+        Integrate(subTimeStep);
+        std::fill(mLambda.begin(), mLambda.end(), 0.0f);
+        for (uint32_t iteration = 0; iteration < mSettings.iterations; ++iteration)
+        {
+            for (uint32_t color = 0; color < GetColorCount(); ++color)
+            {
+                SolveColor(color, subTimeStep);
+            }
+        }
+        EndSubStep(subTimeStep);
+    }
+    WriteVertices();
+}
+
+void Cloth::DebugUI()
+{
+    if (ImGui::CollapsingHeader("Cloth"))
+    {
+        ImGui::Text("Nodes: %u Constraints: %u Colors: %u", GetNodeCount(), GetConstraintCount(), GetColorCount());
+        int subSteps = static_cast<int>(mSettings.subSteps);
+        if (ImGui::DragInt("SubSteps", &subSteps, 1.0f, 1, 50))
+        {
+            mSettings.subSteps = static_cast<uint32_t>(subSteps);
+        }
+        bool complianceChanged = false;
+        complianceChanged |= ImGui::DragFloat("StretchCompliance", &mSettings.stretchCompliance, 0.00001f, 0.0f, 1.0f, "%.5f");
+        complianceChanged |= ImGui::DragFloat("ShearCompliance", &mSettings.shearCompliance, 0.00001f, 0.0f, 1.0f, "%.5f");
+        complianceChanged |= ImGui::DragFloat("BendCompliance", &mSettings.bendCompliance, 0.0001f, 0.0f, 1.0f, "%.4f");
+        ImGui::DragFloat("Damping", &mSettings.damping, 0.01f, 0.0f, 10.0f);
+        if (complianceChanged)
+        {
+            for (std::size_t i = 0; i < mType.size(); ++i)
+            {
+                switch (mType[i])
+                {
+                case ConstraintType::Stretch: mCompliance[i] = mSettings.stretchCompliance; break;
+                case ConstraintType::Shear: mCompliance[i] = mSettings.shearCompliance; break;
+                case ConstraintType::Bend: mCompliance[i] = mSettings.bendCompliance; break;
+                }
+            }
+        }
+    }
+}
+
+void Cloth::SetGroundHeight(std::optional<float> height)
+{
+    mGroundHeight = height;
+}
+
+void Cloth::AddSphereCollider(const Math::Vector3& center, float radius)
+{
+    mSphereColliders.push_back({ center, radius });
+}
+
+void Cloth::ClearSphereColliders()
+{
+    mSphereColliders.clear();
+}
+
+uint32_t Cloth::GetNodeCount() const
+{
+    return static_cast<uint32_t>(mInverseMass.size());
+}
+
+uint32_t Cloth::GetConstraintCount() const
+{
+    return static_cast<uint32_t>(mNodeA.size());
+}
+
+uint32_t Cloth::GetColorCount() const
+{
+    return mColorOffsets.empty() ? 0 : static_cast<uint32_t>(mColorOffsets.size() - 1);
+}
+
+void Cloth::AddConstraint(uint32_t nodeA, uint32_t nodeB, ConstraintType type)
+{
+    const float dx = mPositionX[nodeA] - mPositionX[nodeB];
+    const float dy = mPositionY[nodeA] - mPositionY[nodeB];
+    const float dz = mPositionZ[nodeA] - mPositionZ[nodeB];
+    mNodeA.push_back(nodeA);
+    mNodeB.push_back(nodeB);
+    mRestLength.push_back(sqrt(dx * dx + dy * dy + dz * dz));
+    mType.push_back(type);
+    switch (type)
+    {
+    case ConstraintType::Stretch: mCompliance.push_back(mSettings.stretchCompliance); break;
+    case ConstraintType::Shear: mCompliance.push_back(mSettings.shearCompliance); break;
+    case ConstraintType::Bend: mCompliance.push_back(mSettings.bendCompliance); break;
+    }
+}
+
+void Cloth::BuildColors()
+{
+    // greedy coloring, each constraint takes the lowest color neither of its nodes is in yet
+    const std::size_t constraintCount = mNodeA.size();
+    std::vector<uint64_t> nodeColors(GetNodeCount(), 0);
+    std::vector<uint32_t> constraintColors(constraintCount);
+    std::vector<uint32_t> colorCounts(MaxColors, 0);
+    uint32_t colorCount = 0;
+    for (std::size_t i = 0; i < constraintCount; ++i)
+    {
+        const uint64_t usedColors = nodeColors[mNodeA[i]] | nodeColors[mNodeB[i]];
+        uint32_t color = 0;
+        while (color < MaxColors && (usedColors & (1ull << color)) != 0)
+        {
+            ++color;
+        }
+        ASSERT(color < MaxColors, "Cloth: ran out of constraint colors");
+        nodeColors[mNodeA[i]] |= 1ull << color;
+        nodeColors[mNodeB[i]] |= 1ull << color;
+        constraintColors[i] = color;
+        ++colorCounts[color];
+        colorCount = std::max(colorCount, color + 1);
+    }
+
+    mColorOffsets.assign(colorCount + 1, 0);
+    for (uint32_t color = 0; color < colorCount; ++color)
+    {
+        mColorOffsets[color + 1] = mColorOffsets[color] + colorCounts[color];
+    }
+
+    std::vector<uint32_t> order(constraintCount);
+    std::vector<uint32_t> writeOffsets(mColorOffsets.begin(), mColorOffsets.end() - 1);
+    for (uint32_t i = 0; i < constraintCount; ++i)
+    {
+        order[writeOffsets[constraintColors[i]]++] = i;
+    }
+    auto reorder = [&order](auto& data)
+    {
+        auto sorted = data;
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            sorted[i] = data[order[i]];
+        }
+        data = std::move(sorted);
+    };
+    reorder(mNodeA);
+    reorder(mNodeB);
+    reorder(mRestLength);
+    reorder(mCompliance);
+    reorder(mType);
+    mLambda.assign(constraintCount, 0.0f);
+}
+
+void Cloth::Integrate(float timeStep)
+{
+    const Math::Vector3 gravity = PhysicsWorld::Get()->GetSettings().gravity * timeStep;
+    Core::JobSystem::Get()->ParallelFor(GetNodeCount(), NodeBatchSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            mPreviousX[i] = mPositionX[i];
+            mPreviousY[i] = mPositionY[i];
+            mPreviousZ[i] = mPositionZ[i];
+            if (mInverseMass[i] > 0.0f)
+            {
+                mVelocityX[i] += gravity.x;
+                mVelocityY[i] += gravity.y;
+                mVelocityZ[i] += gravity.z;
+                mPositionX[i] += mVelocityX[i] * timeStep;
+                mPositionY[i] += mVelocityY[i] * timeStep;
+                mPositionZ[i] += mVelocityZ[i] * timeStep;
+            }
+        }
+    });
+}
+
+void Cloth::SolveColor(uint32_t color, float timeStep)
+{
+    // xpbd scales compliance by 1/dt^2 so stiffness does not change with the sub step count
+    const float complianceScale = 1.0f / (timeStep * timeStep);
+    const uint32_t first = mColorOffsets[color];
+    const uint32_t count = mColorOffsets[color + 1] - first;
+    Core::JobSystem::Get()->ParallelFor(count, ConstraintBatchSize, [&](std::size_t begin, std::size_t end)
+    {
+        uint32_t index = first + static_cast<uint32_t>(begin);
+        const uint32_t last = first + static_cast<uint32_t>(end);
+        for (; index + 4 <= last; index += 4)
+        {
+            ProjectConstraints4(index, complianceScale);
+        }
+        for (; index < last; ++index)
+        {
+            ProjectConstraint(index, complianceScale);
+        }
+    });
+}
+
+void Cloth::ProjectConstraint(uint32_t index, float complianceScale)
+{
+    const uint32_t a = mNodeA[index];
+    const uint32_t b = mNodeB[index];
+    const float dx = mPositionX[a] - mPositionX[b];
+    const float dy = mPositionY[a] - mPositionY[b];
+    const float dz = mPositionZ[a] - mPositionZ[b];
+    const float length = sqrt(dx * dx + dy * dy + dz * dz);
+    const float alpha = mCompliance[index] * complianceScale;
+    const float denominator = mInverseMass[a] + mInverseMass[b] + alpha;
+    if (length < Epsilon || denominator < Epsilon)
+    {
+        return;
+    }
+
+    const float deltaLambda = (-(length - mRestLength[index]) - alpha * mLambda[index]) / denominator;
+    mLambda[index] += deltaLambda;
+    const float scale = deltaLambda / length;
+    mPositionX[a] += mInverseMass[a] * dx * scale;
+    mPositionY[a] += mInverseMass[a] * dy * scale;
+    mPositionZ[a] += mInverseMass[a] * dz * scale;
+    mPositionX[b] -= mInverseMass[b] * dx * scale;
+    mPositionY[b] -= mInverseMass[b] * dy * scale;
+    mPositionZ[b] -= mInverseMass[b] * dz * scale;
+}
+
+void Cloth::ProjectConstraints4(uint32_t index, float complianceScale)
+{
+    // same math as ProjectConstraint, one constraint per lane
+    const uint32_t* nodeA = &mNodeA[index];
+    const uint32_t* nodeB = &mNodeB[index];
+    __m128 ax = Gather(mPositionX.data(), nodeA);
+    __m128 ay = Gather(mPositionY.data(), nodeA);
+    __m128 az = Gather(mPositionZ.data(), nodeA);
+    __m128 bx = Gather(mPositionX.data(), nodeB);
+    __m128 by = Gather(mPositionY.data(), nodeB);
+    __m128 bz = Gather(mPositionZ.data(), nodeB);
+    const __m128 wa = Gather(mInverseMass.data(), nodeA);
+    const __m128 wb = Gather(mInverseMass.data(), nodeB);
+
+    const __m128 dx = _mm_sub_ps(ax, bx);
+    const __m128 dy = _mm_sub_ps(ay, by);
+    const __m128 dz = _mm_sub_ps(az, bz);
+    const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+    const __m128 alpha = _mm_mul_ps(_mm_loadu_ps(&mCompliance[index]), _mm_set1_ps(complianceScale));
+    const __m128 denominator = _mm_add_ps(_mm_add_ps(wa, wb), alpha);
+    const __m128 epsilon = _mm_set1_ps(Epsilon);
+    const __m128 valid = _mm_and_ps(_mm_cmpge_ps(length, epsilon), _mm_cmpge_ps(denominator, epsilon));
+
+    const __m128 lambda = _mm_loadu_ps(&mLambda[index]);
+    const __m128 constraint = _mm_sub_ps(length, _mm_loadu_ps(&mRestLength[index]));
+    const __m128 numerator = _mm_sub_ps(_mm_sub_ps(_mm_setzero_ps(), constraint), _mm_mul_ps(alpha, lambda));
+    const __m128 deltaLambda = _mm_and_ps(_mm_div_ps(numerator, denominator), valid);
+    _mm_storeu_ps(&mLambda[index], _mm_add_ps(lambda, deltaLambda));
+
+    const __m128 scale = _mm_and_ps(_mm_div_ps(deltaLambda, length), valid);
+    const __m128 sx = _mm_mul_ps(dx, scale);
+    const __m128 sy = _mm_mul_ps(dy, scale);
+    const __m128 sz = _mm_mul_ps(dz, scale);
+    ax = _mm_add_ps(ax, _mm_mul_ps(wa, sx));
+    ay = _mm_add_ps(ay, _mm_mul_ps(wa, sy));
+    az = _mm_add_ps(az, _mm_mul_ps(wa, sz));
+    bx = _mm_sub_ps(bx, _mm_mul_ps(wb, sx));
+    by = _mm_sub_ps(by, _mm_mul_ps(wb, sy));
+    bz = _mm_sub_ps(bz, _mm_mul_ps(wb, sz));
+    Scatter(mPositionX.data(), nodeA, ax);
+    Scatter(mPositionY.data(), nodeA, ay);
+    Scatter(mPositionZ.data(), nodeA, az);
+    Scatter(mPositionX.data(), nodeB, bx);
+    Scatter(mPositionY.data(), nodeB, by);
+    Scatter(mPositionZ.data(), nodeB, bz);
+}
+
+void Cloth::EndSubStep(float timeStep)
+{
+    const float inverseTimeStep = 1.0f / timeStep;
+    const float damping = std::max(0.0f, 1.0f - mSettings.damping * timeStep);
+    Core::JobSystem::Get()->ParallelFor(GetNodeCount(), NodeBatchSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (mInverseMass[i] <= 0.0f)
+            {
+                continue;
+            }
+            for (const SphereCollider& sphere : mSphereColliders)
+            {
+                const Math::Vector3 offset = { mPositionX[i] - sphere.center.x, mPositionY[i] - sphere.center.y, mPositionZ[i] - sphere.center.z };
+                const float distanceSqr = Math::MagnitudeSqr(offset);
+                if (distanceSqr < sphere.radius * sphere.radius && distanceSqr > Epsilon)
+                {
+                    const Math::Vector3 surface = sphere.center + offset * (sphere.radius / sqrt(distanceSqr));
+                    mPositionX[i] = surface.x;
+                    mPositionY[i] = surface.y;
+                    mPositionZ[i] = surface.z;
+                }
+            }
+            if (mGroundHeight.has_value() && mPositionY[i] < *mGroundHeight)
+            {
+                // touching the ground also stops sliding
+                mPositionX[i] = mPreviousX[i];
+                mPositionY[i] = *mGroundHeight;
+                mPositionZ[i] = mPreviousZ[i];
+            }
+            mVelocityX[i] = (mPositionX[i] - mPreviousX[i]) * inverseTimeStep * damping;
+            mVelocityY[i] = (mPositionY[i] - mPreviousY[i]) * inverseTimeStep * damping;
+            mVelocityZ[i] = (mPositionZ[i] - mPreviousZ[i]) * inverseTimeStep * damping;
+        }
+    });
+}
+
+void Cloth::WriteVertices()
+{
+    // normals and tangents come from the neighbouring nodes so every row can be written independently
+    const uint32_t rowLength = mColumns + 1;
+    auto position = [&](uint32_t r, uint32_t c)
+    {
+        const uint32_t i = (r * rowLength) + c;
+        return Math::Vector3(mPositionX[i], mPositionY[i], mPositionZ[i]);
+    };
+    Core::JobSystem::Get()->ParallelFor(mRows + 1, 8, [&](std::size_t begin, std::size_t end)
+    {
+        for (uint32_t r = static_cast<uint32_t>(begin); r < end; ++r)
+        {
+            const uint32_t rowPrev = (r > 0) ? r - 1 : r;
+            const uint32_t rowNext = (r < mRows) ? r + 1 : r;
+            for (uint32_t c = 0; c <= mColumns; ++c)
+            {
+                const uint32_t columnPrev = (c > 0) ? c - 1 : c;
+                const uint32_t columnNext = (c < mColumns) ? c + 1 : c;
+                const Math::Vector3 alongRow = position(rowNext, c) - position(rowPrev, c);
+                const Math::Vector3 alongColumn = position(r, columnNext) - position(r, columnPrev);
+
+                Graphics::Vertex& vertex = mMesh->vertices[(r * rowLength) + c];
+                vertex.position = position(r, c);
+                vertex.tangent = SafeNormalize(alongColumn, Math::Vector3::XAxis);
+                vertex.normal = SafeNormalize(Math::Cross(alongRow, alongColumn), Math::Vector3::YAxis);
+            }
+        }
+    });
+}
\ No newline at end of file
@@ -56,7 +56,93 @@ void CollisionShape::InitializeHull(const Math::Vector3& halfExtents, const Math
     mCollisionShape = hullShape;
 }
 
+void CollisionShape::InitializeHeightfield(const std::filesystem::path& fileName, float heightScale)
+{
+    ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    FILE* file = nullptr;
+    fopen_s(&file, fileName.u8string().c_str(), "rb");
+    ASSERT(file != nullptr, "CollisionShape: File %s was not found!", fileName.u8string().c_str());
+
+    // a square of one byte samples, the same way Graphics::Terrain reads it
+    fseek(file, 0L, SEEK_END);
+    const uint32_t fileSize = ftell(file);
+    const uint32_t dimensions = (uint32_t)sqrt(static_cast<float>(fileSize));
+    fseek(file, 0L, SEEK_SET);
+
+    std::vector<uint8_t> samples(dimensions * dimensions);
+    fread(samples.data(), 1, samples.size(), file);
+    fclose(file);
+
+    mHeights.resize(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        mHeights[i] = (samples[i] / 255.0f) * heightScale;
+    }
+    CreateHeightfieldShape(mHeights.data(), dimensions, dimensions);
+}
+
+void CollisionShape::InitializeHeightfield(const Graphics::Terrain& terrain)
+{
+    ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    ASSERT(terrain.mesh.vertices.size() == terrain.rows * terrain.columns, "CollisionShape: terrain has no height data!");
+    mHeights.resize(terrain.mesh.vertices.size());
+    for (std::size_t i = 0; i < mHeights.size(); ++i)
+    {
+        mHeights[i] = terrain.mesh.vertices[i].position.y;
+    }
+    CreateHeightfieldShape(mHeights.data(), terrain.rows, terrain.columns);
+}
+
+void CollisionShape::InitializeHeightfield(const float* heights, uint32_t rows, uint32_t columns)
+{
+    ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    ASSERT(heights != nullptr, "CollisionShape: terrain has no height data!");
+    CreateHeightfieldShape(heights, rows, columns);
+}
+
+void CollisionShape::InitializeTriangleMesh(const Graphics::Mesh& mesh)
+{
+    ASSERT(mCollisionShape == nullptr, "CollisionShape: Terminate must be called!");
+    ASSERT(!mesh.indices.empty() && mesh.indices.size() % 3 == 0, "CollisionShape: mesh has no triangles!");
+    mTriangleMesh = new btTriangleMesh(true, false);
+    mTriangleMesh->preallocateVertices(static_cast<int>(mesh.vertices.size()));
+    mTriangleMesh->preallocateIndices(static_cast<int>(mesh.indices.size()));
+    for (const Graphics::Vertex& vertex : mesh.vertices)
+    {
+        mTriangleMesh->findOrAddVertex(ToBtVector3(vertex.position), false);
+    }
+    for (std::size_t i = 0; i < mesh.indices.size(); i += 3)
+    {
+        mTriangleMesh->addTriangleIndices(mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2]);
+    }
+    mCollisionShape = new btBvhTriangleMeshShape(mTriangleMesh, true);
+}
+
+void CollisionShape::CreateHeightfieldShape(const float* heights, uint32_t rows, uint32_t columns)
+{
+    ASSERT(rows > 1 && columns > 1, "CollisionShape: terrain has no height data!");
+    const auto [minHeight, maxHeight] = std::minmax_element(heights, heights + rows * columns);
+    // flipped quad edges split each cell corner to corner the same way the terrain mesh does
+    btHeightfieldTerrainShape* heightfieldShape = new btHeightfieldTerrainShape(
+        static_cast<int>(columns), static_cast<int>(rows), heights,
+        *minHeight, *maxHeight, 1, true);
+    heightfieldShape->buildAccelerator();
+
+    // bullet centers the heightfield on its bounds, the terrain mesh starts at the origin
+    const btVector3 center(
+        (columns - 1) * 0.5f,
+        (*minHeight + *maxHeight) * 0.5f,
+        (rows - 1) * 0.5f);
+    btCompoundShape* compoundShape = new btCompoundShape(false, 1);
+    compoundShape->addChildShape(btTransform(btQuaternion::getIdentity(), center), heightfieldShape);
+    mChildShape = heightfieldShape;
+    mCollisionShape = compoundShape;
+}
+
 void CollisionShape::Terminate()
 {
     SafeDelete(mCollisionShape);
+    SafeDelete(mChildShape);
+    SafeDelete(mTriangleMesh);
+    mHeights.clear();
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "Precompiled.h"
+#include "CollisionShapeCache.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+	std::unique_ptr<CollisionShapeCache> sCollisionShapeCache;
+
+	// -0.0f and 0.0f must produce the same key
+	float Canonical(float value)
+	{
+		return value + 0.0f;
+	}
+}
+
+void CollisionShapeCache::StaticInitialize()
+{
+	ASSERT(sCollisionShapeCache == nullptr, "CollisionShapeCache: is already initialized");
+	sCollisionShapeCache = std::make_unique<CollisionShapeCache>();
+}
+
+void CollisionShapeCache::StaticTerminate()
+{
+	if (sCollisionShapeCache != nullptr)
+	{
+		sCollisionShapeCache.reset();
+	}
+}
+
+CollisionShapeCache* CollisionShapeCache::Get()
+{
+	ASSERT(sCollisionShapeCache != nullptr, "CollisionShapeCache: must be initialized");
+	return sCollisionShapeCache.get();
+}
+
+CollisionShapeCache::~CollisionShapeCache()
+{
+	ASSERT(mShapeCount == 0, "CollisionShapeCache: not all shapes were released");
+	for (auto& [id, entry] : mInventory)
+	{
+		if (entry.shape != nullptr)
+		{
+			entry.shape->Terminate();
+		}
+	}
+	mInventory.clear();
+}
+
+CollisionShapeId CollisionShapeCache::AcquireEmpty()
+{
+	Key key;
+	key.type = ShapeType::Empty;
+	return Acquire(key);
+}
+
+CollisionShapeId CollisionShapeCache::AcquireSphere(float radius)
+{
+	Key key;
+	key.type = ShapeType::Sphere;
+	key.params[0] = Canonical(radius);
+	return Acquire(key);
+}
+
+CollisionShapeId CollisionShapeCache::AcquireCapsule(float radius, float height)
+{
+	Key key;
+	key.type = ShapeType::Capsule;
+	key.params[0] = Canonical(radius);
+	key.params[1] = Canonical(height);
+	return Acquire(key);
+}
+
+CollisionShapeId CollisionShapeCache::AcquireBox(const Math::Vector3& halfExtents)
+{
+	Key key;
+	key.type = ShapeType::Box;
+	key.params[0] = Canonical(halfExtents.x);
+	key.params[1] = Canonical(halfExtents.y);
+	key.params[2] = Canonical(halfExtents.z);
+	return Acquire(key);
+}
+
+CollisionShapeId CollisionShapeCache::AcquireHull(const Math::Vector3& halfExtents, const Math::Vector3& origin)
+{
+	Key key;
+	key.type = ShapeType::Hull;
+	key.params[0] = Canonical(halfExtents.x);
+	key.params[1] = Canonical(halfExtents.y);
+	key.params[2] = Canonical(halfExtents.z);
+	key.params[3] = Canonical(origin.x);
+	key.params[4] = Canonical(origin.y);
+	key.params[5] = Canonical(origin.z);
+	return Acquire(key);
+}
+
+CollisionShapeId CollisionShapeCache::AcquireHeightfield(const std::filesystem::path& fileName, float heightScale)
+{
+	Key key;
+	key.type = ShapeType::Heightfield;
+	key.params[0] = Canonical(heightScale);
+	key.fileName = fileName.string();
+	return Acquire(key);
+}
+
+const CollisionShape* CollisionShapeCache::GetShape(CollisionShapeId id) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto iter = mInventory.find(id);
+	if (iter != mInventory.end())
+	{
+		return iter->second.shape.get();
+	}
+	return nullptr;
+}
+
+bool CollisionShapeCache::GetKey(CollisionShapeId id, Key& key) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto iter = mInventory.find(id);
+	if (iter == mInventory.end() || iter->second.shape == nullptr)
+	{
+		return false;
+	}
+	key = iter->second.key;
+	return true;
+}
+
+void CollisionShapeCache::Release(CollisionShapeId id)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto iter = mInventory.find(id);
+	if (iter == mInventory.end() || iter->second.shape == nullptr)
+	{
+		return;
+	}
+	--mReferenceCount;
+	--iter->second.refCount;
+	if (iter->second.refCount > 0)
+	{
+		return;
+	}
+
+	// the entry stays behind as a tombstone, so ids further along the probe chain are still found
+	iter->second.shape->Terminate();
+	iter->second.shape.reset();
+	iter->second.key = {};
+	--mShapeCount;
+
+	// a tombstone at the end of a chain is not needed, erase back until a live entry
+	while (iter != mInventory.end() && iter->second.shape == nullptr && mInventory.find(NextId(id)) == mInventory.end())
+	{
+		mInventory.erase(iter);
+		id = PreviousId(id);
+		iter = mInventory.find(id);
+	}
+}
+
+std::size_t CollisionShapeCache::GetShapeCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mShapeCount;
+}
+
+std::size_t CollisionShapeCache::GetReferenceCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mReferenceCount;
+}
+
+void CollisionShapeCache::DebugUI()
+{
+	if (ImGui::CollapsingHeader("CollisionShapeCache"))
+	{
+		ImGui::Text("Unique Shapes: %zu", GetShapeCount());
+		ImGui::Text("References: %zu", GetReferenceCount());
+	}
+}
+
+bool CollisionShapeCache::Key::operator==(const Key& other) const
+{
+	return type == other.type && params == other.params && fileName == other.fileName;
+}
+
+CollisionShapeId CollisionShapeCache::Acquire(const Key& key)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	// 0 is reserved as the invalid id, on a hash collision we probe to the next id
+	// released entries are tombstones, the probe walks past them and reuses the first one if the key is new
+	CollisionShapeId id = HashKey(key);
+	CollisionShapeId freeId = 0;
+	auto iter = mInventory.find(id);
+	while (iter != mInventory.end() && !(iter->second.shape != nullptr && iter->second.key == key))
+	{
+		if (freeId == 0 && iter->second.shape == nullptr)
+		{
+			freeId = id;
+		}
+		id = NextId(id);
+		iter = mInventory.find(id);
+	}
+
+	if (iter == mInventory.end())
+	{
+		if (freeId != 0)
+		{
+			id = freeId;
+		}
+		Entry& entry = mInventory[id];
+		entry.key = key;
+		entry.shape = std::make_unique<CollisionShape>();
+		const auto& p = key.params;
+		switch (key.type)
+		{
+		case ShapeType::Empty:		entry.shape->InitializeEmpty(); break;
+		case ShapeType::Sphere:		entry.shape->InitializeSphere(p[0]); break;
+		case ShapeType::Capsule:	entry.shape->InitializeCapsule(p[0], p[1]); break;
+		case ShapeType::Box:		entry.shape->InitializeBox({ p[0], p[1], p[2] }); break;
+		case ShapeType::Hull:		entry.shape->InitializeHull({ p[0], p[1], p[2] }, { p[3], p[4], p[5] }); break;
+		case ShapeType::Heightfield:	entry.shape->InitializeHeightfield(key.fileName, p[0]); break;
+		default:
+			ASSERT(false, "CollisionShapeCache: unsupported shape type");
+			break;
+		}
+		++mShapeCount;
+		iter = mInventory.find(id);
+	}
+
+	++iter->second.refCount;
+	++mReferenceCount;
+	return id;
+}
+
+CollisionShapeId CollisionShapeCache::HashKey(const Key& key)
+{
+	// FNV-1a over the shape type and its parameters
+	uint64_t hash = 14695981039346656037ull;
+	auto hashBytes = [&hash](const void* data, std::size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	};
+	hashBytes(&key.type, sizeof(key.type));
+	hashBytes(key.params.data(), sizeof(float) * key.params.size());
+	hashBytes(key.fileName.data(), key.fileName.size());
+
+	const CollisionShapeId id = static_cast<CollisionShapeId>(hash);
+	return (id == 0) ? 1 : id;
+}
+
+CollisionShapeId CollisionShapeCache::NextId(CollisionShapeId id)
+{
+	return (id + 1 == 0) ? 1 : id + 1;
+}
+
+CollisionShapeId CollisionShapeCache::PreviousId(CollisionShapeId id)
+{
+	return (id == 1) ? std::numeric_limits<CollisionShapeId>::max() : id - 1;
+}
\ No newline at end of file
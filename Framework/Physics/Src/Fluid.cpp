@@ -0,0 +1,604 @@
+#include "Precompiled.h"
+#include "Fluid.h"
+#include "PhysicsWorld.h"
+
+#include <xmmintrin.h>
+
+using namespace SabadEngine;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+    constexpr std::size_t ParticleBatchSize = 1024;
+    constexpr std::size_t NeighbourBatchSize = 256;
+    constexpr std::size_t SortChunkSize = 16384;
+    constexpr uint32_t RadixBits = 8;
+    constexpr uint32_t RadixSize = 1 << RadixBits;
+    constexpr uint32_t RadixMask = RadixSize - 1;
+    constexpr uint32_t EmptyCell = std::numeric_limits<uint32_t>::max();
+    constexpr float WallRestitution = 0.2f;
+    constexpr float Epsilon = 1.0e-6f;
+    // particle arrays are padded so the last partial group of 4 neighbours can still be loaded, the extra lanes are masked off
+    constexpr uint32_t SimdPadding = 3;
+
+    __m128 LaneMask(uint32_t laneCount)
+    {
+        alignas(16) static const uint32_t masks[5][4] = {
+            { 0, 0, 0, 0 },
+            { ~0u, 0, 0, 0 },
+            { ~0u, ~0u, 0, 0 },
+            { ~0u, ~0u, ~0u, 0 },
+            { ~0u, ~0u, ~0u, ~0u }
+        };
+        return _mm_load_ps(reinterpret_cast<const float*>(masks[laneCount]));
+    }
+
+    uint32_t HashCell(int32_t x, int32_t y, int32_t z)
+    {
+        return (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^ (static_cast<uint32_t>(z) * 83492791u);
+    }
+
+    float HorizontalSum(__m128 v)
+    {
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, v);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    void Reorder(std::vector<float>& data, std::vector<float>& scratch, const std::vector<uint32_t>& order, std::size_t count)
+    {
+        Core::JobSystem::Get()->ParallelFor(count, ParticleBatchSize, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                scratch[i] = data[order[i]];
+            }
+        });
+        std::swap(data, scratch);
+    }
+}
+
+Fluid::~Fluid()
+{
+    ASSERT(mMaxParticles == 0, "Fluid: Must call Terminate!");
+}
+
+void Fluid::Initialize(uint32_t maxParticles, const FluidSettings& settings)
+{
+    ASSERT(mMaxParticles == 0, "Fluid: is already initialized");
+    ASSERT(maxParticles > 0 && settings.particleSpacing > 0.0f && settings.subSteps > 0, "Fluid: particle count, spacing and sub steps must be greater than 0");
+
+    mSettings = settings;
+    mMaxParticles = maxParticles;
+    mParticleCount = 0;
+    mSmoothingRadius = settings.particleSpacing * 2.0f;
+
+    // mass is picked so a particle in a perfect lattice at the rest spacing sits exactly at rest density
+    const float h2 = mSmoothingRadius * mSmoothingRadius;
+    const float poly6 = 315.0f / (64.0f * Math::Constants::Pi * std::pow(mSmoothingRadius, 9.0f));
+    float latticeSum = 0.0f;
+    for (int z = -2; z <= 2; ++z)
+    {
+        for (int y = -2; y <= 2; ++y)
+        {
+            for (int x = -2; x <= 2; ++x)
+            {
+                const float r2 = static_cast<float>((x * x) + (y * y) + (z * z)) * settings.particleSpacing * settings.particleSpacing;
+                if (r2 < h2)
+                {
+                    latticeSum += (h2 - r2) * (h2 - r2) * (h2 - r2);
+                }
+            }
+        }
+    }
+    mParticleMass = settings.restDensity / (poly6 * latticeSum);
+
+    for (std::vector<float>* particleData : { &mPositionX, &mPositionY, &mPositionZ, &mVelocityX, &mVelocityY, &mVelocityZ,
+        &mAccelerationX, &mAccelerationY, &mAccelerationZ, &mDensity, &mInverseDensity, &mPressure, &mScratch })
+    {
+        particleData->assign(maxParticles + SimdPadding, 0.0f);
+    }
+    for (std::vector<uint32_t>* particleData : { &mKeys, &mSortedKeys, &mOrder, &mSortedOrder })
+    {
+        particleData->assign(maxParticles, 0);
+    }
+
+    // twice as many buckets as particles keeps unrelated cells from sharing a bucket
+    uint32_t tableSize = 1024;
+    while (tableSize < maxParticles * 2)
+    {
+        tableSize <<= 1;
+    }
+    mHashMask = tableSize - 1;
+    mCellStart.assign(tableSize, EmptyCell);
+    mCellEnd.assign(tableSize, 0);
+}
+
+void Fluid::Terminate()
+{
+    for (std::vector<float>* particleData : { &mPositionX, &mPositionY, &mPositionZ, &mVelocityX, &mVelocityY, &mVelocityZ,
+        &mAccelerationX, &mAccelerationY, &mAccelerationZ, &mDensity, &mInverseDensity, &mPressure, &mScratch })
+    {
+        particleData->clear();
+    }
+    for (std::vector<uint32_t>* particleData : { &mKeys, &mSortedKeys, &mOrder, &mSortedOrder, &mCellStart, &mCellEnd, &mDigitOffsets })
+    {
+        particleData->clear();
+    }
+    mStaticColliders.clear();
+    mMaxParticles = 0;
+    mParticleCount = 0;
+}
+
+void Fluid::Update(float deltaTime)
+{
+    const float timeStep = std::min(deltaTime, mSettings.maxTimeStep);
+    if (timeStep <= 0.0f || mParticleCount == 0)
+    {
+        return;
+    }
+
+    mStaticColliders.clear();
+    if (mSettings.collideWithWorld)
+    {
+        GatherStaticColliders();
+    }
+
+    const float subTimeStep = timeStep / static_cast<float>(mSettings.subSteps);
+    for (uint32_t step = 0; step < mSettings.subSteps; ++step)
+    {
+        Step(subTimeStep);
+    }
+}
+
+void Fluid::DebugUI()
+{
+    if (ImGui::CollapsingHeader("Fluid"))
+    {
+        ImGui::Text("Particles: %u / %u", mParticleCount, mMaxParticles);
+        int subSteps = static_cast<int>(mSettings.subSteps);
+        if (ImGui::DragInt("SubSteps", &subSteps, 1.0f, 1, 20))
+        {
+            mSettings.subSteps = static_cast<uint32_t>(subSteps);
+        }
+        ImGui::DragFloat("Stiffness", &mSettings.stiffness, 1.0f, 0.0f, 5000.0f);
+        ImGui::DragFloat("Viscosity", &mSettings.viscosity, 0.001f, 0.0f, 1.0f);
+        ImGui::Checkbox("CollideWithWorld", &mSettings.collideWithWorld);
+    }
+}
+
+void Fluid::Render(Graphics::ParticleSystemEffect& effect, const Graphics::Color& color)
+{
+    Graphics::Transform transform;
+    transform.scale = Math::Vector3(mSettings.particleSpacing);
+    for (uint32_t i = 0; i < mParticleCount; ++i)
+    {
+        transform.position = { mPositionX[i], mPositionY[i], mPositionZ[i] };
+        effect.Render(transform, color);
+    }
+}
+
+bool Fluid::AddParticle(const Math::Vector3& position, const Math::Vector3& velocity)
+{
+    if (mParticleCount >= mMaxParticles)
+    {
+        return false;
+    }
+
+    const uint32_t i = mParticleCount++;
+    mPositionX[i] = position.x;
+    mPositionY[i] = position.y;
+    mPositionZ[i] = position.z;
+    mVelocityX[i] = velocity.x;
+    mVelocityY[i] = velocity.y;
+    mVelocityZ[i] = velocity.z;
+    mDensity[i] = mSettings.restDensity;
+    mPressure[i] = 0.0f;
+    return true;
+}
+
+uint32_t Fluid::AddBlock(const Math::Vector3& minCorner, const Math::Vector3& maxCorner)
+{
+    const float spacing = mSettings.particleSpacing;
+    const float halfSpacing = spacing * 0.5f;
+    uint32_t added = 0;
+    for (float y = minCorner.y + halfSpacing; y <= maxCorner.y - halfSpacing; y += spacing)
+    {
+        for (float z = minCorner.z + halfSpacing; z <= maxCorner.z - halfSpacing; z += spacing)
+        {
+            for (float x = minCorner.x + halfSpacing; x <= maxCorner.x - halfSpacing; x += spacing)
+            {
+                if (!AddParticle({ x, y, z }))
+                {
+                    return added;
+                }
+                ++added;
+            }
+        }
+    }
+    return added;
+}
+
+void Fluid::Clear()
+{
+    mParticleCount = 0;
+}
+
+uint32_t Fluid::GetParticleCount() const
+{
+    return mParticleCount;
+}
+
+uint32_t Fluid::GetMaxParticles() const
+{
+    return mMaxParticles;
+}
+
+Math::Vector3 Fluid::GetPosition(uint32_t index) const
+{
+    ASSERT(index < mParticleCount, "Fluid: invalid particle index");
+    return { mPositionX[index], mPositionY[index], mPositionZ[index] };
+}
+
+Math::Vector3 Fluid::GetVelocity(uint32_t index) const
+{
+    ASSERT(index < mParticleCount, "Fluid: invalid particle index");
+    return { mVelocityX[index], mVelocityY[index], mVelocityZ[index] };
+}
+
+float Fluid::GetDensity(uint32_t index) const
+{
+    ASSERT(index < mParticleCount, "Fluid: invalid particle index");
+    return mDensity[index];
+}
+
+void Fluid::Step(float timeStep)
+{
+    SortParticles();
+    ComputeDensities();
+    ComputeAccelerations();
+    Integrate(timeStep);
+}
+
+void Fluid::GatherStaticColliders()
+{
+    // compound children are flattened, concave shapes such as heightfields are skipped
+    const btCollisionObjectArray& collisionObjects = PhysicsWorld::Get()->mDynamicsWorld->getCollisionObjectArray();
+    const btVector3 margin(mSettings.particleSpacing, mSettings.particleSpacing, mSettings.particleSpacing);
+    auto addCollider = [&](const btCollisionShape* shape, const btTransform& transform)
+    {
+        if (!shape->isConvex())
+        {
+            return;
+        }
+        StaticCollider& collider = mStaticColliders.emplace_back();
+        collider.shape = static_cast<const btConvexShape*>(shape);
+        collider.transform = transform;
+        shape->getAabb(transform, collider.aabbMin, collider.aabbMax);
+        collider.aabbMin -= margin;
+        collider.aabbMax += margin;
+    };
+    for (int i = 0; i < collisionObjects.size(); ++i)
+    {
+        const btCollisionObject* collisionObject = collisionObjects[i];
+        if (!collisionObject->isStaticObject() || !collisionObject->hasContactResponse())
+        {
+            continue;
+        }
+        const btCollisionShape* shape = collisionObject->getCollisionShape();
+        if (shape->isCompound())
+        {
+            const btCompoundShape* compoundShape = static_cast<const btCompoundShape*>(shape);
+            for (int c = 0; c < compoundShape->getNumChildShapes(); ++c)
+            {
+                addCollider(compoundShape->getChildShape(c), collisionObject->getWorldTransform() * compoundShape->getChildTransform(c));
+            }
+        }
+        else
+        {
+            addCollider(shape, collisionObject->getWorldTransform());
+        }
+    }
+}
+
+void Fluid::SortParticles()
+{
+    Core::JobSystem* jobSystem = Core::JobSystem::Get();
+    const std::size_t count = mParticleCount;
+    jobSystem->ParallelFor(count, ParticleBatchSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            mKeys[i] = GetCellKey(mPositionX[i], mPositionY[i], mPositionZ[i]);
+            mOrder[i] = static_cast<uint32_t>(i);
+        }
+    });
+
+    // least significant digit first, each chunk counts its digits, the offsets are laid out digit major
+    // so every chunk scatters into its own slice and the sort stays stable
+    const std::size_t threadCount = static_cast<std::size_t>(jobSystem->GetActiveWorkerCount()) + 1;
+    const std::size_t chunkCount = std::clamp<std::size_t>((count + SortChunkSize - 1) / SortChunkSize, 1, threadCount);
+    const std::size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    for (uint32_t shift = 0; (mHashMask >> shift) != 0; shift += RadixBits)
+    {
+        mDigitOffsets.assign(chunkCount * RadixSize, 0);
+        jobSystem->ParallelFor(chunkCount, 1, [&](std::size_t chunkBegin, std::size_t chunkEnd)
+        {
+            for (std::size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+            {
+                uint32_t* digitCounts = &mDigitOffsets[chunk * RadixSize];
+                const std::size_t last = std::min(count, (chunk + 1) * chunkSize);
+                for (std::size_t i = chunk * chunkSize; i < last; ++i)
+                {
+                    ++digitCounts[(mKeys[i] >> shift) & RadixMask];
+                }
+            }
+        });
+
+        uint32_t offset = 0;
+        for (uint32_t digit = 0; digit < RadixSize; ++digit)
+        {
+            for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+            {
+                uint32_t& digitOffset = mDigitOffsets[chunk * RadixSize + digit];
+                const uint32_t digitCount = digitOffset;
+                digitOffset = offset;
+                offset += digitCount;
+            }
+        }
+
+        jobSystem->ParallelFor(chunkCount, 1, [&](std::size_t chunkBegin, std::size_t chunkEnd)
+        {
+            for (std::size_t chunk = chunkBegin; chunk < chunkEnd; ++chunk)
+            {
+                uint32_t* digitOffsets = &mDigitOffsets[chunk * RadixSize];
+                const std::size_t last = std::min(count, (chunk + 1) * chunkSize);
+                for (std::size_t i = chunk * chunkSize; i < last; ++i)
+                {
+                    const uint32_t destination = digitOffsets[(mKeys[i] >> shift) & RadixMask]++;
+                    mSortedKeys[destination] = mKeys[i];
+                    mSortedOrder[destination] = mOrder[i];
+                }
+            }
+        });
+        std::swap(mKeys, mSortedKeys);
+        std::swap(mOrder, mSortedOrder);
+    }
+
+    for (std::vector<float>* particleData : { &mPositionX, &mPositionY, &mPositionZ, &mVelocityX, &mVelocityY, &mVelocityZ })
+    {
+        Reorder(*particleData, mScratch, mOrder, count);
+    }
+
+    jobSystem->ParallelFor(mCellStart.size(), SortChunkSize, [&](std::size_t begin, std::size_t end)
+    {
+        std::fill(mCellStart.begin() + begin, mCellStart.begin() + end, EmptyCell);
+    });
+    jobSystem->ParallelFor(count, ParticleBatchSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const uint32_t key = mKeys[i];
+            if (i == 0 || mKeys[i - 1] != key)
+            {
+                mCellStart[key] = static_cast<uint32_t>(i);
+            }
+            if (i + 1 == count || mKeys[i + 1] != key)
+            {
+                mCellEnd[key] = static_cast<uint32_t>(i + 1);
+            }
+        }
+    });
+}
+
+void Fluid::ComputeDensities()
+{
+    const float h2 = mSmoothingRadius * mSmoothingRadius;
+    const float poly6 = 315.0f / (64.0f * Math::Constants::Pi * std::pow(mSmoothingRadius, 9.0f));
+    const float densityScale = mParticleMass * poly6;
+    Core::JobSystem::Get()->ParallelFor(mParticleCount, NeighbourBatchSize, [&](std::size_t begin, std::size_t end)
+    {
+        const __m128 radiusSqr = _mm_set1_ps(h2);
+        NeighbourRanges ranges;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            GatherNeighbourRanges(static_cast<uint32_t>(i), ranges);
+            const __m128 xi = _mm_set1_ps(mPositionX[i]);
+            const __m128 yi = _mm_set1_ps(mPositionY[i]);
+            const __m128 zi = _mm_set1_ps(mPositionZ[i]);
+            __m128 sum = _mm_setzero_ps();
+            for (uint32_t range = 0; range < ranges.count; ++range)
+            {
+                const uint32_t last = ranges.last[range];
+                for (uint32_t j = ranges.first[range]; j < last; j += 4)
+                {
+                    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(&mPositionX[j]), xi);
+                    const __m128 dy = _mm_sub_ps(_mm_loadu_ps(&mPositionY[j]), yi);
+                    const __m128 dz = _mm_sub_ps(_mm_loadu_ps(&mPositionZ[j]), zi);
+                    const __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                    const __m128 inRange = _mm_and_ps(_mm_cmplt_ps(r2, radiusSqr), LaneMask(std::min(last - j, 4u)));
+                    const __m128 w = _mm_sub_ps(radiusSqr, r2);
+                    const __m128 w3 = _mm_mul_ps(_mm_mul_ps(w, w), w);
+                    sum = _mm_add_ps(sum, _mm_and_ps(w3, inRange));
+                }
+            }
+            // negative pressure would pull particles into clumps at a free surface
+            mDensity[i] = densityScale * HorizontalSum(sum);
+            mInverseDensity[i] = 1.0f / mDensity[i];
+            mPressure[i] = std::max(0.0f, mSettings.stiffness * (mDensity[i] - mSettings.restDensity));
+        }
+    });
+}
+
+void Fluid::ComputeAccelerations()
+{
+    // spiky kernel gradient for pressure, viscosity kernel laplacian for viscosity, both share 45 / (pi h^6)
+    const float h = mSmoothingRadius;
+    const float kernelScale = 45.0f / (Math::Constants::Pi * std::pow(h, 6.0f));
+    const float pressureScale = 0.5f * mParticleMass * kernelScale;
+    const float viscosityScale = mSettings.viscosity * mParticleMass * kernelScale;
+    Core::JobSystem::Get()->ParallelFor(mParticleCount, NeighbourBatchSize, [&](std::size_t begin, std::size_t end)
+    {
+        const __m128 radius = _mm_set1_ps(h);
+        const __m128 radiusSqr = _mm_set1_ps(h * h);
+        const __m128 epsilon = _mm_set1_ps(Epsilon);
+        NeighbourRanges ranges;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            GatherNeighbourRanges(static_cast<uint32_t>(i), ranges);
+            const __m128 xi = _mm_set1_ps(mPositionX[i]);
+            const __m128 yi = _mm_set1_ps(mPositionY[i]);
+            const __m128 zi = _mm_set1_ps(mPositionZ[i]);
+            const __m128 vxi = _mm_set1_ps(mVelocityX[i]);
+            const __m128 vyi = _mm_set1_ps(mVelocityY[i]);
+            const __m128 vzi = _mm_set1_ps(mVelocityZ[i]);
+            const __m128 pi = _mm_set1_ps(mPressure[i]);
+            __m128 pressureX = _mm_setzero_ps(), pressureY = _mm_setzero_ps(), pressureZ = _mm_setzero_ps();
+            __m128 viscosityX = _mm_setzero_ps(), viscosityY = _mm_setzero_ps(), viscosityZ = _mm_setzero_ps();
+            for (uint32_t range = 0; range < ranges.count; ++range)
+            {
+                const uint32_t last = ranges.last[range];
+                for (uint32_t j = ranges.first[range]; j < last; j += 4)
+                {
+                    const __m128 dx = _mm_sub_ps(xi, _mm_loadu_ps(&mPositionX[j]));
+                    const __m128 dy = _mm_sub_ps(yi, _mm_loadu_ps(&mPositionY[j]));
+                    const __m128 dz = _mm_sub_ps(zi, _mm_loadu_ps(&mPositionZ[j]));
+                    const __m128 r2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+                    // masks out particle i itself, anything outside the smoothing radius and the padding, the masked lanes may hold inf or nan
+                    const __m128 inRange = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(r2, radiusSqr), _mm_cmpgt_ps(r2, epsilon)), LaneMask(std::min(last - j, 4u)));
+                    const __m128 r = _mm_sqrt_ps(r2);
+                    const __m128 hr = _mm_sub_ps(radius, r);
+                    const __m128 pj = _mm_loadu_ps(&mPressure[j]);
+                    const __m128 inverseDensityJ = _mm_loadu_ps(&mInverseDensity[j]);
+
+                    const __m128 pressureTerm = _mm_and_ps(_mm_div_ps(_mm_mul_ps(_mm_mul_ps(_mm_add_ps(pi, pj), _mm_mul_ps(hr, hr)), inverseDensityJ), r), inRange);
+                    pressureX = _mm_add_ps(pressureX, _mm_mul_ps(dx, pressureTerm));
+                    pressureY = _mm_add_ps(pressureY, _mm_mul_ps(dy, pressureTerm));
+                    pressureZ = _mm_add_ps(pressureZ, _mm_mul_ps(dz, pressureTerm));
+
+                    const __m128 viscosityTerm = _mm_and_ps(_mm_mul_ps(hr, inverseDensityJ), inRange);
+                    viscosityX = _mm_add_ps(viscosityX, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&mVelocityX[j]), vxi), viscosityTerm));
+                    viscosityY = _mm_add_ps(viscosityY, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&mVelocityY[j]), vyi), viscosityTerm));
+                    viscosityZ = _mm_add_ps(viscosityZ, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&mVelocityZ[j]), vzi), viscosityTerm));
+                }
+            }
+            const float pressureFactor = pressureScale * mInverseDensity[i];
+            mAccelerationX[i] = (pressureFactor * HorizontalSum(pressureX)) + (viscosityScale * HorizontalSum(viscosityX));
+            mAccelerationY[i] = (pressureFactor * HorizontalSum(pressureY)) + (viscosityScale * HorizontalSum(viscosityY));
+            mAccelerationZ[i] = (pressureFactor * HorizontalSum(pressureZ)) + (viscosityScale * HorizontalSum(viscosityZ));
+        }
+    });
+}
+
+void Fluid::Integrate(float timeStep)
+{
+    const Math::Vector3 gravity = PhysicsWorld::Get()->GetSettings().gravity;
+    const float radius = mSettings.particleSpacing * 0.5f;
+    const Math::Vector3 boundsMin = mSettings.boundsMin;
+    const Math::Vector3 boundsMax = mSettings.boundsMax;
+    Core::JobSystem::Get()->ParallelFor(mParticleCount, ParticleBatchSize, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Math::Vector3 velocity = { mVelocityX[i], mVelocityY[i], mVelocityZ[i] };
+            velocity += (Math::Vector3(mAccelerationX[i], mAccelerationY[i], mAccelerationZ[i]) + gravity) * timeStep;
+            Math::Vector3 position = Math::Vector3(mPositionX[i], mPositionY[i], mPositionZ[i]) + (velocity * timeStep);
+
+            for (const StaticCollider& collider : mStaticColliders)
+            {
+                const btVector3 point = ToBtVector3(position);
+                if (point.x() < collider.aabbMin.x() || point.y() < collider.aabbMin.y() || point.z() < collider.aabbMin.z() ||
+                    point.x() > collider.aabbMax.x() || point.y() > collider.aabbMax.y() || point.z() > collider.aabbMax.z())
+                {
+                    continue;
+                }
+                // the normal points out of the collider towards the particle
+                btGjkEpaSolver2::sResults results;
+                const float distance = static_cast<float>(btGjkEpaSolver2::SignedDistance(point, radius, collider.shape, collider.transform, results));
+                if (distance < 0.0f)
+                {
+                    const Math::Vector3 normal = ToVector3(results.normal);
+                    position -= normal * distance;
+                    const float normalSpeed = Math::Dot(velocity, normal);
+                    if (normalSpeed < 0.0f)
+                    {
+                        velocity -= normal * (normalSpeed * (1.0f + WallRestitution));
+                    }
+                }
+            }
+
+            float* positionAxis[3] = { &position.x, &position.y, &position.z };
+            float* velocityAxis[3] = { &velocity.x, &velocity.y, &velocity.z };
+            const float minAxis[3] = { boundsMin.x, boundsMin.y, boundsMin.z };
+            const float maxAxis[3] = { boundsMax.x, boundsMax.y, boundsMax.z };
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                if (*positionAxis[axis] < minAxis[axis])
+                {
+                    *positionAxis[axis] = minAxis[axis];
+                    *velocityAxis[axis] = std::max(*velocityAxis[axis], -*velocityAxis[axis] * WallRestitution);
+                }
+                else if (*positionAxis[axis] > maxAxis[axis])
+                {
+                    *positionAxis[axis] = maxAxis[axis];
+                    *velocityAxis[axis] = std::min(*velocityAxis[axis], -*velocityAxis[axis] * WallRestitution);
+                }
+            }
+
+            mPositionX[i] = position.x;
+            mPositionY[i] = position.y;
+            mPositionZ[i] = position.z;
+            mVelocityX[i] = velocity.x;
+            mVelocityY[i] = velocity.y;
+            mVelocityZ[i] = velocity.z;
+        }
+    });
+}
+
+uint32_t Fluid::GetCellKey(float x, float y, float z) const
+{
+    const float inverseCellSize = 1.0f / mSmoothingRadius;
+    const int32_t cellX = static_cast<int32_t>(std::floor(x * inverseCellSize));
+    const int32_t cellY = static_cast<int32_t>(std::floor(y * inverseCellSize));
+    const int32_t cellZ = static_cast<int32_t>(std::floor(z * inverseCellSize));
+    return HashCell(cellX, cellY, cellZ) & mHashMask;
+}
+
+void Fluid::GatherNeighbourRanges(uint32_t index, NeighbourRanges& ranges) const
+{
+    const float inverseCellSize = 1.0f / mSmoothingRadius;
+    const int32_t cellX = static_cast<int32_t>(std::floor(mPositionX[index] * inverseCellSize));
+    const int32_t cellY = static_cast<int32_t>(std::floor(mPositionY[index] * inverseCellSize));
+    const int32_t cellZ = static_cast<int32_t>(std::floor(mPositionZ[index] * inverseCellSize));
+    if (ranges.valid && ranges.cellX == cellX && ranges.cellY == cellY && ranges.cellZ == cellZ)
+    {
+        return;
+    }
+
+    // two neighbouring cells can land in the same bucket, each bucket is kept once so nothing is counted twice
+    ranges.cellX = cellX;
+    ranges.cellY = cellY;
+    ranges.cellZ = cellZ;
+    ranges.valid = true;
+    ranges.count = 0;
+    uint32_t visited[27];
+    uint32_t visitedCount = 0;
+    for (int z = -1; z <= 1; ++z)
+    {
+        for (int y = -1; y <= 1; ++y)
+        {
+            for (int x = -1; x <= 1; ++x)
+            {
+                const uint32_t key = HashCell(cellX + x, cellY + y, cellZ + z) & mHashMask;
+                if (mCellStart[key] == EmptyCell || std::find(visited, visited + visitedCount, key) != visited + visitedCount)
+                {
+                    continue;
+                }
+                visited[visitedCount++] = key;
+                ranges.first[ranges.count] = mCellStart[key];
+                ranges.last[ranges.count] = mCellEnd[key];
+                ++ranges.count;
+            }
+        }
+    }
+}
\ No newline at end of file
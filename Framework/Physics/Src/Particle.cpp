@@ -9,15 +9,18 @@ using namespace SabadEngine::Physics;
 void Particle::Initialize()
 {
     mLifetime = 0.0f;
-    mCollisionShape.InitializeEmpty();
-    mRigidBody.Initialize(mTransform, mCollisionShape, 1.0f, false);
+    // every particle shares the same empty shape
+    CollisionShapeCache* shapeCache = CollisionShapeCache::Get();
+    mCollisionShapeId = shapeCache->AcquireEmpty();
+    mRigidBody.Initialize(mTransform, *shapeCache->GetShape(mCollisionShapeId), 1.0f, false);
     mRigidBody.SetCollisionFlags(btCollisionObject::CF_NO_CONTACT_RESPONSE);
 }
 
 void Particle::Terminate()
 {
     mRigidBody.Terminate();
-    mCollisionShape.Terminate();
+    CollisionShapeCache::Get()->Release(mCollisionShapeId);
+    mCollisionShapeId = 0;
 }
 
 void Particle::Activate(const ParticleInfo& info)
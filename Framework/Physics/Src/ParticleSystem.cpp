@@ -24,7 +24,10 @@ void ParticleSystem::Terminate()
     }
     mParticles.clear();
 
-    TextureManager::Get()->ReleaseTexture(mInfo.textureId);
+    if (mInfo.textureId != 0)
+    {
+        TextureManager::Get()->ReleaseTexture(mInfo.textureId);
+    }
 }
 
 void ParticleSystem::Update(float deltaTime)
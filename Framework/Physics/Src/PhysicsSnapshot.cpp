@@ -0,0 +1,155 @@
+#include "Precompiled.h"
+#include "PhysicsSnapshot.h"
+#include "PhysicsWorld.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+	uint32_t BaselineWord(const std::vector<uint32_t>* baseline, std::size_t index)
+	{
+		return (baseline != nullptr && index < baseline->size()) ? (*baseline)[index] : 0;
+	}
+}
+
+uint32_t PhysicsSnapshot::GetFrame() const
+{
+	return mFrame;
+}
+
+uint32_t PhysicsSnapshot::GetBodyCount() const
+{
+	return mState.empty() ? 0 : mState[0];
+}
+
+std::size_t PhysicsSnapshot::GetSizeInBytes() const
+{
+	return mState.size() * sizeof(uint32_t);
+}
+
+bool PhysicsSnapshot::Matches(const PhysicsSnapshot& other) const
+{
+	return mState == other.mState;
+}
+
+const std::vector<uint32_t>& PhysicsSnapshot::GetDelta() const
+{
+	return mDelta;
+}
+
+std::size_t PhysicsSnapshot::GetDeltaSizeInBytes() const
+{
+	return mDelta.size() * sizeof(uint32_t);
+}
+
+void PhysicsSnapshot::Decode(const PhysicsSnapshot* baseline, const uint32_t* delta, std::size_t deltaCount, uint32_t frame)
+{
+	ASSERT(baseline != this, "PhysicsSnapshot: can't decode against itself");
+	const std::vector<uint32_t>* baseState = (baseline != nullptr) ? &baseline->mState : nullptr;
+
+	mState.clear();
+	std::size_t read = 0;
+	while (read + 1 < deltaCount)
+	{
+		const uint32_t zeroCount = delta[read++];
+		const uint32_t literalCount = delta[read++];
+		for (uint32_t i = 0; i < zeroCount; ++i)
+		{
+			mState.push_back(BaselineWord(baseState, mState.size()));
+		}
+		ASSERT(read + literalCount <= deltaCount, "PhysicsSnapshot: delta is truncated");
+		for (uint32_t i = 0; i < literalCount; ++i)
+		{
+			mState.push_back(delta[read++] ^ BaselineWord(baseState, mState.size()));
+		}
+	}
+	mDelta.assign(delta, delta + deltaCount);
+	mFrame = frame;
+}
+
+void PhysicsSnapshot::Encode(const PhysicsSnapshot* baseline)
+{
+	const std::vector<uint32_t>* baseState = (baseline != nullptr && baseline != this) ? &baseline->mState : nullptr;
+	const std::size_t wordCount = mState.size();
+
+	// stored as [zero run, literal run, literals...] until every word is written
+	mDelta.clear();
+	mDelta.reserve(wordCount * 2 + 2);
+	std::size_t index = 0;
+	while (index < wordCount)
+	{
+		uint32_t zeroCount = 0;
+		while (index < wordCount && (mState[index] ^ BaselineWord(baseState, index)) == 0)
+		{
+			++zeroCount;
+			++index;
+		}
+		const std::size_t literalStart = index;
+		while (index < wordCount && (mState[index] ^ BaselineWord(baseState, index)) != 0)
+		{
+			++index;
+		}
+		mDelta.push_back(zeroCount);
+		mDelta.push_back(static_cast<uint32_t>(index - literalStart));
+		for (std::size_t i = literalStart; i < index; ++i)
+		{
+			mDelta.push_back(mState[i] ^ BaselineWord(baseState, i));
+		}
+	}
+}
+
+void PhysicsSnapshotPool::Initialize(uint32_t capacity)
+{
+	ASSERT(capacity > 0, "PhysicsSnapshotPool: capacity must be greater than 0");
+	mSnapshots.resize(capacity);
+	Clear();
+}
+
+void PhysicsSnapshotPool::Terminate()
+{
+	mSnapshots.clear();
+	Clear();
+}
+
+const PhysicsSnapshot& PhysicsSnapshotPool::Capture(uint32_t frame)
+{
+	ASSERT(!mSnapshots.empty(), "PhysicsSnapshotPool: must be initialized");
+	const PhysicsSnapshot* previous = GetLatest();
+	PhysicsSnapshot& snapshot = mSnapshots[mNextIndex];
+	PhysicsWorld::Get()->CaptureSnapshot(snapshot, frame);
+	snapshot.Encode(previous);
+
+	mNextIndex = (mNextIndex + 1) % mSnapshots.size();
+	mCount = std::min(mCount + 1, static_cast<uint32_t>(mSnapshots.size()));
+	return snapshot;
+}
+
+const PhysicsSnapshot* PhysicsSnapshotPool::Find(uint32_t frame) const
+{
+	for (uint32_t i = 0; i < mCount; ++i)
+	{
+		const PhysicsSnapshot& snapshot = mSnapshots[i];
+		if (snapshot.GetFrame() == frame)
+		{
+			return &snapshot;
+		}
+	}
+	return nullptr;
+}
+
+const PhysicsSnapshot* PhysicsSnapshotPool::GetLatest() const
+{
+	if (mCount == 0)
+	{
+		return nullptr;
+	}
+	const uint32_t latestIndex = (mNextIndex + static_cast<uint32_t>(mSnapshots.size()) - 1) % mSnapshots.size();
+	return &mSnapshots[latestIndex];
+}
+
+void PhysicsSnapshotPool::Clear()
+{
+	mNextIndex = 0;
+	mCount = 0;
+}
\ No newline at end of file
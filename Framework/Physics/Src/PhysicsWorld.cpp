@@ -8,6 +8,382 @@ using namespace SabadEngine::Physics;
 namespace
 {
 	std::unique_ptr<PhysicsWorld> sPhysicsWorld;
+
+	constexpr std::size_t QueryBatchSize = 64;
+
+	// every thread that runs queries keeps its own traversal stack, the job system workers and any other caller alike
+	btNodeStack& GetQueryStack()
+	{
+		thread_local btNodeStack stack;
+		return stack;
+	}
+
+	// hands every broadphase leaf that the traversal reaches to a callable
+	template<class Callback>
+	struct LeafVisitor : btDbvt::ICollide
+	{
+		LeafVisitor(Callback& cb) : callback(cb) {}
+		void Process(const btDbvtNode* leaf) override
+		{
+			callback(static_cast<btBroadphaseProxy*>(leaf->data));
+		}
+		Callback& callback;
+	};
+
+	bool PassesFilter(const btBroadphaseProxy* proxy, int collisionGroup, int collisionMask)
+	{
+		return (proxy->m_collisionFilterGroup & collisionMask) != 0
+			&& (collisionGroup & proxy->m_collisionFilterMask) != 0;
+	}
+
+	PhysicsObject* GetPhysicsObject(const btCollisionObject* collisionObject)
+	{
+		return static_cast<PhysicsObject*>(collisionObject->getUserPointer());
+	}
+
+	// walks the broadphase leaves that the ray (or box swept along the ray) passes through
+	// uses the dbvt directly with our own stack, btDbvtBroadphase::rayTest shares a single stack between callers
+	template<class Callback>
+	void VisitRay(const btBroadphaseInterface* broadphase, const btCollisionObjectArray& objects, btNodeStack& stack,
+		const btVector3& from, const btVector3& to, const btVector3& aabbMin, const btVector3& aabbMax, Callback&& callback)
+	{
+		const btDbvtBroadphase* dbvt = dynamic_cast<const btDbvtBroadphase*>(broadphase);
+		if (dbvt == nullptr)
+		{
+			for (int i = 0; i < objects.size(); ++i)
+			{
+				callback(objects[i]->getBroadphaseHandle());
+			}
+			return;
+		}
+
+		btVector3 rayDirection = to - from;
+		const btScalar length = rayDirection.length();
+		if (length > SIMD_EPSILON)
+		{
+			rayDirection /= length;
+		}
+		btVector3 rayDirectionInverse;
+		unsigned int signs[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			rayDirectionInverse[i] = (rayDirection[i] == btScalar(0.0)) ? btScalar(BT_LARGE_FLOAT) : btScalar(1.0) / rayDirection[i];
+			signs[i] = rayDirectionInverse[i] < 0.0;
+		}
+
+		LeafVisitor<Callback> visitor(callback);
+		for (const btDbvt& set : dbvt->m_sets)
+		{
+			set.rayTestInternal(set.m_root, from, to, rayDirectionInverse, signs, length, aabbMin, aabbMax, stack, visitor);
+		}
+	}
+
+	template<class Callback>
+	void VisitAabb(const btBroadphaseInterface* broadphase, const btCollisionObjectArray& objects, btNodeStack& stack,
+		const btVector3& aabbMin, const btVector3& aabbMax, Callback&& callback)
+	{
+		const btDbvtBroadphase* dbvt = dynamic_cast<const btDbvtBroadphase*>(broadphase);
+		if (dbvt == nullptr)
+		{
+			for (int i = 0; i < objects.size(); ++i)
+			{
+				btBroadphaseProxy* proxy = objects[i]->getBroadphaseHandle();
+				if (TestAabbAgainstAabb2(aabbMin, aabbMax, proxy->m_aabbMin, proxy->m_aabbMax))
+				{
+					callback(proxy);
+				}
+			}
+			return;
+		}
+
+		const ATTRIBUTE_ALIGNED16(btDbvtVolume) bounds = btDbvtVolume::FromMM(aabbMin, aabbMax);
+		LeafVisitor<Callback> visitor(callback);
+		for (const btDbvt& set : dbvt->m_sets)
+		{
+			set.collideTVNoStackAlloc(set.m_root, bounds, stack, visitor);
+		}
+	}
+
+	// bodies are stored as raw float bits so a restore is bit exact
+	constexpr uint32_t SnapshotHeaderWords = 2;
+
+	// m_localTime is protected, it holds the left over time between fixed steps and has to rewind with the bodies
+	struct LocalTimeAccess : btDiscreteDynamicsWorld
+	{
+		static constexpr btScalar btDiscreteDynamicsWorld::* localTime = &LocalTimeAccess::m_localTime;
+	};
+
+	// m_islandManager is protected too, the world frees whatever it points at with btAlignedFree
+	struct IslandManagerAccess : btDiscreteDynamicsWorld
+	{
+		static constexpr btSimulationIslandManager* btDiscreteDynamicsWorld::* islandManager = &IslandManagerAccess::m_islandManager;
+	};
+
+	// bullet joins bodies into islands through broadphase pairs, and which pairs the broadphase still holds depends on
+	// the order bodies moved in, joining them through touching contacts instead, which snapshots hold,
+	// puts the same bodies to sleep on the same step after a restore
+	class ContactIslandManager final : public btSimulationIslandManager
+	{
+	public:
+		void updateActivationState(btCollisionWorld* collisionWorld, btDispatcher* dispatcher) override
+		{
+			const btCollisionObjectArray& collisionObjects = collisionWorld->getCollisionObjectArray();
+			int islandCount = 0;
+			for (int i = 0; i < collisionObjects.size(); ++i)
+			{
+				btCollisionObject* collisionObject = collisionObjects[i];
+				if (!collisionObject->isStaticOrKinematicObject())
+				{
+					collisionObject->setIslandTag(islandCount++);
+				}
+				collisionObject->setCompanionId(-1);
+				collisionObject->setHitFraction(1.0f);
+			}
+			initUnionFind(islandCount);
+
+			for (int i = 0; i < dispatcher->getNumManifolds(); ++i)
+			{
+				const btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+				const btCollisionObject* body0 = manifold->getBody0();
+				const btCollisionObject* body1 = manifold->getBody1();
+				if (manifold->getNumContacts() > 0 && body0->mergesSimulationIslands() && body1->mergesSimulationIslands())
+				{
+					getUnionFind().unite(body0->getIslandTag(), body1->getIslandTag());
+				}
+			}
+		}
+	};
+
+	// triggers only overlap things that move, never static geometry or other triggers
+	void AddGhostObject(btCollisionWorld* world, btGhostObject* ghostObject)
+	{
+		const int group = btBroadphaseProxy::SensorTrigger;
+		const int mask = btBroadphaseProxy::AllFilter & ~(btBroadphaseProxy::StaticFilter | btBroadphaseProxy::SensorTrigger);
+		world->addCollisionObject(ghostObject, group, mask);
+	}
+
+	// adds a pair between one proxy and every other proxy whose bounds it overlaps, the pair cache applies the filters
+	struct PairFinder : btBroadphaseAabbCallback
+	{
+		PairFinder(btOverlappingPairCache* cache, btBroadphaseProxy* target) : pairCache(cache), proxy(target) {}
+		bool process(const btBroadphaseProxy* other) override
+		{
+			if (other != proxy)
+			{
+				pairCache->addOverlappingPair(proxy, const_cast<btBroadphaseProxy*>(other));
+			}
+			return true;
+		}
+		btOverlappingPairCache* pairCache;
+		btBroadphaseProxy* proxy;
+	};
+
+	// the pair cache only checks the filters when it adds a pair, so the narrowphase checks them again every step
+	// a pair whose filter changed since is skipped and its manifold freed, which keeps SetCollisionFilter from searching every pair
+	void FilteredNearCallback(btBroadphasePair& pair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo)
+	{
+		const btBroadphaseProxy* proxy1 = pair.m_pProxy1;
+		if (PassesFilter(pair.m_pProxy0, proxy1->m_collisionFilterGroup, proxy1->m_collisionFilterMask))
+		{
+			btCollisionDispatcher::defaultNearCallback(pair, dispatcher, dispatchInfo);
+		}
+		else if (pair.m_algorithm != nullptr)
+		{
+			pair.m_algorithm->~btCollisionAlgorithm();
+			dispatcher.freeCollisionAlgorithm(pair.m_algorithm);
+			pair.m_algorithm = nullptr;
+		}
+	}
+
+	bool ComparePairs(int idA, int idB, int otherIdA, int otherIdB)
+	{
+		return (idA != otherIdA) ? idA < otherIdA : idB < otherIdB;
+	}
+
+	bool IsSnapshotBody(const btRigidBody* rigidBody)
+	{
+		return rigidBody != nullptr && !rigidBody->isStaticOrKinematicObject();
+	}
+
+	void WriteScalar(std::vector<uint32_t>& state, btScalar value)
+	{
+		const float f = static_cast<float>(value);
+		uint32_t bits = 0;
+		memcpy(&bits, &f, sizeof(bits));
+		state.push_back(bits);
+	}
+
+	void WriteVector3(std::vector<uint32_t>& state, const btVector3& v)
+	{
+		WriteScalar(state, v.x());
+		WriteScalar(state, v.y());
+		WriteScalar(state, v.z());
+	}
+
+	void WriteTransform(std::vector<uint32_t>& state, const btTransform& transform)
+	{
+		const btMatrix3x3& basis = transform.getBasis();
+		WriteVector3(state, basis[0]);
+		WriteVector3(state, basis[1]);
+		WriteVector3(state, basis[2]);
+		WriteVector3(state, transform.getOrigin());
+	}
+
+	btScalar ReadScalar(const uint32_t*& read)
+	{
+		float f = 0.0f;
+		memcpy(&f, read++, sizeof(f));
+		return static_cast<btScalar>(f);
+	}
+
+	btVector3 ReadVector3(const uint32_t*& read)
+	{
+		const btScalar x = ReadScalar(read);
+		const btScalar y = ReadScalar(read);
+		const btScalar z = ReadScalar(read);
+		return btVector3(x, y, z);
+	}
+
+	btTransform ReadTransform(const uint32_t*& read)
+	{
+		const btVector3 row0 = ReadVector3(read);
+		const btVector3 row1 = ReadVector3(read);
+		const btVector3 row2 = ReadVector3(read);
+		const btVector3 origin = ReadVector3(read);
+		return btTransform(btMatrix3x3(row0.x(), row0.y(), row0.z(), row1.x(), row1.y(), row1.z(), row2.x(), row2.y(), row2.z()), origin);
+	}
+
+	// everything the next step reads from a contact point, the narrowphase matches new points against it and the solver
+	// warm starts from its impulses and friction directions
+	void WriteContactPoint(std::vector<uint32_t>& state, const btManifoldPoint& point)
+	{
+		WriteVector3(state, point.m_localPointA);
+		WriteVector3(state, point.m_localPointB);
+		WriteVector3(state, point.m_positionWorldOnA);
+		WriteVector3(state, point.m_positionWorldOnB);
+		WriteVector3(state, point.m_normalWorldOnB);
+		WriteScalar(state, point.m_distance1);
+		WriteScalar(state, point.m_combinedFriction);
+		WriteScalar(state, point.m_combinedRollingFriction);
+		WriteScalar(state, point.m_combinedSpinningFriction);
+		WriteScalar(state, point.m_combinedRestitution);
+		state.push_back(static_cast<uint32_t>(point.m_partId0));
+		state.push_back(static_cast<uint32_t>(point.m_partId1));
+		state.push_back(static_cast<uint32_t>(point.m_index0));
+		state.push_back(static_cast<uint32_t>(point.m_index1));
+		state.push_back(static_cast<uint32_t>(point.m_contactPointFlags));
+		WriteScalar(state, point.m_appliedImpulse);
+		WriteScalar(state, point.m_prevRHS);
+		WriteScalar(state, point.m_appliedImpulseLateral1);
+		WriteScalar(state, point.m_appliedImpulseLateral2);
+		WriteScalar(state, point.m_contactMotion1);
+		WriteScalar(state, point.m_contactMotion2);
+		WriteScalar(state, point.m_contactCFM);
+		WriteScalar(state, point.m_contactERP);
+		WriteScalar(state, point.m_frictionCFM);
+		state.push_back(static_cast<uint32_t>(point.m_lifeTime));
+		WriteVector3(state, point.m_lateralFrictionDir1);
+		WriteVector3(state, point.m_lateralFrictionDir2);
+	}
+
+	constexpr uint32_t ContactPointWords = 41;
+
+	void ReadContactPoint(const uint32_t*& read, btManifoldPoint& point)
+	{
+		point.m_localPointA = ReadVector3(read);
+		point.m_localPointB = ReadVector3(read);
+		point.m_positionWorldOnA = ReadVector3(read);
+		point.m_positionWorldOnB = ReadVector3(read);
+		point.m_normalWorldOnB = ReadVector3(read);
+		point.m_distance1 = ReadScalar(read);
+		point.m_combinedFriction = ReadScalar(read);
+		point.m_combinedRollingFriction = ReadScalar(read);
+		point.m_combinedSpinningFriction = ReadScalar(read);
+		point.m_combinedRestitution = ReadScalar(read);
+		point.m_partId0 = static_cast<int>(*read++);
+		point.m_partId1 = static_cast<int>(*read++);
+		point.m_index0 = static_cast<int>(*read++);
+		point.m_index1 = static_cast<int>(*read++);
+		point.m_contactPointFlags = static_cast<int>(*read++);
+		point.m_appliedImpulse = ReadScalar(read);
+		point.m_prevRHS = ReadScalar(read);
+		point.m_appliedImpulseLateral1 = ReadScalar(read);
+		point.m_appliedImpulseLateral2 = ReadScalar(read);
+		point.m_contactMotion1 = ReadScalar(read);
+		point.m_contactMotion2 = ReadScalar(read);
+		point.m_contactCFM = ReadScalar(read);
+		point.m_contactERP = ReadScalar(read);
+		point.m_frictionCFM = ReadScalar(read);
+		point.m_lifeTime = static_cast<int>(*read++);
+		point.m_lateralFrictionDir1 = ReadVector3(read);
+		point.m_lateralFrictionDir2 = ReadVector3(read);
+		point.m_userPersistentData = nullptr;
+	}
+
+	// snapshots name the bodies of a manifold by their place in the world's collision object array
+	std::pair<int, int> GetManifoldBodies(const btPersistentManifold* manifold)
+	{
+		return { manifold->getBody0()->getWorldArrayIndex(), manifold->getBody1()->getWorldArrayIndex() };
+	}
+
+	// runs bullet's parallel loops on the JobSystem, so the collision dispatch and the solver share the engine's workers
+	// bullet numbers threads in the order they first run a loop and sizes its per thread arrays by getNumThreads,
+	// so only the JobSystem threads may step a threaded world
+	class JobSystemTaskScheduler final : public btITaskScheduler
+	{
+	public:
+		JobSystemTaskScheduler() : btITaskScheduler("JobSystem") {}
+
+		int getMaxNumThreads() const override
+		{
+			return static_cast<int>(Core::JobSystem::Get()->GetThreadCount());
+		}
+
+		int getNumThreads() const override
+		{
+			return getMaxNumThreads();
+		}
+
+		void setNumThreads(int numThreads) override
+		{
+			mThreadCount = static_cast<std::size_t>(std::clamp(numThreads, 1, getMaxNumThreads()));
+		}
+
+		void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+		{
+			Core::JobSystem::Get()->ParallelFor(static_cast<std::size_t>(iEnd - iBegin), GetBatchSize(iBegin, iEnd, grainSize),
+				[iBegin, &body](std::size_t begin, std::size_t end)
+			{
+				body.forLoop(iBegin + static_cast<int>(begin), iBegin + static_cast<int>(end));
+			});
+		}
+
+		btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+		{
+			std::mutex sumMutex;
+			btScalar sum = 0.0f;
+			Core::JobSystem::Get()->ParallelFor(static_cast<std::size_t>(iEnd - iBegin), GetBatchSize(iBegin, iEnd, grainSize),
+				[iBegin, &body, &sumMutex, &sum](std::size_t begin, std::size_t end)
+			{
+				const btScalar batchSum = body.sumLoop(iBegin + static_cast<int>(begin), iBegin + static_cast<int>(end));
+				std::lock_guard<std::mutex> lock(sumMutex);
+				sum += batchSum;
+			});
+			return sum;
+		}
+
+	private:
+		// no more batches than threads the world may use, the JobSystem never puts more threads on a loop than it has batches
+		std::size_t GetBatchSize(int iBegin, int iEnd, int grainSize) const
+		{
+			const std::size_t count = static_cast<std::size_t>(iEnd - iBegin);
+			return std::max(static_cast<std::size_t>(std::max(grainSize, 1)), (count + mThreadCount - 1) / mThreadCount);
+		}
+
+		std::size_t mThreadCount = 1;
+	};
+
+	JobSystemTaskScheduler sTaskScheduler;
 }
 
 void PhysicsWorld::StaticInitialize(const Settings& settings)
@@ -40,19 +416,49 @@ PhysicsWorld::~PhysicsWorld()
 void PhysicsWorld::Initialize(const Settings& settings)
 {
 	mSettings = settings;
-	mInterface = new btDbvtBroadphase();
-	mSolver = new btSequentialImpulseConstraintSolver();
+	if (settings.broadphase == BroadphaseType::AxisSweep)
+	{
+		mInterface = new bt32BitAxisSweep3(ToBtVector3(settings.worldMin), ToBtVector3(settings.worldMax));
+	}
+	else
+	{
+		mInterface = new btDbvtBroadphase();
+	}
 #ifdef USE_SOFT_BODY
 	mCollisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
-	mDispatcher = new btCollisionDispatcher(mCollisionConfiguration);
-	mDynamicsWorld = new btSoftRigidDynamicsWorld(mDispatcher, mInterface, mSolver, mCollisionConfiguration);
 #else
 	mCollisionConfiguration = new btDefaultCollisionConfiguration();
-	mDispatcher = new btCollisionDispatcher(mCollisionConfiguration);
+#endif
+	mSettings.threadCount = (settings.threadCount > 1) ? std::min(settings.threadCount, Core::JobSystem::Get()->GetThreadCount()) : 1;
+	if (mSettings.threadCount > 1)
+	{
+		// the task scheduler has to be set first, the parallel dispatcher sizes its per thread lists from it
+		sTaskScheduler.setNumThreads(static_cast<int>(mSettings.threadCount));
+		btSetTaskScheduler(&sTaskScheduler);
+		mSolver = new btSequentialImpulseConstraintSolverMt();
+		mDispatcher = new btCollisionDispatcherMt(mCollisionConfiguration);
+	}
+	else
+	{
+		mSolver = new btSequentialImpulseConstraintSolver();
+		mDispatcher = new btCollisionDispatcher(mCollisionConfiguration);
+	}
+	mDispatcher->setNearCallback(FilteredNearCallback);
+#ifdef USE_SOFT_BODY
+	mDynamicsWorld = new btSoftRigidDynamicsWorld(mDispatcher, mInterface, mSolver, mCollisionConfiguration);
+#else
 	mDynamicsWorld = new btDiscreteDynamicsWorld(mDispatcher, mInterface, mSolver, mCollisionConfiguration);
 #endif
 
 	mDynamicsWorld->setGravity(ToBtVector3(mSettings.gravity));
+	mDynamicsWorld->getSolverInfo().m_numIterations = static_cast<int>(mSettings.solverIterations);
+	// pairs are processed and manifolds solved in body order instead of the order they were found in,
+	// so a world restored from a snapshot steps the same as the one it was captured from
+	mDynamicsWorld->getDispatchInfo().m_deterministicOverlappingPairs = true;
+	btSimulationIslandManager*& islandManager = mDynamicsWorld->*IslandManagerAccess::islandManager;
+	islandManager->~btSimulationIslandManager();
+	btAlignedFree(islandManager);
+	islandManager = new (btAlignedAlloc(sizeof(ContactIslandManager), 16)) ContactIslandManager();
 	mDynamicsWorld->setDebugDrawer(&mPhysicsDebugDraw);
 }
 
@@ -63,15 +469,28 @@ void PhysicsWorld::Terminate()
 	SafeDelete(mCollisionConfiguration);
 	SafeDelete(mSolver);
 	SafeDelete(mInterface);
+	if (mSettings.threadCount > 1)
+	{
+		btSetTaskScheduler(btGetSequentialTaskScheduler());
+	}
+	mPendingContactEvents.clear();
 }
 
 void PhysicsWorld::Update(float deltaTime)
 {
-	mDynamicsWorld->stepSimulation(deltaTime, mSettings.simulationSteps, mSettings.fixedTimeStep);
+	const int steps = mDynamicsWorld->stepSimulation(deltaTime, mSettings.simulationSteps, mSettings.fixedTimeStep);
 	for (PhysicsObject* obj : mPhysicsObjects)
 	{
 		obj->SyncWithGraphics();
 	}
+
+	mContactEvents.clear();
+	mContactEvents.insert(mContactEvents.end(), mPendingContactEvents.begin(), mPendingContactEvents.end());
+	mPendingContactEvents.clear();
+	if (steps > 0)
+	{
+		UpdateContacts();
+	}
 }
 void PhysicsWorld::DebugUI()
 {
@@ -112,7 +531,12 @@ void PhysicsWorld::DebugUI()
 
 void PhysicsWorld::UpdateSettings(const Settings& settings)
 {
+	const BroadphaseType broadphase = mSettings.broadphase;
+	const uint32_t threadCount = mSettings.threadCount;
 	mSettings = settings;
+	mSettings.broadphase = broadphase;
+	mSettings.threadCount = threadCount;
+	mDynamicsWorld->getSolverInfo().m_numIterations = static_cast<int>(mSettings.solverIterations);
 	SetGravity(settings.gravity);
 }
 
@@ -134,16 +558,40 @@ void PhysicsWorld::Register(PhysicsObject* physicsObject)
 	if (iter == mPhysicsObjects.end())
 	{
 		mPhysicsObjects.push_back(physicsObject);
+		const int objectId = mNextObjectId++;
 #ifdef USE_SOFT_BODY
 		if (physicsObject->GetSoftBody() != nullptr)
 		{
+			physicsObject->GetSoftBody()->setUserPointer(physicsObject);
+			physicsObject->GetSoftBody()->setUserIndex(objectId);
 			mDynamicsWorld->addSoftBody(physicsObject->GetSoftBody());
 		}
 #endif
 		if (physicsObject->GetRigidBody() != nullptr)
 		{
+			physicsObject->GetRigidBody()->setUserPointer(physicsObject);
+			physicsObject->GetRigidBody()->setUserIndex(objectId);
 			mDynamicsWorld->addRigidBody(physicsObject->GetRigidBody());
 		}
+		if (physicsObject->GetGhostObject() != nullptr)
+		{
+			physicsObject->GetGhostObject()->setUserPointer(physicsObject);
+			physicsObject->GetGhostObject()->setUserIndex(objectId);
+			AddGhostObject(mDynamicsWorld, physicsObject->GetGhostObject());
+		}
+	}
+}
+
+void PhysicsWorld::Register(PhysicsObject* physicsObject, int collisionGroup, int collisionMask)
+{
+	ASSERT(physicsObject->GetRigidBody() != nullptr, "PhysicsWorld: only rigid bodies can be registered with a filter");
+	auto iter = std::find(mPhysicsObjects.begin(), mPhysicsObjects.end(), physicsObject);
+	if (iter == mPhysicsObjects.end())
+	{
+		mPhysicsObjects.push_back(physicsObject);
+		physicsObject->GetRigidBody()->setUserPointer(physicsObject);
+		physicsObject->GetRigidBody()->setUserIndex(mNextObjectId++);
+		mDynamicsWorld->addRigidBody(physicsObject->GetRigidBody(), collisionGroup, collisionMask);
 	}
 }
 
@@ -163,6 +611,465 @@ void PhysicsWorld::Unregister(PhysicsObject* physicsObject)
 		{
 			mDynamicsWorld->removeRigidBody(physicsObject->GetRigidBody());
 		}
+		if (physicsObject->GetGhostObject() != nullptr)
+		{
+			mDynamicsWorld->removeCollisionObject(physicsObject->GetGhostObject());
+		}
 		mPhysicsObjects.erase(iter);
+
+		// its manifolds are gone with it, so the next step can't see its pairs end, report them here instead
+		auto involvesObject = [physicsObject](const ContactPair& pair)
+		{
+			return pair.objectA == physicsObject || pair.objectB == physicsObject;
+		};
+		for (const ContactPair& pair : mActivePairs)
+		{
+			if (involvesObject(pair))
+			{
+				ContactEvent& contactEvent = mPendingContactEvents.emplace_back();
+				contactEvent.objectA = pair.objectA;
+				contactEvent.objectB = pair.objectB;
+				contactEvent.type = pair.isTrigger ? ContactEventType::TriggerExit : ContactEventType::ContactEnd;
+			}
+		}
+		mActivePairs.erase(std::remove_if(mActivePairs.begin(), mActivePairs.end(), involvesObject), mActivePairs.end());
+	}
+}
+
+void PhysicsWorld::SetCollisionFilter(PhysicsObject* physicsObject, int collisionGroup, int collisionMask)
+{
+	btCollisionObject* collisionObject = physicsObject->GetRigidBody();
+	if (collisionObject == nullptr)
+	{
+		collisionObject = physicsObject->GetGhostObject();
+	}
+	ASSERT(collisionObject != nullptr && collisionObject->getBroadphaseHandle() != nullptr, "PhysicsWorld: object must be registered to change its filter");
+	ApplyCollisionFilter(collisionObject, collisionGroup, collisionMask);
+}
+
+void PhysicsWorld::ApplyCollisionFilter(btCollisionObject* collisionObject, int collisionGroup, int collisionMask)
+{
+	btBroadphaseProxy* proxy = collisionObject->getBroadphaseHandle();
+	proxy->m_collisionFilterGroup = collisionGroup;
+	proxy->m_collisionFilterMask = collisionMask;
+
+	// pairs the new filter rejects stay in the cache until the broadphase drops them, the narrowphase skips them from the next step
+	// removing them here would walk every pair in the world for each call
+	// the object may have been moved since the last step, then the allowed pairs are found again at its new bounds
+	mDynamicsWorld->updateSingleAabb(collisionObject);
+	if (collisionMask != 0)
+	{
+		PairFinder pairFinder(mInterface->getOverlappingPairCache(), proxy);
+		mInterface->aabbTest(proxy->m_aabbMin, proxy->m_aabbMax, pairFinder);
+	}
+}
+
+const std::vector<ContactEvent>& PhysicsWorld::GetContactEvents() const
+{
+	return mContactEvents;
+}
+
+const std::vector<ContactEvent>& PhysicsWorld::GetPendingContactEvents() const
+{
+	return mPendingContactEvents;
+}
+
+void PhysicsWorld::RayCast(const RayQuery* queries, QueryHit* results, std::size_t count) const
+{
+	const btCollisionObjectArray& objects = mDynamicsWorld->getCollisionObjectArray();
+	Core::JobSystem::Get()->ParallelFor(count, QueryBatchSize, [&](std::size_t begin, std::size_t end)
+	{
+		btNodeStack& stack = GetQueryStack();
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const RayQuery& query = queries[i];
+			const btVector3 from = ToBtVector3(query.from);
+			const btVector3 to = ToBtVector3(query.to);
+			const btTransform fromTransform(btQuaternion::getIdentity(), from);
+			const btTransform toTransform(btQuaternion::getIdentity(), to);
+
+			btCollisionWorld::ClosestRayResultCallback callback(from, to);
+			callback.m_collisionFilterGroup = query.collisionGroup;
+			callback.m_collisionFilterMask = query.collisionMask;
+			VisitRay(mInterface, objects, stack, from, to, btVector3(0.0f, 0.0f, 0.0f), btVector3(0.0f, 0.0f, 0.0f),
+				[&](btBroadphaseProxy* proxy)
+				{
+					btCollisionObject* collisionObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+					// soft bodies need the soft world ray test, they are skipped by the batched queries
+					if (btRigidBody::upcast(collisionObject) == nullptr || !PassesFilter(proxy, query.collisionGroup, query.collisionMask))
+					{
+						return;
+					}
+					btCollisionWorld::rayTestSingle(fromTransform, toTransform, collisionObject,
+						collisionObject->getCollisionShape(), collisionObject->getWorldTransform(), callback);
+				});
+
+			QueryHit& result = results[i];
+			result = QueryHit();
+			if (callback.hasHit())
+			{
+				result.object = GetPhysicsObject(callback.m_collisionObject);
+				result.position = ToVector3(callback.m_hitPointWorld);
+				result.normal = ToVector3(callback.m_hitNormalWorld);
+				result.fraction = static_cast<float>(callback.m_closestHitFraction);
+			}
+		}
+	});
+}
+
+void PhysicsWorld::SphereSweep(const SphereSweepQuery* queries, QueryHit* results, std::size_t count) const
+{
+	const btCollisionObjectArray& objects = mDynamicsWorld->getCollisionObjectArray();
+	Core::JobSystem::Get()->ParallelFor(count, QueryBatchSize, [&](std::size_t begin, std::size_t end)
+	{
+		btNodeStack& stack = GetQueryStack();
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const SphereSweepQuery& query = queries[i];
+			const btVector3 from = ToBtVector3(query.from);
+			const btVector3 to = ToBtVector3(query.to);
+			const btTransform fromTransform(btQuaternion::getIdentity(), from);
+			const btTransform toTransform(btQuaternion::getIdentity(), to);
+			const btVector3 extents(query.radius, query.radius, query.radius);
+			btSphereShape sphere(query.radius);
+
+			btCollisionWorld::ClosestConvexResultCallback callback(from, to);
+			callback.m_collisionFilterGroup = query.collisionGroup;
+			callback.m_collisionFilterMask = query.collisionMask;
+			VisitRay(mInterface, objects, stack, from, to, -extents, extents,
+				[&](btBroadphaseProxy* proxy)
+				{
+					btCollisionObject* collisionObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+					if (btRigidBody::upcast(collisionObject) == nullptr || !PassesFilter(proxy, query.collisionGroup, query.collisionMask))
+					{
+						return;
+					}
+					btCollisionWorld::objectQuerySingle(&sphere, fromTransform, toTransform, collisionObject,
+						collisionObject->getCollisionShape(), collisionObject->getWorldTransform(), callback, 0.0f);
+				});
+
+			QueryHit& result = results[i];
+			result = QueryHit();
+			if (callback.hasHit())
+			{
+				result.object = GetPhysicsObject(callback.m_hitCollisionObject);
+				result.position = ToVector3(callback.m_hitPointWorld);
+				result.normal = ToVector3(callback.m_hitNormalWorld);
+				result.fraction = static_cast<float>(callback.m_closestHitFraction);
+			}
+		}
+	});
+}
+
+void PhysicsWorld::Overlap(const OverlapQuery* queries, OverlapResult* results, std::size_t count, PhysicsObject** hits, uint32_t maxHitsPerQuery) const
+{
+	const btCollisionObjectArray& objects = mDynamicsWorld->getCollisionObjectArray();
+	Core::JobSystem::Get()->ParallelFor(count, QueryBatchSize, [&](std::size_t begin, std::size_t end)
+	{
+		btNodeStack& stack = GetQueryStack();
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			const OverlapQuery& query = queries[i];
+			OverlapResult& result = results[i];
+			result.firstHit = i * maxHitsPerQuery;
+			result.hitCount = 0;
+			PhysicsObject** queryHits = hits + result.firstHit;
+			VisitAabb(mInterface, objects, stack, ToBtVector3(query.min), ToBtVector3(query.max),
+				[&](btBroadphaseProxy* proxy)
+				{
+					if (result.hitCount >= maxHitsPerQuery || !PassesFilter(proxy, query.collisionGroup, query.collisionMask))
+					{
+						return;
+					}
+					const btCollisionObject* collisionObject = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+					queryHits[result.hitCount++] = GetPhysicsObject(collisionObject);
+				});
+		}
+	});
+}
+
+void PhysicsWorld::CaptureSnapshot(PhysicsSnapshot& snapshot, uint32_t frame) const
+{
+	std::vector<uint32_t>& state = snapshot.mState;
+	state.clear();
+	state.push_back(0);
+	WriteScalar(state, mDynamicsWorld->*LocalTimeAccess::localTime);
+
+	uint32_t bodyCount = 0;
+	for (PhysicsObject* physicsObject : mPhysicsObjects)
+	{
+		const btRigidBody* rigidBody = physicsObject->GetRigidBody();
+		if (!IsSnapshotBody(rigidBody))
+		{
+			continue;
+		}
+		WriteTransform(state, rigidBody->getWorldTransform());
+		WriteTransform(state, rigidBody->getInterpolationWorldTransform());
+		WriteVector3(state, rigidBody->getLinearVelocity());
+		WriteVector3(state, rigidBody->getAngularVelocity());
+		WriteVector3(state, rigidBody->getInterpolationLinearVelocity());
+		WriteVector3(state, rigidBody->getInterpolationAngularVelocity());
+		WriteScalar(state, rigidBody->getDeactivationTime());
+		state.push_back(static_cast<uint32_t>(rigidBody->getActivationState()));
+		WriteScalar(state, rigidBody->getHitFraction());
+		const btBroadphaseProxy* proxy = rigidBody->getBroadphaseHandle();
+		state.push_back(static_cast<uint32_t>(proxy->m_collisionFilterGroup));
+		state.push_back(static_cast<uint32_t>(proxy->m_collisionFilterMask));
+		++bodyCount;
+	}
+	state[0] = bodyCount;
+
+	// the bodies go first so their words line up from one snapshot to the next, the number of contacts changes
+	GatherManifolds();
+	const std::size_t manifoldCountIndex = state.size();
+	state.push_back(0);
+	uint32_t manifoldCount = 0;
+	for (const btPersistentManifold* manifold : mSnapshotManifolds)
+	{
+		if (manifold->getNumContacts() == 0)
+		{
+			continue;
+		}
+		const std::pair<int, int> bodies = GetManifoldBodies(manifold);
+		state.push_back(static_cast<uint32_t>(bodies.first));
+		state.push_back(static_cast<uint32_t>(bodies.second));
+		state.push_back(static_cast<uint32_t>(manifold->getNumContacts()));
+		for (int p = 0; p < manifold->getNumContacts(); ++p)
+		{
+			WriteContactPoint(state, manifold->getContactPoint(p));
+		}
+		++manifoldCount;
+	}
+	state[manifoldCountIndex] = manifoldCount;
+	snapshot.mFrame = frame;
+}
+
+void PhysicsWorld::RestoreSnapshot(const PhysicsSnapshot& snapshot)
+{
+	const std::vector<uint32_t>& state = snapshot.mState;
+	ASSERT(state.size() >= SnapshotHeaderWords, "PhysicsWorld: snapshot is empty");
+	const uint32_t* read = state.data();
+	const uint32_t bodyCount = *read++;
+	mDynamicsWorld->*LocalTimeAccess::localTime = ReadScalar(read);
+
+	uint32_t restoredCount = 0;
+	for (PhysicsObject* physicsObject : mPhysicsObjects)
+	{
+		btRigidBody* rigidBody = physicsObject->GetRigidBody();
+		if (!IsSnapshotBody(rigidBody))
+		{
+			continue;
+		}
+		ASSERT(restoredCount < bodyCount, "PhysicsWorld: snapshot has fewer bodies than the world");
+		const btTransform worldTransform = ReadTransform(read);
+		rigidBody->setWorldTransform(worldTransform);
+		rigidBody->updateInertiaTensor();
+		rigidBody->setInterpolationWorldTransform(ReadTransform(read));
+		rigidBody->setLinearVelocity(ReadVector3(read));
+		rigidBody->setAngularVelocity(ReadVector3(read));
+		rigidBody->setInterpolationLinearVelocity(ReadVector3(read));
+		rigidBody->setInterpolationAngularVelocity(ReadVector3(read));
+		rigidBody->setDeactivationTime(ReadScalar(read));
+		rigidBody->forceActivationState(static_cast<int>(*read++));
+		rigidBody->setHitFraction(ReadScalar(read));
+		const int collisionGroup = static_cast<int>(*read++);
+		const int collisionMask = static_cast<int>(*read++);
+		rigidBody->clearForces();
+		if (rigidBody->getMotionState() != nullptr)
+		{
+			rigidBody->getMotionState()->setWorldTransform(worldTransform);
+		}
+
+		// the proxy stays in the broadphase and only its bounds move, its pairs are looked for again if the filter changed
+		const btBroadphaseProxy* proxy = rigidBody->getBroadphaseHandle();
+		if (proxy->m_collisionFilterGroup != collisionGroup || proxy->m_collisionFilterMask != collisionMask)
+		{
+			ApplyCollisionFilter(rigidBody, collisionGroup, collisionMask);
+		}
+		else
+		{
+			mDynamicsWorld->updateSingleAabb(rigidBody);
+		}
+		++restoredCount;
+	}
+	ASSERT(restoredCount == bodyCount, "PhysicsWorld: snapshot body count does not match the world");
+
+	// pairs that separated after the capture have lost their manifolds, the first pass finds those pairs again
+	// and the second fills in the manifolds the narrowphase made for them
+	const uint32_t manifoldCount = *read++;
+	if (RestoreManifolds(read, manifoldCount, true))
+	{
+		RestoreManifolds(read, manifoldCount, false);
+	}
+	// the pairs that were touching at the capture are active again, the next Update reports what changed from there
+	CollectTouchingPairs(mActivePairs);
+
+	for (PhysicsObject* physicsObject : mPhysicsObjects)
+	{
+		physicsObject->SyncWithGraphics();
+	}
+}
+
+void PhysicsWorld::GatherManifolds() const
+{
+	// the dispatcher keeps manifolds in the order their pairs were found, snapshots list them by body instead
+	// a pair with several manifolds, one per child of a compound, keeps them in dispatcher order
+	btPersistentManifold** manifolds = mDispatcher->getInternalManifoldPointer();
+	mSnapshotManifolds.assign(manifolds, manifolds + mDispatcher->getNumManifolds());
+	std::sort(mSnapshotManifolds.begin(), mSnapshotManifolds.end(), [](const btPersistentManifold* a, const btPersistentManifold* b)
+	{
+		return GetManifoldBodies(a) < GetManifoldBodies(b);
+	});
+}
+
+bool PhysicsWorld::RestoreManifolds(const uint32_t* read, uint32_t manifoldCount, bool addMissingPairs)
+{
+	GatherManifolds();
+	const btCollisionObjectArray& collisionObjects = mDynamicsWorld->getCollisionObjectArray();
+	btOverlappingPairCache* pairCache = mInterface->getOverlappingPairCache();
+	bool addedPairs = false;
+	std::size_t current = 0;
+	for (uint32_t i = 0; i < manifoldCount; ++i)
+	{
+		const int index0 = static_cast<int>(*read++);
+		const int index1 = static_cast<int>(*read++);
+		const int pointCount = static_cast<int>(*read++);
+		ASSERT(index0 < collisionObjects.size() && index1 < collisionObjects.size(), "PhysicsWorld: snapshot has contacts for objects that are not in the world");
+		const std::pair<int, int> bodies(index0, index1);
+
+		// manifolds the snapshot has no contacts for start cold
+		while (current < mSnapshotManifolds.size() && GetManifoldBodies(mSnapshotManifolds[current]) < bodies)
+		{
+			mSnapshotManifolds[current++]->clearManifold();
+		}
+		if (current < mSnapshotManifolds.size() && GetManifoldBodies(mSnapshotManifolds[current]) == bodies)
+		{
+			btPersistentManifold* manifold = mSnapshotManifolds[current++];
+			manifold->clearManifold();
+			manifold->setNumContacts(pointCount);
+			for (int p = 0; p < pointCount; ++p)
+			{
+				ReadContactPoint(read, manifold->getContactPoint(p));
+			}
+			continue;
+		}
+		read += pointCount * ContactPointWords;
+		if (!addMissingPairs)
+		{
+			continue;
+		}
+
+		// the narrowphase makes the manifold for the pair, unless the filter keeps the two apart now
+		btBroadphaseProxy* proxy0 = collisionObjects[index0]->getBroadphaseHandle();
+		btBroadphaseProxy* proxy1 = collisionObjects[index1]->getBroadphaseHandle();
+		btBroadphasePair* pair = pairCache->findPair(proxy0, proxy1);
+		if (pair == nullptr)
+		{
+			pair = pairCache->addOverlappingPair(proxy0, proxy1);
+		}
+		if (pair != nullptr)
+		{
+			mDispatcher->getNearCallback()(*pair, *mDispatcher, mDynamicsWorld->getDispatchInfo());
+			addedPairs = true;
+		}
+	}
+	while (current < mSnapshotManifolds.size())
+	{
+		mSnapshotManifolds[current++]->clearManifold();
+	}
+	return addedPairs;
+}
+
+void PhysicsWorld::CollectTouchingPairs(std::vector<ContactPair>& pairs) const
+{
+	// a manifold with a point at or inside the surface means the pair is touching this step
+	pairs.clear();
+	const int manifoldCount = mDispatcher->getNumManifolds();
+	for (int i = 0; i < manifoldCount; ++i)
+	{
+		const btPersistentManifold* manifold = mDispatcher->getManifoldByIndexInternal(i);
+		bool touching = false;
+		for (int p = 0; p < manifold->getNumContacts() && !touching; ++p)
+		{
+			touching = manifold->getContactPoint(p).getDistance() <= 0.0f;
+		}
+		if (!touching)
+		{
+			continue;
+		}
+
+		const btCollisionObject* body0 = manifold->getBody0();
+		const btCollisionObject* body1 = manifold->getBody1();
+		PhysicsObject* object0 = GetPhysicsObject(body0);
+		PhysicsObject* object1 = GetPhysicsObject(body1);
+		if (object0 == nullptr || object1 == nullptr)
+		{
+			continue;
+		}
+
+		ContactPair& pair = pairs.emplace_back();
+		pair.isTrigger = btGhostObject::upcast(body0) != nullptr || btGhostObject::upcast(body1) != nullptr;
+		// keep the trigger second so events can always report it as objectB
+		const bool swap = pair.isTrigger ? btGhostObject::upcast(body0) != nullptr : body1->getUserIndex() < body0->getUserIndex();
+		pair.objectA = swap ? object1 : object0;
+		pair.objectB = swap ? object0 : object1;
+		pair.idA = swap ? body1->getUserIndex() : body0->getUserIndex();
+		pair.idB = swap ? body0->getUserIndex() : body1->getUserIndex();
+	}
+
+	auto lessPair = [](const ContactPair& a, const ContactPair& b)
+	{
+		return ComparePairs(a.idA, a.idB, b.idA, b.idB);
+	};
+	auto samePair = [](const ContactPair& a, const ContactPair& b)
+	{
+		return a.idA == b.idA && a.idB == b.idB;
+	};
+	std::sort(pairs.begin(), pairs.end(), lessPair);
+	pairs.erase(std::unique(pairs.begin(), pairs.end(), samePair), pairs.end());
+}
+
+void PhysicsWorld::UpdateContacts()
+{
+	CollectTouchingPairs(mCurrentPairs);
+
+	auto lessPair = [](const ContactPair& a, const ContactPair& b)
+	{
+		return ComparePairs(a.idA, a.idB, b.idA, b.idB);
+	};
+
+	// both lists are sorted, anything only in the current list began and anything only in the active list ended
+	auto addEvent = [this](const ContactPair& pair, bool began)
+	{
+		ContactEvent& contactEvent = mContactEvents.emplace_back();
+		contactEvent.objectA = pair.objectA;
+		contactEvent.objectB = pair.objectB;
+		if (pair.isTrigger)
+		{
+			contactEvent.type = began ? ContactEventType::TriggerEnter : ContactEventType::TriggerExit;
+		}
+		else
+		{
+			contactEvent.type = began ? ContactEventType::ContactBegin : ContactEventType::ContactEnd;
+		}
+	};
+	std::size_t active = 0;
+	std::size_t current = 0;
+	while (active < mActivePairs.size() || current < mCurrentPairs.size())
+	{
+		if (current == mCurrentPairs.size() || (active < mActivePairs.size() && lessPair(mActivePairs[active], mCurrentPairs[current])))
+		{
+			addEvent(mActivePairs[active++], false);
+		}
+		else if (active == mActivePairs.size() || lessPair(mCurrentPairs[current], mActivePairs[active]))
+		{
+			addEvent(mCurrentPairs[current++], true);
+		}
+		else
+		{
+			++active;
+			++current;
+		}
 	}
+	std::swap(mActivePairs, mCurrentPairs);
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ void RigidBody::Initialize(Graphics::Transform& graphicsTransform, const Collisi
 	mMass = mass;
 
 	// NOTE: may need to set to 0 if using a player and not wanting it to tip over 
-	btVector3 localInertia = btVector3();
+	btVector3 localInertia(0.0f, 0.0f, 0.0f);
 	//shape.mCollisionShape->calculateLocalInertia(mass, localInertia);
 	mMotionState = new btDefaultMotionState(ConvertToBtTransform(graphicsTransform));
 	mRigidBody = new btRigidBody(mMass, mMotionState, shape.mCollisionShape, localInertia);
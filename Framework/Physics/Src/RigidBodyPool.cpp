@@ -0,0 +1,207 @@
+#include "Precompiled.h"
+#include "RigidBodyPool.h"
+#include "CollisionShape.h"
+#include "PhysicsWorld.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Physics;
+
+RigidBodyPool::~RigidBodyPool()
+{
+	ASSERT(mSlots.empty(), "RigidBodyPool: terminate must be called!");
+}
+
+void RigidBodyPool::Initialize(const CollisionShape& shape, float mass, uint32_t capacity)
+{
+	ASSERT(mSlots.empty(), "RigidBodyPool: is already initialized");
+	ASSERT(capacity > 0, "RigidBodyPool: capacity must be greater than 0");
+
+	btCollisionShape* collisionShape = shape.mCollisionShape;
+	btVector3 localInertia(0.0f, 0.0f, 0.0f);
+	if (mass > 0.0f)
+	{
+		collisionShape->calculateLocalInertia(mass, localInertia);
+	}
+
+	mBodyAllocator = std::make_unique<Core::TypedAllocator<btRigidBody>>("RigidBodyPool", capacity);
+	mMotionStateAllocator = std::make_unique<Core::TypedAllocator<btDefaultMotionState>>("RigidBodyPoolMotionStates", capacity);
+	// parked bodies start on a grid a shape apart, stacked on one spot the broadphase tree would become a list
+	btVector3 center;
+	btScalar radius = 0.0f;
+	collisionShape->getBoundingSphere(center, radius);
+	const float spacing = (radius + collisionShape->getMargin()) * 2.0f + 0.1f;
+	const uint32_t rowSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(capacity))));
+	const float offset = (rowSize - 1) * spacing * 0.5f;
+
+	mSlots.resize(capacity);
+	mFreeSlots.reserve(capacity);
+	for (uint32_t i = 0; i < capacity; ++i)
+	{
+		Slot& slot = mSlots[i];
+		const btTransform transform(btQuaternion::getIdentity(), btVector3(((i % rowSize) * spacing) - offset, 0.0f, ((i / rowSize) * spacing) - offset));
+		slot.motionState = mMotionStateAllocator->New(transform);
+		slot.body = mBodyAllocator->New(btRigidBody::btRigidBodyConstructionInfo(mass, slot.motionState, collisionShape, localInertia));
+		// every body goes into the world once, parked, spawning only changes its filter and activation
+		slot.body->forceActivationState(DISABLE_SIMULATION);
+		PhysicsWorld::Get()->Register(&slot, ParkedFilter, ParkedFilter);
+	}
+	// handed out from the back, so the lowest slots are used first
+	for (uint32_t i = capacity; i > 0; --i)
+	{
+		mFreeSlots.push_back(static_cast<int>(i - 1));
+	}
+	mActiveCount = 0;
+}
+
+void RigidBodyPool::Terminate()
+{
+	DespawnAll();
+	for (Slot& slot : mSlots)
+	{
+		PhysicsWorld::Get()->Unregister(&slot);
+		mBodyAllocator->Delete(slot.body);
+		mMotionStateAllocator->Delete(slot.motionState);
+	}
+	mSlots.clear();
+	mFreeSlots.clear();
+	mBodyAllocator.reset();
+	mMotionStateAllocator.reset();
+}
+
+RigidBodyHandle RigidBodyPool::Spawn(const Math::Vector3& position, const Math::Vector3& velocity)
+{
+	RigidBodyHandle handle;
+	if (mFreeSlots.empty())
+	{
+		return handle;
+	}
+
+	const int index = mFreeSlots.back();
+	mFreeSlots.pop_back();
+	Slot& slot = mSlots[index];
+	slot.active = true;
+	++mActiveCount;
+
+	const btTransform transform(btQuaternion::getIdentity(), ToBtVector3(position));
+	slot.motionState->setWorldTransform(transform);
+	slot.body->setWorldTransform(transform);
+	slot.body->setInterpolationWorldTransform(transform);
+	slot.body->setLinearVelocity(ToBtVector3(velocity));
+	slot.body->setInterpolationLinearVelocity(ToBtVector3(velocity));
+	slot.body->forceActivationState(ACTIVE_TAG);
+	slot.body->setDeactivationTime(0.0f);
+	PhysicsWorld::Get()->SetCollisionFilter(&slot, btBroadphaseProxy::DefaultFilter, btBroadphaseProxy::AllFilter);
+
+	handle.mIndex = index;
+	handle.mGeneration = slot.generation;
+	return handle;
+}
+
+void RigidBodyPool::Despawn(const RigidBodyHandle& handle)
+{
+	Slot* slot = GetSlot(handle);
+	if (slot == nullptr)
+	{
+		return;
+	}
+
+	// stays in the broadphase where it is, but collides with nothing and is not simulated until it is spawned again
+	PhysicsWorld::Get()->SetCollisionFilter(slot, ParkedFilter, ParkedFilter);
+	slot->body->forceActivationState(DISABLE_SIMULATION);
+	slot->body->setLinearVelocity(btVector3(0.0f, 0.0f, 0.0f));
+	slot->body->setAngularVelocity(btVector3(0.0f, 0.0f, 0.0f));
+	slot->body->setInterpolationLinearVelocity(btVector3(0.0f, 0.0f, 0.0f));
+	slot->body->setInterpolationAngularVelocity(btVector3(0.0f, 0.0f, 0.0f));
+	slot->body->clearForces();
+	slot->body->setDeactivationTime(0.0f);
+	slot->body->setHitFraction(1.0f);
+	slot->active = false;
+	++slot->generation;
+	--mActiveCount;
+	mFreeSlots.push_back(handle.mIndex);
+}
+
+void RigidBodyPool::DespawnAll()
+{
+	for (std::size_t i = 0; i < mSlots.size(); ++i)
+	{
+		if (mSlots[i].active)
+		{
+			RigidBodyHandle handle;
+			handle.mIndex = static_cast<int>(i);
+			handle.mGeneration = mSlots[i].generation;
+			Despawn(handle);
+		}
+	}
+}
+
+bool RigidBodyPool::IsValid(const RigidBodyHandle& handle) const
+{
+	return GetSlot(handle) != nullptr;
+}
+
+void RigidBodyPool::SetVelocity(const RigidBodyHandle& handle, const Math::Vector3& velocity)
+{
+	Slot* slot = GetSlot(handle);
+	ASSERT(slot != nullptr, "RigidBodyPool: invalid handle");
+	slot->body->activate();
+	slot->body->setLinearVelocity(ToBtVector3(velocity));
+}
+
+Math::Vector3 RigidBodyPool::GetVelocity(const RigidBodyHandle& handle) const
+{
+	const Slot* slot = GetSlot(handle);
+	ASSERT(slot != nullptr, "RigidBodyPool: invalid handle");
+	return ToVector3(slot->body->getLinearVelocity());
+}
+
+Graphics::Transform RigidBodyPool::GetTransform(const RigidBodyHandle& handle) const
+{
+	const Slot* slot = GetSlot(handle);
+	ASSERT(slot != nullptr, "RigidBodyPool: invalid handle");
+	const btTransform& worldTransform = slot->body->getWorldTransform();
+	Graphics::Transform transform;
+	transform.position = ToVector3(worldTransform.getOrigin());
+	transform.rotation = ToQuaternion(worldTransform.getRotation());
+	return transform;
+}
+
+RigidBodyHandle RigidBodyPool::GetHandle(const PhysicsObject* physicsObject) const
+{
+	RigidBodyHandle handle;
+	if (!mSlots.empty() && physicsObject >= mSlots.data() && physicsObject < mSlots.data() + mSlots.size())
+	{
+		const Slot* slot = static_cast<const Slot*>(physicsObject);
+		if (slot->active)
+		{
+			handle.mIndex = static_cast<int>(slot - mSlots.data());
+			handle.mGeneration = slot->generation;
+		}
+	}
+	return handle;
+}
+
+uint32_t RigidBodyPool::GetActiveCount() const
+{
+	return mActiveCount;
+}
+
+uint32_t RigidBodyPool::GetCapacity() const
+{
+	return static_cast<uint32_t>(mSlots.size());
+}
+
+RigidBodyPool::Slot* RigidBodyPool::GetSlot(const RigidBodyHandle& handle)
+{
+	return const_cast<Slot*>(static_cast<const RigidBodyPool*>(this)->GetSlot(handle));
+}
+
+const RigidBodyPool::Slot* RigidBodyPool::GetSlot(const RigidBodyHandle& handle) const
+{
+	if (handle.mIndex < 0 || handle.mIndex >= static_cast<int>(mSlots.size()))
+	{
+		return nullptr;
+	}
+	const Slot& slot = mSlots[handle.mIndex];
+	return (slot.active && slot.generation == handle.mGeneration) ? &slot : nullptr;
+}
\ No newline at end of file
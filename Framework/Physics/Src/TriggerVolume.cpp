@@ -0,0 +1,41 @@
+#include "Precompiled.h"
+#include "TriggerVolume.h"
+#include "CollisionShape.h"
+#include "PhysicsWorld.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Physics;
+
+TriggerVolume::~TriggerVolume()
+{
+	ASSERT(mGhostObject == nullptr, "TriggerVolume: terminate must be called!");
+}
+
+void TriggerVolume::Initialize(Graphics::Transform& graphicsTransform, const CollisionShape& shape, bool addToWorld)
+{
+	mGraphicsTransform = &graphicsTransform;
+	mGhostObject = new btGhostObject();
+	mGhostObject->setCollisionShape(shape.mCollisionShape);
+	mGhostObject->setWorldTransform(ConvertToBtTransform(graphicsTransform));
+	mGhostObject->setCollisionFlags(mGhostObject->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+	if (addToWorld)
+	{
+		PhysicsWorld::Get()->Register(this);
+	}
+}
+
+void TriggerVolume::Terminate()
+{
+	PhysicsWorld::Get()->Unregister(this);
+	SafeDelete(mGhostObject);
+}
+
+void TriggerVolume::SyncWithGraphics()
+{
+	mGhostObject->setWorldTransform(ConvertToBtTransform(*mGraphicsTransform));
+}
+
+btGhostObject* TriggerVolume::GetGhostObject()
+{
+	return mGhostObject;
+}
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "Benchmarks.h"
+
+void PrintCheck(const char* name, bool passed, bool& allPassed)
+{
+    printf("  %-44s %s\n", name, passed ? "ok" : "FAILED");
+    allPassed = allPassed && passed;
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <SabadEngine/Inc/SabadEngine.h>
+
+struct BenchmarkArguments
+{
+    uint32_t count = 0;     // objects per benchmark, 0 uses the benchmark's own default
+    int frames = 100;       // timed frames or repeats
+};
+
+// components registered with REGISTER_COMPONENT all live in this executable, so each needs its own id
+enum class RegisteredComponentId
+{
+    Spin = static_cast<int>(SabadEngine::ComponentId::Count),
+    Tag,
+    ModuleAHealth,
+    ModuleBInventory,
+    ModuleCPatrol,
+    Marker,
+    Pulse,
+    Health,
+    GridModel,
+    Sway,
+    Drift
+};
+
+using BenchmarkClock = std::chrono::high_resolution_clock;
+
+inline double GetElapsedMs(const BenchmarkClock::time_point& start)
+{
+    return std::chrono::duration<double, std::milli>(BenchmarkClock::now() - start).count();
+}
+
+// prints one named check and folds it into allPassed
+void PrintCheck(const char* name, bool passed, bool& allPassed);
+
+// each benchmark builds its own GameWorld and prints a small table, it returns false if any of its checks failed
+bool RunEcsBenchmark(const BenchmarkArguments& args);
+bool RunLookupBenchmark(const BenchmarkArguments& args);
+bool RunSchedulerBenchmark(const BenchmarkArguments& args);
+bool RunHierarchyBenchmark(const BenchmarkArguments& args);
+bool RunTemplateBenchmark(const BenchmarkArguments& args);
+bool RunLevelBenchmark(const BenchmarkArguments& args);
+bool RunRegistryBenchmark(const BenchmarkArguments& args);
+bool RunSlotBenchmark(const BenchmarkArguments& args);
+bool RunSpatialBenchmark(const BenchmarkArguments& args);
+bool RunTickBenchmark(const BenchmarkArguments& args);
+bool RunIdleBenchmark(const BenchmarkArguments& args);
+bool RunSnapshotBenchmark(const BenchmarkArguments& args);
+bool RunSpawnBenchmark(const BenchmarkArguments& args);
+bool RunProfilerBenchmark(const BenchmarkArguments& args);
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    enum class BenchmarkComponentId
+    {
+        Mover = static_cast<int>(ComponentId::Count)
+    };
+
+    // the game object version of the work, one virtual Update per object
+    class MoverComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Mover);
+
+        void Initialize() override
+        {
+            mTransform = GetOwner().GetComponent<TransformComponent>();
+        }
+
+        void Update(float deltaTime) override
+        {
+            mTransform->position += velocity * deltaTime;
+        }
+
+        Math::Vector3 velocity;
+
+    private:
+        TransformComponent* mTransform = nullptr;
+    };
+
+    struct Velocity
+    {
+        Math::Vector3 value;
+    };
+
+    Math::Vector3 GetVelocity(uint32_t index)
+    {
+        return { static_cast<float>(index % 7), 1.0f, static_cast<float>(index % 3) };
+    }
+
+    // crates from rigid body components reached through ComponentMirror, a system launches them with ForEach
+    void RunMirrorChecks(float deltaTime, bool& allPassed)
+    {
+        Physics::PhysicsWorld::Settings physicsSettings;
+        Physics::PhysicsWorld::StaticInitialize(physicsSettings);
+        Physics::CollisionShapeCache::StaticInitialize();
+
+        rapidjson::Document document;
+        document.Parse(R"({
+            "Crate": { "Mass": 2.0, "ColliderData": { "Shape": "Box", "HalfExtents": [ 0.5, 0.5, 0.5 ] } },
+            "Ground": { "Mass": 0.0, "ColliderData": { "Shape": "Box", "HalfExtents": [ 50.0, 0.5, 50.0 ] } }
+        })");
+
+        const uint32_t crateCount = 100;
+        GameWorld world;
+        world.AddService<PhysicsService>();
+        world.Initialize(crateCount + 2);
+        GameObject* ground = world.CreateGameObject("Ground");
+        ground->AddComponent<TransformComponent>();
+        ground->AddComponent<RigidBodyComponent>()->Deserialize(document["Ground"]);
+        ground->Initialize();
+        ComponentMirror::Mirror(world, *ground);
+        std::vector<GameObject*> crates;
+        for (uint32_t i = 0; i < crateCount; ++i)
+        {
+            GameObject* crate = world.CreateGameObject("Crate" + std::to_string(i));
+            crate->AddComponent<TransformComponent>()->position = { (i % 10) * 1.5f, 0.5f, (i / 10) * 1.5f };
+            crate->AddComponent<RigidBodyComponent>()->Deserialize(document["Crate"]);
+            crate->Initialize();
+            ComponentMirror::Mirror(world, *crate);
+            crates.push_back(crate);
+        }
+        // an object with only a transform is mirrored without rigid body data
+        GameObject* marker = world.CreateGameObject("Marker");
+        marker->AddComponent<TransformComponent>();
+        marker->Initialize();
+        ComponentMirror::Mirror(world, *marker);
+        world.Update(deltaTime);
+
+        uint32_t bodyCount = 0;
+        uint32_t dynamicCount = 0;
+        ComponentMirror::Pull(world);
+        world.ForEach<Graphics::Transform, RigidBodyData>([&](Graphics::Transform& transform, RigidBodyData& rigidBody)
+        {
+            ++bodyCount;
+            if (rigidBody.mass > 0.0f)
+            {
+                ++dynamicCount;
+                rigidBody.velocity.y = 5.0f;
+                transform.position.y += 1.0f;
+            }
+        });
+        uint32_t transformCount = 0;
+        world.ForEach<Graphics::Transform>([&transformCount](const Graphics::Transform&) { ++transformCount; });
+        PrintCheck("every rigid body reaches ForEach", bodyCount == crateCount + 1 && dynamicCount == crateCount, allPassed);
+        PrintCheck("every mirrored object reaches ForEach", transformCount == crateCount + 2, allPassed);
+
+        // the old heights were pulled after the update, the pushed ones are a unit above them
+        std::vector<float> heights;
+        world.ForEach<MirroredComponents, Graphics::Transform>([&heights](const MirroredComponents& components, const Graphics::Transform& transform)
+        {
+            heights.push_back(transform.position.y - components.transform->position.y);
+        });
+        ComponentMirror::Push(world);
+        bool pushed = true;
+        for (GameObject* crate : crates)
+        {
+            pushed = pushed && crate->GetComponent<RigidBodyComponent>()->GetVelocity().y == 5.0f;
+        }
+        PrintCheck("pushed velocities reach the bodies", pushed, allPassed);
+        PrintCheck("pull and push copy the transforms", std::count(heights.begin(), heights.end(), 1.0f) == crateCount
+            && std::count(heights.begin(), heights.end(), 0.0f) == 2, allPassed);
+
+        world.Update(deltaTime);
+        ComponentMirror::Pull(world);
+        bool rising = true;
+        world.ForEach<MirroredComponents, Graphics::Transform>([&rising](const MirroredComponents& components, const Graphics::Transform& transform)
+        {
+            rising = rising && (components.rigidBody == nullptr || !components.rigidBody->IsDynamic() || transform.position.y > 1.5f);
+        });
+        PrintCheck("the bodies move from their pushed state", rising, allPassed);
+
+        world.DestroyGameObject(crates.back()->GetHandle());
+        world.Update(deltaTime);
+        bodyCount = 0;
+        world.ForEach<RigidBodyData>([&bodyCount](const RigidBodyData&) { ++bodyCount; });
+        PrintCheck("destroyed objects leave the mirror", bodyCount == crateCount, allPassed);
+
+        world.Terminate();
+        Physics::CollisionShapeCache::StaticTerminate();
+        Physics::PhysicsWorld::StaticTerminate();
+    }
+}
+
+bool RunEcsBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 100000;
+    const float deltaTime = 1.0f / 60.0f;
+
+    double gameObjectMs = 0.0;
+    {
+        GameWorld world;
+        world.Initialize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            GameObject* gameObject = world.CreateGameObject("Mover");
+            gameObject->AddComponent<TransformComponent>();
+            gameObject->AddComponent<MoverComponent>()->velocity = GetVelocity(i);
+            gameObject->Initialize();
+        }
+
+        world.Update(deltaTime);
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int i = 0; i < args.frames; ++i)
+        {
+            world.Update(deltaTime);
+        }
+        gameObjectMs = GetElapsedMs(start) / args.frames;
+        world.Terminate();
+    }
+
+    double entityMs = 0.0;
+    float entityCheck = 0.0f;
+    {
+        GameWorld world;
+        world.Initialize(1);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            world.CreateEntity(Graphics::Transform(), Velocity{ GetVelocity(i) });
+        }
+
+        auto move = [deltaTime](Graphics::Transform& transform, const Velocity& velocity)
+        {
+            transform.position += velocity.value * deltaTime;
+        };
+        world.ForEach<Graphics::Transform, Velocity>(move);
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int i = 0; i < args.frames; ++i)
+        {
+            world.ForEach<Graphics::Transform, Velocity>(move);
+        }
+        entityMs = GetElapsedMs(start) / args.frames;
+
+        world.ForEach<Graphics::Transform>([&entityCheck](const Graphics::Transform& transform)
+        {
+            entityCheck += transform.position.y;
+        });
+        world.Terminate();
+    }
+
+    // the same objects built from components, mirrored and copied in and out around the ForEach every frame
+    double mirrorMs = 0.0;
+    {
+        GameWorld world;
+        world.Initialize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            GameObject* gameObject = world.CreateGameObject("Mover");
+            gameObject->AddComponent<TransformComponent>();
+            gameObject->Initialize();
+            ComponentMirror::Mirror(world, *gameObject);
+        }
+
+        auto move = [deltaTime](Graphics::Transform& transform)
+        {
+            transform.position.y += deltaTime;
+        };
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int i = 0; i < args.frames; ++i)
+        {
+            ComponentMirror::Pull(world);
+            world.ForEach<Graphics::Transform>(move);
+            ComponentMirror::Push(world);
+        }
+        mirrorMs = GetElapsedMs(start) / args.frames;
+        world.Terminate();
+    }
+
+    printf("ecs: %u objects moved by velocity, %d frames\n", count, args.frames);
+    printf("%-28s %12s\n", "storage", "ms/frame");
+    printf("%-28s %12.3f\n", "GameObject components", gameObjectMs);
+    printf("%-28s %12.3f\n", "archetype entities", entityMs);
+    printf("%-28s %12.3f\n", "mirrored components", mirrorMs);
+    printf("speedup %.1fx, check %.1f\n", gameObjectMs / entityMs, entityCheck);
+
+    bool allPassed = true;
+    RunMirrorChecks(deltaTime, allPassed);
+    printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+    return allPassed;
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // a root with three children with three children each
+    constexpr uint32_t TreeFanOut = 3;
+    constexpr uint32_t TreeSize = 1 + TreeFanOut + (TreeFanOut * TreeFanOut);
+
+    GameObject* CreateNode(GameWorld& world, GameObject* parent, const Math::Vector3& position)
+    {
+        GameObject* gameObject = world.CreateGameObject("Node");
+        TransformComponent* transform = gameObject->AddComponent<TransformComponent>();
+        transform->position = position;
+        transform->rotation = Math::Quaternion::CreateFromAxisAngle(Math::Vector3::YAxis, 0.3f);
+        // only the parent link, AddChild would have the world and the parent both terminate the child
+        gameObject->SetParent(parent);
+        gameObject->Initialize();
+        return gameObject;
+    }
+
+    // what every consumer had to do before the hierarchy, walk up and multiply the local matrices
+    Math::Matrix4 WalkWorldMatrix(const GameObject& gameObject)
+    {
+        Math::Matrix4 world = gameObject.GetComponent<TransformComponent>()->GetMatrix4();
+        for (const GameObject* parent = gameObject.GetParent(); parent != nullptr; parent = parent->GetParent())
+        {
+            world = world * parent->GetComponent<TransformComponent>()->GetMatrix4();
+        }
+        return world;
+    }
+
+    float GetWalkError(const GameObject& gameObject)
+    {
+        const Math::Matrix4 cached = gameObject.GetComponent<TransformComponent>()->GetWorldMatrix();
+        const Math::Matrix4 walked = WalkWorldMatrix(gameObject);
+        float error = 0.0f;
+        for (std::size_t i = 0; i < cached.v.size(); ++i)
+        {
+            error = std::max(error, std::abs(cached.v[i] - walked.v[i]));
+        }
+        return error;
+    }
+}
+
+bool RunHierarchyBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t treeCount = std::max(((args.count > 0) ? args.count : 10000) / TreeSize, 1u);
+    const uint32_t count = treeCount * TreeSize;
+    const float deltaTime = 1.0f / 60.0f;
+
+    GameWorld world;
+    world.Initialize(count);
+    std::vector<GameObject*> nodes;
+    std::vector<TransformComponent*> roots;
+    for (uint32_t t = 0; t < treeCount; ++t)
+    {
+        GameObject* root = CreateNode(world, nullptr, { static_cast<float>(t % 100) * 4.0f, 0.0f, static_cast<float>(t / 100) * 4.0f });
+        nodes.push_back(root);
+        roots.push_back(root->GetComponent<TransformComponent>());
+        for (uint32_t c = 0; c < TreeFanOut; ++c)
+        {
+            GameObject* child = CreateNode(world, root, { 1.0f, 0.5f * c, 0.0f });
+            nodes.push_back(child);
+            for (uint32_t g = 0; g < TreeFanOut; ++g)
+            {
+                nodes.push_back(CreateNode(world, child, { 0.0f, 0.25f, 0.5f * g }));
+            }
+        }
+    }
+    world.Update(deltaTime);
+
+    const TransformHierarchy& hierarchy = world.GetTransformHierarchy();
+    printf("hierarchy: %u objects in %u trees, %u levels, %d frames\n", count, treeCount, hierarchy.GetLevelCount(), args.frames);
+    printf("%-22s %12s %14s\n", "case", "ms/frame", "recomputed");
+
+    // parent chain walk for every object, no caching
+    float walkChecksum = 0.0f;
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+    for (int i = 0; i < args.frames; ++i)
+    {
+        for (const GameObject* node : nodes)
+        {
+            walkChecksum += WalkWorldMatrix(*node)._42;
+        }
+    }
+    printf("%-22s %12.3f %14u\n", "parent walk", GetElapsedMs(start) / args.frames, count);
+
+    // moves every stride-th tree a little each frame and times the world update that refreshes the matrices
+    auto runCase = [&](const char* name, uint32_t stride)
+    {
+        uint32_t recomputed = 0;
+        const BenchmarkClock::time_point caseStart = BenchmarkClock::now();
+        for (int i = 0; i < args.frames; ++i)
+        {
+            for (uint32_t r = 0; stride > 0 && r < treeCount; r += stride)
+            {
+                roots[r]->position.y += 0.01f;
+            }
+            world.Update(deltaTime);
+            recomputed += hierarchy.GetRecomputedCount();
+        }
+        printf("%-22s %12.3f %14u\n", name, GetElapsedMs(caseStart) / args.frames, recomputed / args.frames);
+    };
+    runCase("cached, nothing moves", 0);
+    runCase("cached, 10% move", 10);
+    runCase("cached, all move", 1);
+
+    // the cached matrices have to match a fresh walk
+    float maxError = 0.0f;
+    for (const GameObject* node : nodes)
+    {
+        maxError = std::max(maxError, GetWalkError(*node));
+    }
+    printf("max error vs walk: %g (walk checksum %.1f)\n", maxError, walkChecksum);
+    bool allPassed = true;
+    PrintCheck("cached matrices match a parent walk", maxError < 1e-3f, allPassed);
+
+    // a rendered frame, a root moved and a child made after Update, the way LateUpdate or the app would, are drawn this frame
+    world.Update(deltaTime);
+    roots[0]->position.x += 2.0f;
+    GameObject* newChild = CreateNode(world, nodes[0], { 1.0f, 0.0f, 0.0f });
+    world.Render();
+    PrintCheck("Render sees moves made after Update", GetWalkError(*nodes[1]) < 1e-3f, allPassed);
+    PrintCheck("Render places new children under parents", GetWalkError(*newChild) < 1e-3f, allPassed);
+    world.Terminate();
+    return allPassed;
+}
\ No newline at end of file
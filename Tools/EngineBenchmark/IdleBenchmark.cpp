@@ -0,0 +1,179 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // data only, like a mesh or a model, it never overrides Update or LateUpdate
+    class MarkerComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::Marker);
+
+        void Initialize() override
+        {
+            sOwners.push_back(&GetOwner());
+        }
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            SaveUtil::ReadString("Tag", mTag, value);
+        }
+
+        static std::vector<GameObject*> sOwners;
+
+    private:
+        std::string mTag;
+    };
+
+    std::vector<GameObject*> MarkerComponent::sOwners;
+
+    // the few objects that do something every frame
+    class PulseComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::Pulse);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::None, UpdateThreading::PerObject);
+
+        void Update(float deltaTime) override
+        {
+            mTime += deltaTime;
+            mValue = sinf(mTime * mRate);
+        }
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            SaveUtil::ReadFloat("Rate", mRate, value);
+        }
+
+        float GetValue() const { return mValue; }
+
+    private:
+        float mTime = 0.0f;
+        float mRate = 1.0f;
+        float mValue = 0.0f;
+    };
+
+    REGISTER_COMPONENT(MarkerComponent);
+    REGISTER_COMPONENT(PulseComponent);
+
+    void WriteTemplate(const std::filesystem::path& path, bool pulse)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, path.u8string().c_str(), "w");
+        fprintf(file,
+            "{\n"
+            "    \"Components\": {\n"
+            "        \"TransformComponent\": {\n"
+            "            \"Position\": [ 0.0, 0.0, 0.0 ]\n"
+            "        },\n"
+            "        \"SpatialComponent\": {\n"
+            "            \"Radius\": 1.0\n"
+            "        },\n"
+            "        \"MarkerComponent\": {\n"
+            "            \"Tag\": \"Prop\"\n"
+            "        }%s\n"
+            "    }\n"
+            "}\n", pulse ? ",\n        \"PulseComponent\": {\n            \"Rate\": 2.0\n        }" : "");
+        fclose(file);
+    }
+
+    // every pulseEvery'th object ticks, the rest are scenery
+    void WriteLevel(const std::filesystem::path& path, const std::filesystem::path templatePaths[2], uint32_t count, uint32_t pulseEvery)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, path.u8string().c_str(), "w");
+        fprintf(file, "{\n    \"Capacity\": %u,\n    \"Services\": {\n    },\n    \"GameObjects\": {\n", count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            fprintf(file, "        \"Object%u\": {\n", i);
+            fprintf(file, "            \"Template\": \"%s\",\n", templatePaths[(i % pulseEvery == 0) ? 1 : 0].generic_u8string().c_str());
+            fprintf(file, "            \"Components\": {\n");
+            fprintf(file, "                \"TransformComponent\": { \"Position\": [ %.1f, 0.0, %.1f ] }", (i % 50) * 2.0f, (i / 50) * 2.0f);
+            fprintf(file, "\n            }\n        }%s\n", (i + 1 < count) ? "," : "");
+        }
+        fprintf(file, "    }\n}\n");
+        fclose(file);
+    }
+}
+
+bool RunIdleBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 2000;
+    const uint32_t pulseEvery = 10;
+    const uint32_t pulseCount = (count + pulseEvery - 1) / pulseEvery;
+    const float deltaTime = 1.0f / 60.0f;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sabad_idle_benchmark";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path templatePaths[2] = { directory / "prop.json", directory / "pulse.json" };
+    const std::filesystem::path levelPath = directory / "level.json";
+    WriteTemplate(templatePaths[0], false);
+    WriteTemplate(templatePaths[1], true);
+    WriteLevel(levelPath, templatePaths, count, pulseEvery);
+
+    MarkerComponent::sOwners.clear();
+    GameWorld world;
+    world.LoadLevel(levelPath);
+    world.Update(deltaTime);
+    const uint32_t componentCount = count * 3 + pulseCount;
+    printf("idle: %u objects, %u components, %u with an Update, %d frames\n", count, componentCount, pulseCount, args.frames);
+
+    // what every frame paid before, a virtual Update and LateUpdate on every component whether it had one or not
+    std::vector<Component*> allComponents;
+    allComponents.reserve(componentCount);
+    for (GameObject* gameObject : MarkerComponent::sOwners)
+    {
+        Component* components[] = { gameObject->GetComponent<TransformComponent>(), gameObject->GetComponent<SpatialComponent>(),
+            gameObject->GetComponent<MarkerComponent>(), gameObject->GetComponent<PulseComponent>() };
+        for (Component* component : components)
+        {
+            if (component != nullptr)
+            {
+                allComponents.push_back(component);
+            }
+        }
+    }
+    const BenchmarkClock::time_point everyStart = BenchmarkClock::now();
+    for (int frame = 0; frame < args.frames; ++frame)
+    {
+        for (Component* component : allComponents)
+        {
+            component->Update(deltaTime);
+        }
+        for (Component* component : allComponents)
+        {
+            component->LateUpdate(deltaTime);
+        }
+    }
+    const double everyMs = GetElapsedMs(everyStart) / args.frames;
+
+    // the same objects through the schedule, which only holds the pulses
+    const BenchmarkClock::time_point updateStart = BenchmarkClock::now();
+    for (int frame = 0; frame < args.frames; ++frame)
+    {
+        world.Update(deltaTime);
+    }
+    const double worldMs = GetElapsedMs(updateStart) / args.frames;
+
+    printf("%-36s %12s %12s\n", "case", "ms/frame", "calls/frame");
+    printf("%-36s %12.4f %12u\n", "every component, both phases", everyMs, componentCount * 2);
+    printf("%-36s %12.4f %12u\n", "world update, ticking lists", worldMs,
+        world.GetUpdateWorkCount(UpdatePhase::Update) + world.GetUpdateWorkCount(UpdatePhase::LateUpdate));
+
+    bool allPassed = true;
+    PrintCheck("update list holds only the pulses", world.GetUpdateWorkCount(UpdatePhase::Update) == pulseCount, allPassed);
+    PrintCheck("late update list is empty", world.GetUpdateWorkCount(UpdatePhase::LateUpdate) == 0, allPassed);
+    const GameObject* pulseObject = MarkerComponent::sOwners.front();
+    const GameObject* propObject = MarkerComponent::sOwners[1];
+    PrintCheck("pulse detected as ticking", pulseObject->GetComponent<PulseComponent>()->HasUpdate()
+        && !pulseObject->GetComponent<PulseComponent>()->HasLateUpdate(), allPassed);
+    PrintCheck("engine and custom idle components skipped", !propObject->GetComponent<TransformComponent>()->HasUpdate()
+        && !propObject->GetComponent<SpatialComponent>()->HasUpdate() && !propObject->GetComponent<MarkerComponent>()->HasLateUpdate(), allPassed);
+    PrintCheck("pulses still tick every frame", pulseObject->GetComponent<PulseComponent>()->GetValue() != 0.0f, allPassed);
+    printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+
+    world.Terminate();
+    MarkerComponent::sOwners.clear();
+    std::filesystem::remove_all(directory);
+    return allPassed;
+}
\ No newline at end of file
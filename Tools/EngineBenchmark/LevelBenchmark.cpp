@@ -0,0 +1,237 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // a custom component with the kind of fields a level overrides
+    class TagComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::Tag);
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            SaveUtil::ReadString("Tag", mTag, value);
+            SaveUtil::ReadFloat("Weight", mWeight, value);
+            SaveUtil::ReadInt("Team", mTeam, value);
+            SaveUtil::ReadBool("Active", mActive, value);
+        }
+
+        // adds up what was loaded, so both loaders can be compared
+        void Initialize() override
+        {
+            const TransformComponent* transform = GetOwner().GetComponent<TransformComponent>();
+            sChecksum += transform->position.x + transform->position.z + mWeight + mTeam + (mActive ? 1.0 : 0.0) + mTag.size();
+        }
+
+        static double sChecksum;
+
+    private:
+        std::string mTag;
+        float mWeight = 0.0f;
+        int mTeam = 0;
+        bool mActive = false;
+    };
+
+    double TagComponent::sChecksum = 0.0;
+
+    REGISTER_COMPONENT(TagComponent);
+
+    void WriteTemplate(const std::filesystem::path& path, const char* tag)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, path.u8string().c_str(), "w");
+        fprintf(file,
+            "{\n"
+            "    \"Components\": {\n"
+            "        \"TransformComponent\": {\n"
+            "            \"Position\": [ 0.0, 0.0, 0.0 ],\n"
+            "            \"Rotation\": [ 0.0, 0.0, 0.0, 1.0 ],\n"
+            "            \"Scale\": [ 1.0, 1.0, 1.0 ]\n"
+            "        },\n"
+            "        \"TagComponent\": {\n"
+            "            \"Tag\": \"%s\",\n"
+            "            \"Weight\": 1.5,\n"
+            "            \"Team\": 1,\n"
+            "            \"Active\": true\n"
+            "        }\n"
+            "    }\n"
+            "}\n", tag);
+        fclose(file);
+    }
+
+    // every object overrides its position, every other one its tag data too
+    void WriteLevel(const std::filesystem::path& path, const std::filesystem::path templatePaths[2], uint32_t count)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, path.u8string().c_str(), "w");
+        fprintf(file, "{\n    \"Capacity\": %u,\n    \"Services\": {\n    },\n    \"GameObjects\": {\n", count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            fprintf(file, "        \"Object%u\": {\n", i);
+            fprintf(file, "            \"Template\": \"%s\",\n", templatePaths[i % 2].generic_u8string().c_str());
+            fprintf(file, "            \"Components\": {\n");
+            fprintf(file, "                \"TransformComponent\": { \"Position\": [ %.1f, 0.0, %.1f ] }", (i % 50) * 2.0f, (i / 50) * 2.0f);
+            if (i % 2 == 0)
+            {
+                fprintf(file, ",\n                \"TagComponent\": { \"Weight\": %.2f, \"Team\": %u }", i * 0.25f, i % 4);
+            }
+            fprintf(file, "\n            }\n        }%s\n", (i + 1 < count) ? "," : "");
+        }
+        fprintf(file, "    }\n}\n");
+        fclose(file);
+    }
+
+    // best of the repeats, each load builds a fresh world
+    template<class LoadFunction>
+    double TimeLoad(int repeats, double& checksum, LoadFunction&& load)
+    {
+        double bestMs = std::numeric_limits<double>::max();
+        for (int i = 0; i < repeats; ++i)
+        {
+            GameWorld world;
+            TagComponent::sChecksum = 0.0;
+            const BenchmarkClock::time_point start = BenchmarkClock::now();
+            load(world);
+            bestMs = std::min(bestMs, GetElapsedMs(start));
+            checksum = TagComponent::sChecksum;
+            world.Terminate();
+        }
+        return bestMs;
+    }
+
+    // loads over as many frames as the budget needs, the worst frame is what a player would notice as a hitch
+    // frames counts the progress events, the frames spent waiting on the read are not counted
+    void TimeAsyncLoad(const std::filesystem::path& levelPath, float budgetMs, const char* label)
+    {
+        uint32_t progressEvents = 0;
+        uint32_t loadedCount = 0;
+        const Core::EventListenerId listenerId = Core::EventManager::Get()->AddListener(LevelLoadProgressEvent::StaticGetTypeId(),
+            [&](const Core::Event& e)
+            {
+                const LevelLoadProgressEvent& progressEvent = static_cast<const LevelLoadProgressEvent&>(e);
+                loadedCount = progressEvent.loaded;
+                ++progressEvents;
+            });
+
+        GameWorld world;
+        TagComponent::sChecksum = 0.0;
+        double worstFrameMs = 0.0;
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        world.LoadLevelAsync(levelPath, budgetMs);
+        while (world.IsLoading())
+        {
+            const BenchmarkClock::time_point frameStart = BenchmarkClock::now();
+            world.Update(1.0f / 60.0f);
+            worstFrameMs = std::max(worstFrameMs, GetElapsedMs(frameStart));
+        }
+        const double totalMs = GetElapsedMs(start);
+        printf("%-24s %12.3f %12.3f %8u %8u %16.3f\n", label, totalMs, worstFrameMs, progressEvents, loadedCount, TagComponent::sChecksum);
+        world.Terminate();
+        Core::EventManager::Get()->RemoveListener(LevelLoadProgressEvent::StaticGetTypeId(), listenerId);
+    }
+
+    // breaks one record in a copy of the cooked file, the reader should turn it down when it opens
+    template<class RecordType>
+    bool OpensWithBadRecord(std::vector<uint8_t> data, uint32_t offset, uint32_t RecordType::* field, uint32_t badValue)
+    {
+        RecordType record;
+        std::memcpy(&record, data.data() + offset, sizeof(RecordType));
+        record.*field = badValue;
+        std::memcpy(data.data() + offset, &record, sizeof(RecordType));
+        CookedLevel::Reader reader;
+        return reader.Open(data.data(), data.size());
+    }
+
+    bool RunCookedChecks(const std::filesystem::path& cookedPath)
+    {
+        std::vector<uint8_t> data(static_cast<std::size_t>(std::filesystem::file_size(cookedPath)));
+        FILE* file = nullptr;
+        fopen_s(&file, cookedPath.u8string().c_str(), "rb");
+        const bool read = file != nullptr && fread(data.data(), 1, data.size(), file) == data.size();
+        if (file != nullptr)
+        {
+            fclose(file);
+        }
+        CookedLevel::Reader reader;
+        const bool opened = read && reader.Open(data.data(), data.size());
+        bool allPassed = true;
+        PrintCheck("cooked file opens", opened, allPassed);
+        if (opened)
+        {
+            const CookedLevel::Header header = reader.GetHeader();
+            const uint32_t objectOffset = header.objectsOffset;
+            const uint32_t componentOffset = header.componentsOffset;
+            const uint32_t stringOffset = header.stringsOffset;
+            PrintCheck("bad template index is rejected", !OpensWithBadRecord(data, objectOffset, &CookedLevel::ObjectRecord::templateIndex, header.templateCount), allPassed);
+            PrintCheck("bad override range is rejected", !OpensWithBadRecord(data, objectOffset, &CookedLevel::ObjectRecord::firstOverride, header.componentCount), allPassed);
+            PrintCheck("bad component type is rejected", !OpensWithBadRecord(data, componentOffset, &CookedLevel::ComponentRecord::type, header.stringCount), allPassed);
+            PrintCheck("bad component value is rejected", !OpensWithBadRecord(data, componentOffset, &CookedLevel::ComponentRecord::value, header.valueCount), allPassed);
+            PrintCheck("bad string range is rejected", !OpensWithBadRecord(data, stringOffset, &CookedLevel::StringRecord::length, header.charCount), allPassed);
+        }
+        printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+        return allPassed;
+    }
+}
+
+bool RunLevelBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 2000;
+    const int repeats = std::min(args.frames, 10);
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sabad_level_benchmark";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path templatePaths[2] = { directory / "crate.json", directory / "barrel.json" };
+    const std::filesystem::path levelPath = directory / "level.json";
+    const std::filesystem::path cookedPath = directory / (std::string("level") + CookedLevel::Extension);
+    WriteTemplate(templatePaths[0], "Crate");
+    WriteTemplate(templatePaths[1], "Barrel");
+    WriteLevel(levelPath, templatePaths, count);
+
+    const BenchmarkClock::time_point cookStart = BenchmarkClock::now();
+    CookedLevel::Cook(levelPath, cookedPath);
+    const double cookMs = GetElapsedMs(cookStart);
+
+    printf("level: %u objects, json %ju bytes, cooked %ju bytes (cook %.2f ms), best of %d\n", count,
+        static_cast<uintmax_t>(std::filesystem::file_size(levelPath)), static_cast<uintmax_t>(std::filesystem::file_size(cookedPath)), cookMs, repeats);
+    printf("%-24s %12s %16s\n", "case", "load ms", "checksum");
+
+    double checksum = 0.0;
+    double ms = TimeLoad(repeats, checksum, [&](GameWorld& world)
+    {
+        GameObjectFactory::InvalidateTemplates();
+        world.LoadLevel(levelPath);
+    });
+    printf("%-24s %12.3f %16.3f\n", "json, templates cold", ms, checksum);
+    const double jsonMs = TimeLoad(repeats, checksum, [&](GameWorld& world)
+    {
+        world.LoadLevel(levelPath);
+    });
+    printf("%-24s %12.3f %16.3f\n", "json, templates cached", jsonMs, checksum);
+    const double cookedMs = TimeLoad(repeats, checksum, [&](GameWorld& world)
+    {
+        world.LoadLevel(cookedPath);
+    });
+    printf("%-24s %12.3f %16.3f\n", "cooked", cookedMs, checksum);
+    printf("speedup over cached json %.1fx\n", jsonMs / cookedMs);
+    const bool allPassed = RunCookedChecks(cookedPath);
+
+    // templates cold so the async read has the parsing to do as well
+    printf("\n%-24s %12s %12s %8s %8s %16s\n", "case", "total ms", "worst frame", "frames", "loaded", "checksum");
+    GameObjectFactory::InvalidateTemplates();
+    double syncChecksum = 0.0;
+    const double syncMs = TimeLoad(1, syncChecksum, [&](GameWorld& world)
+    {
+        world.LoadLevel(levelPath);
+    });
+    printf("%-24s %12.3f %12.3f %8u %8u %16.3f\n", "json, sync", syncMs, syncMs, 1u, count, syncChecksum);
+    GameObjectFactory::InvalidateTemplates();
+    TimeAsyncLoad(levelPath, 4.0f, "json, async 4 ms");
+    GameObjectFactory::InvalidateTemplates();
+    TimeAsyncLoad(levelPath, 1.0f, "json, async 1 ms");
+    TimeAsyncLoad(cookedPath, 1.0f, "cooked, async 1 ms");
+
+    GameObjectFactory::InvalidateTemplates();
+    std::filesystem::remove_all(directory);
+    return allPassed;
+}
\ No newline at end of file
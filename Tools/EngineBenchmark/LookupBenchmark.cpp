@@ -0,0 +1,187 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // filler components so every object carries a realistic number of them
+    template<int Index>
+    class FillerComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(static_cast<int>(ComponentId::Count) + Index);
+    };
+
+    // filler services with custom ids, added before the service being looked up
+    template<int Index>
+    class FillerService final : public Service
+    {
+    public:
+        SET_TYPE_ID(static_cast<int>(ServiceId::Count) + Index);
+    };
+
+    // the lookup GameObject::GetComponent used to do, a scan with a virtual call per component
+    template<class ComponentType>
+    ComponentType* FindComponent(const std::vector<Component*>& components)
+    {
+        for (Component* component : components)
+        {
+            if (component->GetTypeId() == ComponentType::StaticGetTypeId())
+            {
+                return static_cast<ComponentType*>(component);
+            }
+        }
+        return nullptr;
+    }
+
+    // the lookup GameWorld::GetService used to do
+    template<class ServiceType>
+    ServiceType* FindService(const std::vector<Service*>& services)
+    {
+        for (Service* service : services)
+        {
+            if (service->GetTypeId() == ServiceType::StaticGetTypeId())
+            {
+                return static_cast<ServiceType*>(service);
+            }
+        }
+        return nullptr;
+    }
+
+    template<class Function>
+    double TimeLookups(int frames, Function&& function)
+    {
+        function();
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int i = 0; i < frames; ++i)
+        {
+            function();
+        }
+        return GetElapsedMs(start) / frames;
+    }
+}
+
+bool RunLookupBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 100000;
+
+    GameWorld world;
+    world.Initialize(count);
+    std::vector<GameObject*> gameObjects;
+    std::vector<std::vector<Component*>> componentLists;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        GameObject* gameObject = world.CreateGameObject("Lookup");
+        gameObject->AddComponent<TransformComponent>();
+        gameObject->AddComponent<FillerComponent<0>>();
+        gameObject->AddComponent<FillerComponent<1>>();
+        gameObject->AddComponent<FillerComponent<2>>();
+        gameObject->AddComponent<FillerComponent<3>>();
+        gameObject->AddComponent<FillerComponent<4>>();
+        gameObject->AddComponent<FillerComponent<5>>();
+        gameObject->AddComponent<FillerComponent<6>>();
+        gameObject->Initialize();
+        gameObjects.push_back(gameObject);
+        componentLists.push_back({
+            gameObject->GetComponent<TransformComponent>(),
+            gameObject->GetComponent<FillerComponent<0>>(),
+            gameObject->GetComponent<FillerComponent<1>>(),
+            gameObject->GetComponent<FillerComponent<2>>(),
+            gameObject->GetComponent<FillerComponent<3>>(),
+            gameObject->GetComponent<FillerComponent<4>>(),
+            gameObject->GetComponent<FillerComponent<5>>(),
+            gameObject->GetComponent<FillerComponent<6>>() });
+    }
+
+    std::size_t found = 0;
+    const double scanFirstMs = TimeLookups(args.frames, [&]()
+    {
+        for (const std::vector<Component*>& components : componentLists)
+        {
+            found += FindComponent<TransformComponent>(components) != nullptr;
+        }
+    });
+    const double scanLastMs = TimeLookups(args.frames, [&]()
+    {
+        for (const std::vector<Component*>& components : componentLists)
+        {
+            found += FindComponent<FillerComponent<6>>(components) != nullptr;
+        }
+    });
+    const double tableFirstMs = TimeLookups(args.frames, [&]()
+    {
+        for (GameObject* gameObject : gameObjects)
+        {
+            found += gameObject->GetComponent<TransformComponent>() != nullptr;
+        }
+    });
+    const double tableLastMs = TimeLookups(args.frames, [&]()
+    {
+        for (GameObject* gameObject : gameObjects)
+        {
+            found += gameObject->GetComponent<FillerComponent<6>>() != nullptr;
+        }
+    });
+    const GameObject::ComponentMask mask = GameObject::MakeComponentMask<TransformComponent, FillerComponent<6>>();
+    const double maskMs = TimeLookups(args.frames, [&]()
+    {
+        for (GameObject* gameObject : gameObjects)
+        {
+            found += (gameObject->GetComponentMask() & mask) == mask;
+        }
+    });
+    world.Terminate();
+
+    // one lookup per object, the way components find their service in Initialize and per frame code finds it each update
+    GameWorld serviceWorld;
+    std::vector<Service*> services = {
+        serviceWorld.AddService<FillerService<0>>(),
+        serviceWorld.AddService<FillerService<1>>(),
+        serviceWorld.AddService<FillerService<2>>(),
+        serviceWorld.AddService<FillerService<3>>(),
+        serviceWorld.AddService<FillerService<4>>(),
+        serviceWorld.AddService<FillerService<5>>(),
+        serviceWorld.AddService<FillerService<6>>(),
+        serviceWorld.AddService<SpatialService>() };
+    const double serviceScanMs = TimeLookups(args.frames, [&]()
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            found += FindService<SpatialService>(services) != nullptr;
+        }
+    });
+    const double serviceSlotMs = TimeLookups(args.frames, [&]()
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            found += serviceWorld.GetService<SpatialService>() != nullptr;
+        }
+    });
+    const double customSlotMs = TimeLookups(args.frames, [&]()
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            found += serviceWorld.GetService<FillerService<6>>() != nullptr;
+        }
+    });
+    const double cachedMs = TimeLookups(args.frames, [&]()
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            found += serviceWorld.GetSpatialService() != nullptr;
+        }
+    });
+    serviceWorld.Terminate();
+
+    printf("lookup: %u objects with 8 components, %d frames, %zu found\n", count, args.frames, found);
+    printf("%-28s %12s %12s\n", "lookup", "first ms", "last ms");
+    printf("%-28s %12.3f %12.3f\n", "linear scan", scanFirstMs, scanLastMs);
+    printf("%-28s %12.3f %12.3f\n", "GameObject::GetComponent", tableFirstMs, tableLastMs);
+    printf("%-28s %12.3f\n", "component mask test", maskMs);
+    printf("%-28s %12s\n", "service lookup, 8 services", "ms");
+    printf("%-28s %12.3f\n", "linear scan", serviceScanMs);
+    printf("%-28s %12.3f\n", "GetService engine id", serviceSlotMs);
+    printf("%-28s %12.3f\n", "GetService custom id", customSlotMs);
+    printf("%-28s %12.3f\n", "GetSpatialService", cachedMs);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // the expensive type the table should point at, the same bone chain as the scheduler benchmark's animator stand in
+    class SwayComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::Sway);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::Pose, UpdateThreading::PerObject);
+
+        void Update(float deltaTime) override
+        {
+            mTime += deltaTime;
+            Math::Matrix4 parent = Math::Matrix4::Identity;
+            for (Math::Matrix4& bone : mBones)
+            {
+                bone = Math::Matrix4::RotationY(mTime) * Math::Matrix4::Translation({ 0.0f, 0.1f, 0.0f }) * parent;
+                parent = bone;
+            }
+        }
+
+    private:
+        std::array<Math::Matrix4, 32> mBones;
+        float mTime = 0.0f;
+    };
+
+    // a cheap type that writes the transform, it should end up under the sway
+    class DriftComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::Drift);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::Transform, UpdateThreading::PerObject);
+
+        void Initialize() override
+        {
+            mTransform = GetOwner().GetComponent<TransformComponent>();
+        }
+
+        void Update(float deltaTime) override
+        {
+            mTransform->position.x += deltaTime;
+        }
+
+    private:
+        TransformComponent* mTransform = nullptr;
+    };
+
+    REGISTER_COMPONENT(SwayComponent);
+    REGISTER_COMPONENT(DriftComponent);
+
+    // times every frame on its own, so a frame the os took the core away in can be left out by the median
+    void RunFrames(GameWorld& world, int frames, float deltaTime, std::vector<double>& frameMs)
+    {
+        for (int i = 0; i < frames; ++i)
+        {
+            const BenchmarkClock::time_point start = BenchmarkClock::now();
+            world.Update(deltaTime);
+            world.Render();
+            frameMs.push_back(GetElapsedMs(start));
+        }
+    }
+
+    double GetMedian(std::vector<double>& values)
+    {
+        std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+        return values[values.size() / 2];
+    }
+
+    const UpdateProfiler::Row* FindRow(const std::vector<UpdateProfiler::Row>& rows, const char* name, ProfilePhase phase)
+    {
+        for (const UpdateProfiler::Row& row : rows)
+        {
+            if (row.name == name && row.phase == phase)
+            {
+                return &row;
+            }
+        }
+        return nullptr;
+    }
+}
+
+bool RunProfilerBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 900;
+    const int rounds = 50;
+    const int frames = std::max(args.frames / 10, 10);
+    const float deltaTime = 1.0f / 60.0f;
+
+    GameWorld world;
+    world.AddService<SpatialService>()->SetPartition(SpatialService::Partition::Grid, 16.0f);
+    world.Initialize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        GameObject* gameObject = world.CreateGameObject("Object" + std::to_string(i));
+        gameObject->AddComponent<TransformComponent>()->position = { (i % 30) * 20.0f, 0.0f, (i / 30) * 20.0f };
+        gameObject->AddComponent<SpatialComponent>();
+        gameObject->AddComponent<SwayComponent>();
+        gameObject->AddComponent<DriftComponent>();
+        gameObject->Initialize();
+    }
+    UpdateProfiler& profiler = world.GetUpdateProfiler();
+    std::vector<double> warmupMs;
+    RunFrames(world, frames, deltaTime, warmupMs);
+
+    // off and on in turns so drift in the machine hits both the same
+    std::vector<double> offFrameMs;
+    std::vector<double> onFrameMs;
+    uint32_t framesWhileOff = 0;
+    for (int r = 0; r < rounds; ++r)
+    {
+        profiler.SetEnabled(false);
+        const uint32_t framesBefore = profiler.GetFrameCount();
+        RunFrames(world, frames, deltaTime, offFrameMs);
+        framesWhileOff += profiler.GetFrameCount() - framesBefore;
+        profiler.SetEnabled(true);
+        RunFrames(world, frames, deltaTime, onFrameMs);
+    }
+    const double offMs = GetMedian(offFrameMs);
+    const double onMs = GetMedian(onFrameMs);
+    const double overhead = (onMs - offMs) / offMs * 100.0;
+
+    printf("profiler: %u objects, %d rounds of %d frames\n", count, rounds, frames);
+    printf("%-24s %12s\n", "case", "median ms/frame");
+    printf("%-24s %12.3f\n", "profiler off", offMs);
+    printf("%-24s %12.3f\n", "profiler on", onMs);
+    printf("overhead %.2f%%\n", overhead);
+
+    const std::vector<UpdateProfiler::Row> rows = profiler.GetRows();
+    printf("%-24s %-12s %12s %12s %12s\n", "type", "phase", "ms/frame", "p95 ms", "calls/frame");
+    for (const UpdateProfiler::Row& row : rows)
+    {
+        const char* phaseNames[] = { "Update", "LateUpdate", "Render", "DebugUI" };
+        printf("%-24s %-12s %12.4f %12.4f %12.1f\n", row.name.c_str(), phaseNames[static_cast<int>(row.phase)], row.averageMs, row.p95Ms, row.callsPerFrame);
+    }
+
+    const std::filesystem::path csvPath = std::filesystem::temp_directory_path() / "sabad_update_profile.csv";
+    const bool saved = profiler.SaveToCsv(csvPath);
+    uint32_t csvLines = 0;
+    FILE* csvFile = nullptr;
+    fopen_s(&csvFile, csvPath.u8string().c_str(), "r");
+    char line[512];
+    while (csvFile != nullptr && fgets(line, sizeof(line), csvFile) != nullptr)
+    {
+        ++csvLines;
+    }
+    if (csvFile != nullptr)
+    {
+        fclose(csvFile);
+    }
+    std::filesystem::remove(csvPath);
+
+    const UpdateProfiler::Row* sway = FindRow(rows, "SwayComponent", ProfilePhase::Update);
+    const UpdateProfiler::Row* drift = FindRow(rows, "DriftComponent", ProfilePhase::Update);
+    const UpdateProfiler::Row* spatial = FindRow(rows, "SpatialService", ProfilePhase::Update);
+    bool allPassed = true;
+    PrintCheck("every type has a row", sway != nullptr && drift != nullptr && spatial != nullptr, allPassed);
+    PrintCheck("calls per frame match the objects", sway != nullptr && drift != nullptr && spatial != nullptr
+        && sway->callsPerFrame == count && drift->callsPerFrame == count && spatial->callsPerFrame == 1.0, allPassed);
+    PrintCheck("sorted by cost, sway first", !rows.empty() && rows.front().name == "SwayComponent", allPassed);
+    PrintCheck("p95 is recorded", sway != nullptr && sway->p95Ms > 0.0, allPassed);
+    PrintCheck("nothing is recorded while off", framesWhileOff == 0, allPassed);
+    PrintCheck("csv has a header and every row", saved && csvLines == rows.size() + 1, allPassed);
+    PrintCheck("overhead under 2%", overhead < 2.0, allPassed);
+    printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+
+    world.Terminate();
+    return allPassed;
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+// three stand ins for game projects, each registers its own types the way a VGP project would in its own files
+namespace ModuleA
+{
+    class ModuleAHealthComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::ModuleAHealth);
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            SaveUtil::ReadFloat("Health", mHealth, value);
+        }
+
+        float mHealth = 0.0f;
+    };
+
+    REGISTER_COMPONENT(ModuleAHealthComponent);
+}
+
+namespace ModuleB
+{
+    enum class ModuleBServiceId
+    {
+        Score = static_cast<int>(ServiceId::Count)
+    };
+
+    class ModuleBInventoryComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::ModuleBInventory);
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            SaveUtil::ReadInt("Slots", mSlots, value);
+        }
+
+        int mSlots = 0;
+    };
+
+    class ModuleBScoreService final : public Service
+    {
+    public:
+        SET_TYPE_ID(ModuleBServiceId::Score);
+    };
+
+    REGISTER_COMPONENT(ModuleBInventoryComponent);
+    REGISTER_SERVICE(ModuleBScoreService);
+}
+
+namespace ModuleC
+{
+    class ModuleCPatrolComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::ModuleCPatrol);
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            SaveUtil::ReadString("Route", mRoute, value);
+        }
+
+        // the level overrides the template route, checked after the load
+        void Initialize() override
+        {
+            sLastRoute = mRoute;
+        }
+
+        static std::string sLastRoute;
+        std::string mRoute;
+    };
+
+    std::string ModuleCPatrolComponent::sLastRoute;
+
+    REGISTER_COMPONENT(ModuleCPatrolComponent);
+}
+
+namespace
+{
+    void WriteTemplate(const std::filesystem::path& path)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, path.u8string().c_str(), "w");
+        fprintf(file,
+            "{\n"
+            "    \"Components\": {\n"
+            "        \"TransformComponent\": {},\n"
+            "        \"ModuleAHealthComponent\": { \"Health\": 75.0 },\n"
+            "        \"ModuleBInventoryComponent\": { \"Slots\": 12 },\n"
+            "        \"ModuleCPatrolComponent\": { \"Route\": \"North\" }\n"
+            "    }\n"
+            "}\n");
+        fclose(file);
+    }
+
+    void WriteLevel(const std::filesystem::path& path, const std::filesystem::path& templatePath)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, path.u8string().c_str(), "w");
+        fprintf(file,
+            "{\n"
+            "    \"Capacity\": 4,\n"
+            "    \"Services\": { \"ModuleBScoreService\": {} },\n"
+            "    \"GameObjects\": {\n"
+            "        \"Guard\": {\n"
+            "            \"Template\": \"%s\",\n"
+            "            \"Components\": { \"ModuleCPatrolComponent\": { \"Route\": \"South\" } }\n"
+            "        }\n"
+            "    }\n"
+            "}\n", templatePath.generic_u8string().c_str());
+        fclose(file);
+    }
+
+    // every name a level can use here, in the order the old if chain tested them
+    const std::string sTypeNames[] =
+    {
+        "TransformComponent", "CameraComponent", "FPSCameraComponent", "MeshComponent", "ModelComponent", "AnimatorComponent",
+        "RigidBodyComponent", "TriggerComponent", "SoundEventComponent", "SoundBankComponent", "UITextComponent", "UISpriteComponent",
+        "SpinComponent", "TagComponent", "ModuleAHealthComponent", "ModuleBInventoryComponent", "ModuleCPatrolComponent"
+    };
+}
+
+bool RunRegistryBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t lookups = (args.count > 0) ? args.count : 1000000;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sabad_registry_benchmark";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path templatePath = directory / "guard.json";
+    const std::filesystem::path levelPath = directory / "level.json";
+    WriteTemplate(templatePath);
+    WriteLevel(levelPath, templatePath);
+
+    printf("registry: %u components and %u services registered\n", TypeRegistry::GetComponentCount(), TypeRegistry::GetServiceCount());
+    bool allPassed = true;
+    PrintCheck("engine and module components found", TypeRegistry::FindComponent("TransformComponent") != nullptr
+        && TypeRegistry::FindComponent("ModuleAHealthComponent") != nullptr
+        && TypeRegistry::FindComponent("ModuleBInventoryComponent") != nullptr
+        && TypeRegistry::FindComponent("ModuleCPatrolComponent") != nullptr, allPassed);
+    PrintCheck("unknown name not found", TypeRegistry::FindComponent("MissingComponent") == nullptr, allPassed);
+    PrintCheck("same type registering again is ignored", !TypeRegistry::RegisterComponent<ModuleA::ModuleAHealthComponent>("ModuleAHealthComponent"), allPassed);
+
+    GameWorld world;
+    world.LoadLevel(levelPath);
+    PrintCheck("module service made from the level", world.GetService<ModuleB::ModuleBScoreService>() != nullptr, allPassed);
+    PrintCheck("level override of a module component", ModuleC::ModuleCPatrolComponent::sLastRoute == "South", allPassed);
+    GameObject* guard = world.CreateGameObject("Guard2", templatePath);
+    const auto* health = guard->GetComponent<ModuleA::ModuleAHealthComponent>();
+    const auto* inventory = guard->GetComponent<ModuleB::ModuleBInventoryComponent>();
+    const auto* patrol = guard->GetComponent<ModuleC::ModuleCPatrolComponent>();
+    PrintCheck("one template mixing all three modules", health != nullptr && health->mHealth == 75.0f
+        && inventory != nullptr && inventory->mSlots == 12
+        && patrol != nullptr && patrol->mRoute == "North", allPassed);
+    PrintCheck("get by name finds the module component", GameObjectFactory::GetComponent("ModuleBInventoryComponent", *guard) == inventory, allPassed);
+    world.Terminate();
+    printf("%s\n", allPassed ? "all checks passed" : "SOME CHECKS FAILED");
+
+    // names are cycled so both sides see every type, the chain cost grows with the position of the name
+    const uint32_t nameCount = static_cast<uint32_t>(std::size(sTypeNames));
+    uintptr_t sink = 0;
+    BenchmarkClock::time_point start = BenchmarkClock::now();
+    for (uint32_t i = 0; i < lookups; ++i)
+    {
+        const std::string& name = sTypeNames[i % nameCount];
+        for (uint32_t n = 0; n < nameCount; ++n)
+        {
+            if (name == sTypeNames[n])
+            {
+                sink += n;
+                break;
+            }
+        }
+    }
+    const double chainMs = GetElapsedMs(start);
+    start = BenchmarkClock::now();
+    for (uint32_t i = 0; i < lookups; ++i)
+    {
+        sink += reinterpret_cast<uintptr_t>(TypeRegistry::FindComponent(sTypeNames[i % nameCount]));
+    }
+    const double registryMs = GetElapsedMs(start);
+    start = BenchmarkClock::now();
+    uint32_t nameHashes[std::size(sTypeNames)];
+    for (uint32_t n = 0; n < nameCount; ++n)
+    {
+        nameHashes[n] = HashTypeName(sTypeNames[n]);
+    }
+    for (uint32_t i = 0; i < lookups; ++i)
+    {
+        sink += reinterpret_cast<uintptr_t>(TypeRegistry::FindComponent(nameHashes[i % nameCount]));
+    }
+    const double hashedMs = GetElapsedMs(start);
+
+    printf("\n%u lookups over %u names\n", lookups, nameCount);
+    printf("%-24s %12s %12s\n", "case", "total ms", "ns/lookup");
+    printf("%-24s %12.3f %12.2f\n", "string chain", chainMs, chainMs * 1e6 / lookups);
+    printf("%-24s %12.3f %12.2f\n", "registry by name", registryMs, registryMs * 1e6 / lookups);
+    printf("%-24s %12.3f %12.2f\n", "registry by hash", hashedMs, hashedMs * 1e6 / lookups);
+    printf("(sink %ju)\n", static_cast<uintmax_t>(sink & 0xff));
+    std::filesystem::remove_all(directory);
+    return allPassed;
+}
\ No newline at end of file
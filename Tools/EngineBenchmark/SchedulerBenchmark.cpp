@@ -0,0 +1,163 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    enum class BenchmarkComponentId
+    {
+        Wave = static_cast<int>(ComponentId::Count),
+        Pose,
+        Stats
+    };
+
+    // moves the owner up and down, a stand in for gameplay that writes the transform
+    class WaveComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Wave);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::Transform, UpdateThreading::PerObject);
+
+        void Initialize() override
+        {
+            mTransform = GetOwner().GetComponent<TransformComponent>();
+            mPhase = mTransform->position.x * 0.1f + mTransform->position.z * 0.05f;
+        }
+
+        void Update(float deltaTime) override
+        {
+            mTime += deltaTime;
+            float height = 0.0f;
+            for (int i = 1; i <= 32; ++i)
+            {
+                height += sinf((mTime * i) + mPhase) / i;
+            }
+            mTransform->position.y = height;
+        }
+
+    private:
+        TransformComponent* mTransform = nullptr;
+        float mTime = 0.0f;
+        float mPhase = 0.0f;
+    };
+
+    // builds a chain of bone matrices, a stand in for an animator
+    class PoseComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Pose);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::Pose, UpdateThreading::PerObject);
+
+        void Update(float deltaTime) override
+        {
+            mTime += deltaTime;
+            Math::Matrix4 parent = Math::Matrix4::Identity;
+            for (Math::Matrix4& bone : mBones)
+            {
+                bone = Math::Matrix4::RotationY(mTime) * Math::Matrix4::Translation({ 0.0f, 0.1f, 0.0f }) * parent;
+                parent = bone;
+            }
+        }
+
+        float GetChecksum() const { return mBones.back()._42; }
+
+    private:
+        std::array<Math::Matrix4, 32> mBones;
+        float mTime = 0.0f;
+    };
+
+    // gathers the heights the waves wrote into shared stats, so it has to run after them and one object at a time
+    class StatsComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Stats);
+        SET_UPDATE_ACCESS(UpdateData::Transform, UpdateData::UI, UpdateThreading::Serial);
+
+        void Initialize() override
+        {
+            mTransform = GetOwner().GetComponent<TransformComponent>();
+        }
+
+        void Update(float deltaTime) override
+        {
+            sTotalHeight += mTransform->position.y;
+        }
+
+        static double sTotalHeight;
+
+    private:
+        const TransformComponent* mTransform = nullptr;
+    };
+
+    double StatsComponent::sTotalHeight = 0.0;
+}
+
+bool RunSchedulerBenchmark(const BenchmarkArguments& args)
+{
+    // the VGP340 30x30 grid, every object animated and moved
+    const uint32_t count = (args.count > 0) ? args.count : 900;
+    const uint32_t gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    const float deltaTime = 1.0f / 60.0f;
+    Core::JobSystem* jobSystem = Core::JobSystem::Get();
+    const uint32_t maxThreads = jobSystem->GetThreadCount();
+
+    printf("scheduler: %u objects, %d frames, %u threads available\n", count, args.frames, maxThreads);
+    printf("%8s %12s %10s %16s\n", "threads", "ms/frame", "speedup", "checksum");
+    double serialMs = 0.0;
+    double serialChecksum = 0.0;
+    bool checksumsMatch = true;
+    for (uint32_t threads : { 1u, 2u, 4u, 8u })
+    {
+        if (threads > maxThreads)
+        {
+            printf("%8u %12s\n", threads, "skipped");
+            continue;
+        }
+        jobSystem->SetActiveWorkerCount(threads - 1);
+        StatsComponent::sTotalHeight = 0.0;
+
+        GameWorld world;
+        world.Initialize(count);
+        std::vector<PoseComponent*> poses;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            GameObject* gameObject = world.CreateGameObject("GridObj");
+            TransformComponent* transform = gameObject->AddComponent<TransformComponent>();
+            transform->position = { (i % gridSize) * 20.0f, 0.0f, (i / gridSize) * 20.0f };
+            gameObject->AddComponent<WaveComponent>();
+            poses.push_back(gameObject->AddComponent<PoseComponent>());
+            gameObject->AddComponent<StatsComponent>();
+            gameObject->Initialize();
+        }
+
+        world.Update(deltaTime);
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (int i = 0; i < args.frames; ++i)
+        {
+            world.Update(deltaTime);
+        }
+        const double ms = GetElapsedMs(start) / args.frames;
+        if (threads == 1)
+        {
+            serialMs = ms;
+        }
+
+        // has to match across thread counts, the stats component always sees every wave of its frame
+        double checksum = StatsComponent::sTotalHeight;
+        for (const PoseComponent* pose : poses)
+        {
+            checksum += pose->GetChecksum();
+        }
+        world.Terminate();
+        if (threads == 1)
+        {
+            serialChecksum = checksum;
+        }
+        checksumsMatch = checksumsMatch && checksum == serialChecksum;
+        printf("%8u %12.3f %10.2f %16.6f\n", threads, ms, serialMs / ms, checksum);
+    }
+    jobSystem->SetActiveWorkerCount(jobSystem->GetWorkerCount());
+    bool allPassed = true;
+    PrintCheck("checksum matches on every thread count", checksumsMatch, allPassed);
+    return allPassed;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+bool RunSlotBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 100000;
+    const int rounds = std::max(std::min(args.frames, 10), 1);
+
+    // starts from the default capacity, every slot past it comes from growing
+    GameWorld world;
+    world.Initialize();
+    std::vector<GameObjectHandle> handles(count);
+    std::vector<GameObjectHandle> staleHandles;
+    double createMs = 0.0;
+    double resolveMs = 0.0;
+    double destroyMs = 0.0;
+    uint32_t resolved = 0;
+    bool allPassed = true;
+    bool staleRejected = true;
+    for (int round = 0; round < rounds; ++round)
+    {
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            handles[i] = world.CreateGameObject("Churn")->GetHandle();
+        }
+        createMs += GetElapsedMs(start);
+
+        for (const GameObjectHandle& staleHandle : staleHandles)
+        {
+            staleRejected = staleRejected && (world.GetGameObject(staleHandle) == nullptr);
+        }
+
+        start = BenchmarkClock::now();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            resolved += (world.GetGameObject(handles[i]) != nullptr) ? 1 : 0;
+        }
+        resolveMs += GetElapsedMs(start);
+
+        // every other object goes first so the live list is reshuffled before the rest follow
+        start = BenchmarkClock::now();
+        for (uint32_t i = 0; i < count; i += 2)
+        {
+            world.DestroyGameObject(handles[i]);
+        }
+        world.Update(0.0f);
+        for (uint32_t i = 1; i < count; i += 2)
+        {
+            world.DestroyGameObject(handles[i]);
+        }
+        world.Update(0.0f);
+        destroyMs += GetElapsedMs(start);
+        staleHandles = handles;
+    }
+
+    printf("slots: %u objects created and destroyed %d times\n", count, rounds);
+    PrintCheck("every handle resolves while alive", resolved == count * static_cast<uint32_t>(rounds), allPassed);
+    PrintCheck("handles from earlier rounds resolve to null", staleRejected, allPassed);
+    PrintCheck("world is empty after the churn", world.GetGameObjectCount() == 0, allPassed);
+    PrintCheck("default handle resolves to null", world.GetGameObject(GameObjectHandle()) == nullptr, allPassed);
+
+    // a slot reused more times than the generation can count is retired, its old handles must never resolve
+    GameObjectHandle firstHandle = world.CreateGameObject("Reused")->GetHandle();
+    world.DestroyGameObject(firstHandle);
+    world.Update(0.0f);
+    bool wrapRejected = true;
+    for (uint32_t i = 0; i < GameObjectHandle::MaxGeneration * 2; ++i)
+    {
+        const GameObjectHandle handle = world.CreateGameObject("Reused")->GetHandle();
+        wrapRejected = wrapRejected && (world.GetGameObject(firstHandle) == nullptr) && (handle != firstHandle);
+        world.DestroyGameObject(handle);
+        world.Update(0.0f);
+    }
+    PrintCheck("no handle aliasing after generation wrap", wrapRejected, allPassed);
+    printf("%s\n", allPassed ? "all checks passed" : "SOME CHECKS FAILED");
+    world.Terminate();
+
+    const double perRound = static_cast<double>(count) * rounds;
+    printf("%-20s %12s %12s\n", "case", "total ms", "ns/object");
+    printf("%-20s %12.3f %12.2f\n", "create", createMs, createMs * 1e6 / perRound);
+    printf("%-20s %12.3f %12.2f\n", "resolve handle", resolveMs, resolveMs * 1e6 / perRound);
+    printf("%-20s %12.3f %12.2f\n", "destroy", destroyMs, destroyMs * 1e6 / perRound);
+    return allPassed;
+}
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // gameplay state that changes while the game runs and has to come back with a save
+    class HealthComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::Health);
+
+        void SaveState(SnapshotWriter& writer) const override
+        {
+            writer.Write(mHealth);
+            writer.Write(mTeam);
+            writer.Write(mLabel);
+        }
+
+        void LoadState(SnapshotReader& reader) override
+        {
+            reader.Read(mHealth);
+            reader.Read(mTeam);
+            reader.Read(mLabel);
+        }
+
+        float GetHealth() const { return mHealth; }
+        void Damage(float amount) { mHealth -= amount; }
+        void Setup(float health, int team, std::string label)
+        {
+            mHealth = health;
+            mTeam = team;
+            mLabel = std::move(label);
+        }
+
+    private:
+        std::string mLabel;
+        float mHealth = 100.0f;
+        int mTeam = 0;
+    };
+
+    REGISTER_COMPONENT(HealthComponent);
+
+    // one root every 10 objects, the rest are its children
+    void BuildScene(GameWorld& world, uint32_t count, std::vector<GameObjectHandle>& handles)
+    {
+        world.AddService<SpatialService>()->SetPartition(SpatialService::Partition::Grid, 16.0f);
+        world.Initialize(count);
+        GameObject* root = nullptr;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            GameObject* gameObject = world.CreateGameObject("Object" + std::to_string(i));
+            TransformComponent* transform = gameObject->AddComponent<TransformComponent>();
+            transform->position = { (i % 50) * 2.0f, 0.0f, (i / 50) * 2.0f };
+            gameObject->AddComponent<SpatialComponent>();
+            gameObject->AddComponent<HealthComponent>()->Setup(100.0f, static_cast<int>(i % 4), (i % 2 == 0) ? "Crate" : "Barrel");
+            if (i % 10 == 0)
+            {
+                root = gameObject;
+            }
+            else
+            {
+                gameObject->SetParent(root);
+            }
+            gameObject->Initialize();
+            handles.push_back(gameObject->GetHandle());
+        }
+    }
+
+    // a level of falling crates on a ground body, the engine's own model and rigid body components have to come back with their shape and velocity
+    void RunPhysicsRoundTrip(const std::filesystem::path& directory, float deltaTime, bool& allPassed)
+    {
+        Physics::PhysicsWorld::Settings physicsSettings;
+        Physics::PhysicsWorld::StaticInitialize(physicsSettings);
+        Physics::CollisionShapeCache::StaticInitialize();
+        // the model file is not there, the manager gives it an empty model the same as a missing asset in the game
+        Graphics::ModelManager::StaticInitialize(directory);
+
+        rapidjson::Document document;
+        document.Parse(R"({
+            "Model": { "FileName": "crate.model", "CastShadow": false, "Animations": [ "crate_open.animset" ] },
+            "Crate": { "Mass": 2.0, "ColliderData": { "Shape": "Box", "HalfExtents": [ 0.5, 0.5, 0.5 ] } },
+            "Ground": { "Mass": 0.0, "ColliderData": { "Shape": "Box", "HalfExtents": [ 50.0, 0.5, 50.0 ] } }
+        })");
+
+        const uint32_t crateCount = 100;
+        WorldSnapshot snapshot;
+        std::vector<GameObjectHandle> handles;
+        std::vector<Graphics::ModelId> modelIds;
+        std::size_t shapeReferenceCount = 0;
+        {
+            // only one world at a time, both share the physics world
+            GameWorld world;
+            world.AddService<PhysicsService>();
+            world.Initialize(crateCount + 1);
+            GameObject* ground = world.CreateGameObject("Ground");
+            ground->AddComponent<TransformComponent>();
+            ground->AddComponent<RigidBodyComponent>()->Deserialize(document["Ground"]);
+            ground->Initialize();
+            handles.push_back(ground->GetHandle());
+            for (uint32_t i = 0; i < crateCount; ++i)
+            {
+                GameObject* crate = world.CreateGameObject("Crate" + std::to_string(i));
+                crate->AddComponent<TransformComponent>()->position = { (i % 10) * 1.5f, 2.0f + (i / 10) * 1.5f, 0.0f };
+                crate->AddComponent<ModelComponent>()->Deserialize(document["Model"]);
+                crate->AddComponent<RigidBodyComponent>()->Deserialize(document["Crate"]);
+                crate->Initialize();
+                handles.push_back(crate->GetHandle());
+                modelIds.push_back(crate->GetComponent<ModelComponent>()->GetModelId());
+            }
+            // saved mid fall, so every crate has a velocity to bring back
+            for (int i = 0; i < 20; ++i)
+            {
+                world.Update(deltaTime);
+            }
+            world.CaptureSnapshot(snapshot, 20);
+            shapeReferenceCount = Physics::CollisionShapeCache::Get()->GetReferenceCount();
+            world.Terminate();
+        }
+
+        GameWorld restored;
+        restored.RestoreSnapshot(snapshot);
+        bool modelsMatch = restored.GetGameObjectCount() == crateCount + 1;
+        for (uint32_t i = 0; i < crateCount && modelsMatch; ++i)
+        {
+            const GameObject* crate = restored.GetGameObject(handles[i + 1]);
+            const ModelComponent* model = (crate != nullptr) ? crate->GetComponent<ModelComponent>() : nullptr;
+            modelsMatch = model != nullptr && crate->GetComponent<RigidBodyComponent>() != nullptr && model->GetModelId() == modelIds[i];
+        }
+        PrintCheck("model and rigid body level restores", modelsMatch, allPassed);
+        PrintCheck("collision shapes are acquired again", Physics::CollisionShapeCache::Get()->GetReferenceCount() == shapeReferenceCount, allPassed);
+
+        // the recapture reads the velocities back from the new bodies, so an identical capture means they were applied
+        WorldSnapshot recaptured;
+        restored.CaptureSnapshot(recaptured, 20);
+        recaptured.Encode(&snapshot);
+        PrintCheck("mass, shape and velocity restored", recaptured.GetSizeInBytes() == snapshot.GetSizeInBytes()
+            && recaptured.GetDeltaSizeInBytes() == 2 * sizeof(uint32_t), allPassed);
+        restored.Update(deltaTime);
+        restored.Terminate();
+
+        Graphics::ModelManager::StaticTerminate();
+        Physics::CollisionShapeCache::StaticTerminate();
+        Physics::PhysicsWorld::StaticTerminate();
+    }
+}
+
+bool RunSnapshotBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 2000;
+    const int repeats = std::min(args.frames, 20);
+    const float deltaTime = 1.0f / 60.0f;
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sabad_snapshot_benchmark";
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path baselinePath = directory / "baseline.snapshot";
+    const std::filesystem::path autosavePath = directory / "autosave.snapshot";
+
+    GameWorld world;
+    std::vector<GameObjectHandle> handles;
+    BuildScene(world, count, handles);
+    // a destroyed object, its handle has to stay stale after a restore
+    const GameObjectHandle destroyedHandle = handles.back();
+    world.DestroyGameObject(destroyedHandle);
+    handles.pop_back();
+    world.Update(deltaTime);
+
+    WorldSnapshot baseline;
+    double captureMs = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeats; ++i)
+    {
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        world.CaptureSnapshot(baseline, 0);
+        captureMs = std::min(captureMs, GetElapsedMs(start));
+    }
+    baseline.SaveToFile(baselinePath, nullptr);
+    const std::size_t baselineFileSize = static_cast<std::size_t>(std::filesystem::file_size(baselinePath));
+
+    // a few seconds of play, one object in twenty moves or takes damage
+    for (uint32_t i = 0; i < handles.size(); i += 20)
+    {
+        GameObject* gameObject = world.GetGameObject(handles[i]);
+        gameObject->GetComponent<TransformComponent>()->position.y += 1.0f;
+        gameObject->GetComponent<HealthComponent>()->Damage(15.0f);
+    }
+    world.Update(deltaTime);
+
+    WorldSnapshot autosave;
+    world.CaptureSnapshot(autosave, 300);
+    double encodeMs = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeats; ++i)
+    {
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        autosave.Encode(&baseline);
+        encodeMs = std::min(encodeMs, GetElapsedMs(start));
+    }
+    autosave.SaveToFile(autosavePath, &baseline);
+    const std::size_t autosaveFileSize = static_cast<std::size_t>(std::filesystem::file_size(autosavePath));
+
+    // what loading a save does, read the baseline and the autosave and restore into a fresh world
+    double loadMs = std::numeric_limits<double>::max();
+    double restoreMs = std::numeric_limits<double>::max();
+    bool filesLoaded = true;
+    for (int i = 0; i < repeats; ++i)
+    {
+        GameWorld restored;
+        WorldSnapshot loadedBaseline;
+        WorldSnapshot loaded;
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        filesLoaded = loadedBaseline.LoadFromFile(baselinePath, nullptr) && loaded.LoadFromFile(autosavePath, &loadedBaseline) && filesLoaded;
+        const double readMs = GetElapsedMs(start);
+        const BenchmarkClock::time_point restoreStart = BenchmarkClock::now();
+        restored.RestoreSnapshot(loaded);
+        restoreMs = std::min(restoreMs, GetElapsedMs(restoreStart));
+        loadMs = std::min(loadMs, readMs + GetElapsedMs(restoreStart));
+        restored.Terminate();
+    }
+
+    printf("snapshot: %u objects, best of %d\n", count - 1, repeats);
+    printf("%-36s %12s %12s\n", "case", "ms", "bytes");
+    printf("%-36s %12.3f %12zu\n", "capture", captureMs, baseline.GetSizeInBytes());
+    printf("%-36s %12s %12zu\n", "baseline file", "", baselineFileSize);
+    printf("%-36s %12.3f %12zu\n", "encode autosave against baseline", encodeMs, autosave.GetDeltaSizeInBytes());
+    printf("%-36s %12s %12zu\n", "autosave file", "", autosaveFileSize);
+    printf("%-36s %12.3f\n", "restore into a fresh world", restoreMs);
+    printf("%-36s %12.3f\n", "read both files and restore", loadMs);
+
+    GameWorld restored;
+    WorldSnapshot loadedBaseline;
+    WorldSnapshot loaded;
+    loadedBaseline.LoadFromFile(baselinePath, nullptr);
+    loaded.LoadFromFile(autosavePath, &loadedBaseline);
+    restored.RestoreSnapshot(loaded);
+    restored.Update(deltaTime);
+
+    bool allPassed = true;
+    PrintCheck("files load against their baseline", filesLoaded, allPassed);
+    PrintCheck("autosave refuses the wrong baseline", !WorldSnapshot().LoadFromFile(autosavePath, nullptr), allPassed);
+    PrintCheck("object count matches", restored.GetGameObjectCount() == world.GetGameObjectCount(), allPassed);
+    bool handlesMatch = true;
+    bool stateMatches = true;
+    bool parentsMatch = true;
+    for (const GameObjectHandle& handle : handles)
+    {
+        const GameObject* original = world.GetGameObject(handle);
+        const GameObject* copy = restored.GetGameObject(handle);
+        if (copy == nullptr || copy->GetName() != original->GetName())
+        {
+            handlesMatch = false;
+            continue;
+        }
+        const Math::Vector3 originalPosition = original->GetComponent<TransformComponent>()->GetWorldPosition();
+        const Math::Vector3 copyPosition = copy->GetComponent<TransformComponent>()->GetWorldPosition();
+        stateMatches = stateMatches && Math::MagnitudeSqr(originalPosition - copyPosition) == 0.0f
+            && copy->GetComponent<HealthComponent>()->GetHealth() == original->GetComponent<HealthComponent>()->GetHealth();
+        const GameObject* originalParent = original->GetParent();
+        const GameObject* copyParent = copy->GetParent();
+        parentsMatch = parentsMatch && ((originalParent == nullptr) == (copyParent == nullptr))
+            && (originalParent == nullptr || originalParent->GetHandle() == copyParent->GetHandle());
+    }
+    PrintCheck("every handle finds the same object", handlesMatch, allPassed);
+    PrintCheck("transforms and health restored", stateMatches, allPassed);
+    PrintCheck("parents restored", parentsMatch, allPassed);
+    PrintCheck("destroyed handle stays stale", restored.GetGameObject(destroyedHandle) == nullptr, allPassed);
+    PrintCheck("spatial service has every object", restored.GetSpatialService()->GetObjectCount() == count - 1, allPassed);
+
+    WorldSnapshot recaptured;
+    restored.CaptureSnapshot(recaptured, 300);
+    recaptured.Encode(&autosave);
+    PrintCheck("capture of the restored world is identical", recaptured.GetSizeInBytes() == autosave.GetSizeInBytes()
+        && recaptured.GetDeltaSizeInBytes() == 2 * sizeof(uint32_t), allPassed);
+    GameObject* newObject = restored.CreateGameObject("New");
+    GameObject* expectedObject = world.CreateGameObject("New");
+    PrintCheck("next new object takes the same slot", newObject->GetHandle() == expectedObject->GetHandle(), allPassed);
+
+    // objects spawned and destroyed between two autosaves, only their records and their parents' should end up in the delta
+    WorldSnapshot beforeSpawns;
+    world.CaptureSnapshot(beforeSpawns, 400);
+    const uint32_t churn = std::max(count / 100, 1u);
+    for (uint32_t i = 0; i < churn && 10 * i + 1 < handles.size(); ++i)
+    {
+        world.DestroyGameObject(handles[10 * i + 1]);
+        GameObject* spawned = world.CreateGameObject("Spawned" + std::to_string(i));
+        spawned->AddComponent<TransformComponent>()->position = { i * 2.0f, 5.0f, 0.0f };
+        spawned->AddComponent<SpatialComponent>();
+        spawned->AddComponent<HealthComponent>()->Setup(50.0f, 1, "Projectile");
+        spawned->Initialize();
+    }
+    world.Update(deltaTime);
+    WorldSnapshot afterSpawns;
+    world.CaptureSnapshot(afterSpawns, 401);
+    afterSpawns.Encode(&beforeSpawns);
+    WorldSnapshot decoded;
+    const bool decodes = decoded.Decode(&beforeSpawns, afterSpawns.GetDelta().data(), afterSpawns.GetDelta().size(), 401);
+    decoded.Encode(&afterSpawns);
+    printf("%-36s %12s %12zu\n", ("encode after " + std::to_string(churn) + " spawns and destroys").c_str(), "", afterSpawns.GetDeltaSizeInBytes());
+    PrintCheck("spawns and destroys stay a small delta", afterSpawns.GetDeltaSizeInBytes() * 20 < afterSpawns.GetSizeInBytes(), allPassed);
+    PrintCheck("spawn delta decodes to the same state", decodes && decoded.GetSizeInBytes() == afterSpawns.GetSizeInBytes()
+        && decoded.GetDeltaSizeInBytes() == 2 * sizeof(uint32_t), allPassed);
+    RunPhysicsRoundTrip(directory, deltaTime, allPassed);
+    printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+
+    restored.Terminate();
+    world.Terminate();
+    std::filesystem::remove_all(directory);
+    return allPassed;
+}
\ No newline at end of file
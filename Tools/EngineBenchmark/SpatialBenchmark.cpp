@@ -0,0 +1,335 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+
+namespace
+{
+    constexpr float WorldSize = 1000.0f;
+    constexpr float WorldHeight = 100.0f;
+
+    // fixed seed so every run places the same objects
+    struct Random
+    {
+        uint32_t state = 0x9e3779b9;
+
+        float Next(float min, float max)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return min + ((max - min) * static_cast<float>(state & 0xffffff) / static_cast<float>(0x1000000));
+        }
+    };
+
+    struct BruteObject
+    {
+        const GameObject* gameObject = nullptr;
+        const TransformComponent* transform = nullptr;
+        float radius = 0.0f;
+    };
+
+    // camera at the edge of the world looking along +z
+    Math::Frustum MakeFrustum(const Math::Vector3& eye)
+    {
+        const float d = 1.0f / tanf(0.5f);
+        const float zn = 0.1f;
+        const float zf = 300.0f;
+        const float q = zf / (zf - zn);
+        const Math::Matrix4 projection(
+            d, 0.0f, 0.0f, 0.0f,
+            0.0f, d, 0.0f, 0.0f,
+            0.0f, 0.0f, q, 1.0f,
+            0.0f, 0.0f, -zn * q, 0.0f);
+        return Math::Frustum::FromMatrix(Math::Matrix4::Translation(-eye) * projection);
+    }
+
+    bool SameObjects(const GameWorld& world, const std::vector<GameObjectHandle>& handles, std::vector<const GameObject*> expected)
+    {
+        std::vector<const GameObject*> found;
+        for (const GameObjectHandle& handle : handles)
+        {
+            found.push_back(world.GetGameObject(handle));
+        }
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        return found == expected;
+    }
+
+    bool RunPartition(const char* name, SpatialService::Partition partition, float cellSize, uint32_t levelCount, uint32_t count, int frames)
+    {
+        GameWorld world;
+        SpatialService* spatialService = world.AddService<SpatialService>();
+        spatialService->SetPartition(partition, cellSize, levelCount);
+        world.Initialize(count);
+
+        // mostly small props with a few large ones, the case a single cell size handles worst
+        Random random;
+        std::vector<BruteObject> objects(count);
+        std::vector<TransformComponent*> transforms(count);
+        rapidjson::Document document;
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            GameObject* gameObject = world.CreateGameObject("Prop");
+            TransformComponent* transform = gameObject->AddComponent<TransformComponent>();
+            transform->position = { random.Next(0.0f, WorldSize), random.Next(0.0f, WorldHeight), random.Next(0.0f, WorldSize) };
+            SpatialComponent* spatialComponent = gameObject->AddComponent<SpatialComponent>();
+            document.SetObject();
+            document.AddMember("Radius", (i % 100 == 0) ? random.Next(5.0f, 20.0f) : random.Next(0.25f, 1.0f), document.GetAllocator());
+            spatialComponent->Deserialize(document);
+            gameObject->Initialize();
+            objects[i] = { gameObject, transform, spatialComponent->GetRadius() };
+            transforms[i] = transform;
+        }
+        const double registerMs = GetElapsedMs(start);
+        world.Update(0.0f);
+
+        std::vector<Math::Vector3> centers(frames);
+        for (Math::Vector3& center : centers)
+        {
+            center = { random.Next(0.0f, WorldSize), random.Next(0.0f, WorldHeight), random.Next(0.0f, WorldSize) };
+        }
+
+        printf("spatial %s: %u objects, %u cells, %d queries per case\n", name, spatialService->GetObjectCount(), spatialService->GetCellCount(), frames);
+        bool allPassed = true;
+        bool radiusMatches = true;
+        bool boxMatches = true;
+        bool frustumMatches = true;
+        bool nearestMatches = true;
+        std::vector<GameObjectHandle> results;
+        std::vector<const GameObject*> expected;
+        for (int i = 0; i < std::min(frames, 20); ++i)
+        {
+            const Math::Vector3& center = centers[i];
+            const Math::AABB box = Math::AABB::FromCenter(center, { 30.0f, 10.0f, 15.0f });
+            const Math::Frustum frustum = MakeFrustum(center);
+
+            results.clear();
+            expected.clear();
+            spatialService->QueryRadius(center, 25.0f, results);
+            for (const BruteObject& object : objects)
+            {
+                if (Math::MagnitudeSqr(center - object.transform->GetWorldPosition()) <= Math::Sqr(25.0f + object.radius))
+                {
+                    expected.push_back(object.gameObject);
+                }
+            }
+            radiusMatches = radiusMatches && SameObjects(world, results, expected);
+
+            results.clear();
+            expected.clear();
+            spatialService->QueryAABB(box, results);
+            for (const BruteObject& object : objects)
+            {
+                if (box.IntersectsSphere(object.transform->GetWorldPosition(), object.radius))
+                {
+                    expected.push_back(object.gameObject);
+                }
+            }
+            boxMatches = boxMatches && SameObjects(world, results, expected);
+
+            results.clear();
+            expected.clear();
+            spatialService->QueryFrustum(frustum, results);
+            for (const BruteObject& object : objects)
+            {
+                if (frustum.IntersectsSphere(object.transform->GetWorldPosition(), object.radius))
+                {
+                    expected.push_back(object.gameObject);
+                }
+            }
+            frustumMatches = frustumMatches && SameObjects(world, results, expected);
+
+            results.clear();
+            spatialService->QueryNearest(center, 16, results);
+            std::vector<std::pair<float, const GameObject*>> sorted;
+            for (const BruteObject& object : objects)
+            {
+                sorted.emplace_back(Math::MagnitudeSqr(center - object.transform->GetWorldPosition()), object.gameObject);
+            }
+            std::partial_sort(sorted.begin(), sorted.begin() + 16, sorted.end());
+            bool inOrder = (results.size() == 16);
+            for (std::size_t r = 0; inOrder && r < results.size(); ++r)
+            {
+                inOrder = (world.GetGameObject(results[r]) == sorted[r].second);
+            }
+            nearestMatches = nearestMatches && inOrder;
+        }
+        PrintCheck("radius queries match brute force", radiusMatches, allPassed);
+        PrintCheck("box queries match brute force", boxMatches, allPassed);
+        PrintCheck("frustum queries match brute force", frustumMatches, allPassed);
+        PrintCheck("nearest 16 match brute force, in order", nearestMatches, allPassed);
+
+        // times the same queries through the service and through a loop over every object
+        std::size_t found = 0;
+        auto timeCase = [&](const char* caseName, auto&& query, auto&& bruteQuery)
+        {
+            start = BenchmarkClock::now();
+            for (const Math::Vector3& center : centers)
+            {
+                results.clear();
+                query(center);
+                found += results.size();
+            }
+            const double queryMs = GetElapsedMs(start);
+            start = BenchmarkClock::now();
+            for (const Math::Vector3& center : centers)
+            {
+                expected.clear();
+                bruteQuery(center);
+                found += expected.size();
+            }
+            const double bruteMs = GetElapsedMs(start);
+            printf("%-20s %14.4f %14.4f %10.1fx\n", caseName, queryMs / frames, bruteMs / frames, bruteMs / std::max(queryMs, 1e-6));
+        };
+
+        printf("%-20s %14s %14s %11s\n", "case", "ms/query", "brute ms", "speedup");
+        timeCase("radius 25",
+            [&](const Math::Vector3& center) { spatialService->QueryRadius(center, 25.0f, results); },
+            [&](const Math::Vector3& center)
+            {
+                for (const BruteObject& object : objects)
+                {
+                    if (Math::MagnitudeSqr(center - object.transform->GetWorldPosition()) <= Math::Sqr(25.0f + object.radius))
+                    {
+                        expected.push_back(object.gameObject);
+                    }
+                }
+            });
+        timeCase("box 60x20x30",
+            [&](const Math::Vector3& center) { spatialService->QueryAABB(Math::AABB::FromCenter(center, { 30.0f, 10.0f, 15.0f }), results); },
+            [&](const Math::Vector3& center)
+            {
+                const Math::AABB box = Math::AABB::FromCenter(center, { 30.0f, 10.0f, 15.0f });
+                for (const BruteObject& object : objects)
+                {
+                    if (box.IntersectsSphere(object.transform->GetWorldPosition(), object.radius))
+                    {
+                        expected.push_back(object.gameObject);
+                    }
+                }
+            });
+        timeCase("frustum 300",
+            [&](const Math::Vector3& center) { spatialService->QueryFrustum(MakeFrustum(center), results); },
+            [&](const Math::Vector3& center)
+            {
+                const Math::Frustum frustum = MakeFrustum(center);
+                for (const BruteObject& object : objects)
+                {
+                    if (frustum.IntersectsSphere(object.transform->GetWorldPosition(), object.radius))
+                    {
+                        expected.push_back(object.gameObject);
+                    }
+                }
+            });
+        std::vector<std::pair<float, const GameObject*>> sorted;
+        timeCase("nearest 16",
+            [&](const Math::Vector3& center) { spatialService->QueryNearest(center, 16, results); },
+            [&](const Math::Vector3& center)
+            {
+                sorted.clear();
+                for (const BruteObject& object : objects)
+                {
+                    sorted.emplace_back(Math::MagnitudeSqr(center - object.transform->GetWorldPosition()), object.gameObject);
+                }
+                std::partial_sort(sorted.begin(), sorted.begin() + 16, sorted.end());
+                for (int r = 0; r < 16; ++r)
+                {
+                    expected.push_back(sorted[r].second);
+                }
+            });
+
+        // queries are const, so the job system can run a batch of them at once against the same snapshot
+        JobSystem* jobSystem = JobSystem::Get();
+        std::atomic<std::size_t> parallelFound = 0;
+        std::size_t serialFound = 0;
+        start = BenchmarkClock::now();
+        for (const Math::Vector3& center : centers)
+        {
+            results.clear();
+            spatialService->QueryRadius(center, 25.0f, results);
+            serialFound += results.size();
+        }
+        const double serialMs = GetElapsedMs(start);
+        start = BenchmarkClock::now();
+        jobSystem->ParallelFor(centers.size(), 8, [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<GameObjectHandle> batchResults;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                batchResults.clear();
+                spatialService->QueryRadius(centers[i], 25.0f, batchResults);
+                parallelFound += batchResults.size();
+            }
+        });
+        const double parallelMs = GetElapsedMs(start);
+        printf("%-20s %14.4f %14.4f %10u threads\n", "radius 25 parallel", parallelMs / frames, serialMs / frames, jobSystem->GetActiveWorkerCount() + 1);
+
+        // moves 1% of the objects a little every frame, only the ones crossing a cell edge are touched
+        const uint32_t moveCount = std::max(count / 100, 1u);
+        uint32_t movedTotal = 0;
+        double updateMs = 0.0;
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            for (uint32_t m = 0; m < moveCount; ++m)
+            {
+                TransformComponent* transform = transforms[(m * 97 + frame * 13) % count];
+                transform->position.x += random.Next(-2.0f, 2.0f);
+                transform->position.z += random.Next(-2.0f, 2.0f);
+            }
+            // the world update refreshes the transform hierarchy after the services, the service sees the moves on the next update
+            world.Update(0.0f);
+            start = BenchmarkClock::now();
+            spatialService->Update(0.0f);
+            updateMs += GetElapsedMs(start);
+            movedTotal += spatialService->GetMovedCount();
+        }
+        printf("%-20s %14.4f %14s %11u changed cell\n", "update 1% moving", updateMs / frames, "", movedTotal);
+        printf("%-20s %14.4f\n", "register all", registerMs);
+
+        // the incremental update has to leave the cells exactly as a fresh insert would
+        results.clear();
+        expected.clear();
+        const Math::AABB everything(Math::Vector3(-100.0f), Math::Vector3(WorldSize + 100.0f));
+        spatialService->QueryAABB(everything, results);
+        for (const BruteObject& object : objects)
+        {
+            expected.push_back(object.gameObject);
+        }
+        bool afterMoveMatches = SameObjects(world, results, expected);
+        results.clear();
+        expected.clear();
+        spatialService->QueryRadius(centers[0], 25.0f, results);
+        for (const BruteObject& object : objects)
+        {
+            if (Math::MagnitudeSqr(centers[0] - object.transform->GetWorldPosition()) <= Math::Sqr(25.0f + object.radius))
+            {
+                expected.push_back(object.gameObject);
+            }
+        }
+        afterMoveMatches = afterMoveMatches && SameObjects(world, results, expected);
+        PrintCheck("queries still match after moving", afterMoveMatches, allPassed);
+        PrintCheck("parallel queries find what serial ones do", parallelFound == serialFound, allPassed);
+
+        // destroying half leaves the rest in place
+        for (uint32_t i = 0; i < count; i += 2)
+        {
+            world.DestroyGameObject(objects[i].gameObject->GetHandle());
+        }
+        world.Update(0.0f);
+        PrintCheck("destroyed objects leave the partition", spatialService->GetObjectCount() == count - ((count + 1) / 2), allPassed);
+        printf("%s (%zu found)\n", allPassed ? "all checks passed" : "SOME CHECKS FAILED", found);
+        world.Terminate();
+        return allPassed;
+    }
+}
+
+bool RunSpatialBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 100000;
+    bool allPassed = RunPartition("grid", SpatialService::Partition::Grid, 16.0f, 1, count, args.frames);
+    printf("\n");
+    allPassed = RunPartition("loose octree", SpatialService::Partition::LooseOctree, 64.0f, 3, count, args.frames) && allPassed;
+    return allPassed;
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // stands in for the VGP340 DynamicModelComponent, the same fields read from the same template
+    class GridModelComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::GridModel);
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            mAnimations.clear();
+            SaveUtil::ReadBool("CastShadow", mCastShadow, value);
+            SaveUtil::ReadString("FileName", mFileName, value);
+            SaveUtil::ReadStringArray("Animations", mAnimations, value);
+            SaveUtil::ReadFloat("DistanceThreshold", mDistanceThreshold, value);
+        }
+
+        bool Matches(const GridModelComponent& other) const
+        {
+            return mCastShadow == other.mCastShadow && mFileName == other.mFileName
+                && mAnimations == other.mAnimations && mDistanceThreshold == other.mDistanceThreshold;
+        }
+
+    private:
+        std::string mFileName;
+        std::vector<std::string> mAnimations;
+        float mDistanceThreshold = 0.0f;
+        bool mCastShadow = false;
+    };
+
+    REGISTER_COMPONENT(GridModelComponent);
+
+    void WriteTemplate(const std::filesystem::path& path)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, path.u8string().c_str(), "w");
+        fprintf(file,
+            "{\n"
+            "    \"Components\": {\n"
+            "        \"TransformComponent\": {\n"
+            "            \"Position\": [ 0.0, 0.0, 0.0 ],\n"
+            "            \"Rotation\": [ 0.0, 0.0, 0.0, 1.0 ],\n"
+            "            \"Scale\": [ 1.0, 1.0, 1.0 ]\n"
+            "        },\n"
+            "        \"GridModelComponent\": {\n"
+            "            \"CastShadow\": true,\n"
+            "            \"FileName\": \"Character01/Character01\",\n"
+            "            \"Animations\": [\n"
+            "                \"Character01/StandardWalk.animset\"\n"
+            "            ],\n"
+            "            \"DistanceThreshold\": 100.0\n"
+            "        }\n"
+            "    }\n"
+            "}\n");
+        fclose(file);
+    }
+
+    Math::Vector3 GridPosition(uint32_t index, uint32_t gridSize)
+    {
+        const float spacing = 20.0f;
+        const float half = gridSize / 2.0f;
+        return { ((index / gridSize) - half) * spacing, 0.0f, ((index % gridSize) - half) * spacing };
+    }
+
+    // what the VGP340 grid did before, one CreateGameObject and Initialize at a time
+    void SpawnSerial(GameWorld& world, const std::filesystem::path& templatePath, uint32_t count, uint32_t gridSize, std::vector<GameObjectHandle>* handles)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            GameObject* gameObject = world.CreateGameObject("GridObj" + std::to_string(i), templatePath);
+            gameObject->GetComponent<TransformComponent>()->position = GridPosition(i, gridSize);
+            gameObject->Initialize();
+            if (handles != nullptr)
+            {
+                handles->push_back(gameObject->GetHandle());
+            }
+        }
+    }
+
+    std::vector<GameObject*> SpawnBulk(GameWorld& world, const std::filesystem::path& templatePath, uint32_t count, uint32_t gridSize)
+    {
+        return world.CreateGameObjects(templatePath, count, [gridSize](GameObject& gameObject, uint32_t index)
+        {
+            std::string name = "GridObj" + std::to_string(index);
+            gameObject.SetName(name);
+            gameObject.GetComponent<TransformComponent>()->position = GridPosition(index, gridSize);
+        });
+    }
+
+    // a few objects made and destroyed first, so the free list is out of order and both ways have to follow it
+    void Churn(GameWorld& world)
+    {
+        std::vector<GameObjectHandle> made;
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            made.push_back(world.CreateGameObject("Churn")->GetHandle());
+        }
+        for (uint32_t i = 0; i < made.size(); i += 2)
+        {
+            world.DestroyGameObject(made[i]);
+        }
+        world.Update(0.0f);
+    }
+
+    bool WorldsMatch(GameWorld& expected, GameWorld& actual, const std::vector<GameObjectHandle>& handles)
+    {
+        for (const GameObjectHandle& handle : handles)
+        {
+            const GameObject* expectedObject = expected.GetGameObject(handle);
+            const GameObject* actualObject = actual.GetGameObject(handle);
+            if (actualObject == nullptr || actualObject->GetName() != expectedObject->GetName() || actualObject->GetId() == 0)
+            {
+                return false;
+            }
+            const Math::Vector3 offset = actualObject->GetComponent<TransformComponent>()->position - expectedObject->GetComponent<TransformComponent>()->position;
+            if (Math::MagnitudeSqr(offset) != 0.0f || !actualObject->GetComponent<GridModelComponent>()->Matches(*expectedObject->GetComponent<GridModelComponent>()))
+            {
+                return false;
+            }
+        }
+        return actual.GetGameObjectCount() == expected.GetGameObjectCount();
+    }
+}
+
+bool RunSpawnBenchmark(const BenchmarkArguments& args)
+{
+    // the VGP340 30x30 grid of dynamic models
+    const uint32_t count = (args.count > 0) ? args.count : 900;
+    const uint32_t gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    const int repeats = std::min(args.frames, 20);
+    const std::filesystem::path templatePath = std::filesystem::temp_directory_path() / "sabad_spawn_benchmark.json";
+    WriteTemplate(templatePath);
+    GameObjectFactory::PreloadTemplate(templatePath);
+    Core::JobSystem* jobSystem = Core::JobSystem::Get();
+    // more threads than cores only measures time slicing, those rows are skipped rather than reported as a speedup
+    const uint32_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t maxThreads = std::min(jobSystem->GetThreadCount(), coreCount);
+
+    printf("spawn: %u objects from one template, best of %d, %u threads on %u cores\n", count, repeats, maxThreads, coreCount);
+    printf("%-28s %12s %12s %10s\n", "case", "total ms", "us/object", "speedup");
+    double serialMs = std::numeric_limits<double>::max();
+    for (int r = 0; r < repeats; ++r)
+    {
+        GameWorld world;
+        world.Initialize(count);
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        SpawnSerial(world, templatePath, count, gridSize, nullptr);
+        serialMs = std::min(serialMs, GetElapsedMs(start));
+        world.Terminate();
+    }
+    printf("%-28s %12.3f %12.3f %10.2f\n", "CreateGameObject loop", serialMs, serialMs * 1000.0 / count, 1.0);
+
+    for (uint32_t threads : { 1u, 2u, 4u, 8u })
+    {
+        if (threads > maxThreads)
+        {
+            printf("%-28s %12s\n", ("CreateGameObjects " + std::to_string(threads)).c_str(), "skipped");
+            continue;
+        }
+        jobSystem->SetActiveWorkerCount(threads - 1);
+        double bulkMs = std::numeric_limits<double>::max();
+        for (int r = 0; r < repeats; ++r)
+        {
+            GameWorld world;
+            world.Initialize(count);
+            const BenchmarkClock::time_point start = BenchmarkClock::now();
+            SpawnBulk(world, templatePath, count, gridSize);
+            bulkMs = std::min(bulkMs, GetElapsedMs(start));
+            world.Terminate();
+        }
+        const std::string name = "CreateGameObjects " + std::to_string(threads) + " thread" + ((threads > 1) ? "s" : "");
+        printf("%-28s %12.3f %12.3f %10.2f\n", name.c_str(), bulkMs, bulkMs * 1000.0 / count, serialMs / bulkMs);
+    }
+    jobSystem->SetActiveWorkerCount(jobSystem->GetWorkerCount());
+
+    // both ways into a world with holes in its free list, on every thread
+    GameWorld reference;
+    reference.Initialize(count);
+    Churn(reference);
+    std::vector<GameObjectHandle> handles;
+    SpawnSerial(reference, templatePath, count, gridSize, &handles);
+    GameWorld bulk;
+    bulk.Initialize(count);
+    Churn(bulk);
+    const std::vector<GameObject*> gameObjects = SpawnBulk(bulk, templatePath, count, gridSize);
+    bool inOrder = gameObjects.size() == handles.size();
+    for (std::size_t i = 0; inOrder && i < gameObjects.size(); ++i)
+    {
+        inOrder = gameObjects[i]->GetHandle() == handles[i];
+    }
+    reference.Update(1.0f / 60.0f);
+    bulk.Update(1.0f / 60.0f);
+
+    bool allPassed = true;
+    PrintCheck("objects take the same slots in the same order", inOrder, allPassed);
+    PrintCheck("names, positions and template data match", WorldsMatch(reference, bulk, handles), allPassed);
+    PrintCheck("next new object takes the same slot", reference.CreateGameObject("New")->GetHandle() == bulk.CreateGameObject("New")->GetHandle(), allPassed);
+    printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+    bulk.Terminate();
+    reference.Terminate();
+
+    GameObjectFactory::InvalidateTemplates();
+    std::filesystem::remove(templatePath);
+    return allPassed;
+}
\ No newline at end of file
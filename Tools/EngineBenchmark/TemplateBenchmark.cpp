@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    // a custom component with a few fields, registered by name like the VGP projects do
+    class SpinComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(RegisteredComponentId::Spin);
+
+        void Deserialize(const rapidjson::Value& value) override
+        {
+            SaveUtil::ReadFloat("Speed", mSpeed, value);
+            SaveUtil::ReadVector3("Axis", mAxis, value);
+            SaveUtil::ReadString("Tag", mTag, value);
+        }
+
+        float GetSpeed() const { return mSpeed; }
+
+    private:
+        std::string mTag;
+        Math::Vector3 mAxis = Math::Vector3::YAxis;
+        float mSpeed = 0.0f;
+    };
+
+    REGISTER_COMPONENT(SpinComponent);
+
+    void WriteTemplate(const std::filesystem::path& path, float speed)
+    {
+        FILE* file = nullptr;
+        fopen_s(&file, path.u8string().c_str(), "w");
+        fprintf(file,
+            "{\n"
+            "    \"Components\": {\n"
+            "        \"TransformComponent\": {\n"
+            "            \"Position\": [ 1.0, 2.0, 3.0 ],\n"
+            "            \"Rotation\": [ 0.0, 0.0, 0.0, 1.0 ],\n"
+            "            \"Scale\": [ 1.0, 1.0, 1.0 ]\n"
+            "        },\n"
+            "        \"SpinComponent\": {\n"
+            "            \"Speed\": %f,\n"
+            "            \"Axis\": [ 0.0, 1.0, 0.0 ],\n"
+            "            \"Tag\": \"Spinner\"\n"
+            "        }\n"
+            "    }\n"
+            "}\n", speed);
+        fclose(file);
+    }
+
+    // creates count objects from the template, returns the ms it took
+    double CreateObjects(const std::filesystem::path& templatePath, uint32_t count, bool parseEveryMake)
+    {
+        GameWorld world;
+        world.Initialize(count);
+        const BenchmarkClock::time_point start = BenchmarkClock::now();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (parseEveryMake)
+            {
+                GameObjectFactory::InvalidateTemplates();
+            }
+            world.CreateGameObject("Spinner", templatePath);
+        }
+        const double ms = GetElapsedMs(start);
+        world.Terminate();
+        return ms;
+    }
+}
+
+bool RunTemplateBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 10000;
+    const std::filesystem::path templatePath = std::filesystem::temp_directory_path() / "sabad_template_benchmark.json";
+    WriteTemplate(templatePath, 1.0f);
+
+    printf("template: %u objects from one template\n", count);
+    printf("%-20s %12s %12s\n", "case", "total ms", "us/object");
+    const double parseMs = CreateObjects(templatePath, count, true);
+    printf("%-20s %12.3f %12.3f\n", "parse every make", parseMs, parseMs * 1000.0 / count);
+    GameObjectFactory::InvalidateTemplates();
+    const double cachedMs = CreateObjects(templatePath, count, false);
+    printf("%-20s %12.3f %12.3f\n", "cached template", cachedMs, cachedMs * 1000.0 / count);
+    printf("speedup %.1fx\n", parseMs / cachedMs);
+
+    // an edited template has to show up once the cache has looked at the file again
+    GameWorld world;
+    world.Initialize(2);
+    WriteTemplate(templatePath, 5.0f);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    const float reloadedSpeed = world.CreateGameObject("Edited", templatePath)->GetComponent<SpinComponent>()->GetSpeed();
+    bool allPassed = true;
+    PrintCheck("edited template is reloaded", reloadedSpeed == 5.0f, allPassed);
+    world.Terminate();
+
+    // threads that miss the cache at the same time each parse the file, but only the first one's template is kept
+    GameObjectFactory::InvalidateTemplates();
+    std::vector<std::shared_ptr<const GameObjectFactory::Template>> loaded(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < loaded.size(); ++i)
+    {
+        threads.emplace_back([&loaded, &templatePath, i]() { loaded[i] = GameObjectFactory::GetTemplate(templatePath); });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    const bool shared = std::all_of(loaded.begin(), loaded.end(), [&](const auto& objectTemplate) { return objectTemplate == loaded[0]; });
+    PrintCheck("threads loading at once share one template", shared && GameObjectFactory::GetTemplate(templatePath) == loaded[0], allPassed);
+
+    GameObjectFactory::InvalidateTemplates();
+    std::filesystem::remove(templatePath);
+    return allPassed;
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+
+namespace
+{
+    enum class BenchmarkComponentId
+    {
+        Pose = static_cast<int>(ComponentId::Count),
+        NaivePose
+    };
+
+    // near objects every frame, then every 2nd, 4th and 8th frame further out
+    TickLod MakeTickLod()
+    {
+        TickLod tickLod;
+        tickLod.bands[0] = { 50.0f, 1 };
+        tickLod.bands[1] = { 150.0f, 2 };
+        tickLod.bands[2] = { 400.0f, 4 };
+        tickLod.bandCount = 3;
+        tickLod.farInterval = 8;
+        return tickLod;
+    }
+
+    const TickLod sTickLod = MakeTickLod();
+
+    float BuildPose(std::array<Math::Matrix4, 32>& bones, float time)
+    {
+        Math::Matrix4 parent = Math::Matrix4::Identity;
+        for (Math::Matrix4& bone : bones)
+        {
+            bone = Math::Matrix4::RotationY(time) * Math::Matrix4::Translation({ 0.0f, 0.1f, 0.0f }) * parent;
+            parent = bone;
+        }
+        return bones.back()._42;
+    }
+
+    // a stand in for an animator, builds a chain of bone matrices from the time it was given
+    class PoseComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::Pose);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::Pose, UpdateThreading::PerObject);
+
+        void Update(float deltaTime) override
+        {
+            mTime += deltaTime;
+            ++mTickCount;
+            BuildPose(mBones, mTime);
+        }
+
+        float GetTime() const { return mTime; }
+        uint32_t GetTickCount() const { return mTickCount; }
+
+    private:
+        std::array<Math::Matrix4, 32> mBones;
+        float mTime = 0.0f;
+        uint32_t mTickCount = 0;
+    };
+
+    // the same lod done inside Update against a shared frame count, every object on an interval runs on the same frame
+    class NaivePoseComponent final : public Component
+    {
+    public:
+        SET_TYPE_ID(BenchmarkComponentId::NaivePose);
+        SET_UPDATE_ACCESS(UpdateData::None, UpdateData::Pose, UpdateThreading::PerObject);
+
+        void Initialize() override
+        {
+            mTransform = GetOwner().GetComponent<TransformComponent>();
+        }
+
+        void Update(float deltaTime) override
+        {
+            mTime += deltaTime;
+            const uint32_t interval = sTickLod.GetInterval(mTransform->GetWorldPosition(), GetOwner().GetWorld().GetTickView());
+            if (sFrame % interval == 0)
+            {
+                BuildPose(mBones, mTime);
+            }
+        }
+
+        static uint32_t sFrame;
+
+    private:
+        const TransformComponent* mTransform = nullptr;
+        std::array<Math::Matrix4, 32> mBones;
+        float mTime = 0.0f;
+    };
+
+    uint32_t NaivePoseComponent::sFrame = 0;
+
+    struct FrameStats
+    {
+        double averageMs = 0.0;
+        double maxMs = 0.0;
+        uint32_t minTicks = UINT32_MAX;    // PoseComponent updates in a frame
+        uint32_t maxTicks = 0;
+        bool timeKept = true;           // every pose got all the time that passed, give or take what it is still owed
+    };
+
+    // count objects along a line out to 1000 units from the tick view, setup picks each component's rate
+    template<class ComponentType, class Setup>
+    FrameStats RunCase(uint32_t count, int frames, Setup&& setup)
+    {
+        const float deltaTime = 1.0f / 60.0f;
+        GameWorld world;
+        world.Initialize(count);
+        std::vector<ComponentType*> components;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            GameObject* gameObject = world.CreateGameObject("Character");
+            TransformComponent* transform = gameObject->AddComponent<TransformComponent>();
+            transform->position = { (static_cast<float>(i) + 0.5f) * 1000.0f / count, 0.0f, 0.0f };
+            ComponentType* component = gameObject->AddComponent<ComponentType>();
+            setup(*component);
+            gameObject->Initialize();
+            components.push_back(component);
+        }
+        world.SetTickView({});
+        world.Update(deltaTime);
+
+        FrameStats stats;
+        uint32_t lastTicks = 0;
+        auto countTicks = [&]()
+        {
+            uint32_t ticks = 0;
+            if constexpr (std::is_same_v<ComponentType, PoseComponent>)
+            {
+                for (const PoseComponent* component : components)
+                {
+                    ticks += component->GetTickCount();
+                }
+            }
+            return ticks;
+        };
+        lastTicks = countTicks();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            ++NaivePoseComponent::sFrame;
+            const BenchmarkClock::time_point start = BenchmarkClock::now();
+            world.Update(deltaTime);
+            const double frameMs = GetElapsedMs(start);
+            stats.averageMs += frameMs;
+            stats.maxMs = std::max(stats.maxMs, frameMs);
+
+            const uint32_t ticks = countTicks();
+            stats.minTicks = std::min(stats.minTicks, ticks - lastTicks);
+            stats.maxTicks = std::max(stats.maxTicks, ticks - lastTicks);
+            lastTicks = ticks;
+        }
+        stats.averageMs /= frames;
+
+        if constexpr (std::is_same_v<ComponentType, PoseComponent>)
+        {
+            const float totalTime = (frames + 1) * deltaTime;
+            for (const PoseComponent* component : components)
+            {
+                const float owed = totalTime - component->GetTime();
+                stats.timeKept = stats.timeKept && owed > -0.001f && owed < (sTickLod.farInterval * deltaTime) + 0.001f;
+            }
+        }
+        world.Terminate();
+        return stats;
+    }
+}
+
+bool RunTickBenchmark(const BenchmarkArguments& args)
+{
+    const uint32_t count = (args.count > 0) ? args.count : 4000;
+    const FrameStats everyFrame = RunCase<PoseComponent>(count, args.frames, [](PoseComponent&) {});
+    const FrameStats fixedQuarter = RunCase<PoseComponent>(count, args.frames, [](PoseComponent& component) { component.SetTickInterval(4); });
+    const FrameStats tickLod = RunCase<PoseComponent>(count, args.frames, [](PoseComponent& component) { component.SetTickLod(&sTickLod); });
+    const FrameStats naiveLod = RunCase<NaivePoseComponent>(count, args.frames, [](NaivePoseComponent&) {});
+
+    // what the bands should give, objects are evenly spread along the line
+    const float perUnit = count / 1000.0f;
+    const float expectedTicks = (50.0f * perUnit) + (100.0f * perUnit / 2.0f) + (250.0f * perUnit / 4.0f) + (600.0f * perUnit / 8.0f);
+
+    printf("tick: %u animated objects out to 1000 units, %d frames\n", count, args.frames);
+    bool allPassed = true;
+    PrintCheck("every frame runs every object", everyFrame.minTicks == count && everyFrame.maxTicks == count, allPassed);
+    PrintCheck("interval 4 runs a quarter each frame", fixedQuarter.minTicks >= count / 4 && fixedQuarter.maxTicks <= (count + 3) / 4, allPassed);
+    PrintCheck("lod frames stay within 2% of the average", tickLod.minTicks >= expectedTicks * 0.98f && tickLod.maxTicks <= expectedTicks * 1.02f, allPassed);
+    PrintCheck("skipped frames pass their time on", everyFrame.timeKept && fixedQuarter.timeKept && tickLod.timeKept, allPassed);
+    printf("%s\n", allPassed ? "all checks passed" : "SOME CHECKS FAILED");
+
+    printf("%-24s %12s %12s %16s\n", "case", "ms/frame", "worst ms", "updates/frame");
+    printf("%-24s %12.3f %12.3f %7u - %-7u\n", "every frame", everyFrame.averageMs, everyFrame.maxMs, everyFrame.minTicks, everyFrame.maxTicks);
+    printf("%-24s %12.3f %12.3f %7u - %-7u\n", "interval 4", fixedQuarter.averageMs, fixedQuarter.maxMs, fixedQuarter.minTicks, fixedQuarter.maxTicks);
+    printf("%-24s %12.3f %12.3f %7u - %-7u\n", "distance lod", tickLod.averageMs, tickLod.maxMs, tickLod.minTicks, tickLod.maxTicks);
+    printf("%-24s %12.3f %12.3f\n", "lod on one frame count", naiveLod.averageMs, naiveLod.maxMs);
+    return allPassed;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+
+namespace
+{
+    struct Benchmark
+    {
+        const char* name;
+        bool (*run)(const BenchmarkArguments& args);
+    };
+
+    const Benchmark sBenchmarks[] = {
+        { "ecs", RunEcsBenchmark },
+        { "lookup", RunLookupBenchmark },
+        { "scheduler", RunSchedulerBenchmark },
+        { "hierarchy", RunHierarchyBenchmark },
+        { "template", RunTemplateBenchmark },
+        { "level", RunLevelBenchmark },
+        { "registry", RunRegistryBenchmark },
+        { "slots", RunSlotBenchmark },
+        { "spatial", RunSpatialBenchmark },
+        { "tick", RunTickBenchmark },
+        { "idle", RunIdleBenchmark },
+        { "snapshot", RunSnapshotBenchmark },
+        { "spawn", RunSpawnBenchmark },
+        { "profiler", RunProfilerBenchmark },
+    };
+}
+
+void PrintUsage()
+{
+    printf("Usage: EngineBenchmark [options]\n");
+    printf("  -bench <name|all>   which benchmark to run (default all):");
+    for (const Benchmark& benchmark : sBenchmarks)
+    {
+        printf(" %s", benchmark.name);
+    }
+    printf("\n");
+    printf("  -count <n>          objects per benchmark (default depends on the benchmark)\n");
+    printf("  -frames <n>         timed frames or repeats (default 100)\n");
+    printf("  -threads <n>        job system threads including the main thread (default all)\n");
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkArguments args;
+    std::string benchName = "all";
+    uint32_t threads = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (strcmp(argv[i], "-bench") == 0 && hasValue)
+        {
+            benchName = argv[++i];
+        }
+        else if (strcmp(argv[i], "-count") == 0 && hasValue)
+        {
+            args.count = static_cast<uint32_t>(std::max(atoi(argv[++i]), 0));
+        }
+        else if (strcmp(argv[i], "-frames") == 0 && hasValue)
+        {
+            args.frames = std::max(atoi(argv[++i]), 1);
+        }
+        else if (strcmp(argv[i], "-threads") == 0 && hasValue)
+        {
+            threads = static_cast<uint32_t>(std::max(atoi(argv[++i]), 0));
+        }
+        else
+        {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    // headless, only the GameWorld, the job system and the event manager are used
+    // an explicit thread count makes that many threads even on smaller machines so scaling runs can be repeated anywhere
+    JobSystem::StaticInitialize((threads > 0) ? threads - 1 : 0);
+    EventManager::StaticInitialize();
+
+    bool found = false;
+    bool allPassed = true;
+    for (const Benchmark& benchmark : sBenchmarks)
+    {
+        if (benchName == "all" || benchName == benchmark.name)
+        {
+            allPassed = benchmark.run(args) && allPassed;
+            printf("\n");
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        printf("Unknown benchmark %s\n", benchName.c_str());
+        PrintUsage();
+    }
+
+    EventManager::StaticTerminate();
+    JobSystem::StaticTerminate();
+    // a failed check fails the run, so a script or CI job running the benchmarks sees it
+    if (!found)
+    {
+        return -1;
+    }
+    return allPassed ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include <SabadEngine/Inc/SabadEngine.h>
+
+using namespace SabadEngine;
+
+struct Arguments
+{
+    std::filesystem::path inputFileName;
+    std::filesystem::path outputFileName;
+};
+
+std::optional<Arguments> ParseArgs(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: LevelCooker <level json> [output file]\n");
+        printf("  the output defaults to the level name with the %s extension\n", CookedLevel::Extension);
+        printf("  run it from the game's working directory, template paths are read as the level writes them\n");
+        return std::nullopt;
+    }
+
+    Arguments args;
+    args.inputFileName = argv[1];
+    if (argc > 2)
+    {
+        args.outputFileName = argv[2];
+    }
+    else
+    {
+        args.outputFileName = args.inputFileName;
+        args.outputFileName.replace_extension(CookedLevel::Extension);
+    }
+    return args;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::optional<Arguments> argsOpt = ParseArgs(argc, argv);
+    if (!argsOpt.has_value())
+    {
+        return -1;
+    }
+
+    const Arguments& args = argsOpt.value();
+    printf("Cooking %s...\n", args.inputFileName.u8string().c_str());
+    if (!CookedLevel::Cook(args.inputFileName, args.outputFileName))
+    {
+        printf("Failed to cook %s\n", args.inputFileName.u8string().c_str());
+        return -1;
+    }
+
+    printf("Wrote %s, %ju bytes\n", args.outputFileName.u8string().c_str(), static_cast<uintmax_t>(std::filesystem::file_size(args.outputFileName)));
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,709 @@
+#include "BenchmarkScenes.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+    float RandomFloat(float min, float max)
+    {
+        const float t = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+        return min + ((max - min) * t);
+    }
+
+    // a square pyramid of boxes resting on a static ground box
+    class PyramidScene final : public BenchmarkScene
+    {
+    public:
+        void Initialize() override
+        {
+            mGroundShape.InitializeBox({ 50.0f, 0.5f, 50.0f });
+            mGroundTransform.position = { 0.0f, -0.5f, 0.0f };
+            mGroundBody.Initialize(mGroundTransform, mGroundShape);
+
+            uint32_t boxCount = 0;
+            for (uint32_t level = 0; level < BaseSize; ++level)
+            {
+                boxCount += (BaseSize - level) * (BaseSize - level);
+            }
+            mBoxShape.InitializeBox({ 0.5f, 0.5f, 0.5f });
+            mBoxTransforms.resize(boxCount);
+            mBoxBodies = std::vector<RigidBody>(boxCount);
+
+            uint32_t index = 0;
+            for (uint32_t level = 0; level < BaseSize; ++level)
+            {
+                const uint32_t rowSize = BaseSize - level;
+                const float offset = (static_cast<float>(rowSize) - 1.0f) * Spacing * 0.5f;
+                for (uint32_t z = 0; z < rowSize; ++z)
+                {
+                    for (uint32_t x = 0; x < rowSize; ++x)
+                    {
+                        Graphics::Transform& transform = mBoxTransforms[index];
+                        transform.position = { (x * Spacing) - offset, 0.5f + (level * 1.0f), (z * Spacing) - offset };
+                        mBoxBodies[index].Initialize(transform, mBoxShape, 1.0f);
+                        ++index;
+                    }
+                }
+            }
+        }
+
+        void Terminate() override
+        {
+            for (RigidBody& body : mBoxBodies)
+            {
+                body.Terminate();
+            }
+            mBoxBodies.clear();
+            mBoxTransforms.clear();
+            mBoxShape.Terminate();
+            mGroundBody.Terminate();
+            mGroundShape.Terminate();
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return static_cast<uint32_t>(mBoxBodies.size());
+        }
+
+    private:
+        static constexpr uint32_t BaseSize = 12;
+        static constexpr float Spacing = 1.01f;
+
+        CollisionShape mGroundShape;
+        Graphics::Transform mGroundTransform;
+        RigidBody mGroundBody;
+
+        CollisionShape mBoxShape;
+        std::vector<Graphics::Transform> mBoxTransforms;
+        std::vector<RigidBody> mBoxBodies;
+    };
+
+    // spheres falling onto the hull ground from 17_HelloPhysics, anything that falls off the edge rains again from the top
+    class SphereRainScene final : public BenchmarkScene
+    {
+    public:
+        void Initialize() override
+        {
+            mGroundShape.InitializeHull({ 5.0f, 0.5f, 5.0f }, { 0.0f, -0.5f, 0.0f });
+            mGroundBody.Initialize(mGroundTransform, mGroundShape);
+
+            mSphereShape.InitializeSphere(0.25f);
+            mSphereTransforms.resize(SphereCount);
+            mSphereBodies = std::vector<RigidBody>(SphereCount);
+            for (uint32_t i = 0; i < SphereCount; ++i)
+            {
+                mSphereTransforms[i].position = { RandomFloat(-6.0f, 6.0f), 2.0f + (i * 0.05f), RandomFloat(-6.0f, 6.0f) };
+                mSphereBodies[i].Initialize(mSphereTransforms[i], mSphereShape, 1.0f);
+            }
+        }
+
+        void Terminate() override
+        {
+            for (RigidBody& body : mSphereBodies)
+            {
+                body.Terminate();
+            }
+            mSphereBodies.clear();
+            mSphereTransforms.clear();
+            mSphereShape.Terminate();
+            mGroundBody.Terminate();
+            mGroundShape.Terminate();
+        }
+
+        void Step(float timeStep) override
+        {
+            BenchmarkScene::Step(timeStep);
+            for (uint32_t i = 0; i < SphereCount; ++i)
+            {
+                if (mSphereTransforms[i].position.y < -5.0f)
+                {
+                    mSphereBodies[i].SetPosition({ RandomFloat(-6.0f, 6.0f), 25.0f, RandomFloat(-6.0f, 6.0f) });
+                    mSphereBodies[i].SetVelocity(Math::Vector3::Zero);
+                }
+            }
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return SphereCount;
+        }
+
+    private:
+        static constexpr uint32_t SphereCount = 1000;
+
+        CollisionShape mGroundShape;
+        Graphics::Transform mGroundTransform;
+        RigidBody mGroundBody;
+
+        CollisionShape mSphereShape;
+        std::vector<Graphics::Transform> mSphereTransforms;
+        std::vector<RigidBody> mSphereBodies;
+    };
+
+    // the 18_HelloParticle emitter turned up until all 1000 particles are alive
+    class ParticleEmitterScene final : public BenchmarkScene
+    {
+    public:
+        void Initialize() override
+        {
+            ParticleSystemInfo info;
+            info.maxParticles = MaxParticles;
+            info.particlesPerEmit = { 8, 12 };
+            info.delay = 0.0f;
+            info.lifeTime = FLT_MAX;
+            info.timeBetweenEmit = { 0.01f, 0.02f };
+            info.spawnAngle = { -30.0f, 30.0f };
+            info.spawnSpeed = { 1.0f, 3.0f };
+            info.particleLifeTime = { 1.0f, 2.0f };
+            info.spawnDirection = Math::Vector3::YAxis;
+            info.spawnPosition = Math::Vector3::Zero;
+            mParticleSystem.Initialize(info);
+        }
+
+        void Terminate() override
+        {
+            mParticleSystem.Terminate();
+        }
+
+        void Step(float timeStep) override
+        {
+            mParticleSystem.Update(timeStep);
+            BenchmarkScene::Step(timeStep);
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return MaxParticles;
+        }
+
+        bool IsRewindable() const override
+        {
+            return false;
+        }
+
+    private:
+        static constexpr int MaxParticles = 1000;
+
+        ParticleSystem mParticleSystem;
+    };
+
+    // a bullet soft body curtain pinned at its top corners, swinging onto a ground box
+    // matchXpbd builds the xpbdcloth scene instead, 128x128 with the same spacing and sphere, so the two can be compared
+    class SoftBodyClothScene final : public BenchmarkScene
+    {
+    public:
+        SoftBodyClothScene(bool matchXpbd)
+            : mMatchXpbd(matchXpbd)
+        {
+        }
+
+        void Initialize() override
+        {
+            mGroundShape.InitializeBox({ 10.0f, 0.5f, 10.0f });
+            mGroundTransform.position = { 0.0f, -0.5f, 0.0f };
+            mGroundBody.Initialize(mGroundTransform, mGroundShape);
+            if (mMatchXpbd)
+            {
+                mSphereShape.InitializeSphere(0.5f);
+                mSphereTransform.position = { 0.0f, 1.0f, 0.5f };
+                mSphereBody.Initialize(mSphereTransform, mSphereShape);
+            }
+
+            // a vertical plane tilted back so it falls and folds over the ground
+            const uint32_t size = mMatchXpbd ? 128 : 30;
+            mClothMesh = Graphics::MeshBuilder::CreatePlane(size, size, mMatchXpbd ? 0.025f : 0.1f, false);
+            for (Graphics::Vertex& vertex : mClothMesh.vertices)
+            {
+                vertex.position = { vertex.position.x, 3.0f + (vertex.position.y * 0.7f), vertex.position.y * 0.7f };
+            }
+            const uint32_t topLeft = size * (size + 1);
+            const uint32_t topRight = topLeft + size;
+            mCloth.Initialize(mClothMesh, 1.0f, { topLeft, topRight });
+        }
+
+        void Terminate() override
+        {
+            mCloth.Terminate();
+            mClothMesh = {};
+            if (mMatchXpbd)
+            {
+                mSphereBody.Terminate();
+                mSphereShape.Terminate();
+            }
+            mGroundBody.Terminate();
+            mGroundShape.Terminate();
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return static_cast<uint32_t>(mClothMesh.vertices.size());
+        }
+
+        bool IsRewindable() const override
+        {
+            return false;
+        }
+
+    private:
+        bool mMatchXpbd = false;
+        CollisionShape mGroundShape;
+        Graphics::Transform mGroundTransform;
+        RigidBody mGroundBody;
+        CollisionShape mSphereShape;
+        Graphics::Transform mSphereTransform;
+        RigidBody mSphereBody;
+
+        Graphics::Mesh mClothMesh;
+        SoftBody mCloth;
+    };
+
+    // the same curtain in the XPBD Cloth at 128x128, folding over the ground and a sphere, cloth128 is its bullet twin
+    class XpbdClothScene final : public BenchmarkScene
+    {
+    public:
+        void Initialize() override
+        {
+            mClothMesh = Graphics::MeshBuilder::CreatePlane(Rows, Columns, 0.025f, false);
+            for (Graphics::Vertex& vertex : mClothMesh.vertices)
+            {
+                vertex.position = { vertex.position.x, 3.0f + (vertex.position.y * 0.7f), vertex.position.y * 0.7f };
+            }
+            const uint32_t topLeft = Rows * (Columns + 1);
+            const uint32_t topRight = topLeft + Columns;
+            mCloth.Initialize(mClothMesh, Rows, Columns, { topLeft, topRight });
+            mCloth.SetGroundHeight(0.0f);
+            mCloth.AddSphereCollider({ 0.0f, 1.0f, 0.5f }, 0.5f);
+        }
+
+        void Terminate() override
+        {
+            mCloth.Terminate();
+            mClothMesh = {};
+        }
+
+        void Step(float timeStep) override
+        {
+            mCloth.Update(timeStep);
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return mCloth.GetNodeCount();
+        }
+
+        bool IsRewindable() const override
+        {
+            return false;
+        }
+
+    private:
+        static constexpr uint32_t Rows = 128;
+        static constexpr uint32_t Columns = 128;
+
+        Graphics::Mesh mClothMesh;
+        Cloth mCloth;
+    };
+
+    // a dam break of about 9k particles in the Fluid solver
+    class FluidScene final : public BenchmarkScene
+    {
+    public:
+        void Initialize() override
+        {
+            FluidSettings settings;
+            settings.boundsMin = { -2.0f, 0.0f, -1.0f };
+            settings.boundsMax = { 2.0f, 4.0f, 1.0f };
+            mFluid.Initialize(ParticleCount, settings);
+            mFluid.AddBlock({ -2.0f, 0.0f, -1.0f }, { 0.0f, 2.5f, 1.0f });
+        }
+
+        void Terminate() override
+        {
+            mFluid.Terminate();
+        }
+
+        void Step(float timeStep) override
+        {
+            mFluid.Update(timeStep);
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return mFluid.GetParticleCount();
+        }
+
+        bool IsRewindable() const override
+        {
+            return false;
+        }
+
+    private:
+        static constexpr uint32_t ParticleCount = 10000;
+
+        Fluid mFluid;
+    };
+
+    // a 512x512 height map of rolling hills, written once to the temp directory so both terrain scenes load the same file
+    const std::filesystem::path& GetHeightMapPath()
+    {
+        static const std::filesystem::path heightMapPath = []()
+        {
+            constexpr uint32_t Dimensions = 512;
+            std::vector<uint8_t> samples(Dimensions * Dimensions);
+            for (uint32_t z = 0; z < Dimensions; ++z)
+            {
+                for (uint32_t x = 0; x < Dimensions; ++x)
+                {
+                    const float height = 127.5f + (70.0f * sinf(x * 0.02f) * cosf(z * 0.025f)) + (40.0f * sinf((x + z) * 0.07f));
+                    samples[x + (z * Dimensions)] = static_cast<uint8_t>(std::clamp(height, 0.0f, 255.0f));
+                }
+            }
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / "sabad_benchmark_heightmap.raw";
+            FILE* file = nullptr;
+            fopen_s(&file, path.u8string().c_str(), "wb");
+            fwrite(samples.data(), 1, samples.size(), file);
+            fclose(file);
+            return path;
+        }();
+        return heightMapPath;
+    }
+
+    // 400 spheres rolling over the height map and 1000 rays down onto it every step
+    // the same terrain as a heightfield or as a bvh triangle mesh, to compare the two
+    class TerrainScene final : public BenchmarkScene
+    {
+    public:
+        TerrainScene(bool triangleMesh)
+            : mTriangleMesh(triangleMesh)
+        {
+        }
+
+        void Initialize() override
+        {
+            if (mTriangleMesh)
+            {
+                Graphics::Terrain terrain;
+                terrain.Initialize(GetHeightMapPath(), HeightScale);
+                mTerrainShape.InitializeTriangleMesh(terrain.mesh);
+            }
+            else
+            {
+                mTerrainShape.InitializeHeightfield(GetHeightMapPath(), HeightScale);
+            }
+            mTerrainBody.Initialize(mTerrainTransform, mTerrainShape);
+
+            mSphereShape.InitializeSphere(0.5f);
+            mSphereTransforms.resize(SphereCount);
+            mSphereBodies = std::vector<RigidBody>(SphereCount);
+            for (uint32_t i = 0; i < SphereCount; ++i)
+            {
+                mSphereTransforms[i].position = { 56.0f + ((i % 20) * 20.0f), HeightScale + 2.0f, 56.0f + ((i / 20) * 20.0f) };
+                mSphereBodies[i].Initialize(mSphereTransforms[i], mSphereShape, 1.0f);
+            }
+
+            mRays.resize(RayCount);
+            mHits.resize(RayCount);
+            for (RayQuery& ray : mRays)
+            {
+                ray.from = { RandomFloat(0.0f, 511.0f), HeightScale + 5.0f, RandomFloat(0.0f, 511.0f) };
+                ray.to = { ray.from.x, -5.0f, ray.from.z };
+            }
+        }
+
+        void Terminate() override
+        {
+            for (RigidBody& body : mSphereBodies)
+            {
+                body.Terminate();
+            }
+            mSphereBodies.clear();
+            mSphereTransforms.clear();
+            mRays.clear();
+            mHits.clear();
+            mSphereShape.Terminate();
+            mTerrainBody.Terminate();
+            mTerrainShape.Terminate();
+        }
+
+        void Step(float timeStep) override
+        {
+            BenchmarkScene::Step(timeStep);
+            PhysicsWorld::Get()->RayCast(mRays.data(), mHits.data(), mRays.size());
+            for (uint32_t i = 0; i < SphereCount; ++i)
+            {
+                if (mSphereTransforms[i].position.y < -5.0f)
+                {
+                    mSphereBodies[i].SetPosition({ RandomFloat(56.0f, 456.0f), HeightScale + 2.0f, RandomFloat(56.0f, 456.0f) });
+                    mSphereBodies[i].SetVelocity(Math::Vector3::Zero);
+                }
+            }
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return SphereCount;
+        }
+
+    private:
+        static constexpr uint32_t SphereCount = 400;
+        static constexpr uint32_t RayCount = 1000;
+        static constexpr float HeightScale = 40.0f;
+
+        bool mTriangleMesh = false;
+        CollisionShape mTerrainShape;
+        Graphics::Transform mTerrainTransform;
+        RigidBody mTerrainBody;
+
+        CollisionShape mSphereShape;
+        std::vector<Graphics::Transform> mSphereTransforms;
+        std::vector<RigidBody> mSphereBodies;
+
+        std::vector<RayQuery> mRays;
+        std::vector<QueryHit> mHits;
+    };
+
+    // a batch of 10k rays every step against 5k static boxes and spheres, only the queries are timed
+    class RayCastScene final : public BenchmarkScene
+    {
+    public:
+        void Initialize() override
+        {
+            mBoxShape.InitializeBox({ 0.5f, 0.5f, 0.5f });
+            mSphereShape.InitializeSphere(0.5f);
+            mTransforms.resize(BodyCount);
+            mBodies = std::vector<RigidBody>(BodyCount);
+            for (uint32_t i = 0; i < BodyCount; ++i)
+            {
+                mTransforms[i].position = { RandomFloat(-100.0f, 100.0f), RandomFloat(0.0f, 20.0f), RandomFloat(-100.0f, 100.0f) };
+                mBodies[i].Initialize(mTransforms[i], (i % 2 == 0) ? mBoxShape : mSphereShape);
+            }
+
+            mRays.resize(RayCount);
+            mHits.resize(RayCount);
+            for (RayQuery& ray : mRays)
+            {
+                ray.from = { RandomFloat(-100.0f, 100.0f), RandomFloat(0.0f, 20.0f), RandomFloat(-100.0f, 100.0f) };
+                const Math::Vector3 direction = Math::Normalize({ RandomFloat(-1.0f, 1.0f), RandomFloat(-0.2f, 0.2f), RandomFloat(-1.0f, 1.0f) });
+                ray.to = ray.from + (direction * 50.0f);
+            }
+            // the bodies never move, one step puts them in the broadphase
+            PhysicsWorld::Get()->Update(1.0f / 60.0f);
+        }
+
+        void Terminate() override
+        {
+            for (RigidBody& body : mBodies)
+            {
+                body.Terminate();
+            }
+            mBodies.clear();
+            mTransforms.clear();
+            mRays.clear();
+            mHits.clear();
+            mSphereShape.Terminate();
+            mBoxShape.Terminate();
+        }
+
+        void Step(float timeStep) override
+        {
+            PhysicsWorld::Get()->RayCast(mRays.data(), mHits.data(), mRays.size());
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return BodyCount;
+        }
+
+    private:
+        static constexpr uint32_t BodyCount = 5000;
+        static constexpr uint32_t RayCount = 10000;
+
+        CollisionShape mBoxShape;
+        CollisionShape mSphereShape;
+        std::vector<Graphics::Transform> mTransforms;
+        std::vector<RigidBody> mBodies;
+
+        std::vector<RayQuery> mRays;
+        std::vector<QueryHit> mHits;
+    };
+
+    // projectiles fired every step, the oldest are taken away as new ones are fired so the same number stay alive
+    // the pool parks and unparks its bodies, the other way builds and tears down a RigidBody for every shot
+    class ProjectileChurnScene final : public BenchmarkScene
+    {
+    public:
+        ProjectileChurnScene(bool usePool)
+            : mUsePool(usePool)
+        {
+        }
+
+        void Initialize() override
+        {
+            mGroundShape.InitializeBox({ 100.0f, 0.5f, 100.0f });
+            mGroundTransform.position = { 0.0f, -0.5f, 0.0f };
+            mGroundBody.Initialize(mGroundTransform, mGroundShape);
+
+            mProjectileShape.InitializeSphere(0.2f);
+            if (mUsePool)
+            {
+                mPool.Initialize(mProjectileShape, 1.0f, Capacity);
+                mHandles.resize(LiveCount);
+            }
+            else
+            {
+                mTransforms.resize(LiveCount);
+                mBodies = std::vector<RigidBody>(LiveCount);
+            }
+            for (uint32_t i = 0; i < LiveCount; ++i)
+            {
+                Fire(i);
+            }
+            mOldest = 0;
+        }
+
+        void Terminate() override
+        {
+            if (mUsePool)
+            {
+                mPool.Terminate();
+                mHandles.clear();
+            }
+            else
+            {
+                for (RigidBody& body : mBodies)
+                {
+                    body.Terminate();
+                }
+                mBodies.clear();
+                mTransforms.clear();
+            }
+            mProjectileShape.Terminate();
+            mGroundBody.Terminate();
+            mGroundShape.Terminate();
+        }
+
+        void Step(float timeStep) override
+        {
+            for (uint32_t i = 0; i < ShotsPerStep; ++i)
+            {
+                if (mUsePool)
+                {
+                    mPool.Despawn(mHandles[mOldest]);
+                }
+                else
+                {
+                    mBodies[mOldest].Terminate();
+                }
+                Fire(mOldest);
+                mOldest = (mOldest + 1) % LiveCount;
+            }
+            BenchmarkScene::Step(timeStep);
+        }
+
+        uint32_t GetObjectCount() const override
+        {
+            return LiveCount;
+        }
+
+        // which bodies are alive is kept here, not in the world
+        bool IsRewindable() const override { return false; }
+
+    private:
+        static constexpr uint32_t LiveCount = 1000;
+        static constexpr uint32_t Capacity = 1200;
+        static constexpr uint32_t ShotsPerStep = 50;
+
+        void Fire(uint32_t index)
+        {
+            const Math::Vector3 position = { RandomFloat(-20.0f, 20.0f), 1.0f, RandomFloat(-20.0f, 20.0f) };
+            const Math::Vector3 velocity = { RandomFloat(-10.0f, 10.0f), RandomFloat(5.0f, 15.0f), RandomFloat(-10.0f, 10.0f) };
+            if (mUsePool)
+            {
+                mHandles[index] = mPool.Spawn(position, velocity);
+            }
+            else
+            {
+                mTransforms[index].position = position;
+                mBodies[index].Initialize(mTransforms[index], mProjectileShape, 1.0f);
+                mBodies[index].SetVelocity(velocity);
+            }
+        }
+
+        bool mUsePool = false;
+        CollisionShape mGroundShape;
+        Graphics::Transform mGroundTransform;
+        RigidBody mGroundBody;
+
+        CollisionShape mProjectileShape;
+        RigidBodyPool mPool;
+        std::vector<RigidBodyHandle> mHandles;
+        std::vector<Graphics::Transform> mTransforms;
+        std::vector<RigidBody> mBodies;
+        uint32_t mOldest = 0;
+    };
+}
+
+void BenchmarkScene::Step(float timeStep)
+{
+    PhysicsWorld::Get()->Update(timeStep);
+}
+
+std::unique_ptr<BenchmarkScene> CreateBenchmarkScene(const std::string& name)
+{
+    if (name == "pyramid")
+    {
+        return std::make_unique<PyramidScene>();
+    }
+    else if (name == "rain")
+    {
+        return std::make_unique<SphereRainScene>();
+    }
+    else if (name == "particles")
+    {
+        return std::make_unique<ParticleEmitterScene>();
+    }
+    else if (name == "cloth")
+    {
+        return std::make_unique<SoftBodyClothScene>(false);
+    }
+    else if (name == "cloth128")
+    {
+        return std::make_unique<SoftBodyClothScene>(true);
+    }
+    else if (name == "xpbdcloth")
+    {
+        return std::make_unique<XpbdClothScene>();
+    }
+    else if (name == "fluid")
+    {
+        return std::make_unique<FluidScene>();
+    }
+    else if (name == "raycast")
+    {
+        return std::make_unique<RayCastScene>();
+    }
+    else if (name == "heightfield")
+    {
+        return std::make_unique<TerrainScene>(false);
+    }
+    else if (name == "trimesh")
+    {
+        return std::make_unique<TerrainScene>(true);
+    }
+    else if (name == "poolchurn")
+    {
+        return std::make_unique<ProjectileChurnScene>(true);
+    }
+    else if (name == "bodychurn")
+    {
+        return std::make_unique<ProjectileChurnScene>(false);
+    }
+    return nullptr;
+}
+
+const std::vector<std::string>& GetBenchmarkSceneNames()
+{
+    static const std::vector<std::string> sceneNames = { "pyramid", "rain", "particles", "cloth", "cloth128", "xpbdcloth", "fluid", "raycast", "heightfield", "trimesh", "poolchurn", "bodychurn" };
+    return sceneNames;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Physics/Inc/Physics.h>
+
+// A fixed scene that is built, stepped a set number of times and torn down by the benchmark
+// everything a scene creates must be deterministic for a given rand() seed so runs can be compared across commits
+class BenchmarkScene
+{
+public:
+    virtual ~BenchmarkScene() = default;
+
+    virtual void Initialize() = 0;
+    virtual void Terminate() = 0;
+
+    // one fixed step, by default only the PhysicsWorld is stepped
+    virtual void Step(float timeStep);
+
+    virtual uint32_t GetObjectCount() const = 0;
+
+    // false when the scene keeps state of its own that a PhysicsWorld snapshot can't rewind
+    virtual bool IsRewindable() const { return true; }
+};
+
+// returns nullptr for an unknown name
+std::unique_ptr<BenchmarkScene> CreateBenchmarkScene(const std::string& name);
+const std::vector<std::string>& GetBenchmarkSceneNames();
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "Benchmarks.h"
+
+#include <psapi.h>
+
+#pragma comment(lib, "psapi.lib")
+
+using namespace SabadEngine::Core;
+
+std::size_t GetPrivateBytes()
+{
+    PROCESS_MEMORY_COUNTERS_EX counters = {};
+    GetProcessMemoryInfo(GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&counters), sizeof(counters));
+    return counters.PrivateUsage;
+}
+
+std::size_t GetPeakWorkingSetBytes()
+{
+    PROCESS_MEMORY_COUNTERS counters = {};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize;
+}
+
+std::vector<uint32_t> GetThreadCounts()
+{
+    std::vector<uint32_t> threadCounts;
+    const uint32_t maxThreads = JobSystem::Get()->GetThreadCount();
+    for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+    return threadCounts;
+}
+
+void PrintCheck(const char* name, bool passed, bool& allPassed)
+{
+    printf("  %-52s %s\n", name, passed ? "ok" : "FAILED");
+    allPassed = allPassed && passed;
+}
\ No newline at end of file
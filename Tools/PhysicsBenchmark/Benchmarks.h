@@ -0,0 +1,30 @@
+#pragma once
+
+#include "BenchmarkScenes.h"
+
+struct Arguments
+{
+    std::vector<std::string> scenes = GetBenchmarkSceneNames();
+    int steps = 600;                    // timed fixed steps per scene
+    int warmupSteps = 60;               // untimed steps so setup and the first contacts are not measured
+    uint32_t threads = 0;               // threads the job system may use, 0 is every hardware thread
+    unsigned int seed = 1;
+    SabadEngine::Physics::PhysicsWorld::Settings settings;
+    std::string label;                  // copied into the json, e.g. the commit being measured
+    std::filesystem::path jsonFileName;
+};
+
+using Clock = std::chrono::high_resolution_clock;
+
+std::size_t GetPrivateBytes();
+std::size_t GetPeakWorkingSetBytes();
+// 1, 2, 4 ... threads up to every thread the job system has
+std::vector<uint32_t> GetThreadCounts();
+void PrintCheck(const char* name, bool passed, bool& allPassed);
+
+// each mode prints its own table instead of the scene timings, and returns false if any of its checks failed
+bool RunFluidScaling(const Arguments& args);
+bool RunShapeCacheComparison(const Arguments& args);
+bool RunDeterminismCheck(const Arguments& args);
+bool RunTriggerCheck(const Arguments& args);
+bool RunPoolComparison(const Arguments& args);
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+    // steps the scene on from a snapshot, restores it and steps again, every checkpoint has to match the first run bit for bit
+    // scenes that pick random numbers are reseeded for both runs
+    bool RunSceneDeterminismCheck(const std::string& name, const Arguments& args)
+    {
+        constexpr int CheckpointInterval = 100;
+
+        // a threaded step adds new contacts in the order its threads finish, so only a single threaded one repeats exactly
+        PhysicsWorld::Settings settings = args.settings;
+        settings.threadCount = 1;
+        srand(args.seed);
+        PhysicsWorld::StaticInitialize(settings);
+        CollisionShapeCache::StaticInitialize();
+        PhysicsWorld* physicsWorld = PhysicsWorld::Get();
+        std::unique_ptr<BenchmarkScene> scene = CreateBenchmarkScene(name);
+        scene->Initialize();
+
+        const float timeStep = args.settings.fixedTimeStep;
+        for (int i = 0; i < args.warmupSteps; ++i)
+        {
+            scene->Step(timeStep);
+        }
+
+        PhysicsSnapshot start;
+        Clock::time_point timer = Clock::now();
+        physicsWorld->CaptureSnapshot(start, 0);
+        const double captureUs = std::chrono::duration<double, std::micro>(Clock::now() - timer).count();
+
+        auto simulate = [&](std::vector<PhysicsSnapshot>& checkpoints)
+        {
+            srand(args.seed + 1);
+            for (int i = 1; i <= args.steps; ++i)
+            {
+                scene->Step(timeStep);
+                if (i % CheckpointInterval == 0 || i == args.steps)
+                {
+                    physicsWorld->CaptureSnapshot(checkpoints.emplace_back(), static_cast<uint32_t>(i));
+                }
+            }
+        };
+
+        const bool canCheck = scene->IsRewindable() && start.GetBodyCount() > 0;
+        int divergedStep = 0;
+        double restoreUs = 0.0;
+        if (canCheck)
+        {
+            std::vector<PhysicsSnapshot> expected;
+            std::vector<PhysicsSnapshot> actual;
+            simulate(expected);
+            timer = Clock::now();
+            physicsWorld->RestoreSnapshot(start);
+            restoreUs = std::chrono::duration<double, std::micro>(Clock::now() - timer).count();
+            simulate(actual);
+            for (std::size_t i = 0; i < expected.size() && divergedStep == 0; ++i)
+            {
+                if (!expected[i].Matches(actual[i]))
+                {
+                    divergedStep = static_cast<int>(expected[i].GetFrame());
+                }
+            }
+        }
+
+        if (!canCheck)
+        {
+            printf("%-12s %8u %12s %12s %12s   skipped, %s\n", name.c_str(), start.GetBodyCount(), "-", "-", "-",
+                scene->IsRewindable() ? "no dynamic rigid bodies" : "keeps state outside the physics world");
+        }
+        else
+        {
+            printf("%-12s %8u %12zu %12.1f %12.1f   %s\n", name.c_str(), start.GetBodyCount(), start.GetSizeInBytes() / 1024,
+                captureUs, restoreUs, (divergedStep == 0) ? "ok" : ("diverged by step " + std::to_string(divergedStep)).c_str());
+        }
+
+        scene->Terminate();
+        scene.reset();
+        CollisionShapeCache::StaticTerminate();
+        PhysicsWorld::StaticTerminate();
+        return divergedStep == 0;
+    }
+}
+
+bool RunDeterminismCheck(const Arguments& args)
+{
+    bool allPassed = true;
+    printf("%-12s %8s %12s %12s %12s   %d steps\n", "scene", "bodies", "snapshot KB", "capture us", "restore us", args.steps);
+    for (const std::string& scene : args.scenes)
+    {
+        allPassed = RunSceneDeterminismCheck(scene, args) && allPassed;
+    }
+    printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+    return allPassed;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+using namespace SabadEngine::Physics;
+
+bool RunFluidScaling(const Arguments& args)
+{
+    // one sub step per Update so the numbers are the cost of a single sph step
+    const float timeStep = 1.0f / 240.0f;
+    PhysicsWorld::StaticInitialize(args.settings);
+    printf("%10s %8s %12s\n", "particles", "threads", "ms/step");
+    for (uint32_t particleCount : { 10000u, 25000u, 50000u, 100000u, 200000u })
+    {
+        for (uint32_t threads : GetThreadCounts())
+        {
+            JobSystem::Get()->SetActiveWorkerCount(threads - 1);
+
+            // a column of fluid 1.5 times taller than it is wide, collapsing in a box with room to spread
+            FluidSettings settings;
+            settings.subSteps = 1;
+            const float side = std::cbrt(static_cast<float>(particleCount)) * settings.particleSpacing;
+            settings.boundsMin = { -side, 0.0f, -side };
+            settings.boundsMax = { side, side * 3.0f, side };
+            Fluid fluid;
+            fluid.Initialize(particleCount, settings);
+            fluid.AddBlock({ -side * 0.5f, 0.0f, -side * 0.5f }, { side * 0.5f, side * 1.5f, side * 0.5f });
+
+            for (int i = 0; i < args.warmupSteps; ++i)
+            {
+                fluid.Update(timeStep);
+            }
+            const Clock::time_point start = Clock::now();
+            for (int i = 0; i < args.steps; ++i)
+            {
+                fluid.Update(timeStep);
+            }
+            const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            printf("%10u %8u %12.3f\n", fluid.GetParticleCount(), threads, milliseconds / args.steps);
+            fluid.Terminate();
+        }
+    }
+    PhysicsWorld::StaticTerminate();
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+    constexpr uint32_t ProjectileCount = 1000;
+    constexpr uint32_t ProjectileRowSize = 32;
+    constexpr uint32_t CrowdRowSize = 20;
+    constexpr uint32_t CrowdLayers = 16;
+
+    struct DespawnResult
+    {
+        double despawnMs = 0.0;
+        double spawnMs = 0.0;
+        uint32_t beginCount = 0;        // contacts the projectiles started with the floor
+        uint32_t endCount = 0;          // contacts that ended on the update after they were despawned
+        uint32_t laterEventCount = 0;   // events on the update after that, with every projectile gone
+        uint32_t respawnCount = 0;      // contacts that started again once they were spawned back
+    };
+
+    uint32_t CountEvents(ContactEventType type)
+    {
+        const std::vector<ContactEvent>& contactEvents = PhysicsWorld::Get()->GetContactEvents();
+        return static_cast<uint32_t>(std::count_if(contactEvents.begin(), contactEvents.end(), [type](const ContactEvent& contactEvent)
+        {
+            return contactEvent.type == type;
+        }));
+    }
+
+    Math::Vector3 GetProjectilePosition(uint32_t index)
+    {
+        // sunk a little into the floor, so every projectile starts touching it and is still touching after one step
+        const float x = (index % ProjectileRowSize) - ProjectileRowSize * 0.5f;
+        const float z = (index / ProjectileRowSize) - ProjectileRowSize * 0.5f;
+        return { x, -19.3f, z };
+    }
+
+    // a crowd of still spheres just apart gives the pair cache tens of thousands of pairs that never touch,
+    // then 1000 projectiles lying on a floor away from it are despawned and spawned again
+    DespawnResult RunDespawn(const Arguments& args, bool usePool)
+    {
+        PhysicsWorld::Settings settings = args.settings;
+        settings.gravity = Math::Vector3::Zero;
+        PhysicsWorld::StaticInitialize(settings);
+        PhysicsWorld* physicsWorld = PhysicsWorld::Get();
+        const float timeStep = settings.fixedTimeStep;
+
+        CollisionShape floorShape;
+        floorShape.InitializeBox({ 60.0f, 0.5f, 60.0f });
+        Graphics::Transform floorTransform;
+        floorTransform.position = { 0.0f, -20.0f, 0.0f };
+        RigidBody floorBody;
+        floorBody.Initialize(floorTransform, floorShape);
+
+        CollisionShape crowdShape;
+        crowdShape.InitializeSphere(0.5f);
+        const uint32_t crowdCount = CrowdRowSize * CrowdRowSize * CrowdLayers;
+        std::vector<Graphics::Transform> crowdTransforms(crowdCount);
+        std::vector<RigidBody> crowd(crowdCount);
+        for (uint32_t i = 0; i < crowdCount; ++i)
+        {
+            const uint32_t layerIndex = i % (CrowdRowSize * CrowdRowSize);
+            crowdTransforms[i].position = Math::Vector3(layerIndex % CrowdRowSize, i / (CrowdRowSize * CrowdRowSize), layerIndex / CrowdRowSize) * 1.04f;
+            crowd[i].Initialize(crowdTransforms[i], crowdShape, 1.0f);
+        }
+
+        CollisionShape projectileShape;
+        projectileShape.InitializeSphere(0.25f);
+        RigidBodyPool pool;
+        std::vector<RigidBodyHandle> handles(ProjectileCount);
+        std::vector<Graphics::Transform> transforms(ProjectileCount);
+        std::vector<RigidBody> bodies(ProjectileCount);
+        auto spawnAll = [&]()
+        {
+            for (uint32_t i = 0; i < ProjectileCount; ++i)
+            {
+                if (usePool)
+                {
+                    handles[i] = pool.Spawn(GetProjectilePosition(i));
+                }
+                else
+                {
+                    transforms[i].position = GetProjectilePosition(i);
+                    bodies[i].Initialize(transforms[i], projectileShape, 1.0f);
+                }
+            }
+        };
+        if (usePool)
+        {
+            pool.Initialize(projectileShape, 1.0f, ProjectileCount);
+        }
+        spawnAll();
+
+        DespawnResult result;
+        physicsWorld->Update(timeStep);
+        result.beginCount = CountEvents(ContactEventType::ContactBegin);
+
+        Clock::time_point start = Clock::now();
+        for (uint32_t i = 0; i < ProjectileCount; ++i)
+        {
+            if (usePool)
+            {
+                pool.Despawn(handles[i]);
+            }
+            else
+            {
+                bodies[i].Terminate();
+            }
+        }
+        result.despawnMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        physicsWorld->Update(timeStep);
+        // every event has to be an end, the floor and the crowd did not change
+        const uint32_t eventCount = static_cast<uint32_t>(physicsWorld->GetContactEvents().size());
+        result.endCount = (CountEvents(ContactEventType::ContactEnd) == eventCount) ? eventCount : 0;
+        physicsWorld->Update(timeStep);
+        result.laterEventCount = static_cast<uint32_t>(physicsWorld->GetContactEvents().size());
+
+        start = Clock::now();
+        spawnAll();
+        result.spawnMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        physicsWorld->Update(timeStep);
+        result.respawnCount = CountEvents(ContactEventType::ContactBegin);
+
+        if (usePool)
+        {
+            pool.Terminate();
+        }
+        for (RigidBody& body : bodies)
+        {
+            body.Terminate();
+        }
+        for (RigidBody& body : crowd)
+        {
+            body.Terminate();
+        }
+        floorBody.Terminate();
+        projectileShape.Terminate();
+        crowdShape.Terminate();
+        floorShape.Terminate();
+        PhysicsWorld::StaticTerminate();
+        return result;
+    }
+}
+
+// despawning a pooled body only changes its filter, removing a body has bullet search every pair in the world for its own
+bool RunPoolComparison(const Arguments& args)
+{
+    printf("despawning and spawning %u projectiles next to %u bodies that never touch\n", ProjectileCount, CrowdRowSize * CrowdRowSize * CrowdLayers);
+    printf("%-10s %12s %12s\n", "bodies", "despawn ms", "spawn ms");
+    DespawnResult results[2];
+    for (const bool usePool : { false, true })
+    {
+        DespawnResult& result = results[usePool ? 1 : 0];
+        result = RunDespawn(args, usePool);
+        printf("%-10s %12.3f %12.3f\n", usePool ? "pooled" : "removed", result.despawnMs, result.spawnMs);
+    }
+
+    bool allPassed = true;
+    for (const DespawnResult& result : results)
+    {
+        PrintCheck("projectiles start touching the floor", result.beginCount == ProjectileCount, allPassed);
+        PrintCheck("despawned projectiles end every contact", result.endCount == ProjectileCount, allPassed);
+        PrintCheck("despawned projectiles stay out of contact", result.laterEventCount == 0, allPassed);
+        PrintCheck("spawned projectiles touch the floor again", result.respawnCount == ProjectileCount, allPassed);
+    }
+    PrintCheck("despawning from the pool beats removing bodies", results[1].despawnMs < results[0].despawnMs, allPassed);
+    printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+    return allPassed;
+}
\ No newline at end of file
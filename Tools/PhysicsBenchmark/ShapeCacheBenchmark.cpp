@@ -0,0 +1,100 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+    struct ShapeCacheResult
+    {
+        std::size_t shapeCount = 0;
+        std::size_t memoryBytes = 0;        // private bytes the shapes and bodies added
+        double setupMs = 0.0;               // making the shapes and adding the bodies to the world
+        double firstStepMs = 0.0;           // the first step, where the broadphase finds every pair
+    };
+
+    // the level of identical crates the shape cache was made for, every crate is the same hull
+    ShapeCacheResult RunCrateLevel(const Arguments& args, bool useCache)
+    {
+        constexpr uint32_t CrateCount = 2000;
+        constexpr uint32_t RowSize = 50;
+        const Math::Vector3 halfExtents = { 0.5f, 0.5f, 0.5f };
+
+        PhysicsWorld::StaticInitialize(args.settings);
+        CollisionShapeCache::StaticInitialize();
+        CollisionShapeCache* shapeCache = CollisionShapeCache::Get();
+
+        CollisionShape groundShape;
+        groundShape.InitializeBox({ 50.0f, 0.5f, 50.0f });
+        Graphics::Transform groundTransform;
+        groundTransform.position = { 25.0f, -0.5f, 25.0f };
+        RigidBody groundBody;
+        groundBody.Initialize(groundTransform, groundShape);
+
+        ShapeCacheResult result;
+        std::vector<Graphics::Transform> transforms(CrateCount);
+        std::vector<RigidBody> bodies(CrateCount);
+        std::vector<CollisionShape> ownShapes(useCache ? 0 : CrateCount);
+        std::vector<CollisionShapeId> shapeIds;
+        shapeIds.reserve(CrateCount);
+
+        const std::size_t memoryBefore = GetPrivateBytes();
+        const Clock::time_point setupStart = Clock::now();
+        for (uint32_t i = 0; i < CrateCount; ++i)
+        {
+            // packed side by side on the ground so the broadphase has every neighbour pair to find
+            transforms[i].position = { (i % RowSize) * 1.0f, 0.5f, (i / RowSize) * 1.0f };
+            const CollisionShape* shape = nullptr;
+            if (useCache)
+            {
+                shapeIds.push_back(shapeCache->AcquireHull(halfExtents, Math::Vector3::Zero));
+                shape = shapeCache->GetShape(shapeIds.back());
+            }
+            else
+            {
+                ownShapes[i].InitializeHull(halfExtents, Math::Vector3::Zero);
+                shape = &ownShapes[i];
+            }
+            bodies[i].Initialize(transforms[i], *shape, 1.0f);
+        }
+        result.setupMs = std::chrono::duration<double, std::milli>(Clock::now() - setupStart).count();
+        const std::size_t memoryAfter = GetPrivateBytes();
+        result.memoryBytes = (memoryAfter > memoryBefore) ? memoryAfter - memoryBefore : 0;
+        result.shapeCount = useCache ? shapeCache->GetShapeCount() : ownShapes.size();
+
+        const Clock::time_point stepStart = Clock::now();
+        PhysicsWorld::Get()->Update(args.settings.fixedTimeStep);
+        result.firstStepMs = std::chrono::duration<double, std::milli>(Clock::now() - stepStart).count();
+
+        for (RigidBody& body : bodies)
+        {
+            body.Terminate();
+        }
+        for (CollisionShape& shape : ownShapes)
+        {
+            shape.Terminate();
+        }
+        for (CollisionShapeId id : shapeIds)
+        {
+            shapeCache->Release(id);
+        }
+        groundBody.Terminate();
+        groundShape.Terminate();
+        CollisionShapeCache::StaticTerminate();
+        PhysicsWorld::StaticTerminate();
+        return result;
+    }
+}
+
+bool RunShapeCacheComparison(const Arguments& args)
+{
+    printf("%-16s %8s %12s %12s %14s\n", "crates", "shapes", "memory KB", "setup ms", "first step ms");
+    for (bool useCache : { false, true })
+    {
+        const ShapeCacheResult result = RunCrateLevel(args, useCache);
+        printf("%-16s %8zu %12zu %12.3f %14.3f\n", useCache ? "shape cache" : "shape per crate", result.shapeCount,
+            result.memoryBytes / 1024, result.setupMs, result.firstStepMs);
+    }
+    return true;
+}
\ No newline at end of file
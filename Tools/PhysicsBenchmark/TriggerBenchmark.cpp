@@ -0,0 +1,116 @@
+#include "Benchmarks.h"
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+    // counts the events of one type, and how many of them name an object from the set as objectA or objectB
+    uint32_t CountEvents(ContactEventType type, const std::vector<PhysicsObject*>& objects, bool asObjectB, uint32_t& inSet)
+    {
+        inSet = 0;
+        uint32_t count = 0;
+        for (const ContactEvent& contactEvent : PhysicsWorld::Get()->GetContactEvents())
+        {
+            if (contactEvent.type == type)
+            {
+                ++count;
+                PhysicsObject* object = asObjectB ? contactEvent.objectB : contactEvent.objectA;
+                inSet += (std::find(objects.begin(), objects.end(), object) != objects.end()) ? 1 : 0;
+            }
+        }
+        return count;
+    }
+}
+
+// every body starts inside its own trigger, then half the triggers and the bodies of the other half are removed
+// each pair has to end with exactly one TriggerExit, reported on the next update and never again
+bool RunTriggerCheck(const Arguments& args)
+{
+    constexpr uint32_t TriggerCount = 1000;
+    constexpr uint32_t RowSize = 40;
+
+    PhysicsWorld::Settings settings = args.settings;
+    settings.gravity = Math::Vector3::Zero;
+    PhysicsWorld::StaticInitialize(settings);
+    PhysicsWorld* physicsWorld = PhysicsWorld::Get();
+    const float timeStep = settings.fixedTimeStep;
+
+    CollisionShape triggerShape;
+    triggerShape.InitializeBox({ 1.0f, 1.0f, 1.0f });
+    CollisionShape bodyShape;
+    bodyShape.InitializeSphere(0.25f);
+    std::vector<Graphics::Transform> transforms(TriggerCount);
+    std::vector<TriggerVolume> triggers(TriggerCount);
+    std::vector<RigidBody> bodies(TriggerCount);
+    for (uint32_t i = 0; i < TriggerCount; ++i)
+    {
+        transforms[i].position = { (i % RowSize) * 4.0f, 0.0f, (i / RowSize) * 4.0f };
+        triggers[i].Initialize(transforms[i], triggerShape);
+        bodies[i].Initialize(transforms[i], bodyShape, 1.0f);
+    }
+
+    bool allPassed = true;
+    uint32_t inSet = 0;
+    physicsWorld->Update(timeStep);
+    PrintCheck("every body enters its trigger", CountEvents(ContactEventType::TriggerEnter, {}, true, inSet) == TriggerCount, allPassed);
+    // each trigger and its body were registered one after the other, so the events come in the order the bodies were made
+    const std::vector<ContactEvent>& enterEvents = physicsWorld->GetContactEvents();
+    bool inRegisterOrder = enterEvents.size() == TriggerCount;
+    for (uint32_t i = 0; i < TriggerCount && inRegisterOrder; ++i)
+    {
+        inRegisterOrder = enterEvents[i].objectA == &bodies[i] && enterEvents[i].objectB == &triggers[i];
+    }
+    PrintCheck("events are in the order objects were registered", inRegisterOrder, allPassed);
+
+    std::vector<PhysicsObject*> removedTriggers;
+    std::vector<PhysicsObject*> removedBodies;
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < TriggerCount; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            removedTriggers.push_back(&triggers[i]);
+            triggers[i].Terminate();
+        }
+        else
+        {
+            removedBodies.push_back(&bodies[i]);
+            bodies[i].Terminate();
+        }
+    }
+    const double removeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    PrintCheck("exits wait for the next update", physicsWorld->GetPendingContactEvents().size() == TriggerCount, allPassed);
+
+    physicsWorld->Update(timeStep);
+    uint32_t exitsOfTriggers = 0;
+    uint32_t exitsOfBodies = 0;
+    const uint32_t exitCount = CountEvents(ContactEventType::TriggerExit, removedTriggers, true, exitsOfTriggers);
+    CountEvents(ContactEventType::TriggerExit, removedBodies, false, exitsOfBodies);
+    PrintCheck("one exit for every removed pair", exitCount == TriggerCount, allPassed);
+    PrintCheck("removed triggers report their exits", exitsOfTriggers == TriggerCount / 2, allPassed);
+    PrintCheck("removed bodies report their exits", exitsOfBodies == TriggerCount / 2, allPassed);
+    PrintCheck("nothing else changed", physicsWorld->GetContactEvents().size() == TriggerCount, allPassed);
+
+    physicsWorld->Update(timeStep);
+    PrintCheck("no events once the pairs are gone", physicsWorld->GetContactEvents().empty(), allPassed);
+    printf("removing %u triggers and bodies took %.3f ms\n", TriggerCount, removeMs);
+    printf("%s\n", allPassed ? "all checks passed" : "CHECKS FAILED");
+
+    for (uint32_t i = 0; i < TriggerCount; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            bodies[i].Terminate();
+        }
+        else
+        {
+            triggers[i].Terminate();
+        }
+    }
+    bodyShape.Terminate();
+    triggerShape.Terminate();
+    PhysicsWorld::StaticTerminate();
+    return allPassed;
+}
\ No newline at end of file
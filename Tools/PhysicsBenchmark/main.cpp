@@ -0,0 +1,315 @@
+#include "Benchmarks.h"
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <cstdio>
+
+using namespace SabadEngine;
+using namespace SabadEngine::Core;
+using namespace SabadEngine::Physics;
+
+namespace
+{
+    // the modes that run instead of the scene timings, each lives in its own file
+    struct Mode
+    {
+        const char* flag;
+        bool (*run)(const Arguments& args);
+    };
+
+    const Mode sModes[] = {
+        { "-fluidScaling", RunFluidScaling },
+        { "-shapeCache", RunShapeCacheComparison },
+        { "-determinism", RunDeterminismCheck },
+        { "-triggers", RunTriggerCheck },
+        { "-pool", RunPoolComparison },
+    };
+}
+
+struct SceneResult
+{
+    std::string name;
+    uint32_t objectCount = 0;
+    double setupMs = 0.0;               // Initialize, building the shapes and adding everything to the world
+    double minMs = 0.0;
+    double medianMs = 0.0;
+    double p99Ms = 0.0;
+    double meanMs = 0.0;
+    double maxMs = 0.0;
+    std::size_t memoryBytes = 0;        // private bytes the scene added once it was warmed up
+    std::size_t peakWorkingSetBytes = 0;
+};
+
+void PrintUsage()
+{
+    printf("Usage: PhysicsBenchmark [options]\n");
+    printf("  -scene <name|all>           pyramid, rain, particles, cloth, cloth128, xpbdcloth, fluid,\n");
+    printf("                              raycast, heightfield, trimesh, poolchurn, bodychurn (default all)\n");
+    printf("  -steps <n>                  timed steps per scene (default 600)\n");
+    printf("  -warmup <n>                 untimed steps before timing (default 60)\n");
+    printf("  -threads <n>                job system threads including the main thread (default all)\n");
+    printf("  -physicsThreads <n>         job system threads a physics step may use (default 1)\n");
+    printf("  -broadphase <dbvt|axissweep>\n");
+    printf("  -iterations <n>             constraint solver iterations (default 10)\n");
+    printf("  -timestep <seconds>         fixed time step (default 1/60)\n");
+    printf("  -seed <n>                   rand() seed for the scenes (default 1)\n");
+    printf("  -label <text>               stored in the json to tell runs apart\n");
+    printf("  -json <file>                also write the results as json\n");
+    printf("  -fluidScaling               time the fluid from 10k to 200k particles at each thread count instead\n");
+    printf("  -determinism                rewind each scene with a snapshot and check the re-simulation matches instead\n");
+    printf("  -shapeCache                 compare a 2000 crate level with a shape per crate against the CollisionShapeCache instead\n");
+    printf("  -triggers                   check 1000 triggers report an exit for every pair when they or their bodies are removed instead\n");
+    printf("  -pool                       time despawning 1000 pooled projectiles against removing 1000 bodies in a world with many pairs instead\n");
+}
+
+std::optional<Arguments> ParseArgs(int argc, char* argv[], const Mode*& mode)
+{
+    Arguments args;
+    mode = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = (i + 1 < argc);
+        auto modeIter = std::find_if(std::begin(sModes), std::end(sModes), [&](const Mode& m) { return strcmp(argv[i], m.flag) == 0; });
+        if (modeIter != std::end(sModes))
+        {
+            mode = &*modeIter;
+        }
+        else if (strcmp(argv[i], "-scene") == 0 && hasValue)
+        {
+            const std::string scene = argv[++i];
+            if (scene != "all")
+            {
+                args.scenes = { scene };
+            }
+        }
+        else if (strcmp(argv[i], "-steps") == 0 && hasValue)
+        {
+            args.steps = std::max(atoi(argv[++i]), 1);
+        }
+        else if (strcmp(argv[i], "-warmup") == 0 && hasValue)
+        {
+            args.warmupSteps = std::max(atoi(argv[++i]), 0);
+        }
+        else if (strcmp(argv[i], "-threads") == 0 && hasValue)
+        {
+            args.threads = static_cast<uint32_t>(std::max(atoi(argv[++i]), 0));
+        }
+        else if (strcmp(argv[i], "-physicsThreads") == 0 && hasValue)
+        {
+            args.settings.threadCount = static_cast<uint32_t>(std::max(atoi(argv[++i]), 1));
+        }
+        else if (strcmp(argv[i], "-broadphase") == 0 && hasValue)
+        {
+            const std::string broadphase = argv[++i];
+            if (broadphase == "dbvt")
+            {
+                args.settings.broadphase = PhysicsWorld::BroadphaseType::Dbvt;
+            }
+            else if (broadphase == "axissweep")
+            {
+                args.settings.broadphase = PhysicsWorld::BroadphaseType::AxisSweep;
+            }
+            else
+            {
+                printf("Unknown broadphase %s\n", broadphase.c_str());
+                return std::nullopt;
+            }
+        }
+        else if (strcmp(argv[i], "-iterations") == 0 && hasValue)
+        {
+            args.settings.solverIterations = static_cast<uint32_t>(std::max(atoi(argv[++i]), 1));
+        }
+        else if (strcmp(argv[i], "-timestep") == 0 && hasValue)
+        {
+            args.settings.fixedTimeStep = static_cast<float>(atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-seed") == 0 && hasValue)
+        {
+            args.seed = static_cast<unsigned int>(atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-label") == 0 && hasValue)
+        {
+            args.label = argv[++i];
+        }
+        else if (strcmp(argv[i], "-json") == 0 && hasValue)
+        {
+            args.jsonFileName = argv[++i];
+        }
+        else
+        {
+            PrintUsage();
+            return std::nullopt;
+        }
+    }
+
+    for (const std::string& scene : args.scenes)
+    {
+        if (CreateBenchmarkScene(scene) == nullptr)
+        {
+            printf("Unknown scene %s\n", scene.c_str());
+            return std::nullopt;
+        }
+    }
+    return args;
+}
+
+SceneResult RunScene(const std::string& name, const Arguments& args)
+{
+    // every scene gets a fresh world so nothing carries over from the previous one
+    srand(args.seed);
+    PhysicsWorld::StaticInitialize(args.settings);
+    CollisionShapeCache::StaticInitialize();
+
+    SceneResult result;
+    result.name = name;
+    const std::size_t memoryBefore = GetPrivateBytes();
+    std::unique_ptr<BenchmarkScene> scene = CreateBenchmarkScene(name);
+    const Clock::time_point setupStart = Clock::now();
+    scene->Initialize();
+    result.setupMs = std::chrono::duration<double, std::milli>(Clock::now() - setupStart).count();
+
+    const float timeStep = args.settings.fixedTimeStep;
+    for (int i = 0; i < args.warmupSteps; ++i)
+    {
+        scene->Step(timeStep);
+    }
+
+    std::vector<double> stepTimes(args.steps);
+    for (double& stepTime : stepTimes)
+    {
+        const Clock::time_point start = Clock::now();
+        scene->Step(timeStep);
+        stepTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    const std::size_t memoryAfter = GetPrivateBytes();
+    result.memoryBytes = (memoryAfter > memoryBefore) ? memoryAfter - memoryBefore : 0;
+    result.peakWorkingSetBytes = GetPeakWorkingSetBytes();
+    result.objectCount = scene->GetObjectCount();
+    scene->Terminate();
+    scene.reset();
+
+    CollisionShapeCache::StaticTerminate();
+    PhysicsWorld::StaticTerminate();
+
+    std::sort(stepTimes.begin(), stepTimes.end());
+    const std::size_t count = stepTimes.size();
+    const std::size_t p99Index = std::min(count - 1, static_cast<std::size_t>(std::ceil(count * 0.99)) - 1);
+    result.minMs = stepTimes.front();
+    result.medianMs = stepTimes[count / 2];
+    result.p99Ms = stepTimes[p99Index];
+    result.maxMs = stepTimes.back();
+    result.meanMs = std::accumulate(stepTimes.begin(), stepTimes.end(), 0.0) / count;
+    return result;
+}
+
+void WriteJson(const Arguments& args, const std::vector<SceneResult>& results)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("label");
+    writer.String(args.label.c_str());
+    writer.Key("settings");
+    writer.StartObject();
+    writer.Key("steps");
+    writer.Int(args.steps);
+    writer.Key("warmupSteps");
+    writer.Int(args.warmupSteps);
+    writer.Key("threads");
+    writer.Uint(JobSystem::Get()->GetActiveWorkerCount() + 1);
+    writer.Key("physicsThreads");
+    writer.Uint(args.settings.threadCount);
+    writer.Key("broadphase");
+    writer.String(args.settings.broadphase == PhysicsWorld::BroadphaseType::AxisSweep ? "axissweep" : "dbvt");
+    writer.Key("solverIterations");
+    writer.Uint(args.settings.solverIterations);
+    writer.Key("fixedTimeStep");
+    writer.Double(args.settings.fixedTimeStep);
+    writer.Key("seed");
+    writer.Uint(args.seed);
+    writer.EndObject();
+
+    writer.Key("scenes");
+    writer.StartArray();
+    for (const SceneResult& result : results)
+    {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(result.name.c_str());
+        writer.Key("objects");
+        writer.Uint(result.objectCount);
+        writer.Key("setupMs");
+        writer.Double(result.setupMs);
+        writer.Key("minMs");
+        writer.Double(result.minMs);
+        writer.Key("medianMs");
+        writer.Double(result.medianMs);
+        writer.Key("p99Ms");
+        writer.Double(result.p99Ms);
+        writer.Key("meanMs");
+        writer.Double(result.meanMs);
+        writer.Key("maxMs");
+        writer.Double(result.maxMs);
+        writer.Key("memoryBytes");
+        writer.Uint64(result.memoryBytes);
+        writer.Key("peakWorkingSetBytes");
+        writer.Uint64(result.peakWorkingSetBytes);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    FILE* file = nullptr;
+    auto err = fopen_s(&file, args.jsonFileName.string().c_str(), "w");
+    if (err != 0 || file == nullptr)
+    {
+        printf("Failed to open %s\n", args.jsonFileName.string().c_str());
+        return;
+    }
+    fputs(buffer.GetString(), file);
+    fclose(file);
+}
+
+int main(int argc, char* argv[])
+{
+    const Mode* mode = nullptr;
+    const std::optional<Arguments> args = ParseArgs(argc, argv, mode);
+    if (!args.has_value())
+    {
+        return -1;
+    }
+
+    // headless, nothing here touches the GraphicsSystem
+    JobSystem::StaticInitialize();
+    if (args->threads > 0)
+    {
+        JobSystem::Get()->SetActiveWorkerCount(args->threads - 1);
+    }
+
+    bool allPassed = true;
+    if (mode != nullptr)
+    {
+        allPassed = mode->run(*args);
+    }
+    else
+    {
+        std::vector<SceneResult> results;
+        printf("%-12s %8s %10s %10s %10s %10s %10s %12s\n", "scene", "objects", "setup ms", "min ms", "median ms", "p99 ms", "mean ms", "memory KB");
+        for (const std::string& scene : args->scenes)
+        {
+            const SceneResult& result = results.emplace_back(RunScene(scene, *args));
+            printf("%-12s %8u %10.3f %10.3f %10.3f %10.3f %10.3f %12zu\n", result.name.c_str(), result.objectCount,
+                result.setupMs, result.minMs, result.medianMs, result.p99Ms, result.meanMs, result.memoryBytes / 1024);
+        }
+        if (!args->jsonFileName.empty())
+        {
+            WriteJson(*args, results);
+        }
+    }
+
+    JobSystem::StaticTerminate();
+    // a failed check fails the run, so a script or CI job running the checks sees it
+    return allPassed ? 0 : 1;
+}
\ No newline at end of file
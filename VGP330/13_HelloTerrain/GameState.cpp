@@ -19,6 +19,15 @@ void GameState::Initialize()
     mGround.meshBuffer.Initialize(mTerrain.mesh);
     mGround.diffuseMapId = TextureManager::Get()->LoadTexture(L"../../Assets/Textures/terrain/dirt_seamless.jpg");
     mGround.specMapId = TextureManager::Get()->LoadTexture(L"../../Assets/Textures/terrain/grass_2048.jpg");
+    mTerrainShape.InitializeHeightfield(mTerrain);
+    mTerrainRigidBody.Initialize(mGround.transform, mTerrainShape);
+
+    Mesh sphere = MeshBuilder::CreateSphere(20, 20, 0.5f);
+    mSphere.meshBuffer.Initialize(sphere);
+    mSphere.diffuseMapId = TextureManager::Get()->LoadTexture(L"../../Assets/Textures/misc/basketball.jpg");
+    mSphere.transform.position = { 2.0f, 25.0f, 2.0f };
+    mSphereShape.InitializeSphere(0.5f);
+    mSphereRigidBody.Initialize(mSphere.transform, mSphereShape, 1.0f);
 
     mCharacter.Initialize("Character_01/Character_01.model");
     mCharacter.transform.position = { 0.0f, 0.0f, 0.0f };
@@ -62,6 +71,11 @@ void GameState::Terminate()
     mCharacter.Terminate();
     mCharacter2.Terminate();
     mCharacter3.Terminate();
+    mSphereRigidBody.Terminate();
+    mSphereShape.Terminate();
+    mSphere.Terminate();
+    mTerrainRigidBody.Terminate();
+    mTerrainShape.Terminate();
     mGround.Terminate();
     mStandardEffect.Terminate();
 }
@@ -77,6 +91,7 @@ void GameState::Render()
     mShadowEffect.Render(mCharacter);
     mShadowEffect.Render(mCharacter2);
     mShadowEffect.Render(mCharacter3);
+    mShadowEffect.Render(mSphere);
     mShadowEffect.End();
 
     mTerrainEffect.Begin();
@@ -88,6 +103,7 @@ void GameState::Render()
     mStandardEffect.Render(mCharacter);
     mStandardEffect.Render(mCharacter2);
     mStandardEffect.Render(mCharacter3);
+    mStandardEffect.Render(mSphere);
     mStandardEffect.End();
 
 }
@@ -129,6 +145,11 @@ void GameState::DebugUI()
         }
     }
     ImGui::DragFloat3("CharacterPosition", &mCharacter.transform.position.x, 0.1f);
+    if (ImGui::Button("Drop Ball"))
+    {
+        mSphereRigidBody.SetVelocity(Math::Vector3::Zero);
+        mSphereRigidBody.SetPosition({ mCamera.GetPosition().x, 25.0f, mCamera.GetPosition().z });
+    }
     ImGui::Separator();
 
     mStandardEffect.DebugUI();
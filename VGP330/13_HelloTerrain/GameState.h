@@ -29,6 +29,10 @@ private:
 	SabadEngine::Graphics::RenderObject mSphere;
 
 	SabadEngine::Graphics::Terrain mTerrain;
+	SabadEngine::Physics::CollisionShape mTerrainShape;
+	SabadEngine::Physics::RigidBody mTerrainRigidBody;
+	SabadEngine::Physics::CollisionShape mSphereShape;
+	SabadEngine::Physics::RigidBody mSphereRigidBody;
 
 	SabadEngine::Graphics::RenderObject mScreenQuad;
 	SabadEngine::Graphics::StandardEffect mStandardEffect;
@@ -5,6 +5,8 @@ using namespace SabadEngine;
 using namespace SabadEngine::Graphics;
 using namespace SabadEngine::Math;
 
+REGISTER_COMPONENT(CustomDebugDrawComponent);
+
 void CustomDebugDrawComponent::Initialize()
 {	 
 	mTransformComponent = GetOwner().GetComponent<TransformComponent>();
@@ -1,6 +1,8 @@
 #include "CustomDebugDrawService.h"
 #include "CustomDebugDrawComponent.h"
 
+REGISTER_SERVICE(CustomDebugDrawService);
+
 void CustomDebugDrawService::Render()
 {
 	for (const CustomDebugDrawComponent* component : mCustomDebugDrawComponents)
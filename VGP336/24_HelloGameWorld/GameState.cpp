@@ -7,45 +7,11 @@ using namespace SabadEngine::Graphics;
 using namespace SabadEngine::Input;
 using namespace SabadEngine::Physics;
 
-Service* MakeCustomService(const std::string& serviceName, GameWorld& gameWorld)
-{
-	if (serviceName == "CustomDebugDrawService")
-	{
-		return gameWorld.AddService<CustomDebugDrawService>();
-	}
-	// add another
-	// add text
-	return nullptr;
-}
-
-Component* MakeCustomComponent(const std::string& componentName, GameObject& gameObject)
-{
-	if (componentName == "CustomDebugDrawComponent")
-	{
-		return gameObject.AddComponent<CustomDebugDrawComponent>();
-	}
-	return nullptr;
-}
-
-Component* GetCustomComponent(const std::string& componentName, GameObject& gameObject)
-{
-	if (componentName == "CustomDebugDrawComponent")
-	{
-		return gameObject.GetComponent<CustomDebugDrawComponent>();
-	}
-	return nullptr;
-}
-
 void GameState::Initialize()
 {
 	mLevelFile = L"../../Assets/Templates/Levels/level.json";
 
-	// set a callback to try make a custom service (any service that is NoT part of the engine and unique to the project)
-	GameWorld::SetCustomService(MakeCustomService);
-	// sets callbacks to try make/get a custom component (any component that is NOT part of the engine)
-	GameObjectFactory::SetCustomMake(MakeCustomComponent);
-	GameObjectFactory::SetCustomGet(GetCustomComponent);
-
+	// custom services and components (anything that is NOT part of the engine) register themselves in their own cpp files
 	mGameWorld.LoadLevel(mLevelFile);
 
 
@@ -3,6 +3,8 @@
 using namespace SabadEngine;
 using namespace SabadEngine::Input;
 
+REGISTER_COMPONENT(DialogueComponent);
+
 void DialogueComponent::Initialize()
 {
     mTextComponent = GetOwner().GetComponent<UITextComponent>();
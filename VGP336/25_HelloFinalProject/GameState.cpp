@@ -6,31 +6,10 @@ using namespace SabadEngine::Graphics;
 using namespace SabadEngine::Input;
 using namespace SabadEngine::Physics;
 
-Component* MakeCustomComponent(const std::string& componentName, GameObject& gameObject)
-{
-	if (componentName == "DialogueComponent")
-	{
-		return gameObject.AddComponent<DialogueComponent>();
-	}
-	return nullptr;
-}
-
-Component* GetCustomComponent(const std::string& componentName, GameObject& gameObject)
-{
-	if (componentName == "DialogueComponent")
-	{
-		return gameObject.GetComponent<DialogueComponent>();
-	}
-	return nullptr;
-}
-
 void GameState::Initialize()
 {
 	mLevelFile = L"../../Assets/Templates/Levels/dialogue_level.json";
 
-	GameObjectFactory::SetCustomMake(MakeCustomComponent);
-	GameObjectFactory::SetCustomGet(GetCustomComponent);
-
 	mGameWorld.LoadLevel(mLevelFile);
 }
 
@@ -7,6 +7,8 @@
 using namespace SabadEngine;
 using namespace SabadEngine::Graphics;
 
+REGISTER_COMPONENT(DynamicModelComponent);
+
 void DynamicModelComponent::Initialize()
 {
     // Do NOT call RenderObjectComponent::Initialize() because it automatically 
@@ -87,7 +89,7 @@ void DynamicModelComponent::RegisterWithRenderService()
         return;
     }
 
-    RenderService* renderService = GetOwner().GetWorld().GetService<RenderService>();
+    RenderService* renderService = GetOwner().GetWorld().GetRenderService();
     if (renderService != nullptr)
     {
         renderService->Register(this);
@@ -102,7 +104,7 @@ void DynamicModelComponent::UnregisterFromRenderService()
         return;
     }
 
-    RenderService* renderService = GetOwner().GetWorld().GetService<RenderService>();
+    RenderService* renderService = GetOwner().GetWorld().GetRenderService();
     if (renderService != nullptr)
     {
         renderService->Unregister(this);
@@ -9,6 +9,7 @@ class DynamicModelComponent : public SabadEngine::RenderObjectComponent
 {
 public:
     SET_TYPE_ID(CustomComponentId::DynamicModel);
+    SET_UPDATE_ACCESS(SabadEngine::UpdateData::None, SabadEngine::UpdateData::None, SabadEngine::UpdateThreading::PerObject);
 
     void Initialize() override;
     void Terminate() override;
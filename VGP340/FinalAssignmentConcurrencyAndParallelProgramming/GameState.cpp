@@ -9,36 +9,12 @@ using namespace SabadEngine::Graphics;
 using namespace SabadEngine::Input;
 using namespace SabadEngine::Physics;
 
-namespace
-{
-    Component* MakeCustomComponent(const std::string& componentName, GameObject& gameObject)
-    {
-        if (componentName == "DynamicModelComponent")
-        {
-            return gameObject.AddComponent<DynamicModelComponent>();
-        }
-        return nullptr;
-    }
-
-    Component* GetCustomComponent(const std::string& componentName, GameObject& gameObject)
-    {
-        if (componentName == "DynamicModelComponent")
-        {
-            return gameObject.GetComponent<DynamicModelComponent>();
-        }
-        return nullptr;
-    }
-}
-
 void GameState::Initialize()
 {
     // Use a custom level file
     mLevelFile = L"../../Assets/Templates/Levels/concurrency_level.json";
 
-    // Set custom callbacks to instantiate and access our custom DynamicModelComponent
-    GameObjectFactory::SetCustomMake(MakeCustomComponent);
-    GameObjectFactory::SetCustomGet(GetCustomComponent);
-
+    // DynamicModelComponent registers itself with REGISTER_COMPONENT, so the level can name it
     // Initialize the GameWorld
     mGameWorld.LoadLevel(mLevelFile);
 
@@ -54,36 +30,34 @@ void GameState::Initialize()
     mMaxConcurrentBackgroundLoads = static_cast<int>(std::max<unsigned int>(1u, numThreads / 2));
 
     // Spawn a large grid of dynamic model objects (30x30 = 900 objects)
+    // the components are made from the template on the job system, then every object initializes here
     const float spacing = 20.0f;
     const int gridSize = 30;
     mTelemetryTotalObjects = gridSize * gridSize;
 
-    for (int x = 0; x < gridSize; ++x)
-    {
-        for (int z = 0; z < gridSize; ++z)
+    const auto spawnStart = std::chrono::high_resolution_clock::now();
+    std::vector<GameObject*> gridObjects = mGameWorld.CreateGameObjects("../../Assets/Templates/Objects/dynamic_model_obj.json", mTelemetryTotalObjects,
+        [spacing, gridSize](GameObject& go, uint32_t index)
         {
-            float posX = (x - gridSize / 2.0f) * spacing;
-            float posZ = (z - gridSize / 2.0f) * spacing;
-
+            const int x = static_cast<int>(index) / gridSize;
+            const int z = static_cast<int>(index) % gridSize;
             std::string name = "GridObj_" + std::to_string(x) + "_" + std::to_string(z);
-            GameObject* go = mGameWorld.CreateGameObject(name, "../../Assets/Templates/Objects/dynamic_model_obj.json");
-            if (go != nullptr)
-            {
-                TransformComponent* tc = go->GetComponent<TransformComponent>();
-                if (tc != nullptr)
-                {
-                    tc->position = { posX, 0.0f, posZ };
-                }
-
-                // Call components initialize
-                go->Initialize();
+            go.SetName(name);
 
-                DynamicModelComponent* dmc = go->GetComponent<DynamicModelComponent>();
-                if (dmc != nullptr)
-                {
-                    mDynamicModels.push_back(dmc);
-                }
+            TransformComponent* tc = go.GetComponent<TransformComponent>();
+            if (tc != nullptr)
+            {
+                tc->position = { (x - gridSize / 2.0f) * spacing, 0.0f, (z - gridSize / 2.0f) * spacing };
             }
+        });
+    mGridSpawnMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - spawnStart).count();
+
+    for (GameObject* go : gridObjects)
+    {
+        DynamicModelComponent* dmc = go->GetComponent<DynamicModelComponent>();
+        if (dmc != nullptr)
+        {
+            mDynamicModels.push_back(dmc);
         }
     }
 }
@@ -98,10 +72,12 @@ void GameState::Terminate()
 void GameState::Update(float deltaTime)
 {
     // Update camera and basic engine logic
+    const auto updateStart = std::chrono::high_resolution_clock::now();
     mGameWorld.Update(deltaTime);
+    mWorldUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - updateStart).count();
 
     // Get the Camera position
-    CameraService* cameraService = mGameWorld.GetService<CameraService>();
+    CameraService* cameraService = mGameWorld.GetCameraService();
     if (cameraService == nullptr)
     {
         return;
@@ -236,6 +212,7 @@ void GameState::DebugUI()
     ImGui::Text("Active Background CPU Loads: %d", mTelemetryLoadingCount.load());
     ImGui::Text("Models Loaded in Memory: %d", mTelemetryLoadedCount);
     ImGui::Text("Models Currently Rendered: %d", mTelemetryRenderedCount);
+    ImGui::Text("Grid Spawn Time: %.3f ms", mGridSpawnMs);
 
     ImGui::Separator();
     ImGui::Text("=== THREAD POOL CONFIG ===");
@@ -248,6 +225,16 @@ void GameState::DebugUI()
     ImGui::SliderFloat("Load Distance X", &mGlobalDistanceThreshold, 10.0f, 400.0f, "%.1f");
     ImGui::SliderInt("Max Background Loads", &mMaxConcurrentBackgroundLoads, 1, 32);
 
+    ImGui::Separator();
+    ImGui::Text("=== GAMEWORLD UPDATE ===");
+    ImGui::Text("GameWorld::Update: %.3f ms", mWorldUpdateMs);
+    Core::JobSystem* jobSystem = Core::JobSystem::Get();
+    mUpdateThreads = static_cast<int>(jobSystem->GetActiveWorkerCount()) + 1;
+    if (ImGui::SliderInt("Update Threads", &mUpdateThreads, 1, static_cast<int>(jobSystem->GetThreadCount())))
+    {
+        jobSystem->SetActiveWorkerCount(static_cast<uint32_t>(mUpdateThreads - 1));
+    }
+
     ImGui::End();
 
     // Standard GameWorld services debug UI
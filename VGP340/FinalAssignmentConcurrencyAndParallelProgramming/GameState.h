@@ -30,8 +30,13 @@ private:
     std::atomic<int> mTelemetryLoadingCount{ 0 };
     int mTelemetryLoadedCount = 0;
     int mTelemetryRenderedCount = 0;
+    float mGridSpawnMs = 0.0f;
 
     // Background-load throttling
     std::atomic<int> mConcurrentBackgroundLoads{ 0 };
     int mMaxConcurrentBackgroundLoads = 4;
+
+    // GameWorld::Update timing, the scheduler spreads component updates over this many job system threads
+    int mUpdateThreads = 1;
+    float mWorldUpdateMs = 0.0f;
 };